@@ -9,21 +9,76 @@
 
 #include "AsyncCall.h"
 #include "Buffer.h"
+#include "RecvBuffer.h"
+#include "SockStats.h"
 #include "ifs/net.h"
 #include "ifs/Socket.h"
 #include "Timer.h"
 #include "inetAddr.h"
+#include <vector>
+#include <atomic>
+
+#if defined(Linux) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#if defined(IORING_FEAT_FAST_POLL) && defined(IORING_FEAT_RW_CUR_POS)
+#define HAVE_IO_URING
+#endif
+#endif
 
 namespace fibjs {
 
 #define KEEPALIVE_TIMEOUT 120
 #define SOCKET_BUFF_SIZE 2048
 
+#ifdef HAVE_IO_URING
+bool init_uring();
+result_t uring_close(intptr_t& sockfd, void*& recvProc, void*& sendProc, AsyncEvent* ac);
+result_t uring_connect(intptr_t& sockfd, inetAddr& ai, AsyncEvent* ac, exlib::Locker& locker,
+    void*& opt, Timer_base* timer, SockStats& stats);
+result_t uring_accept(intptr_t& sockfd, obj_ptr<Socket_base>& retVal, AsyncEvent* ac,
+    exlib::Locker& locker, void*& opt, SockStats& stats);
+result_t uring_accept(intptr_t& sockfd, std::vector<obj_ptr<Socket_base>>& retVal, int32_t budget,
+    AsyncEvent* ac, exlib::Locker& locker, void*& opt, SockStats& stats);
+result_t uring_read(intptr_t& sockfd, int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac,
+    int32_t family, bool bRead, exlib::Locker& locker, void*& opt, Timer_base* timer, int32_t& recvSize, SockStats& stats);
+result_t uring_write(intptr_t& sockfd, Buffer_base* data, AsyncEvent* ac, int32_t family,
+    exlib::Locker& locker, void*& opt, SockStats& stats);
+result_t uring_writev(intptr_t& sockfd, std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac,
+    int32_t family, exlib::Locker& locker, void*& opt, SockStats& stats);
+result_t uring_sendfile(intptr_t& sockfd, int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal,
+    AsyncEvent* ac, exlib::Locker& locker, void*& opt, SockStats& stats);
+result_t uring_file_read(int32_t fd, int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+result_t uring_file_write(int32_t fd, Buffer_base* data, AsyncEvent* ac);
+#endif
+
+#ifndef _WIN32
+result_t accept_drain(intptr_t sockfd, std::vector<obj_ptr<Socket_base>>& socks, int32_t budget);
+#endif
+
+struct AcceptStats {
+    std::atomic<int64_t> batches;
+    std::atomic<int64_t> accepted;
+    std::atomic<int64_t> max;
+
+    void record(int64_t n)
+    {
+        int64_t m = max.load(std::memory_order_relaxed);
+
+        batches.fetch_add(1, std::memory_order_relaxed);
+        accepted.fetch_add(n, std::memory_order_relaxed);
+        while (n > m && !max.compare_exchange_weak(m, n, std::memory_order_relaxed))
+            ;
+    }
+};
+
+extern AcceptStats g_accept_stats;
+
 class AsyncIO {
 public:
     AsyncIO(intptr_t s, int32_t family)
         : m_fd(s)
         , m_family(family)
+        , m_recvSize(SOCKET_BUFF_SIZE)
 #ifndef _WIN32
         , m_RecvOpt(NULL)
         , m_SendOpt(NULL)
@@ -34,11 +89,16 @@ public:
 public:
     result_t connect(exlib::string host, int32_t port, AsyncEvent* ac, Timer_base* timer);
     result_t accept(obj_ptr<Socket_base>& retVal, AsyncEvent* ac);
+#ifndef _WIN32
+    result_t accept(std::vector<obj_ptr<Socket_base>>& retVal, int32_t budget, AsyncEvent* ac);
+#endif
     result_t write(Buffer_base* data, AsyncEvent* ac);
+    result_t writev(std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac);
     result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
         AsyncEvent* ac, bool bRead, Timer_base* timer);
 
 #ifndef _WIN32
+    result_t sendfile(int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
     result_t close(AsyncEvent* ac);
 #else
     result_t close(AsyncEvent* ac)
@@ -57,6 +117,8 @@ public:
 public:
     intptr_t m_fd;
     int32_t m_family;
+    int32_t m_recvSize;
+    SockStats m_stats;
 
 private:
     exlib::Locker m_lockRecv;
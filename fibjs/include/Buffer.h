@@ -4,9 +4,96 @@
 #include <list>
 
 #include "ifs/Buffer.h"
+#include "SlabAllocator.h"
 
 namespace fibjs {
 
+// the bytes of a Buffer, an exlib::string handed to the constructor is adopted as is, raw bytes go
+// to a slab block, and a string moves into a block once when .buffer has to share it with V8
+class BufferData {
+public:
+    BufferData()
+        : m_block(NULL)
+        , m_len(0)
+    {
+    }
+
+    BufferData(const exlib::string& str)
+        : m_str(str)
+        , m_block(NULL)
+        , m_len(0)
+    {
+    }
+
+    BufferData(const char* p, size_t n)
+        : m_block(NULL)
+        , m_len(0)
+    {
+        assign(p, n);
+    }
+
+    ~BufferData()
+    {
+        if (m_block)
+            m_block->unref();
+    }
+
+private:
+    BufferData(const BufferData&);
+    BufferData& operator=(const BufferData&);
+
+public:
+    BufferData& operator=(const exlib::string& str)
+    {
+        if (m_block) {
+            m_block->unref();
+            m_block = NULL;
+            m_len = 0;
+        }
+
+        m_str = str;
+        return *this;
+    }
+
+    size_t length() const
+    {
+        return m_block ? m_len : m_str.length();
+    }
+
+    const char* c_str() const
+    {
+        return m_block ? m_block->data() : m_str.c_str();
+    }
+
+    char* c_buffer()
+    {
+        return m_block ? m_block->data() : m_str.c_buffer();
+    }
+
+    char operator[](size_t i) const
+    {
+        return c_str()[i];
+    }
+
+    void append(const exlib::string& str)
+    {
+        append(str.c_str(), str.length());
+    }
+
+    // p may be NULL, the bytes are left uninitialized
+    void assign(const char* p, size_t n);
+    void resize(size_t n);
+    void append(const char* p, size_t n);
+
+    exlib::string str() const;
+    SlabBlock* block();
+
+private:
+    exlib::string m_str;
+    SlabBlock* m_block;
+    size_t m_len;
+};
+
 class Buffer : public Buffer_base {
 public:
     Buffer()
@@ -28,6 +115,7 @@ public:
         extMemory((int32_t)m_data.length());
     }
 
+    // pData may be NULL to get n uninitialized bytes to fill through data()
     Buffer(const void* pData, size_t n)
         : m_data((const char*)pData, n)
     {
@@ -169,6 +257,6 @@ public:
     }
 
 private:
-    exlib::string m_data;
+    BufferData m_data;
 };
 }
@@ -8,12 +8,72 @@
 #pragma once
 
 #include "ifs/BufferedStream.h"
+#include "Buffer.h"
 #include "StringBuffer.h"
 #include "encoding_iconv.h"
 
 namespace fibjs {
 
 class BufferedStream : public BufferedStream_base {
+public:
+    // the chunk last read from m_stm, parsed in place so its bytes are not copied again
+    class Chunk {
+    public:
+        Chunk()
+            : m_data(NULL)
+            , m_len(0)
+        {
+        }
+
+    public:
+        void set(Buffer_base* buf)
+        {
+            int32_t len;
+
+            buf->get_length(len);
+            m_buf = buf;
+            m_data = ((Buffer*)buf)->data();
+            m_len = len;
+        }
+
+        void clear()
+        {
+            m_buf.Release();
+            m_data = NULL;
+            m_len = 0;
+        }
+
+        size_t length() const
+        {
+            return m_len;
+        }
+
+        const char* c_str() const
+        {
+            return m_data;
+        }
+
+        char operator[](size_t i) const
+        {
+            return m_data[i];
+        }
+
+        exlib::string substr(size_t pos, size_t n) const
+        {
+            return exlib::string(m_data + pos, n);
+        }
+
+        Buffer_base* buffer() const
+        {
+            return m_buf;
+        }
+
+    private:
+        obj_ptr<Buffer_base> m_buf;
+        const char* m_data;
+        size_t m_len;
+    };
+
 public:
     BufferedStream(Stream_base* stm)
         : m_stm(stm)
@@ -33,6 +93,7 @@ public:
     virtual result_t get_fd(int32_t& retVal);
     virtual result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
     virtual result_t write(Buffer_base* data, AsyncEvent* ac);
+    virtual result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac);
     virtual result_t flush(AsyncEvent* ac);
     virtual result_t close(AsyncEvent* ac);
     virtual result_t copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
@@ -51,23 +112,24 @@ public:
     virtual result_t get_EOL(exlib::string& retVal);
     virtual result_t set_EOL(exlib::string newVal);
 
+public:
+    // reads up to the blank line that ends an HTTP message head, the terminator is consumed but not returned
+    result_t readHead(int32_t maxlen, exlib::string& retVal, AsyncEvent* ac);
+
 public:
     void append(int32_t n)
     {
         if (n > 0) {
-            if (m_pos == 0 && n == (int32_t)m_buf.length())
-                m_strbuf.append(m_buf);
-            else {
-                exlib::string s1(m_buf.substr(m_pos, n));
-                m_strbuf.append(s1);
-            }
+            exlib::string s1(m_buf.substr(m_pos, n));
+
+            m_strbuf.append(s1);
             m_pos += n;
         }
     }
 
 public:
     obj_ptr<Stream_base> m_stm;
-    exlib::string m_buf;
+    Chunk m_buf;
     int32_t m_pos;
     int32_t m_temp;
     exlib::string m_eol;
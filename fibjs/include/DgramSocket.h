@@ -10,6 +10,8 @@
 #include "ifs/DgramSocket.h"
 #include "AsyncUV.h"
 #include "Buffer.h"
+#include "SimpleObject.h"
+#include "inetAddr.h"
 
 namespace fibjs {
 
@@ -18,6 +20,7 @@ public:
     DgramSocket()
         : m_flags(0)
         , m_bound(false)
+        , m_batch(false)
     {
     }
 
@@ -50,6 +53,7 @@ public:
     virtual result_t bind(v8::Local<v8::Object> opts, AsyncEvent* ac);
     virtual result_t send(Buffer_base* msg, int32_t port, exlib::string address, int32_t& retVal, AsyncEvent* ac);
     virtual result_t send(Buffer_base* msg, int32_t offset, int32_t length, int32_t port, exlib::string address, int32_t& retVal, AsyncEvent* ac);
+    virtual result_t sendBatch(v8::Local<v8::Array> msgs, int32_t port, exlib::string address, int32_t& retVal, AsyncEvent* ac);
     virtual result_t address(obj_ptr<NObject>& retVal);
     virtual result_t close();
     virtual result_t close(v8::Local<v8::Function> callback);
@@ -65,8 +69,11 @@ public:
     void stop_bind();
 
 private:
+    result_t resolve(int32_t port, exlib::string address, inetAddr& addr_info);
+
     static void on_alloc(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf);
     static void on_recv(uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned flags);
+    void on_batch(ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned flags);
 
 public:
     union {
@@ -76,10 +83,13 @@ public:
     int32_t m_family;
     int32_t m_flags;
     bool m_bound;
+    bool m_batch;
     int32_t m_recvbuf_size = -1;
     int32_t m_sendbuf_size = -1;
 
     exlib::string m_buf;
+    obj_ptr<NArray> m_msgs;
+    obj_ptr<NArray> m_rinfos;
 
     obj_ptr<ValueHolder> m_holder;
 };
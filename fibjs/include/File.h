@@ -48,6 +48,7 @@ public:
     // Stream_base
     virtual result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
     virtual result_t write(Buffer_base* data, AsyncEvent* ac);
+    virtual result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac);
     virtual result_t flush(AsyncEvent* ac);
     virtual result_t close(AsyncEvent* ac);
     virtual result_t copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
@@ -72,6 +73,9 @@ public:
 public:
     result_t open(exlib::string fname, exlib::string flags);
     result_t close();
+    result_t copyRange(Stream_base* stm, int64_t pos, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
+    // fstat()s the file, only call it once the call has left the sync phase
+    bool zero_copy(Stream_base* stm);
     result_t Write(const char* p, int32_t sz);
 
     result_t Write(exlib::string data)
@@ -91,6 +95,12 @@ protected:
     int32_t m_fd;
 };
 
+// an anonymous file under os.tmpdir(), the system removes it once it is closed
+class TempFile : public File {
+public:
+    result_t open(exlib::string prefix);
+};
+
 inline result_t file_open(exlib::string fname, exlib::string flags, int32_t mode, int32_t& fd)
 {
 #ifdef _WIN32
@@ -0,0 +1,63 @@
+/*
+ * HPack.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "utils.h"
+#include <deque>
+#include <vector>
+
+namespace fibjs {
+
+#define HPACK_TABLE_SIZE 4096
+
+class HPack {
+public:
+    typedef std::pair<exlib::string, exlib::string> header;
+
+public:
+    class Decoder {
+    public:
+        Decoder()
+            : m_size(0)
+            , m_max(HPACK_TABLE_SIZE)
+            , m_limit(HPACK_TABLE_SIZE)
+        {
+        }
+
+    public:
+        // headers are appended in block order, returns CALL_E_INVALID_DATA on a compression error
+        // and CALL_E_OVERFLOW once the decoded list passes max_list, counted as in RFC 7541
+        result_t decode(const char* data, size_t sz, std::vector<header>& headers, size_t max_list);
+
+    private:
+        bool get(size_t idx, header& retVal);
+        void add(header& h);
+        void evict(size_t max);
+
+    private:
+        std::deque<header> m_table;
+        size_t m_size;
+        size_t m_max;
+        size_t m_limit;
+    };
+
+    class Encoder {
+    public:
+        // the dynamic table is never used, so a block only depends on its own headers
+        void encode(const std::vector<header>& headers, exlib::string& retVal);
+    };
+
+public:
+    static void encode_int(exlib::string& out, uint8_t prefix, int32_t bits, size_t v);
+    static void encode_str(exlib::string& out, const exlib::string& s);
+
+    static bool huffman_decode(const char* data, size_t sz, exlib::string& retVal);
+    static size_t huffman_size(const exlib::string& s);
+    static void huffman_encode(const exlib::string& s, exlib::string& out);
+};
+}
@@ -0,0 +1,160 @@
+/*
+ * Http2Client.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "object.h"
+#include "HPack.h"
+#include "Http2Session.h"
+#include "ifs/BufferedStream.h"
+#include "ifs/HttpRequest.h"
+#include "ifs/HttpResponse.h"
+#include <map>
+
+namespace fibjs {
+
+// one client connection speaking HTTP/2, requests from any number of fibers share it as streams
+class Http2Client : public Http2Connection {
+public:
+    class Stream : public object_base {
+    public:
+        Stream(Http2Client* client, HttpRequest_base* req, SeekableStream_base* response_body,
+            int32_t maxBodySize, bool enableEncoding, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
+            : m_client(client)
+            , m_req(req)
+            , m_response_body(response_body)
+            , m_maxBodySize(maxBodySize)
+            , m_enableEncoding(enableEncoding)
+            , m_retVal(retVal)
+            , m_ac(ac)
+            , m_id(0)
+            , m_send_window(0)
+            , m_status(0)
+            , m_size(0)
+            , m_hr(0)
+            , m_done(false)
+            , m_reset(false)
+            , m_refused(false)
+        {
+        }
+
+    public:
+        obj_ptr<Http2Client> m_client;
+        obj_ptr<HttpRequest_base> m_req;
+        obj_ptr<SeekableStream_base> m_response_body;
+        int32_t m_maxBodySize;
+        bool m_enableEncoding;
+        obj_ptr<HttpResponse_base>& m_retVal;
+        AsyncEvent* m_ac;
+
+        int32_t m_id;
+        int64_t m_send_window;
+        int32_t m_status;
+        std::vector<HPack::header> m_headers;
+        exlib::string m_body;
+        obj_ptr<SeekableStream_base> m_spill;
+        int64_t m_size;
+        result_t m_hr;
+        bool m_done;
+        bool m_reset;
+        bool m_refused;
+    };
+
+public:
+    Http2Client(Stream_base* stm, bool ssl, int32_t maxStreams)
+        : Http2Connection(stm, NULL)
+        , m_ssl(ssl)
+        , m_next_id(1)
+        , m_send_window(H2_DEFAULT_WINDOW)
+        , m_init_window(H2_DEFAULT_WINDOW)
+        , m_max_frame(H2_DEFAULT_FRAME_SIZE)
+        , m_closed(false)
+        , m_goaway(false)
+        , m_max_streams(maxStreams)
+        , m_peer_streams(H2_MAX_STREAMS)
+        , m_active(0)
+        , m_accept(true)
+        , m_block_id(0)
+        , m_block_flags(0)
+    {
+        m_idle.now();
+    }
+
+public:
+    // the client preface and SETTINGS, written before any stream so nothing can overtake them
+    static void preface(exlib::string& buf);
+
+    // starts the reader fiber, the preface has to be on the wire already
+    void start();
+
+    // takes a stream slot, fails when the connection is closing or every slot is in use
+    bool reserve();
+    bool closed();
+    bool idle(date_t d, int32_t timeout);
+    void close();
+
+    // sends req on a reserved slot and posts ac once the whole response has arrived
+    result_t request(HttpRequest_base* req, SeekableStream_base* response_body, int32_t maxBodySize,
+        bool enableEncoding, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
+
+private:
+    static result_t session_proc(Http2Client* pThis);
+    static result_t stream_proc(Stream* s);
+
+    result_t process();
+
+    int32_t on_data(int32_t flags, int32_t id, exlib::string& payload);
+    int32_t on_headers(int32_t flags, int32_t id, exlib::string& payload);
+    int32_t on_continuation(int32_t flags, int32_t id, exlib::string& payload);
+    int32_t on_rst_stream(int32_t id, exlib::string& payload);
+    int32_t on_settings(int32_t flags, int32_t id, exlib::string& payload);
+    int32_t on_goaway(int32_t id, exlib::string& payload);
+    int32_t on_window_update(int32_t id, exlib::string& payload);
+
+    int32_t end_headers();
+    void finish(Stream* s, result_t hr);
+    void refuse();
+
+    result_t send_request(Stream* s);
+    result_t send_data(Stream* s, const char* data, size_t sz, bool end);
+    int32_t acquire(Stream* s, size_t want);
+    result_t response(Stream* s);
+
+    result_t goaway(int32_t code);
+
+private:
+    bool m_ssl;
+
+    HPack::Decoder m_decoder;
+    HPack::Encoder m_encoder;
+
+    // m_lock guards the stream table and the send windows, m_wlock also keeps stream ids in the
+    // order their HEADERS are sent
+    exlib::Locker m_lock;
+    exlib::CondVar m_cond;
+
+    std::map<int32_t, obj_ptr<Stream>> m_streams;
+    int32_t m_next_id;
+    int64_t m_send_window;
+    int64_t m_init_window;
+    int32_t m_max_frame;
+    bool m_closed;
+    bool m_goaway;
+
+    // slot bookkeeping is read by HttpClient outside any fiber, so it has its own spinlock
+    exlib::spinlock m_slock;
+    int32_t m_max_streams;
+    int32_t m_peer_streams;
+    int32_t m_active;
+    date_t m_idle;
+    bool m_accept;
+
+    exlib::string m_block;
+    int32_t m_block_id;
+    int32_t m_block_flags;
+};
+}
@@ -0,0 +1,129 @@
+/*
+ * Http2Connection.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "object.h"
+#include "ifs/Stream.h"
+#include "ifs/BufferedStream.h"
+#include "ifs/SeekableStream.h"
+
+namespace fibjs {
+
+#define H2_PREFACE "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+#define H2_PREFACE_SIZE 24
+
+#define H2_FRAME_DATA 0
+#define H2_FRAME_HEADERS 1
+#define H2_FRAME_PRIORITY 2
+#define H2_FRAME_RST_STREAM 3
+#define H2_FRAME_SETTINGS 4
+#define H2_FRAME_PUSH_PROMISE 5
+#define H2_FRAME_PING 6
+#define H2_FRAME_GOAWAY 7
+#define H2_FRAME_WINDOW_UPDATE 8
+#define H2_FRAME_CONTINUATION 9
+
+#define H2_FLAG_END_STREAM 0x1
+#define H2_FLAG_ACK 0x1
+#define H2_FLAG_END_HEADERS 0x4
+#define H2_FLAG_PADDED 0x8
+#define H2_FLAG_PRIORITY 0x20
+
+#define H2_SETTINGS_HEADER_TABLE_SIZE 1
+#define H2_SETTINGS_ENABLE_PUSH 2
+#define H2_SETTINGS_MAX_CONCURRENT_STREAMS 3
+#define H2_SETTINGS_INITIAL_WINDOW_SIZE 4
+#define H2_SETTINGS_MAX_FRAME_SIZE 5
+#define H2_SETTINGS_MAX_HEADER_LIST_SIZE 6
+
+#define H2_NO_ERROR 0
+#define H2_PROTOCOL_ERROR 1
+#define H2_INTERNAL_ERROR 2
+#define H2_FLOW_CONTROL_ERROR 3
+#define H2_STREAM_CLOSED 5
+#define H2_FRAME_SIZE_ERROR 6
+#define H2_REFUSED_STREAM 7
+#define H2_CANCEL 8
+#define H2_COMPRESSION_ERROR 9
+#define H2_ENHANCE_YOUR_CALM 11
+
+#define H2_DEFAULT_WINDOW 65535
+#define H2_DEFAULT_FRAME_SIZE 16384
+#define H2_MAX_WINDOW 0x7fffffff
+
+// what this end advertises in its SETTINGS frame
+#define H2_MAX_STREAMS 100
+#define H2_STREAM_WINDOW (1024 * 1024)
+#define H2_MAX_HEADER_BLOCK (256 * 1024)
+#define H2_MAX_HEADER_LIST (256 * 1024)
+
+// stream bodies are only handed on once their stream ends, the bodies of one connection share this
+// much memory and the rest goes to temp files, so the receive windows can be given back as data arrives
+#define H2_BODY_MEMORY (4 * 1024 * 1024)
+
+// the framing both ends of an HTTP/2 connection share, Http2Session serves it and Http2Client uses it
+class Http2Connection : public object_base {
+public:
+    Http2Connection(Stream_base* stm, BufferedStream_base* in)
+        : m_stm(stm)
+        , m_in(in)
+        , m_body_memory(0)
+    {
+    }
+
+public:
+    static int32_t get_u31(const char* p)
+    {
+        const uint8_t* s = (const uint8_t*)p;
+        return ((s[0] & 0x7f) << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
+    }
+
+    static void put_u32(exlib::string& buf, uint32_t v)
+    {
+        buf.append(1, (char)(v >> 24));
+        buf.append(1, (char)(v >> 16));
+        buf.append(1, (char)(v >> 8));
+        buf.append(1, (char)v);
+    }
+
+    static void put_setting(exlib::string& buf, int32_t id, uint32_t v)
+    {
+        buf.append(1, (char)(id >> 8));
+        buf.append(1, (char)id);
+        put_u32(buf, v);
+    }
+
+    static void frame_head(exlib::string& buf, int32_t type, int32_t flags, int32_t id, size_t sz);
+
+protected:
+    // CALL_RETURN_NULL when the connection ends before bytes have arrived
+    result_t read(int32_t bytes, exlib::string& retVal);
+
+    int32_t on_ping(int32_t flags, int32_t id, exlib::string& payload);
+
+    result_t write(exlib::string& buf);
+    result_t write_frame(int32_t type, int32_t flags, int32_t id, const char* data, size_t sz);
+    result_t window_update(int32_t id, int32_t inc);
+    result_t rst(int32_t id, int32_t code);
+
+    // appends a DATA payload to a stream body, moving the body to spill once the memory share is used up
+    result_t buffer_body(exlib::string& body, obj_ptr<SeekableStream_base>& spill, const char* data, size_t sz);
+    // the body has been handed on or dropped, its memory goes back to the connection
+    void release_body(exlib::string& body);
+
+protected:
+    obj_ptr<Stream_base> m_stm;
+    obj_ptr<BufferedStream_base> m_in;
+
+    // keeps frames whole on the wire
+    exlib::Locker m_wlock;
+
+    exlib::spinlock m_body_lock;
+    int64_t m_body_memory;
+};
+}
@@ -0,0 +1,125 @@
+/*
+ * Http2Session.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "object.h"
+#include "HPack.h"
+#include "Http2Connection.h"
+#include "ifs/BufferedStream.h"
+#include "ifs/HttpRequest.h"
+#include "ifs/HttpResponse.h"
+#include "HttpHandler.h"
+#include <map>
+
+namespace fibjs {
+
+class Http2Session : public Http2Connection {
+public:
+    class Stream : public object_base {
+    public:
+        Stream(Http2Session* session, int32_t id, int32_t window)
+            : m_session(session)
+            , m_id(id)
+            , m_send_window(window)
+            , m_status(0)
+            , m_size(0)
+            , m_remote_closed(false)
+            , m_reset(false)
+            , m_dispatched(false)
+        {
+        }
+
+    public:
+        obj_ptr<Http2Session> m_session;
+        int32_t m_id;
+        obj_ptr<HttpRequest_base> m_req;
+        exlib::string m_body;
+        obj_ptr<SeekableStream_base> m_spill;
+        int64_t m_send_window;
+        int32_t m_status;
+        int64_t m_size;
+        bool m_remote_closed;
+        bool m_reset;
+        bool m_dispatched;
+    };
+
+public:
+    Http2Session(HttpHandler* hdlr, Stream_base* stm, BufferedStream_base* in)
+        : Http2Connection(stm, in)
+        , m_hdlr(hdlr)
+        , m_ac(NULL)
+        , m_last_id(0)
+        , m_send_window(H2_DEFAULT_WINDOW)
+        , m_init_window(H2_DEFAULT_WINDOW)
+        , m_max_frame(H2_DEFAULT_FRAME_SIZE)
+        , m_active(0)
+        , m_closed(false)
+        , m_goaway(false)
+        , m_block_id(0)
+        , m_block_flags(0)
+    {
+    }
+
+public:
+    // takes over the connection after the client preface line has been parsed as an HTTP/1.x request.
+    // upgrade is the request that carried "Upgrade: h2c", it becomes stream 1
+    result_t run(HttpRequest_base* upgrade, AsyncEvent* ac);
+
+private:
+    class DataStream;
+
+    static result_t session_proc(Http2Session* pThis);
+    static result_t stream_proc(Stream* s);
+
+    result_t process();
+
+    int32_t on_data(int32_t flags, int32_t id, exlib::string& payload);
+    int32_t on_headers(int32_t flags, int32_t id, exlib::string& payload);
+    int32_t on_continuation(int32_t flags, int32_t id, exlib::string& payload);
+    int32_t on_rst_stream(int32_t id, exlib::string& payload);
+    int32_t on_settings(int32_t flags, int32_t id, exlib::string& payload);
+    int32_t on_window_update(int32_t id, exlib::string& payload);
+
+    int32_t end_headers();
+    int32_t apply_settings(const exlib::string& payload);
+    result_t fill(Stream* s, std::vector<HPack::header>& hdrs);
+    void dispatch(Stream* s);
+
+    void respond(Stream* s);
+    result_t send_response(Stream* s, HttpResponse_base* rep, bool headOnly, int32_t type);
+    result_t send_data(Stream* s, const char* data, size_t sz, bool end);
+    int32_t acquire(Stream* s, size_t want);
+
+    result_t goaway(int32_t code);
+
+private:
+    obj_ptr<HttpHandler> m_hdlr;
+    obj_ptr<HttpRequest_base> m_upgrade;
+    AsyncEvent* m_ac;
+
+    HPack::Decoder m_decoder;
+    HPack::Encoder m_encoder;
+
+    // m_lock guards the stream table and the send windows
+    exlib::Locker m_lock;
+    exlib::CondVar m_cond;
+
+    std::map<int32_t, obj_ptr<Stream>> m_streams;
+    int32_t m_last_id;
+    int64_t m_send_window;
+    int64_t m_init_window;
+    int32_t m_max_frame;
+    int32_t m_active;
+    bool m_closed;
+    bool m_goaway;
+
+    exlib::string m_block;
+    int32_t m_block_id;
+    int32_t m_block_flags;
+};
+}
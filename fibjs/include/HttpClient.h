@@ -9,7 +9,12 @@
 #include "ifs/HttpClient.h"
 #include "HttpCookie.h"
 #include "ifs/ssl.h"
+#include "ifs/Timer.h"
 #include "Url.h"
+#include "Http2Client.h"
+#include <list>
+#include <map>
+#include <unordered_map>
 
 namespace fibjs {
 
@@ -24,8 +29,18 @@ public:
         , m_enableEncoding(true)
         , m_sslVerification(-1)
         , m_maxBodySize(-1)
+        , m_enableHttp2(false)
+        , m_enableH2c(false)
+        , m_maxConcurrentStreams(H2_MAX_STREAMS)
         , m_poolSize(128)
         , m_poolTimeout(10000)
+        , m_maxConnsPerHost(0)
+        , m_active(0)
+        , m_reaping(false)
+        , m_hits(0)
+        , m_misses(0)
+        , m_waits(0)
+        , m_evictions(0)
     {
         m_cookies = new NArray();
         m_userAgent = "Mozilla/5.0 AppleWebKit/537.36 (KHTML, like Gecko) Chrome/54.0.2840.98 Safari/537.36";
@@ -50,13 +65,22 @@ public:
     virtual result_t set_poolSize(int32_t newVal);
     virtual result_t get_poolTimeout(int32_t& retVal);
     virtual result_t set_poolTimeout(int32_t newVal);
+    virtual result_t get_maxConnsPerHost(int32_t& retVal);
+    virtual result_t set_maxConnsPerHost(int32_t newVal);
     virtual result_t get_http_proxy(exlib::string& retVal);
     virtual result_t set_http_proxy(exlib::string newVal);
     virtual result_t get_https_proxy(exlib::string& retVal);
     virtual result_t set_https_proxy(exlib::string newVal);
     virtual result_t get_sslVerification(int32_t& retVal);
     virtual result_t set_sslVerification(int32_t newVal);
+    virtual result_t get_enableHttp2(bool& retVal);
+    virtual result_t set_enableHttp2(bool newVal);
+    virtual result_t get_enableH2c(bool& retVal);
+    virtual result_t set_enableH2c(bool newVal);
+    virtual result_t get_maxConcurrentStreams(int32_t& retVal);
+    virtual result_t set_maxConcurrentStreams(int32_t newVal);
     virtual result_t setClientCert(X509Cert_base* crt, PKey_base* key);
+    virtual result_t poolStats(v8::Local<v8::Object>& retVal);
     virtual result_t request(Stream_base* conn, HttpRequest_base* req, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
     virtual result_t request(Stream_base* conn, HttpRequest_base* req, SeekableStream_base* response_body, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
     virtual result_t request(exlib::string method, exlib::string url, v8::Local<v8::Object> opts, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
@@ -83,57 +107,17 @@ public:
     }
 
 public:
-    void clean_coon(date_t d)
-    {
-        std::vector<obj_ptr<Conn>> keep_conns;
-
-        m_lock.lock();
-        while (((int32_t)m_conns.size() > m_poolSize)
-            || (m_conns.size() && d.diff(m_conns[0]->d) >= (double)m_poolTimeout)) {
-            keep_conns.push_back(m_conns[0]);
-            m_conns.erase(m_conns.begin());
-        }
-        m_lock.unlock();
-    }
-
-    void save_conn(exlib::string url, Stream_base* _conn)
-    {
-        obj_ptr<Conn> conn = new Conn();
-
-        conn->d.now();
-        conn->url = url;
-        conn->conn = _conn;
-
-        clean_coon(conn->d);
-
-        m_lock.lock();
-        m_conns.push_back(conn);
-        if ((int32_t)m_conns.size() > m_poolSize) {
-            conn = m_conns[0];
-            m_conns.erase(m_conns.begin());
-        }
-        m_lock.unlock();
-    }
-
-    bool get_conn(exlib::string url, obj_ptr<Stream_base>& _conn)
-    {
-        date_t d;
-
-        d.now();
-        clean_coon(d);
-
-        m_lock.lock();
-        for (std::vector<obj_ptr<Conn>>::iterator it = m_conns.begin(); it != m_conns.end(); it++)
-            if ((*it)->url == url) {
-                _conn = (*it)->conn;
-                m_conns.erase(it);
-
-                m_lock.unlock();
-                return true;
-            }
-        m_lock.unlock();
-        return false;
-    }
+    void clean_coon(date_t d);
+    // idle connections are pooled under url, the maxConnsPerHost slot is counted on host,
+    // the two differ for plain http through a proxy, where one proxy connection serves every origin
+    result_t get_conn(exlib::string url, exlib::string host, obj_ptr<Stream_base>& retVal, AsyncEvent* ac);
+    bool take_conn(exlib::string url, obj_ptr<Stream_base>& retVal);
+    void save_conn(exlib::string url, exlib::string host, Stream_base* conn);
+    void release_conn(exlib::string host);
+    void expire_waiter(exlib::string host, Timer_base* timer);
+    result_t get_h2(exlib::string url, obj_ptr<Http2Client>& retVal, bool& connector, bool& retry, AsyncEvent* ac);
+    void put_h2(exlib::string url, Http2Client* h2, bool http1);
+    void reap();
 
 private:
     result_t update(HttpCookie_base* cookie);
@@ -147,6 +131,9 @@ private:
     bool m_enableEncoding;
     int32_t m_sslVerification;
     int32_t m_maxBodySize;
+    bool m_enableHttp2;
+    bool m_enableH2c;
+    int32_t m_maxConcurrentStreams;
     exlib::string m_userAgent;
     obj_ptr<X509Cert_base> m_crt;
     obj_ptr<PKey_base> m_key;
@@ -157,11 +144,90 @@ private:
         date_t d;
         exlib::string url;
         obj_ptr<Stream_base> conn;
+        std::list<obj_ptr<Conn>>::iterator pos;
+    };
+
+    class Waiter {
+    public:
+        Waiter(AsyncEvent* _ac, exlib::string _url, obj_ptr<Stream_base>* _conn)
+            : ac(_ac)
+            , url(_url)
+            , conn(_conn)
+        {
+        }
+
+    public:
+        AsyncEvent* ac;
+        exlib::string url;
+        obj_ptr<Stream_base>* conn;
+        obj_ptr<Timer_base> timer;
+    };
+
+    // one entry per pool key, idle is a stack with the warmest connection at the back,
+    // active and waiters belong to the origin the slots are counted on
+    class Host : public obj_base {
+    public:
+        Host()
+            : active(0)
+        {
+        }
+
+    public:
+        std::list<obj_ptr<Conn>> idle;
+        std::list<Waiter> waiters;
+        int32_t active;
+    };
+
+    // HTTP/2 sessions of one origin, only one request at a time opens a new connection,
+    // the others wait for it and then share whatever it brought up
+    class H2Origin : public obj_base {
+    public:
+        H2Origin()
+            : connecting(false)
+            , http1(false)
+        {
+        }
+
+    public:
+        std::vector<obj_ptr<Http2Client>> sessions;
+        std::list<AsyncEvent*> waiters;
+        bool connecting;
+        bool http1;
     };
 
-    std::vector<obj_ptr<Conn>> m_conns;
+    // FNV-1a over the pool key, checkout looks a host up on every request
+    struct HostHash {
+        size_t operator()(const exlib::string& key) const
+        {
+            const unsigned char* p = (const unsigned char*)key.c_str();
+            size_t n = key.length();
+            uint32_t h = 2166136261u;
+
+            while (n--)
+                h = (h ^ *p++) * 16777619u;
+
+            return h;
+        }
+    };
+
+    typedef std::unordered_map<exlib::string, obj_ptr<Host>, HostHash> HostMap;
+
+    void evict(date_t d, std::vector<obj_ptr<Conn>>& drops);
+    void drop_host(HostMap::iterator it);
+
+    HostMap m_hosts;
+    // every idle connection of every host, oldest first
+    std::list<obj_ptr<Conn>> m_idle;
+    std::map<exlib::string, obj_ptr<H2Origin>> m_h2;
     int32_t m_poolSize;
     int32_t m_poolTimeout;
+    int32_t m_maxConnsPerHost;
+    int32_t m_active;
+    bool m_reaping;
+    int64_t m_hits;
+    int64_t m_misses;
+    int64_t m_waits;
+    int64_t m_evictions;
     exlib::string m_http_proxy;
     exlib::string m_https_proxy;
 };
@@ -12,10 +12,24 @@
 
 namespace fibjs {
 
+// case-folded FNV-1a
+inline uint32_t header_hash(const char* s, int32_t sz)
+{
+    uint32_t h = 2166136261u;
+
+    while (sz-- > 0) {
+        h ^= (uint8_t)qtolower(*s++);
+        h *= 16777619u;
+    }
+
+    return h;
+}
+
 class HttpCollection : public HttpCollection_base {
 public:
     HttpCollection()
         : m_count(0)
+        , m_dirty(false)
     {
         m_map.resize(16);
     }
@@ -51,41 +65,41 @@ public:
 
     result_t add(exlib::string& name, exlib::string value)
     {
+        materialize();
+
         if (m_map.size() < m_count + 1)
             m_map.resize(m_count + 1);
 
         m_map[m_count] = pair(name, value);
         m_count++;
 
+        index(m_count - 1);
+
         return 0;
     }
 
     result_t first(exlib::string name, exlib::string& retVal)
     {
-        size_t i;
+        int32_t id = find(name.c_str(), (int32_t)name.length());
 
-        for (i = 0; i < m_count; i++) {
-            pair& _pair = m_map[i];
+        if (id < 0)
+            return CALL_RETURN_NULL;
 
-            if (!qstricmp(_pair.first.c_str(), name.c_str())) {
-                retVal = _pair.second;
-                return 0;
-            }
-        }
-
-        return CALL_RETURN_NULL;
+        value(id, retVal);
+        return 0;
     }
 
     result_t all(exlib::string name, obj_ptr<NArray>& retVal)
     {
         obj_ptr<NArray> list = new NArray();
-        size_t i;
+        int32_t id = find(name.c_str(), (int32_t)name.length());
 
-        for (i = 0; i < m_count; i++) {
-            pair& _pair = m_map[i];
+        while (id >= 0) {
+            exlib::string v;
 
-            if (!qstricmp(_pair.first.c_str(), name.c_str()))
-                list->append(_pair.second);
+            value(id, v);
+            list->append(v);
+            id = m_keys[id].next;
         }
 
         retVal = list;
@@ -97,6 +111,7 @@ public:
         obj_ptr<NObject> map = new NObject();
         size_t i;
 
+        materialize();
         map->enable_multi_value();
 
         for (i = 0; i < m_count; i++) {
@@ -108,16 +123,104 @@ public:
         return 0;
     }
 
+    size_t count()
+    {
+        materialize();
+        return m_count;
+    }
+
+    const std::pair<exlib::string, exlib::string>& at(size_t i)
+    {
+        materialize();
+        return m_map[i];
+    }
+
+    // buffer a message head is received into, headers parsed from it are added with add_raw
+    exlib::string& raw()
+    {
+        materialize();
+        return m_raw;
+    }
+
+    void add_raw(int32_t name, int32_t szName, int32_t value, int32_t szValue)
+    {
+        if (m_count > 0) {
+            add(m_raw.c_str() + name, szName, m_raw.c_str() + value, szValue);
+            return;
+        }
+
+        slice _slice = { name, szName, value, szValue };
+        m_slices.push_back(_slice);
+
+        index(m_slices.size() - 1);
+    }
+
     size_t size();
     size_t getData(char* buf, size_t sz);
 
     result_t parse(exlib::string& str, const char* sep = "&", const char* eq = "=");
     result_t parseCookie(exlib::string& str);
 
+private:
+    // a received header stays as offsets into m_raw until something other than a lookup needs it.
+    // a collection holds either slices or string pairs, add() turns the slices into pairs first
+    struct slice {
+        int32_t name;
+        int32_t szName;
+        int32_t value;
+        int32_t szValue;
+    };
+
+    // one key per entry, entries with the same name are chained in order through next
+    struct key {
+        uint32_t hash;
+        int32_t atom;
+        int32_t next;
+    };
+
+    void materialize();
+
+    const char* name(size_t id, int32_t& sz)
+    {
+        if (!m_slices.empty()) {
+            slice& _slice = m_slices[id];
+
+            sz = _slice.szName;
+            return m_raw.c_str() + _slice.name;
+        }
+
+        exlib::string& n = m_map[id].first;
+
+        sz = (int32_t)n.length();
+        return n.c_str();
+    }
+
+    void value(size_t id, exlib::string& retVal)
+    {
+        if (!m_slices.empty()) {
+            slice& _slice = m_slices[id];
+            retVal.assign(m_raw.c_str() + _slice.value, _slice.szValue);
+        } else
+            retVal = m_map[id].second;
+    }
+
+    bool same(key& k, size_t id, const char* n, int32_t sz);
+    int32_t find(const char* n, int32_t sz);
+    void index(size_t id);
+    void link(size_t id);
+    void rebuild();
+
 private:
     typedef std::pair<exlib::string, exlib::string> pair;
     std::vector<pair> m_map;
     size_t m_count;
+    exlib::string m_raw;
+    std::vector<slice> m_slices;
+
+    // open addressing over the first entry of each name, rebuilt lazily after remove and sort
+    std::vector<key> m_keys;
+    std::vector<int32_t> m_slots;
+    bool m_dirty;
 };
 
 } /* namespace fibjs */
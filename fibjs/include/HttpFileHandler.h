@@ -10,6 +10,8 @@
 #include "ifs/Handler.h"
 #include "map"
 #include "path.h"
+#include "date.h"
+#include <list>
 
 namespace fibjs {
 
@@ -19,6 +21,7 @@ class HttpFileHandler : public Handler_base {
 public:
     HttpFileHandler(exlib::string root, bool autoIndex)
         : m_autoIndex(autoIndex)
+        , m_hotSize(0)
     {
         path_base::normalize(root, m_root);
         if (!m_root.empty() && !isPathSlash(m_root.c_str()[m_root.length() - 1]))
@@ -32,10 +35,53 @@ public:
 
     result_t set_mimes(v8::Local<v8::Object> mimes);
 
+public:
+    // what the last stat of a path found, trusted for FILE_CACHE_TTL ms. a path that failed to open is kept too
+    class file_info : public obj_base {
+    public:
+        file_info()
+            : m_exists(false)
+            , m_size(0)
+        {
+            m_checked.now();
+        }
+
+    public:
+        bool m_exists;
+        int64_t m_size;
+        date_t m_mtime;
+        date_t m_checked;
+        exlib::string m_lastModified;
+        exlib::string m_etag;
+    };
+
+    obj_ptr<file_info> get_info(const exlib::string& path);
+    void set_info(const exlib::string& path, file_info* fi);
+
+    // contents of small files, valid while the file still has the ETag they were read under
+    bool get_hot(const exlib::string& path, const exlib::string& etag, exlib::string& retVal);
+    void set_hot(const exlib::string& path, const exlib::string& etag, const exlib::string& data);
+
+private:
+    class hot_file : public obj_base {
+    public:
+        exlib::string m_path;
+        exlib::string m_etag;
+        exlib::string m_data;
+    };
+
 private:
     exlib::string m_root;
     bool m_autoIndex;
     std::map<exlib::string, exlib::string> m_mimes;
+
+    exlib::spinlock m_lock;
+    std::map<exlib::string, obj_ptr<file_info>> m_cache;
+
+    // most recently used first, the tail is dropped once m_hotSize passes HOT_CACHE_SIZE
+    std::list<obj_ptr<hot_file>> m_hot;
+    std::map<exlib::string, std::list<obj_ptr<hot_file>>::iterator> m_hotIndex;
+    size_t m_hotSize;
 };
 
 } /* namespace fibjs */
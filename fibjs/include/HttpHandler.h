@@ -8,9 +8,13 @@
 #pragma once
 
 #include "ifs/HttpHandler.h"
+#include "ifs/HttpRequest.h"
+#include "ifs/HttpResponse.h"
 
 namespace fibjs {
 
+class ZlibStream;
+
 class HttpHandler : public HttpHandler_base {
     FIBER_FREE();
 
@@ -31,11 +35,31 @@ public:
     virtual result_t set_maxBodySize(int32_t newVal);
     virtual result_t get_enableEncoding(bool& retVal);
     virtual result_t set_enableEncoding(bool newVal);
+    virtual result_t get_encodingLevel(int32_t& retVal);
+    virtual result_t set_encodingLevel(int32_t newVal);
+    virtual result_t get_encodingThreshold(int32_t& retVal);
+    virtual result_t set_encodingThreshold(int32_t newVal);
+    virtual result_t get_enableHttp2(bool& retVal);
+    virtual result_t set_enableHttp2(bool newVal);
+    virtual result_t get_maxPipeline(int32_t& retVal);
+    virtual result_t set_maxPipeline(int32_t newVal);
     virtual result_t get_serverName(exlib::string& retVal);
     virtual result_t set_serverName(exlib::string newVal);
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal);
     virtual result_t set_handler(Handler_base* newVal);
 
+public:
+    // shared by the HTTP/1.x loop and the HTTP/2 streams
+    bool preflight(HttpRequest_base* req, HttpResponse_base* rep);
+    void fillHeaders(HttpRequest_base* req, HttpResponse_base* rep, bool options);
+    // picks the content coding for rep and sets Content-Encoding, 0 means send it as is.
+    // bStream lifts the size cap for bodies that are compressed while they are sent
+    int32_t encoding(HttpRequest_base* req, HttpResponse_base* rep, bool bStream = false);
+    ZlibStream* encoder(int32_t type, Stream_base* stm);
+
+    // fills q[i] with the q value, in thousandths, that the Accept-Encoding header gives codings[i]
+    static void accept_encoding(const char* accept, const char* const* codings, int32_t count, int32_t* q);
+
 private:
     obj_ptr<Handler_base> m_hdlr;
 
@@ -44,6 +68,10 @@ private:
     int32_t m_maxHeadersCount;
     int32_t m_maxBodySize;
     bool m_enableEncoding;
+    int32_t m_encodingLevel;
+    int32_t m_encodingThreshold;
+    bool m_enableHttp2;
+    int32_t m_maxPipeline;
     exlib::string m_serverName;
 };
 
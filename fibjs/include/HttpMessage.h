@@ -14,6 +14,10 @@
 namespace fibjs {
 
 #define HTTP_MAX_LINE 4096
+// the old line by line reader allowed 128 header lines of HTTP_MAX_LINE bytes, a head read in one block
+// keeps that budget, messages size it from maxHeadersCount instead
+#define HTTP_MAX_HEAD (HTTP_MAX_LINE * 128)
+#define HTTP_MAX_MEMORY_BODY (4 * 1024 * 1024)
 
 class HttpMessage : public Message {
 public:
@@ -67,12 +71,31 @@ public:
         AsyncEvent* ac);
     result_t sendHeader(Stream_base* stm, exlib::string& strCommand,
         AsyncEvent* ac);
-    result_t readFrom(Stream_base* stm, AsyncEvent* ac);
+    // the head is received into the header collection in one piece, readFrom parses it from pos,
+    // right behind the start line, and then reads the body
+    result_t readHead(BufferedStream_base* stm, AsyncEvent* ac);
+    result_t readFrom(Stream_base* stm, size_t pos, AsyncEvent* ac);
+
+    exlib::string& head()
+    {
+        return m_headers->raw();
+    }
+
+    static const char* eol(const char* p, const char* end)
+    {
+        while ((p = (const char*)memchr(p, '\r', end - p)) != NULL) {
+            if (p + 1 < end && p[1] == '\n')
+                return p;
+            p++;
+        }
+
+        return end;
+    }
 
 public:
     void addHeader(const char* name, int32_t szName, const char* value,
         int32_t szValue);
-    result_t addHeader(exlib::string& strLine);
+    result_t parseHeaders(size_t pos, int64_t& contentLength, bool& bChunked);
     size_t size();
     size_t getData(char* buf, size_t sz);
 
@@ -89,6 +112,7 @@ public:
     exlib::string m_protocol;
     bool m_keepAlive;
     bool m_upgrade;
+    bool m_chunked;
     int32_t m_maxHeadersCount;
     int32_t m_maxBodySize;
     exlib::string m_origin;
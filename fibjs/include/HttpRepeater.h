@@ -19,22 +19,111 @@ class HttpRepeater : public HttpRepeater_base {
 public:
     HttpRepeater();
 
+public:
+    // one backend and what the balancer has learned about it, kept across load() while the url stays
+    class Upstream : public obj_base {
+    public:
+        Upstream(Url* u)
+            : m_url(u)
+            , m_outstanding(0)
+            , m_ewma(0)
+            , m_requests(0)
+            , m_errors(0)
+            , m_ejections(0)
+            , m_fails(0)
+            , m_ejected(false)
+            , m_healthy(true)
+        {
+            u->toString(m_base);
+            m_stamp.now();
+        }
+
+    public:
+        bool available(date_t d);
+        void observe(date_t d, double rtt);
+        double cost(date_t d);
+
+    public:
+        obj_ptr<Url> m_url;
+        exlib::string m_base;
+        int32_t m_outstanding;
+        double m_ewma;
+        date_t m_stamp;
+        int64_t m_requests;
+        int64_t m_errors;
+        int64_t m_ejections;
+        int32_t m_fails;
+        bool m_ejected;
+        date_t m_ejectEnd;
+        bool m_healthy;
+    };
+
 public:
     // HttpRepeater_base
     virtual result_t load(v8::Local<v8::Array> urls);
     virtual result_t get_urls(obj_ptr<NArray>& retVal);
     virtual result_t get_client(obj_ptr<HttpClient_base>& retVal);
+    virtual result_t get_strategy(exlib::string& retVal);
+    virtual result_t set_strategy(exlib::string newVal);
+    virtual result_t get_hashHeader(exlib::string& retVal);
+    virtual result_t set_hashHeader(exlib::string newVal);
+    virtual result_t get_maxFails(int32_t& retVal);
+    virtual result_t set_maxFails(int32_t newVal);
+    virtual result_t get_ejectTime(int32_t& retVal);
+    virtual result_t set_ejectTime(int32_t newVal);
+    virtual result_t get_retries(int32_t& retVal);
+    virtual result_t set_retries(int32_t newVal);
+    virtual result_t get_retryBudget(double& retVal);
+    virtual result_t set_retryBudget(double newVal);
+    virtual result_t get_healthCheck(exlib::string& retVal);
+    virtual result_t set_healthCheck(exlib::string newVal);
+    virtual result_t get_healthInterval(int32_t& retVal);
+    virtual result_t set_healthInterval(int32_t newVal);
+    virtual result_t stats(v8::Local<v8::Object>& retVal);
 
 public:
     // Handler_base
     virtual result_t invoke(object_base* v, obj_ptr<Handler_base>& retVal,
         AsyncEvent* ac);
 
+public:
+    enum {
+        kRoundRobin = 0,
+        kLeastRequest,
+        kPeakEwma,
+        kHash
+    };
+
+    void reset(std::vector<obj_ptr<Url>>& urls);
+    void pick(exlib::string& key, Upstream* exclude, obj_ptr<Upstream>& retVal);
+    void done(Upstream* up, date_t start, bool failed);
+    bool retry();
+    void check(int32_t gen);
+    void checked(Upstream* up, bool healthy);
+
+private:
+    Upstream* pick_hash(date_t d, exlib::string& key, Upstream* exclude);
+
 public:
     obj_ptr<HttpClient> m_client;
-    std::vector<obj_ptr<Url>> m_urls;
+    std::vector<obj_ptr<Upstream>> m_urls;
     int32_t m_idx;
     exlib::spinlock m_lock;
+
+    int32_t m_strategy;
+    exlib::string m_hashHeader;
+    int32_t m_maxFails;
+    int32_t m_ejectTime;
+    int32_t m_retries;
+    double m_retryBudget;
+    double m_budget;
+    int64_t m_retried;
+    exlib::string m_healthCheck;
+    int32_t m_healthInterval;
+    int32_t m_healthGen;
+
+    // consistent hash ring, sorted points each owned by an index into m_urls
+    std::vector<std::pair<uint32_t, int32_t>> m_ring;
 };
 
 } /* namespace fibjs */
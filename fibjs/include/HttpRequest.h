@@ -87,6 +87,7 @@ public:
     virtual result_t get_cookies(obj_ptr<HttpCollection_base>& retVal);
     virtual result_t get_form(obj_ptr<HttpCollection_base>& retVal);
     virtual result_t get_query(obj_ptr<HttpCollection_base>& retVal);
+    virtual result_t parseForm(v8::Local<v8::Object> opts, obj_ptr<HttpCollection_base>& retVal);
 
 public:
     result_t addHeader(NObject* map)
@@ -108,6 +109,11 @@ public:
         return 0;
     }
 
+    void setSocket(Stream_base* stm)
+    {
+        m_message->m_socket = stm;
+    }
+
 private:
     obj_ptr<HttpResponse_base> m_response;
     obj_ptr<HttpMessage> m_message;
@@ -90,6 +90,9 @@ public:
     virtual result_t sendHeader(Stream_base* stm, AsyncEvent* ac);
 
 public:
+    // turns the cookies added by addCookie into Set-Cookie headers
+    void flushCookies();
+
     result_t allHeader(exlib::string name, obj_ptr<NArray>& retVal)
     {
         return m_message->allHeader(name, retVal);
@@ -114,6 +117,11 @@ public:
         return 0;
     }
 
+    void setSocket(Stream_base* stm)
+    {
+        m_message->m_socket = stm;
+    }
+
 public:
     obj_ptr<HttpMessage> m_message;
     int32_t m_statusCode;
@@ -9,10 +9,12 @@
 
 #include "ifs/HttpCollection.h"
 #include "QuickArray.h"
+#include "MultipartParser.h"
 
 namespace fibjs {
 
-class HttpUploadCollection : public HttpCollection_base {
+class HttpUploadCollection : public HttpCollection_base,
+                             public MultipartParser::Sink {
 public:
     HttpUploadCollection()
         : m_count(0)
@@ -44,7 +46,13 @@ public:
     virtual result_t _named_deleter(exlib::string property, v8::Local<v8::Boolean>& retVal);
 
 public:
-    void parse(exlib::string& str, const char* boundary);
+    // MultipartParser::Sink
+    virtual result_t on_field(exlib::string& name, exlib::string& value);
+    virtual result_t on_file(exlib::string& name, HttpUploadData* file, obj_ptr<Stream_base>& stm);
+    virtual result_t on_file_end(exlib::string& name, HttpUploadData* file);
+
+public:
+    result_t parse(SeekableStream_base* body, exlib::string contentType, int64_t threshold);
 
     result_t all(exlib::string name, obj_ptr<NArray>& retVal)
     {
@@ -33,6 +33,14 @@ public:
     virtual result_t set_maxBodySize(int32_t newVal);
     virtual result_t get_enableEncoding(bool& retVal);
     virtual result_t set_enableEncoding(bool newVal);
+    virtual result_t get_encodingLevel(int32_t& retVal);
+    virtual result_t set_encodingLevel(int32_t newVal);
+    virtual result_t get_encodingThreshold(int32_t& retVal);
+    virtual result_t set_encodingThreshold(int32_t newVal);
+    virtual result_t get_enableHttp2(bool& retVal);
+    virtual result_t set_enableHttp2(bool newVal);
+    virtual result_t get_maxPipeline(int32_t& retVal);
+    virtual result_t set_maxPipeline(int32_t newVal);
     virtual result_t get_serverName(exlib::string& retVal);
     virtual result_t set_serverName(exlib::string newVal);
 
@@ -31,6 +31,7 @@ public:
         virtual result_t get_fd(int32_t& retVal);
         virtual result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
         virtual result_t write(Buffer_base* data, AsyncEvent* ac);
+        virtual result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac);
         virtual result_t flush(AsyncEvent* ac);
         virtual result_t close(AsyncEvent* ac);
         virtual result_t copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
@@ -69,6 +70,7 @@ public:
     virtual result_t get_fd(int32_t& retVal);
     virtual result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
     virtual result_t write(Buffer_base* data, AsyncEvent* ac);
+    virtual result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac);
     virtual result_t flush(AsyncEvent* ac);
     virtual result_t close(AsyncEvent* ac);
     virtual result_t copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
@@ -0,0 +1,90 @@
+/*
+ * MultipartParser.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "object.h"
+#include "HttpUploadData.h"
+#include "ifs/SeekableStream.h"
+
+namespace fibjs {
+
+// file parts larger than this are moved from memory to a temp file while they are parsed
+#define HTTP_UPLOAD_THRESHOLD (1024 * 1024)
+
+// incremental multipart/form-data parser, the body is fed in chunks of any size and every
+// part is handed to the sink as soon as its closing boundary has been seen
+class MultipartParser {
+public:
+    class Sink {
+    public:
+        virtual result_t on_field(exlib::string& name, exlib::string& value) = 0;
+
+        // called once the part headers are known, stm may be set to receive the part body
+        virtual result_t on_file(exlib::string& name, HttpUploadData* file, obj_ptr<Stream_base>& stm) = 0;
+        virtual result_t on_file_end(exlib::string& name, HttpUploadData* file) = 0;
+    };
+
+public:
+    MultipartParser(Sink* sink, int64_t threshold);
+
+public:
+    // returns CALL_RETURN_NULL when contentType carries no boundary
+    result_t init(exlib::string contentType);
+
+    result_t write(const char* data, size_t sz);
+    result_t end();
+
+    // rewinds body and feeds it through the parser
+    result_t parse(SeekableStream_base* body);
+
+private:
+    enum {
+        S_PREAMBLE,
+        S_BOUNDARY,
+        S_HEADERS,
+        S_BODY,
+        S_DONE
+    };
+
+    result_t process();
+    result_t boundary(bool& more);
+    result_t headers(bool& more);
+    result_t body(bool& more);
+
+    bool header(const char* p, const char* end);
+    size_t find();
+
+    result_t begin_part();
+    result_t put(const char* data, size_t sz);
+    result_t end_part();
+
+private:
+    Sink* m_sink;
+    int64_t m_threshold;
+
+    // the delimiter is "\n--" + boundary, a CR in front of it belongs to the line break and is dropped
+    exlib::string m_delim;
+    size_t m_skip[256];
+
+    int32_t m_state;
+    exlib::string m_buf;
+    size_t m_pos;
+    size_t m_scan;
+    size_t m_head;
+
+    exlib::string m_name;
+    exlib::string m_filename;
+    exlib::string m_type;
+    exlib::string m_encoding;
+    exlib::string m_value;
+    obj_ptr<HttpUploadData> m_file;
+    obj_ptr<Stream_base> m_stm;
+    obj_ptr<SeekableStream_base> m_spill;
+};
+
+} /* namespace fibjs */
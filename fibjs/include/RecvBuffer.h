@@ -0,0 +1,75 @@
+/*
+ * RecvBuffer.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "Buffer.h"
+#include <atomic>
+
+namespace fibjs {
+
+#define RECV_BUFF_MIN 2048
+#define RECV_BUFF_MAX (64 * 1024)
+#define RECV_POOL_CLASSES 6
+#define RECV_POOL_DEPTH 256
+
+class RecvBuffer {
+public:
+    struct Stats {
+        std::atomic<int64_t> allocs;
+        std::atomic<int64_t> recycled;
+        std::atomic<int64_t> pooled;
+        std::atomic<int64_t> recvs;
+        std::atomic<int64_t> bytes;
+    };
+
+public:
+    RecvBuffer()
+        : m_block(NULL)
+        , m_size(0)
+        , m_recvSize(NULL)
+    {
+    }
+
+    ~RecvBuffer()
+    {
+        free();
+    }
+
+public:
+    // bytes > 0: read exactly into a private buffer of the requested size
+    // bytes <= 0: borrow a pooled block sized by the connection's adaptive recvSize
+    void alloc(int32_t bytes, int32_t& recvSize);
+    void free();
+
+    Buffer_base* detach(int32_t n);
+
+    char* c_buffer()
+    {
+        return m_block ? m_block : m_str.c_buffer();
+    }
+
+    int32_t length() const
+    {
+        return m_block ? m_size : (int32_t)m_str.length();
+    }
+
+    bool empty() const
+    {
+        return length() == 0;
+    }
+
+public:
+    static Stats s_stats;
+
+private:
+    char* m_block;
+    int32_t m_size;
+    int32_t* m_recvSize;
+    exlib::string m_str;
+};
+}
@@ -0,0 +1,47 @@
+/*
+ * Resolver.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "utils.h"
+#include "AsyncCall.h"
+#include <atomic>
+#include <vector>
+#include <functional>
+
+namespace fibjs {
+
+class Resolver {
+public:
+    struct Stats {
+        std::atomic<int64_t> hits;
+        std::atomic<int64_t> misses;
+        std::atomic<int64_t> negative;
+        std::atomic<int64_t> coalesced;
+        std::atomic<int64_t> queries;
+        std::atomic<int64_t> retries;
+        std::atomic<int64_t> timeouts;
+        std::atomic<int64_t> tcp;
+    };
+
+    typedef std::function<void(std::vector<exlib::string>&)> Callback;
+
+public:
+    // false when the name should go through getaddrinfo, e.g. no nameserver is configured or a search list applies
+    static bool enabled(exlib::string name);
+
+    // family is net_base::C_AF_INET, net_base::C_AF_INET6 or 0 for both, IPv4 addresses come first.
+    // done is called with a non-empty address list before ac is posted, it may run on the uv thread
+    static result_t resolve(exlib::string name, int32_t family, Callback done, AsyncEvent* ac);
+
+    static void clear();
+    static int32_t entries();
+
+public:
+    static Stats s_stats;
+};
+}
@@ -10,6 +10,7 @@
 #include "ifs/Routing.h"
 #include <pcre/pcre.h>
 #include <vector>
+#include <map>
 
 namespace fibjs {
 
@@ -17,24 +18,48 @@ class Routing : public Routing_base {
 public:
     class rule : public obj_base {
     public:
-        rule(exlib::string method, pcre* re, Handler_base* hdlr, bool bSub)
+        rule(exlib::string method, pcre* re, pcre_extra* extra, Handler_base* hdlr, bool bSub,
+            exlib::string prefix, bool bAnchored)
             : m_method(method)
             , m_re(re)
+            , m_extra(extra)
             , m_hdlr(hdlr)
             , m_bSub(bSub)
+            , m_prefix(prefix)
+            , m_bAnchored(bAnchored)
         {
         }
 
         ~rule()
         {
+            if (m_extra)
+                pcre_free_study(m_extra);
             pcre_free(m_re);
         }
 
     public:
         exlib::string m_method;
         pcre* m_re;
+        pcre_extra* m_extra;
         obj_ptr<Handler_base> m_hdlr;
         bool m_bSub;
+
+        // case folded literal text every match has to start with, valid when m_bAnchored
+        exlib::string m_prefix;
+        bool m_bAnchored;
+    };
+
+    // radix tree over the literal prefixes of the rules of one method, a lookup collects
+    // every rule whose prefix is a prefix of the path
+    class node : public obj_base {
+    public:
+        void insert(const char* key, size_t len, int32_t no);
+        void lookup(const char* path, size_t len, std::vector<int32_t>& retVal);
+
+    public:
+        exlib::string m_key;
+        std::vector<obj_ptr<node>> m_children;
+        std::vector<int32_t> m_rules;
     };
 
 public:
@@ -69,9 +94,18 @@ public:
     result_t _append(exlib::string method, v8::Local<v8::Object> map, obj_ptr<Routing_base>& retVal);
     static exlib::string host2RegExp(exlib::string pattern);
     static exlib::string path2RegExp(exlib::string pattern);
+    static bool regExpPrefix(exlib::string& re, exlib::string& retVal);
+
+private:
+    void index(rule* r, int32_t no);
+    void candidates(exlib::string& method, bool bHttp, exlib::string& value,
+        std::vector<int32_t>& retVal);
 
 private:
+    // m_array[m_array.size() - 1 - no] is the rule appended as number no, lower numbers win
     std::vector<obj_ptr<rule>> m_array;
+    std::map<exlib::string, obj_ptr<node>> m_methods;
+    std::vector<int32_t> m_hosts;
 };
 
 } /* namespace fibjs */
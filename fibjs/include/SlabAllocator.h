@@ -0,0 +1,113 @@
+/*
+ * SlabAllocator.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <v8/include/v8.h>
+
+namespace fibjs {
+
+#define SLAB_MIN_SHIFT 6
+#define SLAB_CLASSES 11
+#define SLAB_MAX_SIZE ((size_t)1 << (SLAB_MIN_SHIFT + SLAB_CLASSES - 1))
+
+// chunks hold at least 16 blocks and are aligned to their size, so a block finds its chunk by masking
+#define SLAB_CHUNK_SIZE (256 * 1024)
+#define SLAB_CHUNK_BLOCKS 16
+
+// per thread and per class, each cache keeps up to this many bytes and never more than SLAB_CACHE_DEPTH blocks
+#define SLAB_CACHE_BYTES (256 * 1024)
+#define SLAB_CACHE_DEPTH 64
+
+// fully free chunks kept by each class before the rest are given back to the system
+#define SLAB_SPARE_CHUNKS 1
+
+class SlabAllocator {
+public:
+    struct Stats {
+        std::atomic<int64_t> reserved;
+        std::atomic<int64_t> used;
+        std::atomic<int64_t> allocs;
+        std::atomic<int64_t> frees;
+        std::atomic<int64_t> hits;
+        std::atomic<int64_t> released;
+    };
+
+public:
+    static int32_t size_class(size_t sz)
+    {
+        int32_t cls = 0;
+
+        if (sz > SLAB_MAX_SIZE)
+            return -1;
+
+        while (((size_t)1 << (SLAB_MIN_SHIFT + cls)) < sz)
+            cls++;
+
+        return cls;
+    }
+
+    static size_t class_size(int32_t cls)
+    {
+        return (size_t)1 << (SLAB_MIN_SHIFT + cls);
+    }
+
+    // return NULL when sz is larger than SLAB_MAX_SIZE, the caller should fall back to malloc
+    static void* alloc(size_t sz);
+    static void free(void* p, size_t sz);
+
+    // gives every fully free chunk back to the system
+    static void trim();
+
+public:
+    static Stats s_stats;
+};
+
+// a refcounted byte block, taken from the slab when it fits and from the heap when it does not,
+// Buffer keeps its payload in one and Buffer.buffer shares it with V8 without copying
+class SlabBlock {
+public:
+    static SlabBlock* New(size_t sz);
+
+public:
+    void ref()
+    {
+        m_refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void unref()
+    {
+        if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            release();
+    }
+
+    char* data()
+    {
+        return (char*)(this + 1);
+    }
+
+    size_t capacity() const
+    {
+        return m_cap;
+    }
+
+    // wraps the first sz bytes as an ArrayBuffer backing store, which holds a reference until V8 drops it
+    std::shared_ptr<v8::BackingStore> backing_store(size_t sz);
+
+private:
+    void release();
+
+private:
+    std::atomic<int32_t> m_refs;
+    bool m_slab;
+    size_t m_cap;
+};
+}
@@ -0,0 +1,89 @@
+/*
+ * SockCork.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "object.h"
+#include "Buffer.h"
+#include <exlib/include/thread.h>
+#include <functional>
+#include <vector>
+
+namespace fibjs {
+
+#define CORK_MAX_BYTES (64 * 1024)
+
+class SockCork {
+public:
+    typedef std::function<result_t(std::vector<obj_ptr<Buffer_base>>&, AsyncEvent*)> Writer;
+
+public:
+    SockCork(object_base* owner, Writer writev)
+        : m_owner(owner)
+        , m_writev(writev)
+        , m_auto(false)
+        , m_corked(0)
+        , m_scheduled(false)
+        , m_bytes(0)
+        , m_inflight(0)
+        , m_error(0)
+    {
+    }
+
+public:
+    // true when writes have to go through the cork buffer to keep their order
+    bool enabled()
+    {
+        bool ret;
+
+        m_lock.lock();
+        ret = m_auto || m_corked > 0 || !m_bufs.empty();
+        m_lock.unlock();
+
+        return ret;
+    }
+
+    bool get_auto()
+    {
+        return m_auto;
+    }
+
+    void set_auto(bool newVal);
+
+    void cork();
+    void uncork();
+
+    result_t write(Buffer_base* data, AsyncEvent* ac);
+    result_t write(std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac);
+    result_t flush(AsyncEvent* ac);
+    result_t close(std::function<result_t(AsyncEvent*)> close, AsyncEvent* ac);
+
+    // hand pending data to the socket without waiting, flush() waits until it has been sent
+    void drain();
+
+private:
+    void schedule();
+    static result_t flush_job(SockCork* pThis);
+
+private:
+    object_base* m_owner;
+    Writer m_writev;
+    exlib::spinlock m_lock;
+    bool m_auto;
+    int32_t m_corked;
+    bool m_scheduled;
+    int32_t m_bytes;
+    // bytes handed to background writevs that have not completed yet
+    int32_t m_inflight;
+    result_t m_error;
+    std::vector<obj_ptr<Buffer_base>> m_bufs;
+    // flush calls waiting for the background writevs to complete
+    std::vector<AsyncEvent*> m_waiters;
+
+    friend class asyncCorkFlush;
+};
+}
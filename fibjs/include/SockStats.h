@@ -0,0 +1,107 @@
+/*
+ * SockStats.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "utils.h"
+#include <v8/include/v8.h>
+#include <uv/include/uv.h>
+#include <atomic>
+
+namespace fibjs {
+
+class SockStats {
+public:
+    struct Counters {
+        std::atomic<int64_t> reads;
+        std::atomic<int64_t> writes;
+        std::atomic<int64_t> bytesIn;
+        std::atomic<int64_t> bytesOut;
+        std::atomic<int64_t> again;
+        std::atomic<int64_t> queued;
+        std::atomic<int64_t> queueTime;
+        std::atomic<int64_t> resumed;
+        std::atomic<int64_t> resumeTime;
+    };
+
+public:
+    SockStats()
+    {
+        clear(m_counters);
+    }
+
+public:
+    static uint64_t now()
+    {
+        return uv_hrtime();
+    }
+
+    void read(int64_t n)
+    {
+        add(&Counters::reads, 1);
+        add(&Counters::bytesIn, n);
+    }
+
+    void write(int64_t n)
+    {
+        add(&Counters::writes, 1);
+        add(&Counters::bytesOut, n);
+    }
+
+    void again()
+    {
+        add(&Counters::again, 1);
+    }
+
+    // time spent in the event loop wait list before the loop thread picks the request up
+    void queue(uint64_t since)
+    {
+        add(&Counters::queued, 1);
+        add(&Counters::queueTime, (int64_t)(now() - since));
+    }
+
+    // time from the socket becoming ready to the result being handed back to the waiting fiber
+    void resume(uint64_t since)
+    {
+        add(&Counters::resumed, 1);
+        add(&Counters::resumeTime, (int64_t)(now() - since));
+    }
+
+    static result_t toJSON(Counters& c, v8::Local<v8::Object>& retVal);
+
+    result_t toJSON(v8::Local<v8::Object>& retVal)
+    {
+        return toJSON(m_counters, retVal);
+    }
+
+private:
+    static void clear(Counters& c)
+    {
+        c.reads = 0;
+        c.writes = 0;
+        c.bytesIn = 0;
+        c.bytesOut = 0;
+        c.again = 0;
+        c.queued = 0;
+        c.queueTime = 0;
+        c.resumed = 0;
+        c.resumeTime = 0;
+    }
+
+    void add(std::atomic<int64_t> Counters::*field, int64_t n)
+    {
+        (m_counters.*field).fetch_add(n, std::memory_order_relaxed);
+        (s_global.*field).fetch_add(n, std::memory_order_relaxed);
+    }
+
+public:
+    static Counters s_global;
+
+private:
+    Counters m_counters;
+};
+}
@@ -10,6 +10,7 @@
 #include "ifs/Socket.h"
 #include "inetAddr.h"
 #include "AsyncIO.h"
+#include "SockCork.h"
 #include "Timer.h"
 
 namespace fibjs {
@@ -20,6 +21,7 @@ class Socket : public Socket_base {
 public:
     Socket()
         : m_aio(INVALID_SOCKET, net_base::C_AF_INET)
+        , m_cork(this, [this](std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac) { return m_aio.writev(datas, ac); })
         , m_timeout(0)
 #ifdef _WIN32
         , m_bBind(FALSE)
@@ -29,6 +31,7 @@ public:
 
     Socket(SOCKET s, int32_t family)
         : m_aio(s, family)
+        , m_cork(this, [this](std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac) { return m_aio.writev(datas, ac); })
         , m_timeout(0)
 #ifdef _WIN32
         , m_bBind(FALSE)
@@ -48,6 +51,7 @@ public:
     virtual result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
         AsyncEvent* ac);
     virtual result_t write(Buffer_base* data, AsyncEvent* ac);
+    virtual result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac);
     virtual result_t flush(AsyncEvent* ac);
     virtual result_t close(AsyncEvent* ac);
     virtual result_t copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
@@ -61,6 +65,8 @@ public:
     virtual result_t get_localPort(int32_t& retVal);
     virtual result_t get_timeout(int32_t& retVal);
     virtual result_t set_timeout(int32_t newVal);
+    virtual result_t get_autoCork(bool& retVal);
+    virtual result_t set_autoCork(bool newVal);
     virtual result_t connect(exlib::string host, int32_t port, AsyncEvent* ac);
     virtual result_t bind(exlib::string addr, int32_t port, bool allowIPv4);
     virtual result_t bind(int32_t port, bool allowIPv4);
@@ -68,9 +74,17 @@ public:
     virtual result_t accept(obj_ptr<Socket_base>& retVal, AsyncEvent* ac);
     virtual result_t recv(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
     virtual result_t send(Buffer_base* data, AsyncEvent* ac);
+    virtual result_t cork();
+    virtual result_t uncork();
+    virtual result_t stats(v8::Local<v8::Object>& retVal);
 
 public:
     static result_t create(int32_t family, obj_ptr<Socket_base>& retVal);
+    result_t writev(std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac);
+#ifndef _WIN32
+    result_t accept(std::vector<obj_ptr<Socket_base>>& retVal, int32_t budget, AsyncEvent* ac);
+    result_t sendfile(int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
+#endif
 
 private:
     result_t create(int32_t family);
@@ -95,6 +109,7 @@ private:
 
 private:
     AsyncIO m_aio;
+    SockCork m_cork;
     int32_t m_timeout;
 
 #ifdef _WIN32
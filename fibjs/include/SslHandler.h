@@ -32,6 +32,9 @@ public:
     result_t init(v8::Local<v8::Array> certs, Handler_base* hdlr);
     result_t init(X509Cert_base* crt, PKey_base* key, Handler_base* hdlr);
 
+    // re-reads enableHttp2 from an HttpHandler behind this handler
+    void update_alpn();
+
 private:
     obj_ptr<Handler_base> m_hdlr;
     obj_ptr<SslSocket_base> m_socket;
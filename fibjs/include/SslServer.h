@@ -36,6 +36,11 @@ public:
     result_t create(v8::Local<v8::Array> certs, exlib::string addr, int32_t port,
         Handler_base* listener);
 
+    void update_alpn()
+    {
+        ((SslHandler*)(SslHandler_base*)m_hdlr)->update_alpn();
+    }
+
 private:
     obj_ptr<TcpServer_base> m_server;
     obj_ptr<SslHandler_base> m_hdlr;
@@ -122,6 +122,7 @@ public:
     virtual result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
         AsyncEvent* ac);
     virtual result_t write(Buffer_base* data, AsyncEvent* ac);
+    virtual result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac);
     virtual result_t flush(AsyncEvent* ac);
     virtual result_t close(AsyncEvent* ac);
     virtual result_t copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
@@ -177,6 +178,9 @@ public:
     mbedtls_ssl_config m_ssl_conf;
     std::vector<obj_ptr<Cert>> m_crts;
 
+    // protocols offered through ALPN by this socket when it connects, or by the sockets it accepts, NULL terminated
+    const char** m_alpn;
+
 private:
     obj_ptr<X509Cert> m_ca;
     obj_ptr<Stream_base> m_s;
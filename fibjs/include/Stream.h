@@ -0,0 +1,19 @@
+/*
+ * Stream.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "ifs/Stream.h"
+#include "Buffer.h"
+#include <vector>
+
+namespace fibjs {
+
+result_t stream_writev(Stream_base* stm, v8::Local<v8::Array> datas, AsyncEvent* ac);
+result_t stream_writev(Stream_base* stm, std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac);
+result_t get_writev_buffers(v8::Local<v8::Array> datas, std::vector<obj_ptr<Buffer_base>>& bufs, AsyncEvent* ac);
+}
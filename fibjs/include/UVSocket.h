@@ -11,6 +11,7 @@
 #include "inetAddr.h"
 #include "AsyncUV.h"
 #include "UVStream.h"
+#include "SockCork.h"
 
 namespace fibjs {
 
@@ -20,11 +21,16 @@ class UVSocket : public UVStream_tmpl<Socket_base> {
 public:
     UVSocket(int32_t family)
         : m_family(family)
+        , m_cork(this, [this](std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac) { return cork_write(datas, ac); })
     {
+        m_stats = &m_sockStats;
     }
 
 public:
     // Stream_base
+    virtual result_t write(Buffer_base* data, AsyncEvent* ac);
+    virtual result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac);
+    virtual result_t flush(AsyncEvent* ac);
     virtual result_t close(AsyncEvent* ac);
 
 public:
@@ -40,7 +46,15 @@ public:
     virtual result_t listen(int32_t backlog);
     virtual result_t accept(obj_ptr<Socket_base>& retVal, AsyncEvent* ac);
     virtual result_t recv(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+    virtual result_t get_autoCork(bool& retVal);
+    virtual result_t set_autoCork(bool newVal);
     virtual result_t send(Buffer_base* data, AsyncEvent* ac);
+    virtual result_t cork();
+    virtual result_t uncork();
+    virtual result_t stats(v8::Local<v8::Object>& retVal);
+
+public:
+    result_t writev(std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac);
 
 public:
     static result_t create(int32_t family, obj_ptr<Socket_base>& retVal);
@@ -48,9 +62,13 @@ public:
 private:
     static void on_listen(uv_stream_t* server, int status);
     void on_listen(int status);
+    result_t close_handle(AsyncEvent* ac);
+    result_t cork_write(std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac);
 
 private:
     int32_t m_family;
+    SockStats m_sockStats;
+    SockCork m_cork;
     exlib::spinlock m_lock;
     std::list<obj_ptr<UVSocket>> m_socks;
     std::list<std::pair<obj_ptr<Socket_base>&, AsyncEvent*>> m_accepts;
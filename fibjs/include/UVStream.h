@@ -10,6 +10,8 @@
 #include "ifs/io.h"
 #include "AsyncUV.h"
 #include "Buffer.h"
+#include "Stream.h"
+#include "SockStats.h"
 
 #define STREAM_BLOCK_SIZE 2048
 
@@ -101,12 +103,16 @@ public:
             , m_retVal(retVal)
             , m_ac(ac)
             , m_pos(0)
+            , m_posted(pThis->m_stats ? SockStats::now() : 0)
         {
         }
 
     public:
         virtual void invoke()
         {
+            if (m_posted)
+                m_this->m_stats->queue(m_posted);
+
             m_this->queue_read.putTail(this);
             if (m_this->queue_read.count() == 1) {
                 int32_t ret = uv_read_start(&m_this->m_stream, on_alloc, on_read);
@@ -144,6 +150,9 @@ public:
                 return;
             }
 
+            if (pThis->m_stats)
+                pThis->m_stats->read(nread);
+
             ar = pThis->queue_read.head();
             ar->m_pos += nread;
             if (!ar->m_bRead || (ar->m_bytes < 0) || (ar->m_bytes == ar->m_pos)) {
@@ -186,6 +195,7 @@ public:
         obj_ptr<Buffer_base>& m_retVal;
         AsyncEvent* m_ac;
         size_t m_pos;
+        uint64_t m_posted;
         exlib::string m_buf;
     };
 
@@ -196,18 +206,52 @@ public:
             : UVTimeout(pThis)
             , m_this(pThis)
             , m_ac(ac)
+            , m_posted(pThis->m_stats ? SockStats::now() : 0)
+            , m_len(0)
+        {
+            add(data);
+        }
+
+        // every buffer goes to uv_write as it is, libuv hands them to the kernel in one gathered write
+        AsyncWrite(UVStream_tmpl* pThis, std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac)
+            : UVTimeout(pThis)
+            , m_this(pThis)
+            , m_ac(ac)
+            , m_posted(pThis->m_stats ? SockStats::now() : 0)
+            , m_len(0)
+        {
+            size_t i;
+
+            m_datas.reserve(datas.size());
+            m_bufs.reserve(datas.size());
+            for (i = 0; i < datas.size(); i++)
+                add(datas[i]);
+        }
+
+    private:
+        void add(Buffer_base* data)
         {
-            data->toString(m_strBuf);
-            m_buf.base = (char*)m_strBuf.c_str();
-            m_buf.len = (uint32_t)m_strBuf.length();
+            uv_buf_t buf;
+            int32_t len;
+
+            data->get_length(len);
+            buf.base = ((Buffer*)data)->data();
+            buf.len = (uint32_t)len;
+
+            m_datas.push_back(data);
+            m_bufs.push_back(buf);
+            m_len += len;
         }
 
     public:
         virtual void invoke()
         {
+            if (m_posted)
+                m_this->m_stats->queue(m_posted);
+
             m_this->queue_write.putTail(this);
             if (m_this->queue_write.count() == 1) {
-                int32_t ret = uv_write(&m_req, &m_this->m_stream, &m_buf, 1, on_write);
+                int32_t ret = uv_write(&m_req, &m_this->m_stream, m_bufs.data(), (uint32_t)m_bufs.size(), on_write);
                 if (ret < 0)
                     post_all_result(m_this, ret);
             }
@@ -224,11 +268,14 @@ public:
                 return;
             }
 
-            pThis->queue_write.getHead()->post_result(0);
+            wr = pThis->queue_write.getHead();
+            if (pThis->m_stats)
+                pThis->m_stats->write(wr->m_len);
+            wr->post_result(0);
 
             if (pThis->queue_write.count() > 0) {
                 wr = pThis->queue_write.head();
-                int32_t ret = uv_write(&wr->m_req, &pThis->m_stream, &wr->m_buf, 1, on_write);
+                int32_t ret = uv_write(&wr->m_req, &pThis->m_stream, wr->m_bufs.data(), (uint32_t)wr->m_bufs.size(), on_write);
                 if (ret)
                     post_all_result(pThis, ret);
             }
@@ -249,8 +296,10 @@ public:
     private:
         obj_ptr<UVStream_tmpl> m_this;
         AsyncEvent* m_ac;
-        exlib::string m_strBuf;
-        uv_buf_t m_buf;
+        uint64_t m_posted;
+        std::vector<obj_ptr<Buffer_base>> m_datas;
+        std::vector<uv_buf_t> m_bufs;
+        size_t m_len;
         uv_write_t m_req;
     };
 
@@ -288,6 +337,20 @@ public:
         return CALL_E_PENDDING;
     }
 
+    virtual result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac)
+    {
+        return stream_writev(this, datas, ac);
+    }
+
+    result_t writev(std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac)
+    {
+        if (ac->isSync())
+            return CHECK_ERROR(CALL_E_NOSYNC);
+
+        uv_post(new AsyncWrite(this, datas, ac));
+        return CALL_E_PENDDING;
+    }
+
     virtual result_t flush(AsyncEvent* ac)
     {
         return 0;
@@ -344,6 +407,7 @@ public:
 public:
     int32_t m_fd;
     int32_t m_timeout = -1;
+    SockStats* m_stats = NULL;
 
 public:
     union {
@@ -9,6 +9,7 @@
 
 #include "ifs/zlib.h"
 #include "Buffer.h"
+#include "Stream.h"
 #include "MemoryStream.h"
 #include <zlib/include/zlib.h>
 
@@ -122,6 +123,11 @@ public:
         return (new asyncWrite(this, m_stm, data, ac))->post(0);
     }
 
+    result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac)
+    {
+        return stream_writev(this, datas, ac);
+    }
+
     result_t flush(AsyncEvent* ac)
     {
         return (new asyncWrite(this, m_stm, Z_SYNC_FLUSH, ac))->post(0);
@@ -341,10 +347,10 @@ public:
 
 class gz : public def_base {
 public:
-    gz(Stream_base* stm)
+    gz(Stream_base* stm, int32_t level = -1)
         : def_base(stm)
     {
-        deflateInit2(&strm, -1, 8, 15 + 16, 8, 0);
+        deflateInit2(&strm, level, 8, 15 + 16, 8, 0);
     }
 };
 
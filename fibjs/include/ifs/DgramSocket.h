@@ -28,6 +28,7 @@ public:
     virtual result_t bind(v8::Local<v8::Object> opts, AsyncEvent* ac) = 0;
     virtual result_t send(Buffer_base* msg, int32_t port, exlib::string address, int32_t& retVal, AsyncEvent* ac) = 0;
     virtual result_t send(Buffer_base* msg, int32_t offset, int32_t length, int32_t port, exlib::string address, int32_t& retVal, AsyncEvent* ac) = 0;
+    virtual result_t sendBatch(v8::Local<v8::Array> msgs, int32_t port, exlib::string address, int32_t& retVal, AsyncEvent* ac) = 0;
     virtual result_t address(obj_ptr<NObject>& retVal) = 0;
     virtual result_t close() = 0;
     virtual result_t close(v8::Local<v8::Function> callback) = 0;
@@ -53,6 +54,7 @@ public:
 public:
     static void s_bind(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_send(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_sendBatch(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_address(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_close(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_getRecvBufferSize(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -68,6 +70,7 @@ public:
     ASYNC_MEMBER1(DgramSocket_base, bind, v8::Local<v8::Object>);
     ASYNC_MEMBERVALUE4(DgramSocket_base, send, Buffer_base*, int32_t, exlib::string, int32_t);
     ASYNC_MEMBERVALUE6(DgramSocket_base, send, Buffer_base*, int32_t, int32_t, int32_t, exlib::string, int32_t);
+    ASYNC_MEMBERVALUE4(DgramSocket_base, sendBatch, v8::Local<v8::Array>, int32_t, exlib::string, int32_t);
 };
 }
 
@@ -81,6 +84,8 @@ inline ClassInfo& DgramSocket_base::class_info()
         { "bindSync", s_bind, false, false },
         { "send", s_send, false, true },
         { "sendSync", s_send, false, false },
+        { "sendBatch", s_sendBatch, false, true },
+        { "sendBatchSync", s_sendBatch, false, false },
         { "address", s_address, false, false },
         { "close", s_close, false, false },
         { "getRecvBufferSize", s_getRecvBufferSize, false, false },
@@ -165,6 +170,28 @@ inline void DgramSocket_base::s_send(const v8::FunctionCallbackInfo<v8::Value>&
     METHOD_RETURN();
 }
 
+inline void DgramSocket_base::s_sendBatch(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("DgramSocket.sendBatch");
+    METHOD_INSTANCE(DgramSocket_base);
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(3, 2);
+
+    ARG(v8::Local<v8::Array>, 0);
+    ARG(int32_t, 1);
+    OPT_ARG(exlib::string, 2, "");
+
+    if (!cb.IsEmpty())
+        hr = pInst->acb_sendBatch(v0, v1, v2, cb, args);
+    else
+        hr = pInst->ac_sendBatch(v0, v1, v2, vr);
+
+    METHOD_RETURN();
+}
+
 inline void DgramSocket_base::s_address(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     obj_ptr<NObject> vr;
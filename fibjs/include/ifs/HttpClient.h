@@ -45,13 +45,22 @@ public:
     virtual result_t set_poolSize(int32_t newVal) = 0;
     virtual result_t get_poolTimeout(int32_t& retVal) = 0;
     virtual result_t set_poolTimeout(int32_t newVal) = 0;
+    virtual result_t get_maxConnsPerHost(int32_t& retVal) = 0;
+    virtual result_t set_maxConnsPerHost(int32_t newVal) = 0;
     virtual result_t get_http_proxy(exlib::string& retVal) = 0;
     virtual result_t set_http_proxy(exlib::string newVal) = 0;
     virtual result_t get_https_proxy(exlib::string& retVal) = 0;
     virtual result_t set_https_proxy(exlib::string newVal) = 0;
     virtual result_t get_sslVerification(int32_t& retVal) = 0;
     virtual result_t set_sslVerification(int32_t newVal) = 0;
+    virtual result_t get_enableHttp2(bool& retVal) = 0;
+    virtual result_t set_enableHttp2(bool newVal) = 0;
+    virtual result_t get_enableH2c(bool& retVal) = 0;
+    virtual result_t set_enableH2c(bool newVal) = 0;
+    virtual result_t get_maxConcurrentStreams(int32_t& retVal) = 0;
+    virtual result_t set_maxConcurrentStreams(int32_t newVal) = 0;
     virtual result_t setClientCert(X509Cert_base* crt, PKey_base* key) = 0;
+    virtual result_t poolStats(v8::Local<v8::Object>& retVal) = 0;
     virtual result_t request(Stream_base* conn, HttpRequest_base* req, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac) = 0;
     virtual result_t request(Stream_base* conn, HttpRequest_base* req, SeekableStream_base* response_body, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac) = 0;
     virtual result_t request(exlib::string method, exlib::string url, v8::Local<v8::Object> opts, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac) = 0;
@@ -87,13 +96,22 @@ public:
     static void s_set_poolSize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_poolTimeout(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_poolTimeout(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_maxConnsPerHost(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_maxConnsPerHost(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_http_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_http_proxy(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_https_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_https_proxy(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_sslVerification(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_sslVerification(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_enableH2c(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_enableH2c(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_maxConcurrentStreams(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_maxConcurrentStreams(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_setClientCert(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_poolStats(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_request(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_get(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_post(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -129,6 +147,7 @@ inline ClassInfo& HttpClient_base::class_info()
 {
     static ClassData::ClassMethod s_method[] = {
         { "setClientCert", s_setClientCert, false, false },
+        { "poolStats", s_poolStats, false, false },
         { "request", s_request, false, true },
         { "requestSync", s_request, false, false },
         { "get", s_get, false, true },
@@ -155,9 +174,13 @@ inline ClassInfo& HttpClient_base::class_info()
         { "userAgent", s_get_userAgent, s_set_userAgent, false },
         { "poolSize", s_get_poolSize, s_set_poolSize, false },
         { "poolTimeout", s_get_poolTimeout, s_set_poolTimeout, false },
+        { "maxConnsPerHost", s_get_maxConnsPerHost, s_set_maxConnsPerHost, false },
         { "http_proxy", s_get_http_proxy, s_set_http_proxy, false },
         { "https_proxy", s_get_https_proxy, s_set_https_proxy, false },
-        { "sslVerification", s_get_sslVerification, s_set_sslVerification, false }
+        { "sslVerification", s_get_sslVerification, s_set_sslVerification, false },
+        { "enableHttp2", s_get_enableHttp2, s_set_enableHttp2, false },
+        { "enableH2c", s_get_enableH2c, s_set_enableH2c, false },
+        { "maxConcurrentStreams", s_get_maxConcurrentStreams, s_set_maxConcurrentStreams, false }
     };
 
     static ClassData s_cd = {
@@ -404,6 +427,31 @@ inline void HttpClient_base::s_set_poolTimeout(v8::Local<v8::Name> property, v8:
     PROPERTY_SET_LEAVE();
 }
 
+inline void HttpClient_base::s_get_maxConnsPerHost(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("HttpClient.maxConnsPerHost");
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_maxConnsPerHost(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpClient_base::s_set_maxConnsPerHost(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpClient.maxConnsPerHost");
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_maxConnsPerHost(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void HttpClient_base::s_get_http_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     exlib::string vr;
@@ -479,6 +527,81 @@ inline void HttpClient_base::s_set_sslVerification(v8::Local<v8::Name> property,
     PROPERTY_SET_LEAVE();
 }
 
+inline void HttpClient_base::s_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_NAME("HttpClient.enableHttp2");
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_enableHttp2(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpClient_base::s_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpClient.enableHttp2");
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = pInst->set_enableHttp2(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpClient_base::s_get_enableH2c(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_NAME("HttpClient.enableH2c");
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_enableH2c(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpClient_base::s_set_enableH2c(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpClient.enableH2c");
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = pInst->set_enableH2c(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpClient_base::s_get_maxConcurrentStreams(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("HttpClient.maxConcurrentStreams");
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_maxConcurrentStreams(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpClient_base::s_set_maxConcurrentStreams(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpClient.maxConcurrentStreams");
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_maxConcurrentStreams(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void HttpClient_base::s_setClientCert(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     METHOD_NAME("HttpClient.setClientCert");
@@ -495,6 +618,21 @@ inline void HttpClient_base::s_setClientCert(const v8::FunctionCallbackInfo<v8::
     METHOD_VOID();
 }
 
+inline void HttpClient_base::s_poolStats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_NAME("HttpClient.poolStats");
+    METHOD_INSTANCE(HttpClient_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = pInst->poolStats(vr);
+
+    METHOD_RETURN();
+}
+
 inline void HttpClient_base::s_request(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     obj_ptr<HttpResponse_base> vr;
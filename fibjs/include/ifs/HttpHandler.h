@@ -31,6 +31,14 @@ public:
     virtual result_t set_maxBodySize(int32_t newVal) = 0;
     virtual result_t get_enableEncoding(bool& retVal) = 0;
     virtual result_t set_enableEncoding(bool newVal) = 0;
+    virtual result_t get_encodingLevel(int32_t& retVal) = 0;
+    virtual result_t set_encodingLevel(int32_t newVal) = 0;
+    virtual result_t get_encodingThreshold(int32_t& retVal) = 0;
+    virtual result_t set_encodingThreshold(int32_t newVal) = 0;
+    virtual result_t get_enableHttp2(bool& retVal) = 0;
+    virtual result_t set_enableHttp2(bool newVal) = 0;
+    virtual result_t get_maxPipeline(int32_t& retVal) = 0;
+    virtual result_t set_maxPipeline(int32_t newVal) = 0;
     virtual result_t get_serverName(exlib::string& retVal) = 0;
     virtual result_t set_serverName(exlib::string newVal) = 0;
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal) = 0;
@@ -49,6 +57,14 @@ public:
     static void s_set_maxBodySize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_enableEncoding(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_enableEncoding(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_encodingLevel(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_encodingLevel(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_encodingThreshold(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_encodingThreshold(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_maxPipeline(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_maxPipeline(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_serverName(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_serverName(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_handler(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
@@ -67,6 +83,10 @@ inline ClassInfo& HttpHandler_base::class_info()
         { "maxHeadersCount", s_get_maxHeadersCount, s_set_maxHeadersCount, false },
         { "maxBodySize", s_get_maxBodySize, s_set_maxBodySize, false },
         { "enableEncoding", s_get_enableEncoding, s_set_enableEncoding, false },
+        { "encodingLevel", s_get_encodingLevel, s_set_encodingLevel, false },
+        { "encodingThreshold", s_get_encodingThreshold, s_set_encodingThreshold, false },
+        { "enableHttp2", s_get_enableHttp2, s_set_enableHttp2, false },
+        { "maxPipeline", s_get_maxPipeline, s_set_maxPipeline, false },
         { "serverName", s_get_serverName, s_set_serverName, false },
         { "handler", s_get_handler, s_set_handler, false }
     };
@@ -194,6 +214,106 @@ inline void HttpHandler_base::s_set_enableEncoding(v8::Local<v8::Name> property,
     PROPERTY_SET_LEAVE();
 }
 
+inline void HttpHandler_base::s_get_encodingLevel(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("HttpHandler.encodingLevel");
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_encodingLevel(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpHandler_base::s_set_encodingLevel(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpHandler.encodingLevel");
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_encodingLevel(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpHandler_base::s_get_encodingThreshold(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("HttpHandler.encodingThreshold");
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_encodingThreshold(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpHandler_base::s_set_encodingThreshold(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpHandler.encodingThreshold");
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_encodingThreshold(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpHandler_base::s_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_NAME("HttpHandler.enableHttp2");
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_enableHttp2(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpHandler_base::s_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpHandler.enableHttp2");
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = pInst->set_enableHttp2(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpHandler_base::s_get_maxPipeline(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("HttpHandler.maxPipeline");
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_maxPipeline(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpHandler_base::s_set_maxPipeline(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpHandler.maxPipeline");
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_maxPipeline(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void HttpHandler_base::s_get_serverName(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     exlib::string vr;
@@ -29,6 +29,23 @@ public:
     virtual result_t load(v8::Local<v8::Array> urls) = 0;
     virtual result_t get_urls(obj_ptr<NArray>& retVal) = 0;
     virtual result_t get_client(obj_ptr<HttpClient_base>& retVal) = 0;
+    virtual result_t get_strategy(exlib::string& retVal) = 0;
+    virtual result_t set_strategy(exlib::string newVal) = 0;
+    virtual result_t get_hashHeader(exlib::string& retVal) = 0;
+    virtual result_t set_hashHeader(exlib::string newVal) = 0;
+    virtual result_t get_maxFails(int32_t& retVal) = 0;
+    virtual result_t set_maxFails(int32_t newVal) = 0;
+    virtual result_t get_ejectTime(int32_t& retVal) = 0;
+    virtual result_t set_ejectTime(int32_t newVal) = 0;
+    virtual result_t get_retries(int32_t& retVal) = 0;
+    virtual result_t set_retries(int32_t newVal) = 0;
+    virtual result_t get_retryBudget(double& retVal) = 0;
+    virtual result_t set_retryBudget(double newVal) = 0;
+    virtual result_t get_healthCheck(exlib::string& retVal) = 0;
+    virtual result_t set_healthCheck(exlib::string newVal) = 0;
+    virtual result_t get_healthInterval(int32_t& retVal) = 0;
+    virtual result_t set_healthInterval(int32_t newVal) = 0;
+    virtual result_t stats(v8::Local<v8::Object>& retVal) = 0;
 
 public:
     template <typename T>
@@ -39,6 +56,23 @@ public:
     static void s_load(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_get_urls(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_get_client(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_get_strategy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_strategy(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_hashHeader(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_hashHeader(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_maxFails(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_maxFails(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_ejectTime(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_ejectTime(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_retries(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_retries(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_retryBudget(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_retryBudget(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_healthCheck(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_healthCheck(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_healthInterval(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_healthInterval(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_stats(const v8::FunctionCallbackInfo<v8::Value>& args);
 };
 }
 
@@ -48,12 +82,21 @@ namespace fibjs {
 inline ClassInfo& HttpRepeater_base::class_info()
 {
     static ClassData::ClassMethod s_method[] = {
-        { "load", s_load, false, false }
+        { "load", s_load, false, false },
+        { "stats", s_stats, false, false }
     };
 
     static ClassData::ClassProperty s_property[] = {
         { "urls", s_get_urls, block_set, false },
-        { "client", s_get_client, block_set, false }
+        { "client", s_get_client, block_set, false },
+        { "strategy", s_get_strategy, s_set_strategy, false },
+        { "hashHeader", s_get_hashHeader, s_set_hashHeader, false },
+        { "maxFails", s_get_maxFails, s_set_maxFails, false },
+        { "ejectTime", s_get_ejectTime, s_set_ejectTime, false },
+        { "retries", s_get_retries, s_set_retries, false },
+        { "retryBudget", s_get_retryBudget, s_set_retryBudget, false },
+        { "healthCheck", s_get_healthCheck, s_set_healthCheck, false },
+        { "healthInterval", s_get_healthInterval, s_set_healthInterval, false }
     };
 
     static ClassData s_cd = {
@@ -135,4 +178,219 @@ inline void HttpRepeater_base::s_get_client(v8::Local<v8::Name> property, const
 
     METHOD_RETURN();
 }
+
+inline void HttpRepeater_base::s_get_strategy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    exlib::string vr;
+
+    METHOD_NAME("HttpRepeater.strategy");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_strategy(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpRepeater_base::s_set_strategy(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpRepeater.strategy");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(exlib::string);
+
+    hr = pInst->set_strategy(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpRepeater_base::s_get_hashHeader(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    exlib::string vr;
+
+    METHOD_NAME("HttpRepeater.hashHeader");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_hashHeader(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpRepeater_base::s_set_hashHeader(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpRepeater.hashHeader");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(exlib::string);
+
+    hr = pInst->set_hashHeader(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpRepeater_base::s_get_maxFails(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("HttpRepeater.maxFails");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_maxFails(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpRepeater_base::s_set_maxFails(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpRepeater.maxFails");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_maxFails(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpRepeater_base::s_get_ejectTime(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("HttpRepeater.ejectTime");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_ejectTime(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpRepeater_base::s_set_ejectTime(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpRepeater.ejectTime");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_ejectTime(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpRepeater_base::s_get_retries(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("HttpRepeater.retries");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_retries(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpRepeater_base::s_set_retries(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpRepeater.retries");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_retries(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpRepeater_base::s_get_retryBudget(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    double vr;
+
+    METHOD_NAME("HttpRepeater.retryBudget");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_retryBudget(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpRepeater_base::s_set_retryBudget(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpRepeater.retryBudget");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(double);
+
+    hr = pInst->set_retryBudget(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpRepeater_base::s_get_healthCheck(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    exlib::string vr;
+
+    METHOD_NAME("HttpRepeater.healthCheck");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_healthCheck(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpRepeater_base::s_set_healthCheck(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpRepeater.healthCheck");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(exlib::string);
+
+    hr = pInst->set_healthCheck(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpRepeater_base::s_get_healthInterval(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("HttpRepeater.healthInterval");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_healthInterval(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpRepeater_base::s_set_healthInterval(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("HttpRepeater.healthInterval");
+    METHOD_INSTANCE(HttpRepeater_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_healthInterval(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpRepeater_base::s_stats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_NAME("HttpRepeater.stats");
+    METHOD_INSTANCE(HttpRepeater_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = pInst->stats(vr);
+
+    METHOD_RETURN();
+}
 }
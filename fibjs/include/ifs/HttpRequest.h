@@ -36,6 +36,7 @@ public:
     virtual result_t get_cookies(obj_ptr<HttpCollection_base>& retVal) = 0;
     virtual result_t get_form(obj_ptr<HttpCollection_base>& retVal) = 0;
     virtual result_t get_query(obj_ptr<HttpCollection_base>& retVal) = 0;
+    virtual result_t parseForm(v8::Local<v8::Object> opts, obj_ptr<HttpCollection_base>& retVal) = 0;
 
 public:
     template <typename T>
@@ -53,6 +54,7 @@ public:
     static void s_get_cookies(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_get_form(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_get_query(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_parseForm(const v8::FunctionCallbackInfo<v8::Value>& args);
 };
 }
 
@@ -62,6 +64,10 @@ public:
 namespace fibjs {
 inline ClassInfo& HttpRequest_base::class_info()
 {
+    static ClassData::ClassMethod s_method[] = {
+        { "parseForm", s_parseForm, false, false }
+    };
+
     static ClassData::ClassProperty s_property[] = {
         { "response", s_get_response, block_set, false },
         { "method", s_get_method, s_set_method, false },
@@ -74,7 +80,7 @@ inline ClassInfo& HttpRequest_base::class_info()
 
     static ClassData s_cd = {
         "HttpRequest", false, s__new, NULL,
-        0, NULL, 0, NULL, ARRAYSIZE(s_property), s_property, 0, NULL, NULL, NULL,
+        ARRAYSIZE(s_method), s_method, 0, NULL, ARRAYSIZE(s_property), s_property, 0, NULL, NULL, NULL,
         &HttpMessage_base::class_info()
     };
 
@@ -229,4 +235,21 @@ inline void HttpRequest_base::s_get_query(v8::Local<v8::Name> property, const v8
 
     METHOD_RETURN();
 }
+
+inline void HttpRequest_base::s_parseForm(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<HttpCollection_base> vr;
+
+    METHOD_NAME("HttpRequest.parseForm");
+    METHOD_INSTANCE(HttpRequest_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(1, 0);
+
+    OPT_ARG(v8::Local<v8::Object>, 0, v8::Object::New(isolate));
+
+    hr = pInst->parseForm(v0, vr);
+
+    METHOD_RETURN();
+}
 }
@@ -33,6 +33,8 @@ public:
     virtual result_t get_localPort(int32_t& retVal) = 0;
     virtual result_t get_timeout(int32_t& retVal) = 0;
     virtual result_t set_timeout(int32_t newVal) = 0;
+    virtual result_t get_autoCork(bool& retVal) = 0;
+    virtual result_t set_autoCork(bool newVal) = 0;
     virtual result_t connect(exlib::string host, int32_t port, AsyncEvent* ac) = 0;
     virtual result_t bind(int32_t port, bool allowIPv4) = 0;
     virtual result_t bind(exlib::string addr, int32_t port, bool allowIPv4) = 0;
@@ -40,6 +42,9 @@ public:
     virtual result_t accept(obj_ptr<Socket_base>& retVal, AsyncEvent* ac) = 0;
     virtual result_t recv(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac) = 0;
     virtual result_t send(Buffer_base* data, AsyncEvent* ac) = 0;
+    virtual result_t cork() = 0;
+    virtual result_t uncork() = 0;
+    virtual result_t stats(v8::Local<v8::Object>& retVal) = 0;
 
 public:
     template <typename T>
@@ -54,12 +59,17 @@ public:
     static void s_get_localPort(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_get_timeout(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_timeout(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_autoCork(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_autoCork(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_connect(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_bind(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_listen(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_accept(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_recv(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_send(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_cork(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_uncork(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_stats(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 public:
     ASYNC_MEMBER2(Socket_base, connect, exlib::string, int32_t);
@@ -85,7 +95,10 @@ inline ClassInfo& Socket_base::class_info()
         { "recv", s_recv, false, true },
         { "recvSync", s_recv, false, false },
         { "send", s_send, false, true },
-        { "sendSync", s_send, false, false }
+        { "sendSync", s_send, false, false },
+        { "cork", s_cork, false, false },
+        { "uncork", s_uncork, false, false },
+        { "stats", s_stats, false, false }
     };
 
     static ClassData::ClassProperty s_property[] = {
@@ -94,7 +107,8 @@ inline ClassInfo& Socket_base::class_info()
         { "remotePort", s_get_remotePort, block_set, false },
         { "localAddress", s_get_localAddress, block_set, false },
         { "localPort", s_get_localPort, block_set, false },
-        { "timeout", s_get_timeout, s_set_timeout, false }
+        { "timeout", s_get_timeout, s_set_timeout, false },
+        { "autoCork", s_get_autoCork, s_set_autoCork, false }
     };
 
     static ClassData s_cd = {
@@ -220,6 +234,31 @@ inline void Socket_base::s_set_timeout(v8::Local<v8::Name> property, v8::Local<v
     PROPERTY_SET_LEAVE();
 }
 
+inline void Socket_base::s_get_autoCork(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_NAME("Socket.autoCork");
+    METHOD_INSTANCE(Socket_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_autoCork(vr);
+
+    METHOD_RETURN();
+}
+
+inline void Socket_base::s_set_autoCork(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("Socket.autoCork");
+    METHOD_INSTANCE(Socket_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = pInst->set_autoCork(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void Socket_base::s_connect(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     METHOD_NAME("Socket.connect");
@@ -333,4 +372,45 @@ inline void Socket_base::s_send(const v8::FunctionCallbackInfo<v8::Value>& args)
 
     METHOD_VOID();
 }
+
+inline void Socket_base::s_cork(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_NAME("Socket.cork");
+    METHOD_INSTANCE(Socket_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = pInst->cork();
+
+    METHOD_VOID();
+}
+
+inline void Socket_base::s_uncork(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_NAME("Socket.uncork");
+    METHOD_INSTANCE(Socket_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = pInst->uncork();
+
+    METHOD_VOID();
+}
+
+inline void Socket_base::s_stats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_NAME("Socket.stats");
+    METHOD_INSTANCE(Socket_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = pInst->stats(vr);
+
+    METHOD_RETURN();
+}
 }
@@ -25,6 +25,7 @@ public:
     virtual result_t get_fd(int32_t& retVal) = 0;
     virtual result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac) = 0;
     virtual result_t write(Buffer_base* data, AsyncEvent* ac) = 0;
+    virtual result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac) = 0;
     virtual result_t flush(AsyncEvent* ac) = 0;
     virtual result_t close(AsyncEvent* ac) = 0;
     virtual result_t copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac) = 0;
@@ -44,6 +45,7 @@ public:
     static void s_get_fd(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_read(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_write(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_writev(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_flush(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_close(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_copyTo(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -51,6 +53,7 @@ public:
 public:
     ASYNC_MEMBERVALUE2(Stream_base, read, int32_t, obj_ptr<Buffer_base>);
     ASYNC_MEMBER1(Stream_base, write, Buffer_base*);
+    ASYNC_MEMBER1(Stream_base, writev, v8::Local<v8::Array>);
     ASYNC_MEMBER0(Stream_base, flush);
     ASYNC_MEMBER0(Stream_base, close);
     ASYNC_MEMBERVALUE3(Stream_base, copyTo, Stream_base*, int64_t, int64_t);
@@ -67,6 +70,8 @@ inline ClassInfo& Stream_base::class_info()
         { "readSync", s_read, false, false },
         { "write", s_write, false, true },
         { "writeSync", s_write, false, false },
+        { "writev", s_writev, false, true },
+        { "writevSync", s_writev, false, false },
         { "flush", s_flush, false, true },
         { "flushSync", s_flush, false, false },
         { "close", s_close, false, true },
@@ -140,6 +145,24 @@ inline void Stream_base::s_write(const v8::FunctionCallbackInfo<v8::Value>& args
     METHOD_VOID();
 }
 
+inline void Stream_base::s_writev(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_NAME("Stream.writev");
+    METHOD_INSTANCE(Stream_base);
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(1, 1);
+
+    ARG(v8::Local<v8::Array>, 0);
+
+    if (!cb.IsEmpty())
+        hr = pInst->acb_writev(v0, cb, args);
+    else
+        hr = pInst->ac_writev(v0);
+
+    METHOD_VOID();
+}
+
 inline void Stream_base::s_flush(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     METHOD_NAME("Stream.flush");
@@ -22,6 +22,8 @@ public:
     // dns_base
     static result_t resolve(exlib::string name, obj_ptr<NArray>& retVal, AsyncEvent* ac);
     static result_t lookup(exlib::string name, exlib::string& retVal, AsyncEvent* ac);
+    static result_t stats(v8::Local<v8::Object>& retVal);
+    static result_t clearCache();
 
 public:
     static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args)
@@ -37,6 +39,8 @@ public:
 public:
     static void s_static_resolve(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_lookup(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_stats(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_clearCache(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 public:
     ASYNC_STATICVALUE2(dns_base, resolve, exlib::string, obj_ptr<NArray>);
@@ -51,7 +55,9 @@ inline ClassInfo& dns_base::class_info()
         { "resolve", s_static_resolve, true, true },
         { "resolveSync", s_static_resolve, true, false },
         { "lookup", s_static_lookup, true, true },
-        { "lookupSync", s_static_lookup, true, false }
+        { "lookupSync", s_static_lookup, true, false },
+        { "stats", s_static_stats, true, false },
+        { "clearCache", s_static_clearCache, true, false }
     };
 
     static ClassData s_cd = {
@@ -101,4 +107,30 @@ inline void dns_base::s_static_lookup(const v8::FunctionCallbackInfo<v8::Value>&
 
     METHOD_RETURN();
 }
+
+inline void dns_base::s_static_stats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_NAME("dns.stats");
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = stats(vr);
+
+    METHOD_RETURN();
+}
+
+inline void dns_base::s_static_clearCache(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_NAME("dns.clearCache");
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = clearCache();
+
+    METHOD_VOID();
+}
 }
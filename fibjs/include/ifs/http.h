@@ -52,12 +52,15 @@ public:
     static result_t set_poolSize(int32_t newVal);
     static result_t get_poolTimeout(int32_t& retVal);
     static result_t set_poolTimeout(int32_t newVal);
+    static result_t get_maxConnsPerHost(int32_t& retVal);
+    static result_t set_maxConnsPerHost(int32_t newVal);
     static result_t get_http_proxy(exlib::string& retVal);
     static result_t set_http_proxy(exlib::string newVal);
     static result_t get_https_proxy(exlib::string& retVal);
     static result_t set_https_proxy(exlib::string newVal);
     static result_t fileHandler(exlib::string root, v8::Local<v8::Object> mimes, bool autoIndex, obj_ptr<Handler_base>& retVal);
     static result_t setClientCert(X509Cert_base* crt, PKey_base* key);
+    static result_t poolStats(v8::Local<v8::Object>& retVal);
     static result_t request(Stream_base* conn, HttpRequest_base* req, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
     static result_t request(Stream_base* conn, HttpRequest_base* req, SeekableStream_base* response_body, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
     static result_t request(exlib::string method, exlib::string url, v8::Local<v8::Object> opts, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
@@ -100,12 +103,15 @@ public:
     static void s_static_set_poolSize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_get_poolTimeout(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_poolTimeout(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_static_get_maxConnsPerHost(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_static_set_maxConnsPerHost(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_get_http_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_http_proxy(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_get_https_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_https_proxy(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_fileHandler(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_setClientCert(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_poolStats(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_request(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_get(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_post(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -149,6 +155,7 @@ inline ClassInfo& http_base::class_info()
     static ClassData::ClassMethod s_method[] = {
         { "fileHandler", s_static_fileHandler, true, false },
         { "setClientCert", s_static_setClientCert, true, false },
+        { "poolStats", s_static_poolStats, true, false },
         { "request", s_static_request, true, true },
         { "requestSync", s_static_request, true, false },
         { "get", s_static_get, true, true },
@@ -187,6 +194,7 @@ inline ClassInfo& http_base::class_info()
         { "userAgent", s_static_get_userAgent, s_static_set_userAgent, true },
         { "poolSize", s_static_get_poolSize, s_static_set_poolSize, true },
         { "poolTimeout", s_static_get_poolTimeout, s_static_set_poolTimeout, true },
+        { "maxConnsPerHost", s_static_get_maxConnsPerHost, s_static_set_maxConnsPerHost, true },
         { "http_proxy", s_static_get_http_proxy, s_static_set_http_proxy, true },
         { "https_proxy", s_static_get_https_proxy, s_static_set_https_proxy, true }
     };
@@ -409,6 +417,29 @@ inline void http_base::s_static_set_poolTimeout(v8::Local<v8::Name> property, v8
     PROPERTY_SET_LEAVE();
 }
 
+inline void http_base::s_static_get_maxConnsPerHost(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("http.maxConnsPerHost");
+    PROPERTY_ENTER();
+
+    hr = get_maxConnsPerHost(vr);
+
+    METHOD_RETURN();
+}
+
+inline void http_base::s_static_set_maxConnsPerHost(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("http.maxConnsPerHost");
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = set_maxConnsPerHost(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void http_base::s_static_get_http_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     exlib::string vr;
@@ -488,6 +519,20 @@ inline void http_base::s_static_setClientCert(const v8::FunctionCallbackInfo<v8:
     METHOD_VOID();
 }
 
+inline void http_base::s_static_poolStats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_NAME("http.poolStats");
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = poolStats(vr);
+
+    METHOD_RETURN();
+}
+
 inline void http_base::s_static_request(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     obj_ptr<HttpResponse_base> vr;
@@ -36,6 +36,11 @@ public:
     // net_base
     static result_t get_use_uv_socket(bool& retVal);
     static result_t set_use_uv_socket(bool newVal);
+    static result_t get_io_threads(int32_t& retVal);
+    static result_t get_reuse_port(bool& retVal);
+    static result_t set_reuse_port(bool newVal);
+    static result_t get_accept_batch(int32_t& retVal);
+    static result_t set_accept_batch(int32_t newVal);
     static result_t info(v8::Local<v8::Object>& retVal);
     static result_t resolve(exlib::string name, int32_t family, exlib::string& retVal, AsyncEvent* ac);
     static result_t ip(exlib::string name, exlib::string& retVal, AsyncEvent* ac);
@@ -43,6 +48,9 @@ public:
     static result_t connect(exlib::string url, int32_t timeout, obj_ptr<Stream_base>& retVal, AsyncEvent* ac);
     static result_t openSmtp(exlib::string url, int32_t timeout, obj_ptr<Smtp_base>& retVal, AsyncEvent* ac);
     static result_t backend(exlib::string& retVal);
+    static result_t recvStats(v8::Local<v8::Object>& retVal);
+    static result_t acceptStats(v8::Local<v8::Object>& retVal);
+    static result_t ioStats(v8::Local<v8::Object>& retVal);
     static result_t isIP(exlib::string ip, int32_t& retVal);
     static result_t isIPv4(exlib::string ip, bool& retVal);
     static result_t isIPv6(exlib::string ip, bool& retVal);
@@ -61,6 +69,11 @@ public:
 public:
     static void s_static_get_use_uv_socket(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_use_uv_socket(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_static_get_io_threads(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_static_get_reuse_port(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_static_set_reuse_port(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_static_get_accept_batch(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_static_set_accept_batch(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_info(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_resolve(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_ip(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -68,6 +81,9 @@ public:
     static void s_static_connect(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_openSmtp(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_backend(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_recvStats(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_acceptStats(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_ioStats(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_isIP(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_isIPv4(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_isIPv6(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -103,6 +119,9 @@ inline ClassInfo& net_base::class_info()
         { "openSmtp", s_static_openSmtp, true, true },
         { "openSmtpSync", s_static_openSmtp, true, false },
         { "backend", s_static_backend, true, false },
+        { "recvStats", s_static_recvStats, true, false },
+        { "acceptStats", s_static_acceptStats, true, false },
+        { "ioStats", s_static_ioStats, true, false },
         { "isIP", s_static_isIP, true, false },
         { "isIPv4", s_static_isIPv4, true, false },
         { "isIPv6", s_static_isIPv6, true, false }
@@ -116,7 +135,10 @@ inline ClassInfo& net_base::class_info()
     };
 
     static ClassData::ClassProperty s_property[] = {
-        { "use_uv_socket", s_static_get_use_uv_socket, s_static_set_use_uv_socket, true }
+        { "use_uv_socket", s_static_get_use_uv_socket, s_static_set_use_uv_socket, true },
+        { "io_threads", s_static_get_io_threads, block_set, true },
+        { "reuse_port", s_static_get_reuse_port, s_static_set_reuse_port, true },
+        { "accept_batch", s_static_get_accept_batch, s_static_set_accept_batch, true }
     };
 
     static ClassData::ClassConst s_const[] = {
@@ -159,6 +181,64 @@ inline void net_base::s_static_set_use_uv_socket(v8::Local<v8::Name> property, v
     PROPERTY_SET_LEAVE();
 }
 
+inline void net_base::s_static_get_io_threads(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("net.io_threads");
+    PROPERTY_ENTER();
+
+    hr = get_io_threads(vr);
+
+    METHOD_RETURN();
+}
+
+inline void net_base::s_static_get_reuse_port(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_NAME("net.reuse_port");
+    PROPERTY_ENTER();
+
+    hr = get_reuse_port(vr);
+
+    METHOD_RETURN();
+}
+
+inline void net_base::s_static_set_reuse_port(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("net.reuse_port");
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = set_reuse_port(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void net_base::s_static_get_accept_batch(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_NAME("net.accept_batch");
+    PROPERTY_ENTER();
+
+    hr = get_accept_batch(vr);
+
+    METHOD_RETURN();
+}
+
+inline void net_base::s_static_set_accept_batch(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_NAME("net.accept_batch");
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = set_accept_batch(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void net_base::s_static_info(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     v8::Local<v8::Object> vr;
@@ -285,6 +365,48 @@ inline void net_base::s_static_backend(const v8::FunctionCallbackInfo<v8::Value>
     METHOD_RETURN();
 }
 
+inline void net_base::s_static_recvStats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_NAME("net.recvStats");
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = recvStats(vr);
+
+    METHOD_RETURN();
+}
+
+inline void net_base::s_static_acceptStats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_NAME("net.acceptStats");
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = acceptStats(vr);
+
+    METHOD_RETURN();
+}
+
+inline void net_base::s_static_ioStats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_NAME("net.ioStats");
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = ioStats(vr);
+
+    METHOD_RETURN();
+}
+
 inline void net_base::s_static_isIP(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     int32_t vr;
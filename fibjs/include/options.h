@@ -26,6 +26,10 @@ extern bool g_ssldump;
 extern exlib::string g_exec_code;
 
 extern bool g_uv_socket;
+extern bool g_reuse_port;
+extern int32_t g_io_threads;
+extern int32_t g_accept_batch;
+extern bool g_io_uring;
 
 struct OptData {
     const char* name;
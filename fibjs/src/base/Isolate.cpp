@@ -17,6 +17,7 @@
 #include "SandBox.h"
 #include "TTYStream.h"
 #include "EventEmitter.h"
+#include "SlabAllocator.h"
 #include "v8/include/libplatform/libplatform.h"
 
 using namespace v8;
@@ -105,12 +106,18 @@ public:
 
     virtual void* AllocateUninitialized(size_t length)
     {
+        if (length <= SLAB_MAX_SIZE)
+            return SlabAllocator::alloc(length);
+
         return exlib::string::Buffer::New(length)->data();
     }
 
-    virtual void Free(void* data, size_t)
+    virtual void Free(void* data, size_t length)
     {
-        exlib::string::Buffer::fromData((char*)data)->unref();
+        if (length <= SLAB_MAX_SIZE)
+            SlabAllocator::free(data, length);
+        else
+            exlib::string::Buffer::fromData((char*)data)->unref();
     }
 };
 
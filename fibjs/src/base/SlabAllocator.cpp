@@ -0,0 +1,485 @@
+/*
+ * SlabAllocator.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "SlabAllocator.h"
+#include <exlib/include/thread.h>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace fibjs {
+
+SlabAllocator::Stats SlabAllocator::s_stats;
+
+struct SlabNode {
+    SlabNode* next;
+};
+
+// lives in the first block of its chunk, only the depot touches it and only under the depot lock
+struct SlabChunk {
+    SlabNode* free;
+    SlabChunk* prev;
+    SlabChunk* next;
+    int32_t nfree;
+    int32_t total;
+};
+
+static size_t chunk_size(int32_t cls)
+{
+    size_t sz = SlabAllocator::class_size(cls) * SLAB_CHUNK_BLOCKS;
+    return sz > SLAB_CHUNK_SIZE ? sz : SLAB_CHUNK_SIZE;
+}
+
+static void* chunk_alloc(size_t sz)
+{
+#ifdef _WIN32
+    return _aligned_malloc(sz, sz);
+#else
+    void* p;
+
+    if (posix_memalign(&p, sz, sz))
+        return NULL;
+    return p;
+#endif
+}
+
+static void chunk_free(void* p)
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    ::free(p);
+#endif
+}
+
+class SlabDepot {
+public:
+    SlabDepot()
+        : m_cls(0)
+        , m_head(NULL)
+        , m_tail(NULL)
+        , m_empty(0)
+    {
+    }
+
+public:
+    int32_t get(SlabNode*& head, int32_t cnt)
+    {
+        int32_t n = 0;
+
+        m_lock.lock();
+        while (n < cnt && m_head) {
+            SlabChunk* c = m_head;
+
+            if (c->nfree == c->total)
+                m_empty--;
+
+            while (n < cnt && c->free) {
+                SlabNode* node = c->free;
+
+                c->free = node->next;
+                c->nfree--;
+                node->next = head;
+                head = node;
+                n++;
+            }
+
+            if (!c->free)
+                unlink(c);
+        }
+        m_lock.unlock();
+
+        if (n == 0)
+            n = carve(head, cnt);
+
+        return n;
+    }
+
+    void put(SlabNode* first)
+    {
+        SlabChunk* released = NULL;
+        size_t mask = ~(chunk_size(m_cls) - 1);
+
+        m_lock.lock();
+        while (first) {
+            SlabNode* node = first;
+            SlabChunk* c = (SlabChunk*)((uintptr_t)node & mask);
+
+            first = node->next;
+
+            node->next = c->free;
+            c->free = node;
+            if (c->nfree++ == 0)
+                push_front(c);
+
+            if (c->nfree == c->total) {
+                // an empty chunk goes to the back so partly used chunks are drained first
+                unlink(c);
+                if (m_empty < SLAB_SPARE_CHUNKS) {
+                    push_back(c);
+                    m_empty++;
+                } else {
+                    c->next = released;
+                    released = c;
+                }
+            }
+        }
+        m_lock.unlock();
+
+        release(released);
+    }
+
+    void trim()
+    {
+        SlabChunk* released = NULL;
+        SlabChunk* c;
+
+        m_lock.lock();
+        c = m_head;
+        while (c) {
+            SlabChunk* next = c->next;
+
+            if (c->nfree == c->total) {
+                unlink(c);
+                m_empty--;
+                c->next = released;
+                released = c;
+            }
+
+            c = next;
+        }
+        m_lock.unlock();
+
+        release(released);
+    }
+
+public:
+    int32_t m_cls;
+
+private:
+    int32_t carve(SlabNode*& head, int32_t cnt)
+    {
+        size_t blk = SlabAllocator::class_size(m_cls);
+        size_t sz = chunk_size(m_cls);
+        char* base = (char*)chunk_alloc(sz);
+        SlabChunk* c = (SlabChunk*)base;
+        int32_t n = 0;
+        size_t i;
+
+        if (base == NULL)
+            return 0;
+
+        SlabAllocator::s_stats.reserved.fetch_add(sz, std::memory_order_relaxed);
+
+        // block 0 holds the chunk header
+        c->free = NULL;
+        c->prev = c->next = NULL;
+        c->total = (int32_t)(sz / blk) - 1;
+        c->nfree = 0;
+
+        for (i = sz - blk; i >= blk; i -= blk) {
+            SlabNode* node = (SlabNode*)(base + i);
+
+            if (n < cnt) {
+                node->next = head;
+                head = node;
+                n++;
+            } else {
+                node->next = c->free;
+                c->free = node;
+                c->nfree++;
+            }
+        }
+
+        if (c->free) {
+            m_lock.lock();
+            push_front(c);
+            m_lock.unlock();
+        }
+
+        return n;
+    }
+
+    void release(SlabChunk* c)
+    {
+        size_t sz = chunk_size(m_cls);
+
+        while (c) {
+            SlabChunk* next = c->next;
+
+            chunk_free(c);
+            SlabAllocator::s_stats.reserved.fetch_sub(sz, std::memory_order_relaxed);
+            SlabAllocator::s_stats.released.fetch_add(1, std::memory_order_relaxed);
+            c = next;
+        }
+    }
+
+    void push_front(SlabChunk* c)
+    {
+        c->prev = NULL;
+        c->next = m_head;
+        if (m_head)
+            m_head->prev = c;
+        else
+            m_tail = c;
+        m_head = c;
+    }
+
+    void push_back(SlabChunk* c)
+    {
+        c->next = NULL;
+        c->prev = m_tail;
+        if (m_tail)
+            m_tail->next = c;
+        else
+            m_head = c;
+        m_tail = c;
+    }
+
+    void unlink(SlabChunk* c)
+    {
+        if (c->prev)
+            c->prev->next = c->next;
+        else
+            m_head = c->next;
+
+        if (c->next)
+            c->next->prev = c->prev;
+        else
+            m_tail = c->prev;
+
+        c->prev = c->next = NULL;
+    }
+
+private:
+    exlib::spinlock m_lock;
+    SlabChunk* m_head;
+    SlabChunk* m_tail;
+    int32_t m_empty;
+};
+
+// never destroyed, blocks freed while the process exits still have a depot to go back to
+static SlabDepot* depots()
+{
+    static SlabDepot* s_depots = []() {
+        SlabDepot* d = new SlabDepot[SLAB_CLASSES];
+
+        for (int32_t i = 0; i < SLAB_CLASSES; i++)
+            d[i].m_cls = i;
+
+        return d;
+    }();
+
+    return s_depots;
+}
+
+class SlabCache {
+public:
+    SlabCache()
+    {
+        int32_t i;
+
+        for (i = 0; i < SLAB_CLASSES; i++) {
+            size_t depth = SLAB_CACHE_BYTES / SlabAllocator::class_size(i);
+
+            m_head[i] = NULL;
+            m_count[i] = 0;
+            m_depth[i] = depth > SLAB_CACHE_DEPTH ? SLAB_CACHE_DEPTH : depth < 2 ? 2 : (int32_t)depth;
+        }
+    }
+
+    ~SlabCache()
+    {
+        int32_t i;
+
+        for (i = 0; i < SLAB_CLASSES; i++)
+            if (m_count[i]) {
+                depots()[i].put(m_head[i]);
+                m_head[i] = NULL;
+                m_count[i] = 0;
+            }
+    }
+
+public:
+    void* get(int32_t cls)
+    {
+        if (m_head[cls] == NULL)
+            m_count[cls] = depots()[cls].get(m_head[cls], m_depth[cls] / 2);
+        else
+            SlabAllocator::s_stats.hits.fetch_add(1, std::memory_order_relaxed);
+
+        SlabNode* node = m_head[cls];
+        if (node) {
+            m_head[cls] = node->next;
+            m_count[cls]--;
+        }
+
+        return node;
+    }
+
+    void put(int32_t cls, void* p)
+    {
+        SlabNode* node = (SlabNode*)p;
+
+        node->next = m_head[cls];
+        m_head[cls] = node;
+
+        if (++m_count[cls] > m_depth[cls])
+            flush(cls, m_depth[cls] / 2);
+    }
+
+private:
+    void flush(int32_t cls, int32_t cnt)
+    {
+        SlabNode* first = m_head[cls];
+        SlabNode* last = first;
+        int32_t i;
+
+        for (i = 1; i < cnt; i++)
+            last = last->next;
+
+        m_head[cls] = last->next;
+        m_count[cls] -= cnt;
+
+        last->next = NULL;
+        depots()[cls].put(first);
+    }
+
+private:
+    SlabNode* m_head[SLAB_CLASSES];
+    int32_t m_count[SLAB_CLASSES];
+    int32_t m_depth[SLAB_CLASSES];
+};
+
+// the cache pointer and the closed flag are trivially destructible, so they stay usable while the
+// thread tears down, a block freed after the cache is gone goes straight to its depot
+static thread_local SlabCache* s_cache = NULL;
+static thread_local bool s_cache_closed = false;
+
+class SlabCacheGuard {
+public:
+    ~SlabCacheGuard()
+    {
+        SlabCache* cache = s_cache;
+
+        s_cache = NULL;
+        s_cache_closed = true;
+        delete cache;
+    }
+};
+
+static thread_local SlabCacheGuard s_cache_guard;
+
+static SlabCache* cache()
+{
+    if (s_cache == NULL && !s_cache_closed) {
+        // touching the guard registers its destructor for this thread
+        (void)&s_cache_guard;
+        s_cache = new SlabCache();
+    }
+
+    return s_cache;
+}
+
+void* SlabAllocator::alloc(size_t sz)
+{
+    int32_t cls = size_class(sz);
+    if (cls < 0)
+        return NULL;
+
+    SlabCache* c = cache();
+    void* p;
+
+    if (c)
+        p = c->get(cls);
+    else {
+        SlabNode* head = NULL;
+
+        depots()[cls].get(head, 1);
+        p = head;
+    }
+
+    if (p) {
+        s_stats.allocs.fetch_add(1, std::memory_order_relaxed);
+        s_stats.used.fetch_add(class_size(cls), std::memory_order_relaxed);
+    }
+
+    return p;
+}
+
+void SlabAllocator::free(void* p, size_t sz)
+{
+    int32_t cls = size_class(sz);
+    SlabCache* c = cache();
+
+    s_stats.frees.fetch_add(1, std::memory_order_relaxed);
+    s_stats.used.fetch_sub(class_size(cls), std::memory_order_relaxed);
+
+    if (c)
+        c->put(cls, p);
+    else {
+        SlabNode* node = (SlabNode*)p;
+
+        node->next = NULL;
+        depots()[cls].put(node);
+    }
+}
+
+void SlabAllocator::trim()
+{
+    int32_t i;
+
+    for (i = 0; i < SLAB_CLASSES; i++)
+        depots()[i].trim();
+}
+
+SlabBlock* SlabBlock::New(size_t sz)
+{
+    size_t total = sizeof(SlabBlock) + sz + 1;
+    SlabBlock* blk = NULL;
+    bool slab = false;
+
+    // round up to the size class so growing inside the block is free
+    int32_t cls = SlabAllocator::size_class(total);
+    if (cls >= 0) {
+        total = SlabAllocator::class_size(cls);
+        blk = (SlabBlock*)SlabAllocator::alloc(total);
+        slab = blk != NULL;
+    }
+
+    if (blk == NULL)
+        blk = (SlabBlock*)::malloc(total);
+
+    new (blk) SlabBlock();
+    blk->m_refs.store(1, std::memory_order_relaxed);
+    blk->m_slab = slab;
+    blk->m_cap = total - sizeof(SlabBlock) - 1;
+
+    return blk;
+}
+
+void SlabBlock::release()
+{
+    if (m_slab)
+        SlabAllocator::free(this, sizeof(SlabBlock) + m_cap + 1);
+    else
+        ::free(this);
+}
+
+static void block_deleter(void* data, size_t length, void* deleter_data)
+{
+    ((SlabBlock*)deleter_data)->unref();
+}
+
+std::shared_ptr<v8::BackingStore> SlabBlock::backing_store(size_t sz)
+{
+    ref();
+    return v8::ArrayBuffer::NewBackingStore(data(), sz, block_deleter, this);
+}
+}
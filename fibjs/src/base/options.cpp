@@ -32,6 +32,10 @@ bool g_tcpdump = false;
 bool g_ssldump = false;
 
 bool g_uv_socket = false;
+bool g_reuse_port = false;
+int32_t g_io_threads = 1;
+int32_t g_accept_batch = 64;
+bool g_io_uring = false;
 
 exlib::string g_exec_code;
 
@@ -57,6 +61,9 @@ static void printHelp()
          "\n"
          "  --use-uv-socket[=on|off]\n"
          "                       use uv as socket backend.\n"
+         "  --io-threads=n       number of event loop threads used by socket backend (default: 1).\n"
+         "  --use-io-uring[=on|off]\n"
+         "                       use io_uring as socket and file backend on linux.\n"
          "\n"
          "  --init               write a package.json file.\n"
          "  --install [opt] foo  install the dependencies in the local node_modules folder.\n"
@@ -119,6 +126,16 @@ void options(int32_t& pos, char* argv[])
         } else if (!qstrcmp(arg, "--use-uv-socket", 15)) {
             g_uv_socket = (arg[15] == 0 || !qstrcmp(arg + 15, "=on"));
             df++;
+        } else if (!qstrcmp(arg, "--use-io-uring", 14)) {
+            g_io_uring = (arg[14] == 0 || !qstrcmp(arg + 14, "=on"));
+            df++;
+        } else if (!qstrcmp(arg, "--io-threads=", 13)) {
+            g_io_threads = atoi(arg + 13);
+            if (g_io_threads < 1)
+                g_io_threads = 1;
+            else if (g_io_threads > 64)
+                g_io_threads = 64;
+            df++;
         } else if (!qstrcmp(arg, "--prof")) {
             g_prof = true;
             df++;
@@ -9,13 +9,25 @@
 
 #include "ifs/io.h"
 #include "ifs/fs.h"
+#include "ifs/os.h"
 #include "File.h"
+#include "Stream.h"
 #include "Buffer.h"
+#include "AsyncIO.h"
+#include "AsyncUV.h"
+#include "Socket.h"
+#include "options.h"
 
 #ifdef _WIN32
 #define pclose _pclose
 #endif
 
+#ifdef Linux
+#include <sys/syscall.h>
+#endif
+
+#define COPY_RANGE_CHUNK_SIZE (1024 * 1024 * 1024)
+
 namespace fibjs {
 
 File::~File()
@@ -33,6 +45,12 @@ result_t File::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
+#ifdef HAVE_IO_URING
+    // NOSYNC comes back on the calling fiber, the ring reads up to the end of the file by itself
+    if (g_io_uring)
+        return uring_file_read(m_fd, bytes < 0 ? STREAM_BUFF_SIZE : bytes, retVal, ac);
+#endif
+
     exlib::string strBuf;
 
     if (bytes < 0) {
@@ -160,19 +178,176 @@ result_t File::write(Buffer_base* data, AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
+#ifdef HAVE_IO_URING
+    if (g_io_uring)
+        return uring_file_write(m_fd, data, ac);
+#endif
+
     exlib::string strBuf;
     data->toString(strBuf);
 
     return Write(strBuf);
 }
 
+result_t File::writev(v8::Local<v8::Array> datas, AsyncEvent* ac)
+{
+    return stream_writev(this, datas, ac);
+}
+
 result_t File::copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal,
     AsyncEvent* ac)
+{
+    class asyncCopyRange : public AsyncState {
+    public:
+        asyncCopyRange(File* pThis, Stream_base* stm, int64_t pos, int64_t bytes,
+            int64_t& retVal, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_pThis(pThis)
+            , m_stm(stm)
+            , m_pos(pos)
+            , m_bytes(bytes)
+            , m_retVal(retVal)
+        {
+            next(copy);
+        }
+
+        ON_STATE(asyncCopyRange, copy)
+        {
+            return m_pThis->copyRange(m_stm, m_pos, m_bytes, m_retVal, next(seek));
+        }
+
+        ON_STATE(asyncCopyRange, seek)
+        {
+            if (_lseeki64(m_pThis->m_fd, m_pos + m_retVal, SEEK_SET) < 0)
+                return CHECK_ERROR(LastError());
+
+            return next();
+        }
+
+    private:
+        obj_ptr<File> m_pThis;
+        obj_ptr<Stream_base> m_stm;
+        int64_t m_pos;
+        int64_t m_bytes;
+        int64_t& m_retVal;
+    };
+
+    if (m_fd == -1)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    // zero_copy stats the file, so it waits for the async side like the seek below
+    if (!zero_copy(stm))
+        return io_base::copyStream(this, stm, bytes, retVal, ac);
+
+    int64_t pos = _lseeki64(m_fd, 0, SEEK_CUR);
+    if (pos < 0)
+        return CHECK_ERROR(LastError());
+
+    int64_t sz;
+    result_t hr = size(sz);
+    if (hr < 0)
+        return hr;
+
+    sz -= pos;
+    if (sz < 0)
+        sz = 0;
+
+    if (bytes < 0 || bytes > sz)
+        bytes = sz;
+
+    return (new asyncCopyRange(this, stm, pos, bytes, retVal, ac))->post(0);
+}
+
+bool File::zero_copy(Stream_base* stm)
+{
+#ifdef _WIN32
+    return false;
+#else
+    struct stat st;
+
+    if (m_fd == -1 || ::fstat(m_fd, &st) < 0 || !S_ISREG(st.st_mode))
+        return false;
+
+    if (dynamic_cast<Socket*>(stm))
+        return true;
+
+    File* file = dynamic_cast<File*>(stm);
+    return file && file->m_fd != -1;
+#endif
+}
+
+result_t File::copyRange(Stream_base* stm, int64_t pos, int64_t bytes, int64_t& retVal,
+    AsyncEvent* ac)
 {
     if (m_fd == -1)
         return CHECK_ERROR(CALL_E_INVALID_CALL);
 
-    return io_base::copyStream(this, stm, bytes, retVal, ac);
+#ifndef _WIN32
+    Socket* sock = dynamic_cast<Socket*>(stm);
+    if (sock)
+        return sock->sendfile(m_fd, pos, bytes, retVal, ac);
+
+    File* file = dynamic_cast<File*>(stm);
+    if (file) {
+        if (file->m_fd == -1)
+            return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+        if (ac->isSync())
+            return CHECK_ERROR(CALL_E_NOSYNC);
+
+        retVal = 0;
+
+#if defined(Linux) && defined(__NR_copy_file_range)
+        while (bytes > 0) {
+            loff_t off = pos;
+            size_t sz = bytes > COPY_RANGE_CHUNK_SIZE ? COPY_RANGE_CHUNK_SIZE : (size_t)bytes;
+            ssize_t n = syscall(__NR_copy_file_range, m_fd, &off, file->m_fd, NULL, sz, 0);
+
+            if (n < 0) {
+                int32_t nError = errno;
+                if (retVal == 0 && (nError == ENOSYS || nError == EXDEV || nError == EINVAL || nError == EOPNOTSUPP || nError == EBADF))
+                    break;
+                return CHECK_ERROR(-nError);
+            }
+
+            if (n == 0)
+                return 0;
+
+            pos += n;
+            bytes -= n;
+            retVal += n;
+        }
+#endif
+
+        exlib::string strBuf;
+        strBuf.resize(STREAM_BUFF_SIZE);
+
+        while (bytes > 0) {
+            char* p = strBuf.c_buffer();
+            ssize_t n = ::pread(m_fd, p, bytes > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : (size_t)bytes, pos);
+
+            if (n < 0)
+                return CHECK_ERROR(LastError());
+            if (n == 0)
+                break;
+
+            result_t hr = file->Write(p, (int32_t)n);
+            if (hr < 0)
+                return hr;
+
+            pos += n;
+            bytes -= n;
+            retVal += n;
+        }
+
+        return 0;
+    }
+#endif
+
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
 }
 
 result_t File::open(exlib::string fname, exlib::string flags)
@@ -182,6 +357,42 @@ result_t File::open(exlib::string fname, exlib::string flags)
     return file_open(fname, flags, 0666, m_fd);
 }
 
+result_t TempFile::open(exlib::string prefix)
+{
+    static exlib::atomic s_seq;
+    exlib::string dir;
+    char buf[64];
+    result_t hr;
+
+    close();
+
+    hr = os_base::tmpdir(dir);
+    if (hr < 0)
+        return hr;
+
+    snprintf(buf, sizeof(buf), "%d-%d-%lld", (int32_t)uv_os_getpid(), (int32_t)s_seq.inc(),
+        (long long)uv_hrtime());
+    name = dir;
+    name.append(1, PATH_SLASH);
+    name.append(prefix);
+    name.append(buf);
+
+#ifdef _WIN32
+    m_fd = _wopen(UTF8_W(name), _O_BINARY | _O_CREAT | _O_EXCL | _O_RDWR | _O_TEMPORARY,
+        _S_IREAD | _S_IWRITE);
+#else
+    m_fd = ::open(name.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+#endif
+    if (m_fd < 0)
+        return CHECK_ERROR(LastError());
+
+#ifndef _WIN32
+    ::unlink(name.c_str());
+#endif
+
+    return 0;
+}
+
 result_t File::get_name(exlib::string& retVal)
 {
     if (m_fd == -1)
@@ -391,16 +391,11 @@ result_t Buffer::get_byteOffset(int32_t& retVal)
     return 0;
 }
 
-static void _deleter(void* data, size_t length, void* deleter_data)
-{
-    exlib::string::Buffer::fromData((char*)data)->unref();
-}
-
 result_t Buffer::get_buffer(v8::Local<v8::ArrayBuffer>& retVal)
 {
-    char* buf = exlib::string::Buffer::New(m_data.length(), m_data.c_str(), m_data.length())->data();
-    std::shared_ptr<v8::BackingStore> store = v8::ArrayBuffer::NewBackingStore(buf, m_data.length(), _deleter, 0);
-    retVal = v8::ArrayBuffer::New(holder()->m_isolate, store);
+    size_t len = m_data.length();
+
+    retVal = v8::ArrayBuffer::New(holder()->m_isolate, m_data.block()->backing_store(len));
     return 0;
 }
 
@@ -1052,12 +1047,10 @@ result_t Buffer::slice(int32_t start, int32_t end, obj_ptr<Buffer_base>& retVal)
     if (start > end)
         start = end;
 
-    obj_ptr<Buffer> pNew = new Buffer();
-    if (start < end) {
-        pNew->m_data.append(m_data.c_str() + start, end - start);
-        pNew->extMemory((int32_t)(end - start));
-    }
-    retVal = pNew;
+    if (start < end)
+        retVal = new Buffer(m_data.c_str() + start, end - start);
+    else
+        retVal = new Buffer();
 
     return 0;
 }
@@ -1192,7 +1185,7 @@ result_t Buffer::forEach(v8::Local<v8::Function> callback, v8::Local<v8::Value>
 
 result_t Buffer::toString(exlib::string& retVal)
 {
-    retVal = m_data;
+    retVal = m_data.str();
     return 0;
 }
 
@@ -1216,7 +1209,7 @@ result_t Buffer::toString(exlib::string codec, int32_t offset, exlib::string& re
         str.append(m_data.c_str() + offset, length - offset);
         return commonEncode(codec, str, retVal);
     } else {
-        return commonEncode(codec, m_data, retVal);
+        return commonEncode(codec, m_data.str(), retVal);
     }
 }
 
@@ -1243,7 +1236,7 @@ result_t Buffer::toString(exlib::string codec, int32_t offset, int32_t end, exli
         str.append(m_data.c_str() + offset, end - offset);
         return commonEncode(codec, str, retVal);
     } else {
-        return commonEncode(codec, m_data, retVal);
+        return commonEncode(codec, m_data.str(), retVal);
     }
 }
 
@@ -1318,7 +1311,92 @@ result_t Buffer::fromJSON(Isolate* isolate, v8::Local<v8::Value> data, v8::Local
 
 result_t Buffer::unbind(obj_ptr<object_base>& retVal)
 {
-    retVal = new Buffer(m_data);
+    retVal = new Buffer(m_data.str());
     return 0;
 }
+
+void BufferData::assign(const char* p, size_t n)
+{
+    SlabBlock* blk = SlabBlock::New(n);
+
+    if (p)
+        memcpy(blk->data(), p, n);
+    blk->data()[n] = 0;
+
+    if (m_block)
+        m_block->unref();
+    m_str.clear();
+
+    m_block = blk;
+    m_len = n;
+}
+
+void BufferData::resize(size_t n)
+{
+    if (!m_block) {
+        m_str.resize(n);
+        return;
+    }
+
+    if (n > m_block->capacity()) {
+        size_t cap = m_block->capacity() * 2;
+        SlabBlock* blk = SlabBlock::New(cap > n ? cap : n);
+
+        memcpy(blk->data(), m_block->data(), m_len);
+        m_block->unref();
+        m_block = blk;
+    }
+
+    m_len = n;
+    m_block->data()[n] = 0;
+}
+
+void BufferData::append(const char* p, size_t n)
+{
+    if (!m_block) {
+        m_str.append(p, n);
+        return;
+    }
+
+    size_t len = m_len + n;
+
+    if (len > m_block->capacity()) {
+        size_t cap = m_block->capacity() * 2;
+        SlabBlock* blk = SlabBlock::New(cap > len ? cap : len);
+
+        // p may point into the old block, so it is released only after the copy
+        memcpy(blk->data(), m_block->data(), m_len);
+        memcpy(blk->data() + m_len, p, n);
+        m_block->unref();
+        m_block = blk;
+    } else
+        memmove(m_block->data() + m_len, p, n);
+
+    m_len = len;
+    m_block->data()[len] = 0;
+}
+
+exlib::string BufferData::str() const
+{
+    if (m_block)
+        return exlib::string(m_block->data(), m_len);
+    return m_str;
+}
+
+SlabBlock* BufferData::block()
+{
+    if (!m_block) {
+        size_t n = m_str.length();
+        SlabBlock* blk = SlabBlock::New(n);
+
+        memcpy(blk->data(), m_str.c_str(), n);
+        blk->data()[n] = 0;
+
+        m_str.clear();
+        m_block = blk;
+        m_len = n;
+    }
+
+    return m_block;
+}
 }
@@ -4,6 +4,7 @@
 #include "ifs/process.h"
 #include "ifs/base64.h"
 #include "SandBox.h"
+#include "SlabAllocator.h"
 #include <vector>
 
 namespace fibjs {
@@ -25,6 +26,7 @@ result_t global_base::get_global(v8::Local<v8::Object>& retVal)
 result_t global_base::GC()
 {
     Isolate::current()->m_isolate->LowMemoryNotification();
+    SlabAllocator::trim();
     return 0;
 }
 
@@ -0,0 +1,470 @@
+/*
+ * HPack.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "HPack.h"
+
+namespace fibjs {
+
+static const char* s_static_table[][2] = {
+    { ":authority", "" },
+    { ":method", "GET" },
+    { ":method", "POST" },
+    { ":path", "/" },
+    { ":path", "/index.html" },
+    { ":scheme", "http" },
+    { ":scheme", "https" },
+    { ":status", "200" },
+    { ":status", "204" },
+    { ":status", "206" },
+    { ":status", "304" },
+    { ":status", "400" },
+    { ":status", "404" },
+    { ":status", "500" },
+    { "accept-charset", "" },
+    { "accept-encoding", "gzip, deflate" },
+    { "accept-language", "" },
+    { "accept-ranges", "" },
+    { "accept", "" },
+    { "access-control-allow-origin", "" },
+    { "age", "" },
+    { "allow", "" },
+    { "authorization", "" },
+    { "cache-control", "" },
+    { "content-disposition", "" },
+    { "content-encoding", "" },
+    { "content-language", "" },
+    { "content-length", "" },
+    { "content-location", "" },
+    { "content-range", "" },
+    { "content-type", "" },
+    { "cookie", "" },
+    { "date", "" },
+    { "etag", "" },
+    { "expect", "" },
+    { "expires", "" },
+    { "from", "" },
+    { "host", "" },
+    { "if-match", "" },
+    { "if-modified-since", "" },
+    { "if-none-match", "" },
+    { "if-range", "" },
+    { "if-unmodified-since", "" },
+    { "last-modified", "" },
+    { "link", "" },
+    { "location", "" },
+    { "max-forwards", "" },
+    { "proxy-authenticate", "" },
+    { "proxy-authorization", "" },
+    { "range", "" },
+    { "referer", "" },
+    { "refresh", "" },
+    { "retry-after", "" },
+    { "server", "" },
+    { "set-cookie", "" },
+    { "strict-transport-security", "" },
+    { "transfer-encoding", "" },
+    { "user-agent", "" },
+    { "vary", "" },
+    { "via", "" },
+    { "www-authenticate", "" }
+};
+
+#define STATIC_TABLE_SIZE ((size_t)ARRAYSIZE(s_static_table))
+
+// RFC 7541 Appendix B, the code of every symbol and its length in bits
+static const struct {
+    uint32_t code;
+    int32_t bits;
+} s_huffman[257] = {
+    { 0x1ff8, 13 }, { 0x7fffd8, 23 }, { 0xfffffe2, 28 }, { 0xfffffe3, 28 },
+    { 0xfffffe4, 28 }, { 0xfffffe5, 28 }, { 0xfffffe6, 28 }, { 0xfffffe7, 28 },
+    { 0xfffffe8, 28 }, { 0xffffea, 24 }, { 0x3ffffffc, 30 }, { 0xfffffe9, 28 },
+    { 0xfffffea, 28 }, { 0x3ffffffd, 30 }, { 0xfffffeb, 28 }, { 0xfffffec, 28 },
+    { 0xfffffed, 28 }, { 0xfffffee, 28 }, { 0xfffffef, 28 }, { 0xffffff0, 28 },
+    { 0xffffff1, 28 }, { 0xffffff2, 28 }, { 0x3ffffffe, 30 }, { 0xffffff3, 28 },
+    { 0xffffff4, 28 }, { 0xffffff5, 28 }, { 0xffffff6, 28 }, { 0xffffff7, 28 },
+    { 0xffffff8, 28 }, { 0xffffff9, 28 }, { 0xffffffa, 28 }, { 0xffffffb, 28 },
+    { 0x14, 6 }, { 0x3f8, 10 }, { 0x3f9, 10 }, { 0xffa, 12 },
+    { 0x1ff9, 13 }, { 0x15, 6 }, { 0xf8, 8 }, { 0x7fa, 11 },
+    { 0x3fa, 10 }, { 0x3fb, 10 }, { 0xf9, 8 }, { 0x7fb, 11 },
+    { 0xfa, 8 }, { 0x16, 6 }, { 0x17, 6 }, { 0x18, 6 },
+    { 0x0, 5 }, { 0x1, 5 }, { 0x2, 5 }, { 0x19, 6 },
+    { 0x1a, 6 }, { 0x1b, 6 }, { 0x1c, 6 }, { 0x1d, 6 },
+    { 0x1e, 6 }, { 0x1f, 6 }, { 0x5c, 7 }, { 0xfb, 8 },
+    { 0x7ffc, 15 }, { 0x20, 6 }, { 0xffb, 12 }, { 0x3fc, 10 },
+    { 0x1ffa, 13 }, { 0x21, 6 }, { 0x5d, 7 }, { 0x5e, 7 },
+    { 0x5f, 7 }, { 0x60, 7 }, { 0x61, 7 }, { 0x62, 7 },
+    { 0x63, 7 }, { 0x64, 7 }, { 0x65, 7 }, { 0x66, 7 },
+    { 0x67, 7 }, { 0x68, 7 }, { 0x69, 7 }, { 0x6a, 7 },
+    { 0x6b, 7 }, { 0x6c, 7 }, { 0x6d, 7 }, { 0x6e, 7 },
+    { 0x6f, 7 }, { 0x70, 7 }, { 0x71, 7 }, { 0x72, 7 },
+    { 0xfc, 8 }, { 0x73, 7 }, { 0xfd, 8 }, { 0x1ffb, 13 },
+    { 0x7fff0, 19 }, { 0x1ffc, 13 }, { 0x3ffc, 14 }, { 0x22, 6 },
+    { 0x7ffd, 15 }, { 0x3, 5 }, { 0x23, 6 }, { 0x4, 5 },
+    { 0x24, 6 }, { 0x5, 5 }, { 0x25, 6 }, { 0x26, 6 },
+    { 0x27, 6 }, { 0x6, 5 }, { 0x74, 7 }, { 0x75, 7 },
+    { 0x28, 6 }, { 0x29, 6 }, { 0x2a, 6 }, { 0x7, 5 },
+    { 0x2b, 6 }, { 0x76, 7 }, { 0x2c, 6 }, { 0x8, 5 },
+    { 0x9, 5 }, { 0x2d, 6 }, { 0x77, 7 }, { 0x78, 7 },
+    { 0x79, 7 }, { 0x7a, 7 }, { 0x7b, 7 }, { 0x7ffe, 15 },
+    { 0x7fc, 11 }, { 0x3ffd, 14 }, { 0x1ffd, 13 }, { 0xffffffc, 28 },
+    { 0xfffe6, 20 }, { 0x3fffd2, 22 }, { 0xfffe7, 20 }, { 0xfffe8, 20 },
+    { 0x3fffd3, 22 }, { 0x3fffd4, 22 }, { 0x3fffd5, 22 }, { 0x7fffd9, 23 },
+    { 0x3fffd6, 22 }, { 0x7fffda, 23 }, { 0x7fffdb, 23 }, { 0x7fffdc, 23 },
+    { 0x7fffdd, 23 }, { 0x7fffde, 23 }, { 0xffffeb, 24 }, { 0x7fffdf, 23 },
+    { 0xffffec, 24 }, { 0xffffed, 24 }, { 0x3fffd7, 22 }, { 0x7fffe0, 23 },
+    { 0xffffee, 24 }, { 0x7fffe1, 23 }, { 0x7fffe2, 23 }, { 0x7fffe3, 23 },
+    { 0x7fffe4, 23 }, { 0x1fffdc, 21 }, { 0x3fffd8, 22 }, { 0x7fffe5, 23 },
+    { 0x3fffd9, 22 }, { 0x7fffe6, 23 }, { 0x7fffe7, 23 }, { 0xffffef, 24 },
+    { 0x3fffda, 22 }, { 0x1fffdd, 21 }, { 0xfffe9, 20 }, { 0x3fffdb, 22 },
+    { 0x3fffdc, 22 }, { 0x7fffe8, 23 }, { 0x7fffe9, 23 }, { 0x1fffde, 21 },
+    { 0x7fffea, 23 }, { 0x3fffdd, 22 }, { 0x3fffde, 22 }, { 0xfffff0, 24 },
+    { 0x1fffdf, 21 }, { 0x3fffdf, 22 }, { 0x7fffeb, 23 }, { 0x7fffec, 23 },
+    { 0x1fffe0, 21 }, { 0x1fffe1, 21 }, { 0x3fffe0, 22 }, { 0x1fffe2, 21 },
+    { 0x7fffed, 23 }, { 0x3fffe1, 22 }, { 0x7fffee, 23 }, { 0x7fffef, 23 },
+    { 0xfffea, 20 }, { 0x3fffe2, 22 }, { 0x3fffe3, 22 }, { 0x3fffe4, 22 },
+    { 0x7ffff0, 23 }, { 0x3fffe5, 22 }, { 0x3fffe6, 22 }, { 0x7ffff1, 23 },
+    { 0x3ffffe0, 26 }, { 0x3ffffe1, 26 }, { 0xfffeb, 20 }, { 0x7fff1, 19 },
+    { 0x3fffe7, 22 }, { 0x7ffff2, 23 }, { 0x3fffe8, 22 }, { 0x1ffffec, 25 },
+    { 0x3ffffe2, 26 }, { 0x3ffffe3, 26 }, { 0x3ffffe4, 26 }, { 0x7ffffde, 27 },
+    { 0x7ffffdf, 27 }, { 0x3ffffe5, 26 }, { 0xfffff1, 24 }, { 0x1ffffed, 25 },
+    { 0x7fff2, 19 }, { 0x1fffe3, 21 }, { 0x3ffffe6, 26 }, { 0x7ffffe0, 27 },
+    { 0x7ffffe1, 27 }, { 0x3ffffe7, 26 }, { 0x7ffffe2, 27 }, { 0xfffff2, 24 },
+    { 0x1fffe4, 21 }, { 0x1fffe5, 21 }, { 0x3ffffe8, 26 }, { 0x3ffffe9, 26 },
+    { 0xffffffd, 28 }, { 0x7ffffe3, 27 }, { 0x7ffffe4, 27 }, { 0x7ffffe5, 27 },
+    { 0xfffec, 20 }, { 0xfffff3, 24 }, { 0xfffed, 20 }, { 0x1fffe6, 21 },
+    { 0x3fffe9, 22 }, { 0x1fffe7, 21 }, { 0x1fffe8, 21 }, { 0x7ffff3, 23 },
+    { 0x3fffea, 22 }, { 0x3fffeb, 22 }, { 0x1ffffee, 25 }, { 0x1ffffef, 25 },
+    { 0xfffff4, 24 }, { 0xfffff5, 24 }, { 0x3ffffea, 26 }, { 0x7ffff4, 23 },
+    { 0x3ffffeb, 26 }, { 0x7ffffe6, 27 }, { 0x3ffffec, 26 }, { 0x3ffffed, 26 },
+    { 0x7ffffe7, 27 }, { 0x7ffffe8, 27 }, { 0x7ffffe9, 27 }, { 0x7ffffea, 27 },
+    { 0x7ffffeb, 27 }, { 0xffffffe, 28 }, { 0x7ffffec, 27 }, { 0x7ffffed, 27 },
+    { 0x7ffffee, 27 }, { 0x7ffffef, 27 }, { 0x7fffff0, 27 }, { 0x3ffffee, 26 },
+    { 0x3fffffff, 30 }
+};
+
+#define HUFFMAN_EOS 256
+#define HUFFMAN_MAX_BITS 30
+
+// the code is canonical, so a code of a given length decodes by its offset from the first code of that length
+class huffman_table {
+public:
+    huffman_table()
+    {
+        int32_t count[HUFFMAN_MAX_BITS + 1] = { 0 };
+        int32_t i, len;
+
+        for (i = 0; i < 257; i++)
+            count[s_huffman[i].bits]++;
+
+        int32_t pos = 0;
+        for (len = 1; len <= HUFFMAN_MAX_BITS; len++) {
+            m_base[len] = pos;
+            m_count[len] = count[len];
+            pos += count[len];
+        }
+
+        for (len = 1; len <= HUFFMAN_MAX_BITS; len++) {
+            int32_t n = m_base[len];
+
+            m_first[len] = 0xffffffff;
+            for (i = 0; i < 257; i++)
+                if (s_huffman[i].bits == len) {
+                    if (n == m_base[len])
+                        m_first[len] = s_huffman[i].code;
+                    m_syms[n++] = (int16_t)i;
+                }
+        }
+    }
+
+public:
+    uint32_t m_first[HUFFMAN_MAX_BITS + 1];
+    int32_t m_base[HUFFMAN_MAX_BITS + 1];
+    int32_t m_count[HUFFMAN_MAX_BITS + 1];
+    int16_t m_syms[257];
+};
+
+static huffman_table s_table;
+
+bool HPack::huffman_decode(const char* data, size_t sz, exlib::string& retVal)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    uint32_t code = 0;
+    int32_t len = 0;
+    size_t i;
+    int32_t b;
+
+    retVal.clear();
+    retVal.reserve(sz * 8 / 5);
+
+    for (i = 0; i < sz; i++)
+        for (b = 7; b >= 0; b--) {
+            code = (code << 1) | ((p[i] >> b) & 1);
+            len++;
+
+            uint32_t off = code - s_table.m_first[len];
+            if (s_table.m_count[len] && code >= s_table.m_first[len]
+                && off < (uint32_t)s_table.m_count[len]) {
+                int32_t sym = s_table.m_syms[s_table.m_base[len] + off];
+                if (sym == HUFFMAN_EOS)
+                    return false;
+
+                retVal.append(1, (char)sym);
+                code = 0;
+                len = 0;
+            } else if (len >= HUFFMAN_MAX_BITS)
+                return false;
+        }
+
+    // the padding is a prefix of EOS, i.e. at most 7 one bits
+    return len < 8 && code == ((1u << len) - 1);
+}
+
+size_t HPack::huffman_size(const exlib::string& s)
+{
+    const uint8_t* p = (const uint8_t*)s.c_str();
+    size_t bits = 0;
+    size_t i;
+
+    for (i = 0; i < s.length(); i++)
+        bits += s_huffman[p[i]].bits;
+
+    return (bits + 7) / 8;
+}
+
+void HPack::huffman_encode(const exlib::string& s, exlib::string& out)
+{
+    const uint8_t* p = (const uint8_t*)s.c_str();
+    uint64_t acc = 0;
+    int32_t bits = 0;
+    size_t i;
+
+    for (i = 0; i < s.length(); i++) {
+        acc = (acc << s_huffman[p[i]].bits) | s_huffman[p[i]].code;
+        bits += s_huffman[p[i]].bits;
+
+        while (bits >= 8) {
+            bits -= 8;
+            out.append(1, (char)(acc >> bits));
+        }
+    }
+
+    if (bits > 0)
+        out.append(1, (char)((acc << (8 - bits)) | (0xff >> bits)));
+}
+
+void HPack::encode_int(exlib::string& out, uint8_t prefix, int32_t bits, size_t v)
+{
+    size_t mask = (1 << bits) - 1;
+
+    if (v < mask) {
+        out.append(1, (char)(prefix | v));
+        return;
+    }
+
+    out.append(1, (char)(prefix | mask));
+    v -= mask;
+    while (v >= 0x80) {
+        out.append(1, (char)((v & 0x7f) | 0x80));
+        v >>= 7;
+    }
+    out.append(1, (char)v);
+}
+
+void HPack::encode_str(exlib::string& out, const exlib::string& s)
+{
+    size_t sz = huffman_size(s);
+
+    if (sz < s.length()) {
+        encode_int(out, 0x80, 7, sz);
+        huffman_encode(s, out);
+    } else {
+        encode_int(out, 0, 7, s.length());
+        out.append(s);
+    }
+}
+
+static bool decode_int(const uint8_t*& p, const uint8_t* end, int32_t bits, size_t& v)
+{
+    size_t mask = (1 << bits) - 1;
+    int32_t shift = 0;
+
+    v = *p++ & mask;
+    if (v < mask)
+        return true;
+
+    while (p < end) {
+        uint8_t b = *p++;
+
+        v += (size_t)(b & 0x7f) << shift;
+        if (!(b & 0x80))
+            return true;
+
+        shift += 7;
+        if (shift > 28)
+            return false;
+    }
+
+    return false;
+}
+
+static bool decode_str(const uint8_t*& p, const uint8_t* end, exlib::string& retVal)
+{
+    bool huffman;
+    size_t sz;
+
+    if (p >= end)
+        return false;
+
+    huffman = (*p & 0x80) != 0;
+    if (!decode_int(p, end, 7, sz) || sz > (size_t)(end - p))
+        return false;
+
+    if (huffman) {
+        if (!HPack::huffman_decode((const char*)p, sz, retVal))
+            return false;
+    } else
+        retVal.assign((const char*)p, sz);
+
+    p += sz;
+    return true;
+}
+
+bool HPack::Decoder::get(size_t idx, header& retVal)
+{
+    if (idx == 0)
+        return false;
+
+    if (idx <= STATIC_TABLE_SIZE) {
+        retVal.first = s_static_table[idx - 1][0];
+        retVal.second = s_static_table[idx - 1][1];
+        return true;
+    }
+
+    idx -= STATIC_TABLE_SIZE + 1;
+    if (idx >= m_table.size())
+        return false;
+
+    retVal = m_table[idx];
+    return true;
+}
+
+void HPack::Decoder::evict(size_t max)
+{
+    while (m_size > max) {
+        header& h = m_table.back();
+
+        m_size -= h.first.length() + h.second.length() + 32;
+        m_table.pop_back();
+    }
+}
+
+void HPack::Decoder::add(header& h)
+{
+    size_t sz = h.first.length() + h.second.length() + 32;
+
+    // an entry larger than the table empties it and is not added
+    if (sz > m_max) {
+        evict(0);
+        return;
+    }
+
+    evict(m_max - sz);
+    m_table.push_front(h);
+    m_size += sz;
+}
+
+result_t HPack::Decoder::decode(const char* data, size_t sz, std::vector<header>& headers, size_t max_list)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    const uint8_t* end = p + sz;
+    bool head = true;
+    size_t list = 0;
+
+    while (p < end) {
+        uint8_t b = *p;
+        header h;
+        size_t idx;
+
+        if (b & 0x80) {
+            if (!decode_int(p, end, 7, idx) || !get(idx, h))
+                return CALL_E_INVALID_DATA;
+
+            // a one byte reference can expand to a whole table entry, so stop before storing it
+            list += h.first.length() + h.second.length() + 32;
+            if (list > max_list)
+                return CALL_E_OVERFLOW;
+
+            headers.push_back(h);
+        } else if ((b & 0xe0) == 0x20) {
+            // dynamic table size updates are only allowed at the beginning of a block
+            if (!head || !decode_int(p, end, 5, idx) || idx > m_limit)
+                return CALL_E_INVALID_DATA;
+
+            m_max = idx;
+            evict(m_max);
+            continue;
+        } else {
+            bool indexing = (b & 0x40) != 0;
+
+            if (!decode_int(p, end, indexing ? 6 : 4, idx))
+                return CALL_E_INVALID_DATA;
+
+            if (idx) {
+                if (!get(idx, h))
+                    return CALL_E_INVALID_DATA;
+            } else if (!decode_str(p, end, h.first))
+                return CALL_E_INVALID_DATA;
+
+            if (!decode_str(p, end, h.second))
+                return CALL_E_INVALID_DATA;
+
+            list += h.first.length() + h.second.length() + 32;
+            if (list > max_list)
+                return CALL_E_OVERFLOW;
+
+            headers.push_back(h);
+            if (indexing)
+                add(h);
+        }
+
+        head = false;
+    }
+
+    return 0;
+}
+
+void HPack::Encoder::encode(const std::vector<header>& headers, exlib::string& retVal)
+{
+    size_t i, j;
+
+    for (i = 0; i < headers.size(); i++) {
+        const header& h = headers[i];
+        size_t name = 0;
+
+        for (j = 0; j < STATIC_TABLE_SIZE; j++)
+            if (h.first == s_static_table[j][0]) {
+                if (h.second == s_static_table[j][1])
+                    break;
+                if (!name)
+                    name = j + 1;
+            }
+
+        if (j < STATIC_TABLE_SIZE) {
+            encode_int(retVal, 0x80, 7, j + 1);
+            continue;
+        }
+
+        // literal header field without indexing
+        encode_int(retVal, 0, 4, name);
+        if (!name)
+            encode_str(retVal, h.first);
+        encode_str(retVal, h.second);
+    }
+}
+}
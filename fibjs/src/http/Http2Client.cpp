@@ -0,0 +1,877 @@
+/*
+ * Http2Client.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "Http2Client.h"
+#include "HttpResponse.h"
+#include "HttpCollection.h"
+#include "BufferedStream.h"
+#include "Buffer.h"
+#include "MemoryStream.h"
+#include "ifs/zlib.h"
+
+namespace fibjs {
+
+void Http2Client::preface(exlib::string& buf)
+{
+    buf.assign(H2_PREFACE, H2_PREFACE_SIZE);
+
+    frame_head(buf, H2_FRAME_SETTINGS, 0, 0, 18);
+    put_setting(buf, H2_SETTINGS_ENABLE_PUSH, 0);
+    put_setting(buf, H2_SETTINGS_INITIAL_WINDOW_SIZE, H2_STREAM_WINDOW);
+    put_setting(buf, H2_SETTINGS_MAX_HEADER_LIST_SIZE, H2_MAX_HEADER_LIST);
+
+    frame_head(buf, H2_FRAME_WINDOW_UPDATE, 0, 0, 4);
+    put_u32(buf, H2_STREAM_WINDOW - H2_DEFAULT_WINDOW);
+}
+
+void Http2Client::start()
+{
+    m_in = new BufferedStream(m_stm);
+
+    Ref();
+    asyncCall(session_proc, this);
+}
+
+bool Http2Client::reserve()
+{
+    bool ok;
+
+    m_slock.lock();
+    ok = m_accept && m_active < m_max_streams && m_active < m_peer_streams;
+    if (ok)
+        m_active++;
+    m_slock.unlock();
+
+    return ok;
+}
+
+bool Http2Client::closed()
+{
+    bool ret;
+
+    m_slock.lock();
+    ret = !m_accept;
+    m_slock.unlock();
+
+    return ret;
+}
+
+bool Http2Client::idle(date_t d, int32_t timeout)
+{
+    bool ret;
+
+    m_slock.lock();
+    ret = m_active == 0 && d.diff(m_idle) >= (double)timeout;
+    m_slock.unlock();
+
+    return ret;
+}
+
+void Http2Client::refuse()
+{
+    m_slock.lock();
+    m_accept = false;
+    m_slock.unlock();
+}
+
+void Http2Client::close()
+{
+    refuse();
+    m_stm->cc_close();
+}
+
+result_t Http2Client::request(HttpRequest_base* req, SeekableStream_base* response_body, int32_t maxBodySize,
+    bool enableEncoding, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    Stream* s = new Stream(this, req, response_body, maxBodySize, enableEncoding, retVal, ac);
+
+    s->Ref();
+    asyncCall(stream_proc, s);
+
+    return CALL_E_PENDDING;
+}
+
+// the session reads frames in a worker fiber until the connection is closed
+result_t Http2Client::session_proc(Http2Client* pThis)
+{
+    obj_ptr<Http2Client> _this = pThis;
+    pThis->Unref();
+
+    pThis->process();
+    pThis->refuse();
+
+    pThis->m_lock.lock();
+    pThis->m_closed = true;
+
+    std::map<int32_t, obj_ptr<Stream>>::iterator it;
+    for (it = pThis->m_streams.begin(); it != pThis->m_streams.end(); it++) {
+        Stream* s = it->second;
+
+        if (!s->m_done) {
+            s->m_done = true;
+            s->m_hr = CALL_E_CLOSED;
+        }
+    }
+
+    pThis->m_cond.notify_all();
+    pThis->m_lock.unlock();
+
+    pThis->m_stm->cc_close();
+    return 0;
+}
+
+// every request runs in its own worker fiber, sending and then waiting for the reader to complete it
+result_t Http2Client::stream_proc(Stream* s)
+{
+    obj_ptr<Stream> _s = s;
+    obj_ptr<Http2Client> pThis = s->m_client;
+    AsyncEvent* ac = s->m_ac;
+    result_t hr;
+
+    s->Unref();
+
+    hr = pThis->send_request(s);
+
+    pThis->m_lock.lock();
+    if (hr >= 0) {
+        while (!s->m_done)
+            pThis->m_cond.wait(pThis->m_lock, -1);
+        hr = s->m_hr;
+    }
+
+    bool cancel = s->m_id && !s->m_done && !pThis->m_closed;
+    if (s->m_id)
+        pThis->m_streams.erase(s->m_id);
+    pThis->m_lock.unlock();
+
+    if (cancel)
+        pThis->rst(s->m_id, H2_CANCEL);
+
+    // CALL_E_CLOSED is left only for requests the server never saw, those are safe to send again
+    if (hr == CALL_E_OVERFLOW)
+        hr = CHECK_ERROR(Runtime::setError("HttpMessage: body is too huge."));
+    else if (hr == CALL_E_CLOSED && s->m_id && !s->m_refused)
+        hr = CHECK_ERROR(Runtime::setError("HttpClient: connection reset by HTTP/2 server."));
+    else if (hr >= 0)
+        hr = pThis->response(s);
+
+    pThis->release_body(s->m_body);
+    s->m_spill.Release();
+
+    pThis->m_slock.lock();
+    if (--pThis->m_active == 0)
+        pThis->m_idle.now();
+    pThis->m_slock.unlock();
+
+    s->m_client.Release();
+    s->m_req.Release();
+
+    ac->apost(hr);
+    return 0;
+}
+
+result_t Http2Client::process()
+{
+    exlib::string s;
+    result_t hr;
+
+    while (true) {
+        exlib::string payload;
+        int32_t len, type, flags, id;
+        int32_t code;
+
+        hr = read(9, s);
+        if (hr < 0 || hr == CALL_RETURN_NULL)
+            return hr;
+
+        const uint8_t* p = (const uint8_t*)s.c_str();
+
+        len = (p[0] << 16) | (p[1] << 8) | p[2];
+        type = p[3];
+        flags = p[4];
+        id = get_u31(s.c_str() + 5);
+
+        if (len > H2_DEFAULT_FRAME_SIZE)
+            return goaway(H2_FRAME_SIZE_ERROR);
+
+        if (len > 0) {
+            hr = read(len, payload);
+            if (hr < 0 || hr == CALL_RETURN_NULL)
+                return hr;
+        }
+
+        if (m_block_id && type != H2_FRAME_CONTINUATION)
+            return goaway(H2_PROTOCOL_ERROR);
+
+        switch (type) {
+        case H2_FRAME_DATA:
+            code = on_data(flags, id, payload);
+            break;
+        case H2_FRAME_HEADERS:
+            code = on_headers(flags, id, payload);
+            break;
+        case H2_FRAME_PRIORITY:
+            code = (id == 0) ? H2_PROTOCOL_ERROR : (len != 5 ? H2_FRAME_SIZE_ERROR : H2_NO_ERROR);
+            break;
+        case H2_FRAME_RST_STREAM:
+            code = on_rst_stream(id, payload);
+            break;
+        case H2_FRAME_SETTINGS:
+            code = on_settings(flags, id, payload);
+            break;
+        case H2_FRAME_PUSH_PROMISE:
+            // push is disabled in our SETTINGS
+            code = H2_PROTOCOL_ERROR;
+            break;
+        case H2_FRAME_PING:
+            code = on_ping(flags, id, payload);
+            break;
+        case H2_FRAME_GOAWAY:
+            code = on_goaway(id, payload);
+            break;
+        case H2_FRAME_WINDOW_UPDATE:
+            code = on_window_update(id, payload);
+            break;
+        case H2_FRAME_CONTINUATION:
+            code = on_continuation(flags, id, payload);
+            break;
+        default:
+            code = H2_NO_ERROR;
+            break;
+        }
+
+        if (code < 0)
+            return code;
+
+        if (code != H2_NO_ERROR)
+            return goaway(code);
+    }
+
+    return 0;
+}
+
+void Http2Client::finish(Stream* s, result_t hr)
+{
+    m_lock.lock();
+    if (!s->m_done) {
+        s->m_done = true;
+        s->m_hr = hr;
+    }
+    m_cond.notify_all();
+    m_lock.unlock();
+}
+
+int32_t Http2Client::on_data(int32_t flags, int32_t id, exlib::string& payload)
+{
+    int32_t len = (int32_t)payload.length();
+    size_t pos = 0;
+    size_t pad = 0;
+    obj_ptr<Stream> s;
+    result_t hr;
+
+    if (id == 0)
+        return H2_PROTOCOL_ERROR;
+
+    if (flags & H2_FLAG_PADDED) {
+        if (len < 1)
+            return H2_FRAME_SIZE_ERROR;
+
+        pad = (uint8_t)payload[0];
+        pos = 1;
+        if (pos + pad > (size_t)len)
+            return H2_PROTOCOL_ERROR;
+    }
+
+    if (len > 0) {
+        hr = window_update(0, len);
+        if (hr < 0)
+            return hr;
+    }
+
+    m_lock.lock();
+    std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it != m_streams.end())
+        s = it->second;
+    bool unopened = id >= m_next_id;
+    m_lock.unlock();
+
+    // frames for a stream we gave up on are dropped
+    if (!s || s->m_done)
+        return unopened ? H2_PROTOCOL_ERROR : H2_NO_ERROR;
+
+    if (!s->m_status) {
+        finish(s, CALL_E_INVALID_DATA);
+        return rst(id, H2_PROTOCOL_ERROR);
+    }
+
+    size_t sz = len - pos - pad;
+
+    s->m_size += sz;
+    if (s->m_maxBodySize >= 0 && s->m_size > (int64_t)s->m_maxBodySize * 1024 * 1024) {
+        release_body(s->m_body);
+        finish(s, CALL_E_OVERFLOW);
+        return rst(id, H2_CANCEL);
+    }
+
+    hr = buffer_body(s->m_body, s->m_spill, payload.c_str() + pos, sz);
+    if (hr < 0) {
+        finish(s, hr);
+        return rst(id, H2_CANCEL);
+    }
+
+    if (flags & H2_FLAG_END_STREAM)
+        finish(s, 0);
+    else if (len > 0) {
+        hr = window_update(id, len);
+        if (hr < 0)
+            return hr;
+    }
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Client::on_headers(int32_t flags, int32_t id, exlib::string& payload)
+{
+    size_t len = payload.length();
+    size_t pos = 0;
+    size_t pad = 0;
+
+    if (id == 0)
+        return H2_PROTOCOL_ERROR;
+
+    if (flags & H2_FLAG_PADDED) {
+        if (len < 1)
+            return H2_FRAME_SIZE_ERROR;
+
+        pad = (uint8_t)payload[0];
+        pos = 1;
+    }
+
+    if (flags & H2_FLAG_PRIORITY)
+        pos += 5;
+
+    if (pos + pad > len)
+        return H2_PROTOCOL_ERROR;
+
+    m_block.assign(payload.c_str() + pos, len - pos - pad);
+    m_block_id = id;
+    m_block_flags = flags;
+
+    if (flags & H2_FLAG_END_HEADERS)
+        return end_headers();
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Client::on_continuation(int32_t flags, int32_t id, exlib::string& payload)
+{
+    if (!m_block_id || id != m_block_id)
+        return H2_PROTOCOL_ERROR;
+
+    m_block.append(payload);
+    if (m_block.length() > H2_MAX_HEADER_BLOCK)
+        return H2_ENHANCE_YOUR_CALM;
+
+    if (flags & H2_FLAG_END_HEADERS)
+        return end_headers();
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Client::end_headers()
+{
+    std::vector<HPack::header> hdrs;
+    int32_t id = m_block_id;
+    bool end = (m_block_flags & H2_FLAG_END_STREAM) != 0;
+    obj_ptr<Stream> s;
+    size_t i;
+
+    m_block_id = 0;
+
+    // the block is always decoded to keep the dynamic table in step with the server
+    result_t hr = m_decoder.decode(m_block.c_str(), m_block.length(), hdrs, H2_MAX_HEADER_LIST);
+    if (hr == CALL_E_OVERFLOW)
+        return H2_ENHANCE_YOUR_CALM;
+    if (hr < 0)
+        return H2_COMPRESSION_ERROR;
+    m_block.clear();
+
+    m_lock.lock();
+    std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it != m_streams.end())
+        s = it->second;
+    bool unopened = id >= m_next_id;
+    m_lock.unlock();
+
+    if (!s || s->m_done)
+        return unopened ? H2_PROTOCOL_ERROR : H2_NO_ERROR;
+
+    // trailers, their fields are not exposed
+    if (s->m_status) {
+        if (!end)
+            return rst(id, H2_PROTOCOL_ERROR);
+
+        finish(s, 0);
+        return H2_NO_ERROR;
+    }
+
+    int32_t status = 0;
+    std::vector<HPack::header> fields;
+
+    for (i = 0; i < hdrs.size(); i++) {
+        exlib::string& name = hdrs[i].first;
+
+        if (!name.empty() && name[0] == ':') {
+            if (name != ":status" || !fields.empty()) {
+                finish(s, CALL_E_INVALID_DATA);
+                return rst(id, H2_PROTOCOL_ERROR);
+            }
+
+            status = atoi(hdrs[i].second.c_str());
+        } else
+            fields.push_back(hdrs[i]);
+    }
+
+    if (status < 100 || status > 999) {
+        finish(s, CALL_E_INVALID_DATA);
+        return rst(id, H2_PROTOCOL_ERROR);
+    }
+
+    // an interim response, the final one follows on the same stream
+    if (status < 200)
+        return H2_NO_ERROR;
+
+    s->m_status = status;
+    s->m_headers.swap(fields);
+
+    if (end)
+        finish(s, 0);
+
+    return H2_NO_ERROR;
+}
+
+result_t Http2Client::send_request(Stream* s)
+{
+    HttpRequest_base* req = s->m_req;
+    obj_ptr<HttpCollection_base> _headers;
+    std::vector<HPack::header> hdrs;
+    exlib::string method, path, query, authority;
+    obj_ptr<SeekableStream_base> body;
+    exlib::string block;
+    exlib::string buf;
+    int64_t len;
+    size_t i;
+    result_t hr;
+
+    req->get_method(method);
+    req->get_address(path);
+    req->get_queryString(query);
+    if (!query.empty()) {
+        path.append(1, '?');
+        path.append(query);
+    }
+
+    req->firstHeader("Host", authority);
+
+    hdrs.push_back(HPack::header(":method", method));
+    hdrs.push_back(HPack::header(":scheme", m_ssl ? "https" : "http"));
+    hdrs.push_back(HPack::header(":authority", authority));
+    hdrs.push_back(HPack::header(":path", path));
+
+    req->get_headers(_headers);
+    HttpCollection* headers = (HttpCollection*)(HttpCollection_base*)_headers;
+
+    for (i = 0; i < headers->count(); i++) {
+        const std::pair<exlib::string, exlib::string>& h = headers->at(i);
+        exlib::string name(h.first);
+        size_t j;
+
+        for (j = 0; j < name.length(); j++)
+            name[j] = qtolower(name[j]);
+
+        if (name == "host" || name == "connection" || name == "keep-alive" || name == "proxy-connection"
+            || name == "transfer-encoding" || name == "upgrade" || name == "content-length")
+            continue;
+
+        hdrs.push_back(HPack::header(name, h.second));
+    }
+
+    req->get_length(len);
+    if (len > 0) {
+        char num[32];
+
+        snprintf(num, sizeof(num), "%lld", (long long)len);
+        hdrs.push_back(HPack::header("content-length", num));
+    }
+
+    m_encoder.encode(hdrs, block);
+
+    bool end = len <= 0;
+    size_t pos = 0;
+
+    // ids have to rise in the order the HEADERS frames reach the wire, so both are done under m_wlock
+    m_wlock.lock();
+
+    m_lock.lock();
+    if (m_closed || m_goaway) {
+        m_lock.unlock();
+        m_wlock.unlock();
+        return CHECK_ERROR(CALL_E_CLOSED);
+    }
+
+    s->m_id = m_next_id;
+    m_next_id += 2;
+    s->m_send_window = m_init_window;
+    m_streams[s->m_id] = s;
+
+    size_t max_frame = m_max_frame;
+    m_lock.unlock();
+
+    do {
+        size_t sz = block.length() - pos;
+        int32_t flags = 0;
+
+        if (sz > max_frame)
+            sz = max_frame;
+        else
+            flags |= H2_FLAG_END_HEADERS;
+
+        if (pos == 0) {
+            if (end)
+                flags |= H2_FLAG_END_STREAM;
+            frame_head(buf, H2_FRAME_HEADERS, flags, s->m_id, sz);
+        } else
+            frame_head(buf, H2_FRAME_CONTINUATION, flags, s->m_id, sz);
+
+        buf.append(block.c_str() + pos, sz);
+        pos += sz;
+    } while (pos < block.length());
+
+    obj_ptr<Buffer_base> data = new Buffer(buf);
+    hr = m_stm->cc_write(data);
+    m_wlock.unlock();
+
+    if (hr < 0 || end)
+        return hr;
+
+    req->get_body(body);
+    body->rewind();
+
+    int64_t sent = 0;
+
+    while (sent < len) {
+        obj_ptr<Buffer_base> chunk;
+        exlib::string str;
+
+        hr = body->cc_read(H2_DEFAULT_FRAME_SIZE, chunk);
+        if (hr < 0)
+            return hr;
+        if (hr == CALL_RETURN_NULL)
+            break;
+
+        chunk->toString(str);
+        sent += str.length();
+
+        hr = send_data(s, str.c_str(), str.length(), sent >= len);
+        if (hr < 0)
+            return hr;
+    }
+
+    if (sent < len)
+        return send_data(s, NULL, 0, true);
+
+    return 0;
+}
+
+int32_t Http2Client::acquire(Stream* s, size_t want)
+{
+    int32_t n;
+
+    m_lock.lock();
+    while (!m_closed && !s->m_done && (m_send_window <= 0 || s->m_send_window <= 0))
+        m_cond.wait(m_lock, -1);
+
+    // the server may answer before it has read the whole body
+    if (m_closed || s->m_done) {
+        m_lock.unlock();
+        return s->m_done ? 0 : CALL_E_CLOSED;
+    }
+
+    n = (int32_t)want;
+    if (n > m_send_window)
+        n = (int32_t)m_send_window;
+    if (n > s->m_send_window)
+        n = (int32_t)s->m_send_window;
+    if (n > m_max_frame)
+        n = m_max_frame;
+
+    m_send_window -= n;
+    s->m_send_window -= n;
+    m_lock.unlock();
+
+    return n;
+}
+
+result_t Http2Client::send_data(Stream* s, const char* data, size_t sz, bool end)
+{
+    result_t hr;
+
+    if (sz == 0)
+        return write_frame(H2_FRAME_DATA, end ? H2_FLAG_END_STREAM : 0, s->m_id, NULL, 0);
+
+    while (sz > 0) {
+        int32_t n = acquire(s, sz);
+        if (n <= 0)
+            return n;
+
+        hr = write_frame(H2_FRAME_DATA, (end && (size_t)n == sz) ? H2_FLAG_END_STREAM : 0,
+            s->m_id, data, n);
+        if (hr < 0)
+            return hr;
+
+        data += n;
+        sz -= n;
+    }
+
+    return 0;
+}
+
+result_t Http2Client::response(Stream* s)
+{
+    obj_ptr<HttpResponse> rep = new HttpResponse();
+    obj_ptr<SeekableStream_base> body;
+    exlib::string coding;
+    size_t i;
+    result_t hr;
+
+    rep->set_protocol("HTTP/2.0");
+    rep->set_statusCode(s->m_status);
+    rep->setSocket(m_stm);
+
+    for (i = 0; i < s->m_headers.size(); i++)
+        rep->addHeader(s->m_headers[i].first, s->m_headers[i].second);
+
+    if (s->m_response_body)
+        body = s->m_response_body;
+    else if (s->m_spill)
+        body = s->m_spill;
+    else
+        body = new MemoryStream();
+
+    if (s->m_spill && s->m_response_body) {
+        int64_t sz;
+
+        s->m_spill->rewind();
+        hr = s->m_spill->cc_copyTo(body, -1, sz);
+        if (hr < 0)
+            return hr;
+    } else if (!s->m_body.empty()) {
+        obj_ptr<Buffer_base> buf = new Buffer(s->m_body);
+
+        release_body(s->m_body);
+        hr = body->cc_write(buf);
+        if (hr < 0)
+            return hr;
+    }
+    s->m_spill.Release();
+
+    body->rewind();
+    rep->set_body(body);
+
+    if (s->m_enableEncoding && !s->m_response_body
+        && rep->firstHeader("Content-Encoding", coding) != CALL_RETURN_NULL
+        && (coding == "gzip" || coding == "deflate")) {
+        obj_ptr<MemoryStream> unzip = new MemoryStream();
+
+        rep->removeHeader("Content-Encoding");
+
+        if (coding == "gzip")
+            hr = zlib_base::cc_gunzipTo(body, unzip, s->m_maxBodySize);
+        else
+            hr = zlib_base::cc_inflateRawTo(body, unzip, s->m_maxBodySize);
+        if (hr < 0)
+            return hr;
+
+        unzip->rewind();
+        rep->set_body(unzip);
+    }
+
+    s->m_retVal = rep;
+    return 0;
+}
+
+int32_t Http2Client::on_rst_stream(int32_t id, exlib::string& payload)
+{
+    if (id == 0)
+        return H2_PROTOCOL_ERROR;
+
+    if (payload.length() != 4)
+        return H2_FRAME_SIZE_ERROR;
+
+    m_lock.lock();
+    std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it != m_streams.end()) {
+        Stream* s = it->second;
+
+        s->m_reset = true;
+        if (!s->m_done) {
+            s->m_done = true;
+            s->m_refused = get_u31(payload.c_str()) == H2_REFUSED_STREAM;
+            s->m_hr = CALL_E_CLOSED;
+        }
+        m_cond.notify_all();
+    }
+    m_lock.unlock();
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Client::on_settings(int32_t flags, int32_t id, exlib::string& payload)
+{
+    const uint8_t* p = (const uint8_t*)payload.c_str();
+    size_t len = payload.length();
+    size_t i;
+
+    if (id != 0)
+        return H2_PROTOCOL_ERROR;
+
+    if (flags & H2_FLAG_ACK)
+        return len == 0 ? H2_NO_ERROR : H2_FRAME_SIZE_ERROR;
+
+    if (len % 6)
+        return H2_FRAME_SIZE_ERROR;
+
+    m_lock.lock();
+    for (i = 0; i < len; i += 6) {
+        int32_t sid = (p[i] << 8) | p[i + 1];
+        uint32_t v = ((uint32_t)p[i + 2] << 24) | (p[i + 3] << 16) | (p[i + 4] << 8) | p[i + 5];
+
+        if (sid == H2_SETTINGS_INITIAL_WINDOW_SIZE) {
+            if (v > H2_MAX_WINDOW) {
+                m_lock.unlock();
+                return H2_FLOW_CONTROL_ERROR;
+            }
+
+            int64_t delta = (int64_t)v - m_init_window;
+            std::map<int32_t, obj_ptr<Stream>>::iterator it;
+
+            for (it = m_streams.begin(); it != m_streams.end(); it++)
+                it->second->m_send_window += delta;
+            m_init_window = v;
+        } else if (sid == H2_SETTINGS_MAX_FRAME_SIZE) {
+            if (v < H2_DEFAULT_FRAME_SIZE || v > 0xffffff) {
+                m_lock.unlock();
+                return H2_PROTOCOL_ERROR;
+            }
+
+            m_max_frame = v;
+        } else if (sid == H2_SETTINGS_MAX_CONCURRENT_STREAMS) {
+            m_slock.lock();
+            m_peer_streams = v > 0x7fffffff ? 0x7fffffff : (int32_t)v;
+            m_slock.unlock();
+        }
+    }
+
+    m_cond.notify_all();
+    m_lock.unlock();
+
+    return write_frame(H2_FRAME_SETTINGS, H2_FLAG_ACK, 0, NULL, 0);
+}
+
+int32_t Http2Client::on_goaway(int32_t id, exlib::string& payload)
+{
+    if (id != 0)
+        return H2_PROTOCOL_ERROR;
+
+    if (payload.length() < 8)
+        return H2_FRAME_SIZE_ERROR;
+
+    int32_t last_id = get_u31(payload.c_str());
+
+    refuse();
+
+    // streams above last_id were never processed, the rest are still answered
+    m_lock.lock();
+    m_goaway = true;
+
+    std::map<int32_t, obj_ptr<Stream>>::iterator it;
+    for (it = m_streams.begin(); it != m_streams.end(); it++) {
+        Stream* s = it->second;
+
+        if (s->m_id > last_id && !s->m_done) {
+            s->m_done = true;
+            s->m_refused = true;
+            s->m_hr = CALL_E_CLOSED;
+        }
+    }
+
+    m_cond.notify_all();
+    m_lock.unlock();
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Client::on_window_update(int32_t id, exlib::string& payload)
+{
+    int32_t inc;
+
+    if (payload.length() != 4)
+        return H2_FRAME_SIZE_ERROR;
+
+    inc = get_u31(payload.c_str());
+
+    m_lock.lock();
+    if (id == 0) {
+        if (inc == 0 || m_send_window + inc > H2_MAX_WINDOW) {
+            m_lock.unlock();
+            return inc == 0 ? H2_PROTOCOL_ERROR : H2_FLOW_CONTROL_ERROR;
+        }
+
+        m_send_window += inc;
+    } else {
+        std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+
+        if (it != m_streams.end()) {
+            Stream* s = it->second;
+
+            if (inc == 0 || s->m_send_window + inc > H2_MAX_WINDOW) {
+                if (!s->m_done) {
+                    s->m_done = true;
+                    s->m_hr = CALL_E_INVALID_DATA;
+                }
+                m_cond.notify_all();
+                m_lock.unlock();
+
+                return rst(id, inc == 0 ? H2_PROTOCOL_ERROR : H2_FLOW_CONTROL_ERROR);
+            }
+
+            s->m_send_window += inc;
+        }
+    }
+
+    m_cond.notify_all();
+    m_lock.unlock();
+
+    return H2_NO_ERROR;
+}
+
+result_t Http2Client::goaway(int32_t code)
+{
+    exlib::string buf;
+
+    // the server never opens streams towards us
+    put_u32(buf, 0);
+    put_u32(buf, code);
+    write_frame(H2_FRAME_GOAWAY, 0, 0, buf.c_str(), buf.length());
+
+    return CHECK_ERROR(CALL_E_INVALID_DATA);
+}
+}
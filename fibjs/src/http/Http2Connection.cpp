@@ -0,0 +1,144 @@
+/*
+ * Http2Connection.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "Http2Connection.h"
+#include "Buffer.h"
+#include "File.h"
+
+namespace fibjs {
+
+void Http2Connection::frame_head(exlib::string& buf, int32_t type, int32_t flags, int32_t id, size_t sz)
+{
+    buf.append(1, (char)(sz >> 16));
+    buf.append(1, (char)(sz >> 8));
+    buf.append(1, (char)sz);
+    buf.append(1, (char)type);
+    buf.append(1, (char)flags);
+    put_u32(buf, id & 0x7fffffff);
+}
+
+result_t Http2Connection::read(int32_t bytes, exlib::string& retVal)
+{
+    obj_ptr<Buffer_base> buf;
+    result_t hr;
+
+    hr = m_in->cc_read(bytes, buf);
+    if (hr < 0 || hr == CALL_RETURN_NULL)
+        return hr;
+
+    buf->toString(retVal);
+    if ((int32_t)retVal.length() < bytes)
+        return CALL_RETURN_NULL;
+
+    return 0;
+}
+
+int32_t Http2Connection::on_ping(int32_t flags, int32_t id, exlib::string& payload)
+{
+    if (id != 0)
+        return H2_PROTOCOL_ERROR;
+
+    if (payload.length() != 8)
+        return H2_FRAME_SIZE_ERROR;
+
+    if (flags & H2_FLAG_ACK)
+        return H2_NO_ERROR;
+
+    return write_frame(H2_FRAME_PING, H2_FLAG_ACK, 0, payload.c_str(), payload.length());
+}
+
+result_t Http2Connection::write(exlib::string& buf)
+{
+    obj_ptr<Buffer_base> data = new Buffer(buf);
+    result_t hr;
+
+    m_wlock.lock();
+    hr = m_stm->cc_write(data);
+    m_wlock.unlock();
+
+    return hr;
+}
+
+result_t Http2Connection::write_frame(int32_t type, int32_t flags, int32_t id, const char* data, size_t sz)
+{
+    exlib::string buf;
+
+    frame_head(buf, type, flags, id, sz);
+    if (sz)
+        buf.append(data, sz);
+
+    return write(buf);
+}
+
+result_t Http2Connection::window_update(int32_t id, int32_t inc)
+{
+    exlib::string buf;
+
+    put_u32(buf, inc);
+    return write_frame(H2_FRAME_WINDOW_UPDATE, 0, id, buf.c_str(), buf.length());
+}
+
+result_t Http2Connection::rst(int32_t id, int32_t code)
+{
+    exlib::string buf;
+
+    put_u32(buf, code);
+    return write_frame(H2_FRAME_RST_STREAM, 0, id, buf.c_str(), buf.length());
+}
+result_t Http2Connection::buffer_body(exlib::string& body, obj_ptr<SeekableStream_base>& spill,
+    const char* data, size_t sz)
+{
+    obj_ptr<Buffer_base> buf;
+    result_t hr;
+
+    if (!spill) {
+        bool fits;
+
+        m_body_lock.lock();
+        fits = m_body_memory + (int64_t)sz <= H2_BODY_MEMORY;
+        if (fits)
+            m_body_memory += sz;
+        m_body_lock.unlock();
+
+        if (fits) {
+            body.append(data, sz);
+            return 0;
+        }
+
+        obj_ptr<TempFile> f = new TempFile();
+        hr = f->open("fibjs-body-");
+        if (hr < 0)
+            return hr;
+
+        spill = f;
+        if (!body.empty()) {
+            buf = new Buffer(body.c_str(), body.length());
+            release_body(body);
+
+            hr = spill->cc_write(buf);
+            if (hr < 0)
+                return hr;
+        }
+    }
+
+    buf = new Buffer(data, sz);
+    return spill->cc_write(buf);
+}
+
+void Http2Connection::release_body(exlib::string& body)
+{
+    if (body.empty())
+        return;
+
+    m_body_lock.lock();
+    m_body_memory -= body.length();
+    m_body_lock.unlock();
+
+    body.clear();
+}
+}
@@ -0,0 +1,988 @@
+/*
+ * Http2Session.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "Http2Session.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "Buffer.h"
+#include "ZlibStream.h"
+#include "encoding.h"
+#include "ifs/mq.h"
+
+namespace fibjs {
+
+result_t Http2Session::run(HttpRequest_base* upgrade, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    m_upgrade = upgrade;
+    m_ac = ac;
+
+    Ref();
+    asyncCall(session_proc, this);
+
+    return CALL_E_PENDDING;
+}
+
+// the session runs in a worker fiber, reading frames until the connection is closed
+result_t Http2Session::session_proc(Http2Session* pThis)
+{
+    obj_ptr<Http2Session> _this = pThis;
+    pThis->Unref();
+
+    pThis->process();
+
+    pThis->m_lock.lock();
+    pThis->m_closed = true;
+    pThis->m_cond.notify_all();
+    while (pThis->m_active > 0)
+        pThis->m_cond.wait(pThis->m_lock, -1);
+    pThis->m_streams.clear();
+    pThis->m_lock.unlock();
+
+    pThis->m_ac->apost(0);
+    return 0;
+}
+
+result_t Http2Session::process()
+{
+    exlib::string buf;
+    exlib::string s;
+    result_t hr;
+
+    frame_head(buf, H2_FRAME_SETTINGS, 0, 0, 18);
+    put_setting(buf, H2_SETTINGS_MAX_CONCURRENT_STREAMS, H2_MAX_STREAMS);
+    put_setting(buf, H2_SETTINGS_INITIAL_WINDOW_SIZE, H2_STREAM_WINDOW);
+    put_setting(buf, H2_SETTINGS_MAX_HEADER_LIST_SIZE, H2_MAX_HEADER_LIST);
+
+    frame_head(buf, H2_FRAME_WINDOW_UPDATE, 0, 0, 4);
+    put_u32(buf, H2_STREAM_WINDOW - H2_DEFAULT_WINDOW);
+
+    hr = write(buf);
+    if (hr < 0)
+        return hr;
+
+    if (m_upgrade) {
+        // HTTP2-Settings carries the client SETTINGS payload, acknowledged by the 101 response
+        exlib::string settings;
+
+        m_upgrade->firstHeader("HTTP2-Settings", s);
+        base64Decode(s.c_str(), s.length(), settings);
+        if (apply_settings(settings) != H2_NO_ERROR)
+            return goaway(H2_PROTOCOL_ERROR);
+
+        m_upgrade->removeHeader("Upgrade");
+        m_upgrade->removeHeader("HTTP2-Settings");
+        m_upgrade->set_upgrade(false);
+        m_upgrade->set_protocol("HTTP/2.0");
+
+        obj_ptr<Stream> st = new Stream(this, 1, (int32_t)m_init_window);
+        st->m_req = m_upgrade;
+        st->m_remote_closed = true;
+
+        m_lock.lock();
+        m_streams[1] = st;
+        m_last_id = 1;
+        m_lock.unlock();
+
+        m_upgrade.Release();
+        dispatch(st);
+
+        hr = read(H2_PREFACE_SIZE, s);
+        if (hr < 0 || hr == CALL_RETURN_NULL)
+            return hr;
+
+        if (s != H2_PREFACE)
+            return goaway(H2_PROTOCOL_ERROR);
+    } else {
+        // the HTTP/1.x parser has consumed "PRI * HTTP/2.0\r\n\r\n" already
+        hr = read(H2_PREFACE_SIZE - 18, s);
+        if (hr < 0 || hr == CALL_RETURN_NULL)
+            return hr;
+
+        if (s != H2_PREFACE + 18)
+            return goaway(H2_PROTOCOL_ERROR);
+    }
+
+    while (true) {
+        exlib::string payload;
+        int32_t len, type, flags, id;
+        int32_t code;
+
+        hr = read(9, s);
+        if (hr < 0 || hr == CALL_RETURN_NULL)
+            return hr;
+
+        const uint8_t* p = (const uint8_t*)s.c_str();
+
+        len = (p[0] << 16) | (p[1] << 8) | p[2];
+        type = p[3];
+        flags = p[4];
+        id = get_u31(s.c_str() + 5);
+
+        if (len > H2_DEFAULT_FRAME_SIZE)
+            return goaway(H2_FRAME_SIZE_ERROR);
+
+        if (len > 0) {
+            hr = read(len, payload);
+            if (hr < 0 || hr == CALL_RETURN_NULL)
+                return hr;
+        }
+
+        // a header block has to be finished before any other frame
+        if (m_block_id && type != H2_FRAME_CONTINUATION)
+            return goaway(H2_PROTOCOL_ERROR);
+
+        switch (type) {
+        case H2_FRAME_DATA:
+            code = on_data(flags, id, payload);
+            break;
+        case H2_FRAME_HEADERS:
+            code = on_headers(flags, id, payload);
+            break;
+        case H2_FRAME_PRIORITY:
+            code = (id == 0) ? H2_PROTOCOL_ERROR : (len != 5 ? H2_FRAME_SIZE_ERROR : H2_NO_ERROR);
+            break;
+        case H2_FRAME_RST_STREAM:
+            code = on_rst_stream(id, payload);
+            break;
+        case H2_FRAME_SETTINGS:
+            code = on_settings(flags, id, payload);
+            break;
+        case H2_FRAME_PUSH_PROMISE:
+            code = H2_PROTOCOL_ERROR;
+            break;
+        case H2_FRAME_PING:
+            code = on_ping(flags, id, payload);
+            break;
+        case H2_FRAME_GOAWAY:
+            m_lock.lock();
+            m_goaway = true;
+            m_lock.unlock();
+            code = (id == 0) ? H2_NO_ERROR : H2_PROTOCOL_ERROR;
+            break;
+        case H2_FRAME_WINDOW_UPDATE:
+            code = on_window_update(id, payload);
+            break;
+        case H2_FRAME_CONTINUATION:
+            code = on_continuation(flags, id, payload);
+            break;
+        default:
+            // unknown frame types are ignored
+            code = H2_NO_ERROR;
+            break;
+        }
+
+        if (code < 0)
+            return code;
+
+        if (code != H2_NO_ERROR)
+            return goaway(code);
+    }
+
+    return 0;
+}
+
+int32_t Http2Session::on_data(int32_t flags, int32_t id, exlib::string& payload)
+{
+    int32_t len = (int32_t)payload.length();
+    size_t pos = 0;
+    size_t pad = 0;
+    obj_ptr<Stream> s;
+    result_t hr;
+
+    if (id == 0)
+        return H2_PROTOCOL_ERROR;
+
+    if (flags & H2_FLAG_PADDED) {
+        if (len < 1)
+            return H2_FRAME_SIZE_ERROR;
+
+        pad = (uint8_t)payload[0];
+        pos = 1;
+        if (pos + pad > (size_t)len)
+            return H2_PROTOCOL_ERROR;
+    }
+
+    // the bodies held by the connection are capped by buffer_body, so the window is handed back
+    // as soon as the frame arrives
+    if (len > 0) {
+        hr = window_update(0, len);
+        if (hr < 0)
+            return hr;
+    }
+
+    m_lock.lock();
+    std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it != m_streams.end())
+        s = it->second;
+    m_lock.unlock();
+
+    if (!s)
+        return id > m_last_id ? H2_PROTOCOL_ERROR : H2_NO_ERROR;
+
+    if (s->m_remote_closed)
+        return rst(id, H2_STREAM_CLOSED);
+
+    if (!(flags & H2_FLAG_END_STREAM) && len > 0) {
+        hr = window_update(id, len);
+        if (hr < 0)
+            return hr;
+    }
+
+    if (!s->m_dispatched) {
+        int32_t maxBodySize;
+        size_t sz = len - pos - pad;
+
+        s->m_size += sz;
+
+        m_hdlr->get_maxBodySize(maxBodySize);
+        if (maxBodySize >= 0 && s->m_size > (int64_t)maxBodySize * 1024 * 1024) {
+            // answer right away like the HTTP/1.x path does, the rest of the body is dropped
+            release_body(s->m_body);
+            s->m_spill.Release();
+            s->m_status = 400;
+            dispatch(s);
+        } else {
+            hr = buffer_body(s->m_body, s->m_spill, payload.c_str() + pos, sz);
+            if (hr < 0)
+                return hr;
+        }
+    }
+
+    if (flags & H2_FLAG_END_STREAM) {
+        s->m_remote_closed = true;
+        if (!s->m_dispatched)
+            dispatch(s);
+    }
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Session::on_headers(int32_t flags, int32_t id, exlib::string& payload)
+{
+    size_t len = payload.length();
+    size_t pos = 0;
+    size_t pad = 0;
+
+    if (id == 0)
+        return H2_PROTOCOL_ERROR;
+
+    if (flags & H2_FLAG_PADDED) {
+        if (len < 1)
+            return H2_FRAME_SIZE_ERROR;
+
+        pad = (uint8_t)payload[0];
+        pos = 1;
+    }
+
+    if (flags & H2_FLAG_PRIORITY)
+        pos += 5;
+
+    if (pos + pad > len)
+        return H2_PROTOCOL_ERROR;
+
+    m_block.assign(payload.c_str() + pos, len - pos - pad);
+    m_block_id = id;
+    m_block_flags = flags;
+
+    if (flags & H2_FLAG_END_HEADERS)
+        return end_headers();
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Session::on_continuation(int32_t flags, int32_t id, exlib::string& payload)
+{
+    if (!m_block_id || id != m_block_id)
+        return H2_PROTOCOL_ERROR;
+
+    m_block.append(payload);
+    if (m_block.length() > H2_MAX_HEADER_BLOCK)
+        return H2_ENHANCE_YOUR_CALM;
+
+    if (flags & H2_FLAG_END_HEADERS)
+        return end_headers();
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Session::end_headers()
+{
+    std::vector<HPack::header> hdrs;
+    int32_t id = m_block_id;
+    bool end = (m_block_flags & H2_FLAG_END_STREAM) != 0;
+    obj_ptr<Stream> s;
+
+    m_block_id = 0;
+
+    // the block is always decoded to keep the dynamic table in step with the client
+    result_t hr = m_decoder.decode(m_block.c_str(), m_block.length(), hdrs, H2_MAX_HEADER_LIST);
+    if (hr == CALL_E_OVERFLOW)
+        return H2_ENHANCE_YOUR_CALM;
+    if (hr < 0)
+        return H2_COMPRESSION_ERROR;
+    m_block.clear();
+
+    m_lock.lock();
+    std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it != m_streams.end()) {
+        s = it->second;
+        m_lock.unlock();
+
+        // trailers, their fields are not exposed to the handler
+        if (s->m_remote_closed)
+            return rst(id, H2_STREAM_CLOSED);
+
+        if (!end)
+            return H2_PROTOCOL_ERROR;
+
+        s->m_remote_closed = true;
+        if (!s->m_dispatched)
+            dispatch(s);
+
+        return H2_NO_ERROR;
+    }
+
+    if (id <= m_last_id) {
+        m_lock.unlock();
+        return H2_NO_ERROR;
+    }
+
+    if ((id & 1) == 0) {
+        m_lock.unlock();
+        return H2_PROTOCOL_ERROR;
+    }
+
+    m_last_id = id;
+
+    if (m_goaway || m_streams.size() >= H2_MAX_STREAMS) {
+        m_lock.unlock();
+        return rst(id, H2_REFUSED_STREAM);
+    }
+
+    s = new Stream(this, id, (int32_t)m_init_window);
+    m_streams[id] = s;
+    m_lock.unlock();
+
+    if (fill(s, hdrs) < 0) {
+        m_lock.lock();
+        m_streams.erase(id);
+        m_lock.unlock();
+
+        return rst(id, H2_PROTOCOL_ERROR);
+    }
+
+    s->m_remote_closed = end;
+    if (end)
+        dispatch(s);
+
+    return H2_NO_ERROR;
+}
+
+result_t Http2Session::fill(Stream* s, std::vector<HPack::header>& hdrs)
+{
+    obj_ptr<HttpRequest> req = new HttpRequest();
+    exlib::string method, path, authority, cookie;
+    bool regular = false;
+    bool host = false;
+    int32_t maxHeadersCount;
+    int32_t maxBodySize;
+    int32_t count = 0;
+    size_t i;
+
+    m_hdlr->get_maxHeadersCount(maxHeadersCount);
+    m_hdlr->get_maxBodySize(maxBodySize);
+    req->set_maxHeadersCount(maxHeadersCount);
+    req->set_maxBodySize(maxBodySize);
+
+    for (i = 0; i < hdrs.size(); i++) {
+        exlib::string& name = hdrs[i].first;
+        exlib::string& value = hdrs[i].second;
+
+        if (name.empty())
+            return CALL_E_INVALID_DATA;
+
+        if (name[0] == ':') {
+            if (regular)
+                return CALL_E_INVALID_DATA;
+
+            if (name == ":method")
+                method = value;
+            else if (name == ":path")
+                path = value;
+            else if (name == ":authority")
+                authority = value;
+            else if (name != ":scheme")
+                return CALL_E_INVALID_DATA;
+
+            continue;
+        }
+
+        regular = true;
+
+        // connection specific fields have no meaning here, the body length comes from the DATA frames
+        if (name == "connection" || name == "keep-alive" || name == "proxy-connection"
+            || name == "transfer-encoding" || name == "upgrade" || name == "content-length")
+            continue;
+
+        if (name == "cookie") {
+            if (!cookie.empty())
+                cookie.append("; ", 2);
+            cookie.append(value);
+            continue;
+        }
+
+        if (name == "host")
+            host = true;
+
+        req->addHeader(name, value);
+        count++;
+    }
+
+    if (method.empty() || path.empty())
+        return CALL_E_INVALID_DATA;
+
+    if (!host && !authority.empty()) {
+        req->addHeader("host", authority);
+        count++;
+    }
+
+    if (!cookie.empty()) {
+        req->addHeader("cookie", cookie);
+        count++;
+    }
+
+    if (count > maxHeadersCount)
+        s->m_status = 400;
+
+    req->set_method(method);
+
+    size_t q = path.find('?');
+    if (q != exlib::string::npos) {
+        req->set_queryString(path.substr(q + 1));
+        path.resize(q);
+    }
+
+    req->set_address(path);
+    req->set_value(path);
+    req->set_protocol("HTTP/2.0");
+    req->set_keepAlive(true);
+    req->setSocket(m_stm);
+
+    s->m_req = req;
+    return 0;
+}
+
+void Http2Session::dispatch(Stream* s)
+{
+    s->m_dispatched = true;
+
+    m_lock.lock();
+    m_active++;
+    m_lock.unlock();
+
+    s->Ref();
+    asyncCall(stream_proc, s);
+}
+
+// every stream is answered in its own worker fiber, so a slow handler does not hold up the others
+result_t Http2Session::stream_proc(Stream* s)
+{
+    obj_ptr<Stream> _s = s;
+    Http2Session* pThis = s->m_session;
+
+    s->Unref();
+
+    pThis->respond(s);
+
+    if (!s->m_remote_closed && !s->m_reset)
+        pThis->rst(s->m_id, H2_NO_ERROR);
+
+    pThis->m_lock.lock();
+    pThis->m_streams.erase(s->m_id);
+    pThis->m_active--;
+    pThis->m_cond.notify_all();
+    pThis->m_lock.unlock();
+
+    pThis->release_body(s->m_body);
+    s->m_spill.Release();
+    s->m_session.Release();
+    return 0;
+}
+
+// frames what the encoder writes to it as DATA frames of up to H2_DEFAULT_FRAME_SIZE bytes,
+// close() ends the stream
+class Http2Session::DataStream : public Stream_base {
+public:
+    DataStream(Http2Session* session, Stream* s)
+        : m_session(session)
+        , m_s(s)
+    {
+    }
+
+public:
+    // Stream_base
+    virtual result_t get_fd(int32_t& retVal)
+    {
+        return CALL_E_INVALID_CALL;
+    }
+
+    virtual result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+    {
+        return CALL_E_INVALID_CALL;
+    }
+
+    virtual result_t write(Buffer_base* data, AsyncEvent* ac)
+    {
+        exlib::string buf;
+
+        data->toString(buf);
+        m_buf.append(buf);
+
+        if (m_buf.length() < H2_DEFAULT_FRAME_SIZE)
+            return 0;
+
+        return send(false);
+    }
+
+    virtual result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac)
+    {
+        return stream_writev(this, datas, ac);
+    }
+
+    virtual result_t flush(AsyncEvent* ac)
+    {
+        if (m_buf.empty())
+            return 0;
+
+        return send(false);
+    }
+
+    virtual result_t close(AsyncEvent* ac)
+    {
+        return send(true);
+    }
+
+    virtual result_t copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac)
+    {
+        return CALL_E_INVALID_CALL;
+    }
+
+private:
+    result_t send(bool end)
+    {
+        exlib::string buf;
+
+        buf.swap(m_buf);
+        return m_session->send_data(m_s, buf.c_str(), buf.length(), end);
+    }
+
+private:
+    obj_ptr<Http2Session> m_session;
+    obj_ptr<Stream> m_s;
+    exlib::string m_buf;
+};
+
+void Http2Session::respond(Stream* s)
+{
+    obj_ptr<HttpRequest_base> req = s->m_req;
+    obj_ptr<HttpResponse_base> rep;
+    obj_ptr<SeekableStream_base> body;
+    exlib::string str;
+    bool options = false;
+    result_t hr;
+
+    req->get_response(rep);
+
+    if (s->m_status)
+        rep->set_statusCode(s->m_status);
+    else {
+        if (s->m_spill) {
+            s->m_spill->rewind();
+            req->set_body(s->m_spill);
+            s->m_spill.Release();
+        } else if (!s->m_body.empty()) {
+            obj_ptr<Buffer_base> buf = new Buffer(s->m_body);
+
+            release_body(s->m_body);
+            req->get_body(body);
+            body->cc_write(buf);
+            body->rewind();
+            body.Release();
+        }
+
+        options = m_hdlr->preflight(req, rep);
+        if (!options) {
+            obj_ptr<Handler_base> hdlr;
+
+            m_hdlr->get_handler(hdlr);
+            hr = mq_base::cc_invoke(hdlr, req);
+            if (hr < 0) {
+                exlib::string err = getResultMessage(hr);
+
+                req->set_lastError(err);
+                errorLog("HttpHandler: " + err);
+
+                rep->set_statusCode(500);
+            }
+        }
+    }
+
+    m_hdlr->fillHeaders(req, rep, options);
+
+    req->get_method(str);
+    bool headOnly = !qstricmp(str.c_str(), "head");
+
+    rep->get_body(body);
+
+    send_response(s, rep, headOnly, headOnly ? 0 : m_hdlr->encoding(req, rep, true));
+
+    if (body)
+        body->cc_close();
+}
+
+result_t Http2Session::send_response(Stream* s, HttpResponse_base* rep, bool headOnly, int32_t type)
+{
+    HttpResponse* r = (HttpResponse*)rep;
+    HttpCollection* headers = r->m_message->m_headers;
+    std::vector<HPack::header> hdrs;
+    obj_ptr<SeekableStream_base> body;
+    exlib::string block;
+    exlib::string buf;
+    char num[32];
+    int64_t len;
+    size_t i;
+    result_t hr;
+
+    r->flushCookies();
+
+    snprintf(num, sizeof(num), "%d", r->m_statusCode);
+    hdrs.push_back(HPack::header(":status", num));
+
+    for (i = 0; i < headers->count(); i++) {
+        const std::pair<exlib::string, exlib::string>& h = headers->at(i);
+        exlib::string name(h.first);
+        size_t j;
+
+        for (j = 0; j < name.length(); j++)
+            name[j] = qtolower(name[j]);
+
+        if (name == "connection" || name == "keep-alive" || name == "proxy-connection"
+            || name == "transfer-encoding" || name == "upgrade" || name == "content-length")
+            continue;
+
+        hdrs.push_back(HPack::header(name, h.second));
+    }
+
+    // an encoded body is compressed while it is sent, its length is not known up front
+    rep->get_length(len);
+    if (type == 0) {
+        snprintf(num, sizeof(num), "%lld", (long long)len);
+        hdrs.push_back(HPack::header("content-length", num));
+    }
+
+    m_encoder.encode(hdrs, block);
+
+    bool end = headOnly || len <= 0;
+    size_t pos = 0;
+    size_t max_frame = m_max_frame;
+
+    // a block larger than a frame goes out as HEADERS followed by CONTINUATION frames in one write
+    do {
+        size_t sz = block.length() - pos;
+        int32_t flags = 0;
+
+        if (sz > max_frame)
+            sz = max_frame;
+        else
+            flags |= H2_FLAG_END_HEADERS;
+
+        if (pos == 0) {
+            if (end)
+                flags |= H2_FLAG_END_STREAM;
+            frame_head(buf, H2_FRAME_HEADERS, flags, s->m_id, sz);
+        } else
+            frame_head(buf, H2_FRAME_CONTINUATION, flags, s->m_id, sz);
+
+        buf.append(block.c_str() + pos, sz);
+        pos += sz;
+    } while (pos < block.length());
+
+    hr = write(buf);
+    if (hr < 0 || end)
+        return hr;
+
+    rep->get_body(body);
+    body->rewind();
+
+    if (type != 0) {
+        // the body is read here on the stream fiber, so DataStream may wait for the send window
+        obj_ptr<DataStream> out = new DataStream(this, s);
+        obj_ptr<ZlibStream> zip = m_hdlr->encoder(type, out);
+
+        while (true) {
+            obj_ptr<Buffer_base> data;
+
+            hr = body->cc_read(H2_DEFAULT_FRAME_SIZE, data);
+            if (hr < 0)
+                return hr;
+            if (hr == CALL_RETURN_NULL)
+                break;
+
+            hr = zip->cc_write(data);
+            if (hr < 0)
+                return hr;
+        }
+
+        hr = zip->cc_close();
+        if (hr < 0)
+            return hr;
+
+        return out->cc_close();
+    }
+
+    int64_t sent = 0;
+
+    while (sent < len) {
+        obj_ptr<Buffer_base> data;
+        exlib::string str;
+
+        hr = body->cc_read(H2_DEFAULT_FRAME_SIZE, data);
+        if (hr < 0)
+            return hr;
+        if (hr == CALL_RETURN_NULL)
+            break;
+
+        data->toString(str);
+        sent += str.length();
+
+        hr = send_data(s, str.c_str(), str.length(), sent >= len);
+        if (hr < 0)
+            return hr;
+    }
+
+    if (sent < len)
+        return send_data(s, NULL, 0, true);
+
+    return 0;
+}
+
+int32_t Http2Session::acquire(Stream* s, size_t want)
+{
+    int32_t n;
+
+    m_lock.lock();
+    while (!m_closed && !s->m_reset && (m_send_window <= 0 || s->m_send_window <= 0))
+        m_cond.wait(m_lock, -1);
+
+    if (m_closed || s->m_reset) {
+        m_lock.unlock();
+        return CALL_E_CLOSED;
+    }
+
+    n = (int32_t)want;
+    if (n > m_send_window)
+        n = (int32_t)m_send_window;
+    if (n > s->m_send_window)
+        n = (int32_t)s->m_send_window;
+    if (n > m_max_frame)
+        n = m_max_frame;
+
+    m_send_window -= n;
+    s->m_send_window -= n;
+    m_lock.unlock();
+
+    return n;
+}
+
+result_t Http2Session::send_data(Stream* s, const char* data, size_t sz, bool end)
+{
+    result_t hr;
+
+    if (sz == 0)
+        return write_frame(H2_FRAME_DATA, end ? H2_FLAG_END_STREAM : 0, s->m_id, NULL, 0);
+
+    while (sz > 0) {
+        int32_t n = acquire(s, sz);
+        if (n < 0)
+            return n;
+
+        hr = write_frame(H2_FRAME_DATA, (end && (size_t)n == sz) ? H2_FLAG_END_STREAM : 0,
+            s->m_id, data, n);
+        if (hr < 0)
+            return hr;
+
+        data += n;
+        sz -= n;
+    }
+
+    return 0;
+}
+
+int32_t Http2Session::on_rst_stream(int32_t id, exlib::string& payload)
+{
+    if (id == 0)
+        return H2_PROTOCOL_ERROR;
+
+    if (payload.length() != 4)
+        return H2_FRAME_SIZE_ERROR;
+
+    m_lock.lock();
+    if (id > m_last_id) {
+        m_lock.unlock();
+        return H2_PROTOCOL_ERROR;
+    }
+
+    obj_ptr<Stream> s;
+    std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it != m_streams.end()) {
+        s = it->second;
+        s->m_reset = true;
+        s->m_remote_closed = true;
+
+        // nobody will answer a stream that was reset while its body was still coming in
+        if (!s->m_dispatched)
+            m_streams.erase(it);
+        else
+            s.Release();
+
+        m_cond.notify_all();
+    }
+    m_lock.unlock();
+
+    if (s) {
+        release_body(s->m_body);
+        s->m_spill.Release();
+        s->m_session.Release();
+    }
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Session::apply_settings(const exlib::string& payload)
+{
+    const uint8_t* p = (const uint8_t*)payload.c_str();
+    size_t len = payload.length();
+    size_t i;
+
+    if (len % 6)
+        return H2_FRAME_SIZE_ERROR;
+
+    m_lock.lock();
+    for (i = 0; i < len; i += 6) {
+        int32_t id = (p[i] << 8) | p[i + 1];
+        uint32_t v = ((uint32_t)p[i + 2] << 24) | (p[i + 3] << 16) | (p[i + 4] << 8) | p[i + 5];
+
+        if (id == H2_SETTINGS_ENABLE_PUSH) {
+            if (v > 1) {
+                m_lock.unlock();
+                return H2_PROTOCOL_ERROR;
+            }
+        } else if (id == H2_SETTINGS_INITIAL_WINDOW_SIZE) {
+            if (v > H2_MAX_WINDOW) {
+                m_lock.unlock();
+                return H2_FLOW_CONTROL_ERROR;
+            }
+
+            int64_t delta = (int64_t)v - m_init_window;
+            std::map<int32_t, obj_ptr<Stream>>::iterator it;
+
+            for (it = m_streams.begin(); it != m_streams.end(); it++)
+                it->second->m_send_window += delta;
+            m_init_window = v;
+        } else if (id == H2_SETTINGS_MAX_FRAME_SIZE) {
+            if (v < H2_DEFAULT_FRAME_SIZE || v > 0xffffff) {
+                m_lock.unlock();
+                return H2_PROTOCOL_ERROR;
+            }
+
+            m_max_frame = v;
+        }
+        // the encoder never indexes, so HEADER_TABLE_SIZE does not matter
+    }
+
+    m_cond.notify_all();
+    m_lock.unlock();
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Session::on_settings(int32_t flags, int32_t id, exlib::string& payload)
+{
+    int32_t code;
+
+    if (id != 0)
+        return H2_PROTOCOL_ERROR;
+
+    if (flags & H2_FLAG_ACK)
+        return payload.empty() ? H2_NO_ERROR : H2_FRAME_SIZE_ERROR;
+
+    code = apply_settings(payload);
+    if (code != H2_NO_ERROR)
+        return code;
+
+    return write_frame(H2_FRAME_SETTINGS, H2_FLAG_ACK, 0, NULL, 0);
+}
+
+int32_t Http2Session::on_window_update(int32_t id, exlib::string& payload)
+{
+    int32_t inc;
+
+    if (payload.length() != 4)
+        return H2_FRAME_SIZE_ERROR;
+
+    inc = get_u31(payload.c_str());
+
+    m_lock.lock();
+    if (id == 0) {
+        if (inc == 0 || m_send_window + inc > H2_MAX_WINDOW) {
+            m_lock.unlock();
+            return inc == 0 ? H2_PROTOCOL_ERROR : H2_FLOW_CONTROL_ERROR;
+        }
+
+        m_send_window += inc;
+    } else {
+        std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+
+        if (it != m_streams.end()) {
+            Stream* s = it->second;
+
+            if (inc == 0 || s->m_send_window + inc > H2_MAX_WINDOW) {
+                s->m_reset = true;
+                m_cond.notify_all();
+                m_lock.unlock();
+
+                return rst(id, inc == 0 ? H2_PROTOCOL_ERROR : H2_FLOW_CONTROL_ERROR);
+            }
+
+            s->m_send_window += inc;
+        }
+    }
+
+    m_cond.notify_all();
+    m_lock.unlock();
+
+    return H2_NO_ERROR;
+}
+
+result_t Http2Session::goaway(int32_t code)
+{
+    exlib::string buf;
+
+    m_lock.lock();
+    put_u32(buf, m_last_id);
+    m_lock.unlock();
+
+    put_u32(buf, code);
+    write_frame(H2_FRAME_GOAWAY, 0, 0, buf.c_str(), buf.length());
+
+    return CHECK_ERROR(CALL_E_INVALID_DATA);
+}
+}
@@ -12,6 +12,7 @@
 #include "SslSocket.h"
 #include "BufferedStream.h"
 #include "inetAddr.h"
+#include "Timer.h"
 #include "ifs/net.h"
 #include "ifs/zlib.h"
 #include "ifs/json.h"
@@ -129,6 +130,452 @@ result_t HttpClient::set_poolTimeout(int32_t newVal)
     return 0;
 }
 
+result_t HttpClient::get_maxConnsPerHost(int32_t& retVal)
+{
+    retVal = m_maxConnsPerHost;
+    return 0;
+}
+
+result_t HttpClient::set_maxConnsPerHost(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    std::vector<AsyncEvent*> wakes;
+    std::vector<obj_ptr<Timer_base>> timers;
+
+    m_lock.lock();
+    m_maxConnsPerHost = newVal;
+
+    // a raised limit admits the requests already queued on each host
+    HostMap::iterator it;
+    for (it = m_hosts.begin(); it != m_hosts.end(); it++) {
+        Host* h = it->second;
+
+        while (!h->waiters.empty() && (newVal == 0 || h->active < newVal)) {
+            wakes.push_back(h->waiters.front().ac);
+            if (h->waiters.front().timer)
+                timers.push_back(h->waiters.front().timer);
+            h->waiters.pop_front();
+            h->active++;
+            m_active++;
+            m_misses++;
+        }
+    }
+    m_lock.unlock();
+
+    for (size_t i = 0; i < timers.size(); i++)
+        timers[i]->clear();
+
+    for (size_t i = 0; i < wakes.size(); i++)
+        wakes[i]->apost(0);
+
+    return 0;
+}
+
+#define POOL_REAP_INTERVAL 1000
+
+class PoolReaper : public Timer {
+public:
+    PoolReaper(HttpClient* hc)
+        : Timer(POOL_REAP_INTERVAL)
+        , m_hc(hc)
+    {
+    }
+
+public:
+    virtual void on_timer()
+    {
+        m_hc->reap();
+    }
+
+private:
+    obj_ptr<HttpClient> m_hc;
+};
+
+// a request queued behind maxConnsPerHost gives up once HttpClient.timeout has passed
+class PoolWaitTimer : public Timer {
+public:
+    PoolWaitTimer(HttpClient* hc, int32_t timeout, exlib::string host)
+        : Timer(timeout)
+        , m_hc(hc)
+        , m_host(host)
+    {
+    }
+
+public:
+    virtual void on_timer()
+    {
+        m_hc->expire_waiter(m_host, this);
+    }
+
+private:
+    obj_ptr<HttpClient> m_hc;
+    exlib::string m_host;
+};
+
+void HttpClient::drop_host(HostMap::iterator it)
+{
+    Host* h = it->second;
+
+    if (h->idle.empty() && h->waiters.empty() && h->active == 0)
+        m_hosts.erase(it);
+}
+
+// the oldest idle connection of all hosts is also the oldest of its own host,
+// so both lists lose their front together. caller holds m_lock
+void HttpClient::evict(date_t d, std::vector<obj_ptr<Conn>>& drops)
+{
+    while (!m_idle.empty()) {
+        obj_ptr<Conn> c = m_idle.front();
+
+        if ((int32_t)m_idle.size() <= m_poolSize && d.diff(c->d) < (double)m_poolTimeout)
+            break;
+
+        m_idle.pop_front();
+        drops.push_back(c);
+        m_evictions++;
+
+        HostMap::iterator it = m_hosts.find(c->url);
+        it->second->idle.pop_front();
+        drop_host(it);
+    }
+}
+
+void HttpClient::clean_coon(date_t d)
+{
+    std::vector<obj_ptr<Conn>> drops;
+
+    m_lock.lock();
+    evict(d, drops);
+    m_lock.unlock();
+}
+
+void HttpClient::reap()
+{
+    std::vector<obj_ptr<Conn>> drops;
+    std::vector<obj_ptr<Http2Client>> h2drops;
+    bool h2 = false;
+    date_t d;
+    bool rearm;
+
+    d.now();
+
+    m_lock.lock();
+    evict(d, drops);
+
+    std::map<exlib::string, obj_ptr<H2Origin>>::iterator it = m_h2.begin();
+    while (it != m_h2.end()) {
+        H2Origin* o = it->second;
+        size_t i = 0;
+
+        while (i < o->sessions.size()) {
+            Http2Client* s = o->sessions[i];
+
+            if (s->closed() || s->idle(d, m_poolTimeout)) {
+                h2drops.push_back(s);
+                o->sessions.erase(o->sessions.begin() + i);
+            } else
+                i++;
+        }
+
+        if (!o->sessions.empty())
+            h2 = true;
+
+        if (o->sessions.empty() && o->waiters.empty() && !o->connecting && !o->http1)
+            m_h2.erase(it++);
+        else
+            it++;
+    }
+
+    rearm = m_reaping = !m_idle.empty() || h2;
+    m_lock.unlock();
+
+    for (size_t i = 0; i < h2drops.size(); i++)
+        h2drops[i]->close();
+
+    if (rearm)
+        (new PoolReaper(this))->sleep();
+}
+
+result_t HttpClient::get_h2(exlib::string url, obj_ptr<Http2Client>& retVal, bool& connector,
+    bool& retry, AsyncEvent* ac)
+{
+    std::vector<obj_ptr<Http2Client>> drops;
+
+    retVal.Release();
+    connector = false;
+    retry = false;
+
+    m_lock.lock();
+    obj_ptr<H2Origin>& o = m_h2[url];
+    if (!o)
+        o = new H2Origin();
+
+    size_t i = 0;
+    while (i < o->sessions.size()) {
+        Http2Client* s = o->sessions[i];
+
+        if (s->closed()) {
+            drops.push_back(s);
+            o->sessions.erase(o->sessions.begin() + i);
+        } else if (s->reserve()) {
+            retVal = s;
+            m_hits++;
+            break;
+        } else
+            i++;
+    }
+
+    if (!retVal && !o->http1) {
+        if (o->connecting) {
+            // someone is already bringing up a connection, ask again once it is there
+            retry = true;
+            o->waiters.push_back(ac);
+            m_waits++;
+            m_lock.unlock();
+
+            return CALL_E_PENDDING;
+        }
+
+        o->connecting = true;
+        connector = true;
+    }
+    m_lock.unlock();
+
+    return 0;
+}
+
+void HttpClient::put_h2(exlib::string url, Http2Client* h2, bool http1)
+{
+    std::list<AsyncEvent*> wakes;
+    bool arm = false;
+
+    m_lock.lock();
+    obj_ptr<H2Origin>& o = m_h2[url];
+    if (!o)
+        o = new H2Origin();
+
+    o->connecting = false;
+    if (h2) {
+        o->sessions.push_back(h2);
+        if (!m_reaping)
+            arm = m_reaping = true;
+    }
+    if (http1)
+        o->http1 = true;
+
+    wakes.swap(o->waiters);
+    m_lock.unlock();
+
+    std::list<AsyncEvent*>::iterator it;
+    for (it = wakes.begin(); it != wakes.end(); it++)
+        (*it)->apost(0);
+
+    if (arm)
+        (new PoolReaper(this))->sleep();
+}
+
+result_t HttpClient::get_conn(exlib::string url, exlib::string host, obj_ptr<Stream_base>& retVal, AsyncEvent* ac)
+{
+    std::vector<obj_ptr<Conn>> drops;
+    obj_ptr<Timer> timer;
+    date_t d;
+
+    d.now();
+    retVal.Release();
+
+    m_lock.lock();
+    evict(d, drops);
+
+    obj_ptr<Host>& h = m_hosts[host];
+    if (!h)
+        h = new Host();
+
+    HostMap::iterator it = m_hosts.find(url);
+    if (it != m_hosts.end() && !it->second->idle.empty()) {
+        obj_ptr<Conn> c = it->second->idle.back();
+
+        it->second->idle.pop_back();
+        m_idle.erase(c->pos);
+        if (url != host)
+            drop_host(it);
+        retVal = c->conn;
+        m_hits++;
+    } else if (m_maxConnsPerHost > 0 && h->active >= m_maxConnsPerHost) {
+        h->waiters.push_back(Waiter(ac, url, &retVal));
+        if (m_timeout > 0) {
+            timer = new PoolWaitTimer(this, m_timeout, host);
+            h->waiters.back().timer = timer;
+        }
+        m_waits++;
+        m_lock.unlock();
+
+        if (timer)
+            timer->sleep();
+
+        return CALL_E_PENDDING;
+    } else
+        m_misses++;
+
+    h->active++;
+    m_active++;
+    m_lock.unlock();
+
+    return 0;
+}
+
+bool HttpClient::take_conn(exlib::string url, obj_ptr<Stream_base>& retVal)
+{
+    std::vector<obj_ptr<Conn>> drops;
+    date_t d;
+
+    d.now();
+
+    m_lock.lock();
+    evict(d, drops);
+
+    HostMap::iterator it = m_hosts.find(url);
+    if (it == m_hosts.end() || it->second->idle.empty()) {
+        m_lock.unlock();
+        return false;
+    }
+
+    obj_ptr<Conn> c = it->second->idle.back();
+
+    it->second->idle.pop_back();
+    m_idle.erase(c->pos);
+    drop_host(it);
+    retVal = c->conn;
+    m_hits++;
+    m_lock.unlock();
+
+    return true;
+}
+
+void HttpClient::save_conn(exlib::string url, exlib::string host, Stream_base* conn)
+{
+    std::vector<obj_ptr<Conn>> drops;
+    obj_ptr<Timer_base> timer;
+    AsyncEvent* ac = NULL;
+    bool arm = false;
+    date_t d;
+
+    d.now();
+
+    m_lock.lock();
+    obj_ptr<Host>& h = m_hosts[host];
+    if (!h)
+        h = new Host();
+
+    if (!h->waiters.empty()) {
+        // hand the slot straight to the next request in line, and the connection with it
+        // when that request pools under the same key
+        Waiter& w = h->waiters.front();
+
+        if (w.url == url) {
+            *w.conn = conn;
+            conn = NULL;
+            m_hits++;
+        } else
+            m_misses++;
+
+        ac = w.ac;
+        timer = w.timer;
+        h->waiters.pop_front();
+    } else if (h->active > 0) {
+        h->active--;
+        m_active--;
+    }
+
+    if (conn) {
+        obj_ptr<Host>& p = m_hosts[url];
+        if (!p)
+            p = new Host();
+
+        obj_ptr<Conn> c = new Conn();
+
+        c->d = d;
+        c->url = url;
+        c->conn = conn;
+
+        p->idle.push_back(c);
+        c->pos = m_idle.insert(m_idle.end(), c);
+
+        if (url != host)
+            drop_host(m_hosts.find(host));
+
+        evict(d, drops);
+
+        if (!m_reaping && !m_idle.empty())
+            arm = m_reaping = true;
+    }
+    m_lock.unlock();
+
+    if (timer)
+        timer->clear();
+
+    if (ac)
+        ac->apost(0);
+
+    if (arm)
+        (new PoolReaper(this))->sleep();
+}
+
+void HttpClient::release_conn(exlib::string host)
+{
+    obj_ptr<Timer_base> timer;
+    AsyncEvent* ac = NULL;
+
+    m_lock.lock();
+    HostMap::iterator it = m_hosts.find(host);
+    if (it != m_hosts.end()) {
+        Host* h = it->second;
+
+        if (!h->waiters.empty()) {
+            ac = h->waiters.front().ac;
+            timer = h->waiters.front().timer;
+            h->waiters.pop_front();
+            m_misses++;
+        } else if (h->active > 0) {
+            h->active--;
+            m_active--;
+            drop_host(it);
+        }
+    }
+    m_lock.unlock();
+
+    if (timer)
+        timer->clear();
+
+    if (ac)
+        ac->apost(0);
+}
+
+void HttpClient::expire_waiter(exlib::string host, Timer_base* timer)
+{
+    AsyncEvent* ac = NULL;
+
+    m_lock.lock();
+    HostMap::iterator it = m_hosts.find(host);
+    if (it != m_hosts.end()) {
+        std::list<Waiter>& waiters = it->second->waiters;
+        std::list<Waiter>::iterator w;
+
+        for (w = waiters.begin(); w != waiters.end(); w++)
+            if (w->timer == timer) {
+                ac = w->ac;
+                waiters.erase(w);
+                drop_host(it);
+                break;
+            }
+    }
+    m_lock.unlock();
+
+    if (ac)
+        ac->apost(-ETIMEDOUT);
+}
+
 result_t HttpClient::get_http_proxy(exlib::string& retVal)
 {
     retVal = m_http_proxy;
@@ -220,6 +667,45 @@ result_t HttpClient::set_sslVerification(int32_t newVal)
     return 0;
 }
 
+result_t HttpClient::get_enableHttp2(bool& retVal)
+{
+    retVal = m_enableHttp2;
+    return 0;
+}
+
+result_t HttpClient::set_enableHttp2(bool newVal)
+{
+    m_enableHttp2 = newVal;
+    return 0;
+}
+
+result_t HttpClient::get_enableH2c(bool& retVal)
+{
+    retVal = m_enableH2c;
+    return 0;
+}
+
+result_t HttpClient::set_enableH2c(bool newVal)
+{
+    m_enableH2c = newVal;
+    return 0;
+}
+
+result_t HttpClient::get_maxConcurrentStreams(int32_t& retVal)
+{
+    retVal = m_maxConcurrentStreams;
+    return 0;
+}
+
+result_t HttpClient::set_maxConcurrentStreams(int32_t newVal)
+{
+    if (newVal < 1)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_maxConcurrentStreams = newVal;
+    return 0;
+}
+
 result_t HttpClient::update(HttpCookie_base* cookie)
 {
     int32_t length, i;
@@ -390,6 +876,33 @@ result_t HttpClient::setClientCert(X509Cert_base* crt, PKey_base* key)
     return 0;
 }
 
+result_t HttpClient::poolStats(v8::Local<v8::Object>& retVal)
+{
+    Isolate* isolate = Isolate::current();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+    double hits, misses, waits, evictions, idle, active;
+
+    m_lock.lock();
+    hits = (double)m_hits;
+    misses = (double)m_misses;
+    waits = (double)m_waits;
+    evictions = (double)m_evictions;
+    idle = (double)m_idle.size();
+    active = (double)m_active;
+    m_lock.unlock();
+
+    o->Set(context, isolate->NewString("hits"), v8::Number::New(isolate->m_isolate, hits)).IsJust();
+    o->Set(context, isolate->NewString("misses"), v8::Number::New(isolate->m_isolate, misses)).IsJust();
+    o->Set(context, isolate->NewString("waits"), v8::Number::New(isolate->m_isolate, waits)).IsJust();
+    o->Set(context, isolate->NewString("evictions"), v8::Number::New(isolate->m_isolate, evictions)).IsJust();
+    o->Set(context, isolate->NewString("idle"), v8::Number::New(isolate->m_isolate, idle)).IsJust();
+    o->Set(context, isolate->NewString("active"), v8::Number::New(isolate->m_isolate, active)).IsJust();
+
+    retVal = o;
+    return 0;
+}
+
 result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req, SeekableStream_base* response_body,
     obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
 {
@@ -506,6 +1019,10 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
             , m_opts(opts)
             , m_retVal(retVal)
             , m_hc(hc)
+            , m_slot(false)
+            , m_h2Connector(false)
+            , m_h2Retry(false)
+            , m_h2Retried(false)
         {
             m_u->toString(m_url);
             if (m_response_body)
@@ -513,6 +1030,12 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
             next(prepare);
         }
 
+        ~asyncRequest()
+        {
+            release();
+            give_up_h2();
+        }
+
         ON_STATE(asyncRequest, prepare)
         {
             bool _domain = false;
@@ -595,17 +1118,63 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
                 m_sslhost.clear();
 
             m_reuse = false;
-            if (m_hc->get_conn(m_connUrl, m_conn)) {
+            if (m_http_proxy.empty() || m_http_proxy[0] == 's' || m_ssl)
+                m_poolUrl = m_connUrl;
+            else
+                m_poolUrl = m_http_proxy;
+
+            if (m_http_proxy.empty() && (m_ssl ? m_hc->m_enableHttp2 : m_hc->m_enableH2c))
+                return next(h2_lookup);
+
+            return next(conn_pool);
+        }
+
+        ON_STATE(asyncRequest, h2_lookup)
+        {
+            return m_hc->get_h2(m_connUrl, m_h2, m_h2Connector, m_h2Retry, next(h2_pooled));
+        }
+
+        ON_STATE(asyncRequest, h2_pooled)
+        {
+            if (m_h2Retry)
+                return next(h2_lookup);
+
+            if (m_h2)
+                return next(h2_request);
+
+            return next(conn_pool);
+        }
+
+        ON_STATE(asyncRequest, conn_pool)
+        {
+            // get_conn may queue this request until the host is under maxConnsPerHost,
+            // either way the slot is ours once pooled runs, a request that timed out in
+            // the queue never gets there and holds no slot
+            return m_hc->get_conn(m_poolUrl, m_connUrl, m_conn, next(pooled));
+        }
+
+        ON_STATE(asyncRequest, pooled)
+        {
+            m_slot = true;
+
+            if (m_conn) {
+                // an idle HTTP/1.1 connection tells nothing about HTTP/2, let the next request try
+                give_up_h2();
                 m_reuse = true;
                 return next(connected);
             }
 
             if (m_http_proxy.empty()) {
-                if (m_ssl)
+                if (m_ssl) {
+                    if (m_h2Connector)
+                        return net_base::connect("tcp://" + m_connUrl.substr(6), m_hc->m_timeout,
+                            m_conn, next(ssl_handshake));
+
                     return ssl_base::connect(m_connUrl, m_hc->m_sslVerification,
                         m_hc->m_crt, m_hc->m_key, m_hc->m_timeout, m_conn, next(connected));
-                else
-                    return net_base::connect(m_connUrl, m_hc->m_timeout, m_conn, next(connected));
+                } else
+                    return net_base::connect(m_connUrl, m_hc->m_timeout, m_conn,
+                        next(m_h2Connector ? h2_start : connected));
             } else {
                 bool socks = m_http_proxy[0] == 's';
 
@@ -620,11 +1189,11 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
                     exlib::string a = m_hc->agent();
                     if (!a.empty())
                         m_reqConn->addHeader("User-Agent", a);
-                }
 
-                if (m_hc->get_conn(m_http_proxy, m_conn)) {
-                    m_reuse = true;
-                    return next(m_ssl ? ssl_connect : connected);
+                    if (m_hc->take_conn(m_http_proxy, m_conn)) {
+                        m_reuse = true;
+                        return next(ssl_connect);
+                    }
                 }
 
                 obj_ptr<Url> u = new Url();
@@ -790,7 +1359,71 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
                     return hr;
             }
 
-            return ss->connect(conn, m_sslhost, m_temp, next(connected));
+            static const char* s_alpn_h2[] = { "h2", "http/1.1", NULL };
+
+            if (m_h2Connector)
+                ss->m_alpn = s_alpn_h2;
+
+            return ss->connect(conn, m_sslhost, m_temp, next(m_h2Connector ? h2_start : connected));
+        }
+
+        ON_STATE(asyncRequest, h2_start)
+        {
+            if (m_ssl) {
+                SslSocket* ss = (SslSocket*)(Stream_base*)m_conn;
+                const char* proto = mbedtls_ssl_get_alpn_protocol(&ss->m_ssl);
+
+                if (!proto || qstrcmp(proto, "h2")) {
+                    // remember the server only speaks HTTP/1.1 so nobody waits for HTTP/2 again
+                    m_h2Connector = false;
+                    m_hc->put_h2(m_connUrl, NULL, true);
+                    return next(connected);
+                }
+            }
+
+            exlib::string buf;
+
+            Http2Client::preface(buf);
+            m_h2 = new Http2Client(m_conn, m_ssl, m_hc->m_maxConcurrentStreams);
+
+            obj_ptr<Buffer_base> data = new Buffer(buf);
+            return m_conn->write(data, next(h2_ready));
+        }
+
+        ON_STATE(asyncRequest, h2_ready)
+        {
+            m_h2->start();
+            m_h2->reserve();
+
+            m_h2Connector = false;
+            m_hc->put_h2(m_connUrl, m_h2, false);
+
+            // the connection belongs to the session now, not to the keep-alive pool
+            release();
+            m_conn.Release();
+
+            return next(h2_request);
+        }
+
+        ON_STATE(asyncRequest, h2_request)
+        {
+            return m_h2->request(m_req, m_response_body, m_hc->m_maxBodySize,
+                m_hc->m_enableEncoding, m_retVal, next(h2_requested));
+        }
+
+        ON_STATE(asyncRequest, h2_requested)
+        {
+            m_h2.Release();
+
+            bool enableCookie;
+            m_hc->get_enableCookie(enableCookie);
+            if (enableCookie) {
+                obj_ptr<NArray> cookies;
+                m_retVal->get_cookies(cookies);
+                m_hc->update_cookies(m_url, cookies);
+            }
+
+            return next(closed);
         }
 
         ON_STATE(asyncRequest, connected)
@@ -810,20 +1443,21 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
 
             bool upgrade;
             m_retVal->get_upgrade(upgrade);
-            if (upgrade)
+            if (upgrade) {
+                release();
                 return next(closed);
+            }
 
             bool keepalive;
             m_retVal->get_keepAlive(keepalive);
             if (keepalive) {
-                if (m_http_proxy.empty() || m_http_proxy[0] == 's' || !m_sslhost.empty())
-                    m_hc->save_conn(m_connUrl, m_conn);
-                else
-                    m_hc->save_conn(m_http_proxy, m_conn);
+                m_slot = false;
+                m_hc->save_conn(m_poolUrl, m_connUrl, m_conn);
 
                 return next(closed);
             }
 
+            release();
             return m_conn->close(next(closed));
         }
 
@@ -863,6 +1497,15 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
         {
             if (m_reuse && (at(ssl_connect) || at(connected))) {
                 m_reuse = false;
+                release();
+                next(prepare);
+                return 0;
+            }
+
+            // a session that went away before taking the stream never saw the request, send it again
+            if (!m_h2Retried && at(h2_request) && v == CALL_E_CLOSED) {
+                m_h2Retried = true;
+                m_h2.Release();
                 next(prepare);
                 return 0;
             }
@@ -870,6 +1513,22 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
             return v;
         }
 
+        void release()
+        {
+            if (m_slot) {
+                m_slot = false;
+                m_hc->release_conn(m_connUrl);
+            }
+        }
+
+        void give_up_h2()
+        {
+            if (m_h2Connector) {
+                m_h2Connector = false;
+                m_hc->put_h2(m_connUrl, NULL, false);
+            }
+        }
+
     private:
         exlib::string m_method;
         obj_ptr<Url> m_u;
@@ -887,10 +1546,16 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
         obj_ptr<HttpRequest> m_req;
         obj_ptr<HttpRequest> m_reqConn;
         exlib::string m_connUrl;
+        exlib::string m_poolUrl;
         obj_ptr<HttpClient> m_hc;
         obj_ptr<Buffer_base> m_buffer;
         int32_t m_temp;
         bool m_reuse;
+        bool m_slot;
+        obj_ptr<Http2Client> m_h2;
+        bool m_h2Connector;
+        bool m_h2Retry;
+        bool m_h2Retried;
     };
 
     if (ac->isSync())
@@ -13,11 +13,238 @@
 
 namespace fibjs {
 
+// names the http module itself looks up on every request, an entry carrying one of them
+// is matched by atom number instead of by string
+static const char* s_atoms[] = {
+    "accept",
+    "accept-encoding",
+    "accept-language",
+    "accept-ranges",
+    "access-control-allow-origin",
+    "authorization",
+    "cache-control",
+    "connection",
+    "content-disposition",
+    "content-encoding",
+    "content-length",
+    "content-range",
+    "content-type",
+    "cookie",
+    "date",
+    "etag",
+    "expires",
+    "host",
+    "http2-settings",
+    "if-modified-since",
+    "if-none-match",
+    "if-range",
+    "last-modified",
+    "location",
+    "origin",
+    "range",
+    "referer",
+    "sec-websocket-key",
+    "sec-websocket-version",
+    "server",
+    "set-cookie",
+    "transfer-encoding",
+    "upgrade",
+    "user-agent",
+    "vary",
+    "x-forwarded-for"
+};
+
+class header_atoms {
+public:
+    header_atoms()
+    {
+        int32_t i;
+
+        for (i = 0; i < ATOM_SLOTS; i++)
+            m_slots[i] = 0;
+
+        for (i = 0; i < (int32_t)ARRAYSIZE(s_atoms); i++) {
+            uint32_t h = header_hash(s_atoms[i], (int32_t)qstrlen(s_atoms[i]));
+            uint32_t n = h & (ATOM_SLOTS - 1);
+
+            while (m_slots[n])
+                n = (n + 1) & (ATOM_SLOTS - 1);
+
+            m_slots[n] = i + 1;
+            m_hashes[n] = h;
+        }
+    }
+
+public:
+    int32_t find(uint32_t h, const char* name, int32_t sz)
+    {
+        uint32_t n;
+
+        for (n = h & (ATOM_SLOTS - 1); m_slots[n]; n = (n + 1) & (ATOM_SLOTS - 1)) {
+            const char* a = s_atoms[m_slots[n] - 1];
+
+            if (m_hashes[n] == h && !qstricmp(a, name, sz) && !a[sz])
+                return m_slots[n];
+        }
+
+        return 0;
+    }
+
+private:
+    static const int32_t ATOM_SLOTS = 128;
+    int32_t m_slots[ATOM_SLOTS];
+    uint32_t m_hashes[ATOM_SLOTS];
+};
+
+inline int32_t header_atom(uint32_t h, const char* name, int32_t sz)
+{
+    static header_atoms s_table;
+    return s_table.find(h, name, sz);
+}
+
+bool HttpCollection::same(key& k, size_t id, const char* n, int32_t sz)
+{
+    key& k1 = m_keys[id];
+
+    if (k1.hash != k.hash)
+        return false;
+
+    if (k.atom || k1.atom)
+        return k.atom == k1.atom;
+
+    int32_t sz1;
+    const char* n1 = name(id, sz1);
+
+    return sz1 == sz && !qstricmp(n1, n, sz);
+}
+
+int32_t HttpCollection::find(const char* n, int32_t sz)
+{
+    if (m_dirty)
+        rebuild();
+
+    if (m_slots.empty())
+        return -1;
+
+    key k;
+    size_t mask = m_slots.size() - 1;
+    size_t i;
+
+    k.hash = header_hash(n, sz);
+    k.atom = header_atom(k.hash, n, sz);
+
+    for (i = k.hash & mask; m_slots[i] >= 0; i = (i + 1) & mask)
+        if (same(k, m_slots[i], n, sz))
+            return m_slots[i];
+
+    return -1;
+}
+
+void HttpCollection::link(size_t id)
+{
+    key& k = m_keys[id];
+    size_t mask = m_slots.size() - 1;
+    int32_t sz;
+    const char* n = name(id, sz);
+    size_t i;
+
+    for (i = k.hash & mask; m_slots[i] >= 0; i = (i + 1) & mask) {
+        int32_t e = m_slots[i];
+
+        if (same(k, e, n, sz)) {
+            while (m_keys[e].next >= 0)
+                e = m_keys[e].next;
+            m_keys[e].next = (int32_t)id;
+            return;
+        }
+    }
+
+    m_slots[i] = (int32_t)id;
+}
+
+void HttpCollection::index(size_t id)
+{
+    if (m_dirty)
+        return;
+
+    // keep the table at most half full
+    if ((id + 1) * 2 > m_slots.size()) {
+        m_dirty = true;
+        return;
+    }
+
+    key& k = m_keys[id];
+    int32_t sz;
+    const char* n = name(id, sz);
+
+    k.hash = header_hash(n, sz);
+    k.atom = header_atom(k.hash, n, sz);
+    k.next = -1;
+
+    link(id);
+}
+
+void HttpCollection::rebuild()
+{
+    size_t cnt = m_slices.empty() ? m_count : m_slices.size();
+    size_t sz = 16;
+    size_t i;
+
+    while (sz < cnt * 2)
+        sz <<= 1;
+
+    m_slots.assign(sz, -1);
+    if (m_keys.size() < sz / 2)
+        m_keys.resize(sz / 2);
+
+    for (i = 0; i < cnt; i++) {
+        key& k = m_keys[i];
+        int32_t szName;
+        const char* n = name(i, szName);
+
+        k.hash = header_hash(n, szName);
+        k.atom = header_atom(k.hash, n, szName);
+        k.next = -1;
+
+        link(i);
+    }
+
+    m_dirty = false;
+}
+
+void HttpCollection::materialize()
+{
+    size_t n = m_slices.size();
+    size_t i;
+
+    if (n == 0)
+        return;
+
+    if (m_map.size() < m_count + n)
+        m_map.resize(m_count + n);
+
+    for (i = m_count; i > 0; i--)
+        std::swap(m_map[i - 1], m_map[i - 1 + n]);
+
+    for (i = 0; i < n; i++) {
+        slice& _slice = m_slices[i];
+        pair& _pair = m_map[i];
+
+        _pair.first.assign(m_raw.c_str() + _slice.name, _slice.szName);
+        _pair.second.assign(m_raw.c_str() + _slice.value, _slice.szValue);
+    }
+
+    m_count += n;
+    m_slices.clear();
+}
+
 size_t HttpCollection::size()
 {
     size_t sz = 0;
     size_t i;
 
+    materialize();
+
     for (i = 0; i < m_count; i++) {
         pair& _pair = m_map[i];
         sz += _pair.first.length() + _pair.second.length() + 4;
@@ -44,6 +271,8 @@ size_t HttpCollection::getData(char* buf, size_t sz)
     size_t pos = 0;
     size_t i;
 
+    materialize();
+
     for (i = 0; i < m_count; i++) {
         pair& _pair = m_map[i];
         exlib::string& n = _pair.first;
@@ -70,6 +299,12 @@ result_t HttpCollection::clear()
 
     m_count = 0;
 
+    m_raw.clear();
+    m_slices.clear();
+
+    m_slots.assign(m_slots.size(), -1);
+    m_dirty = false;
+
     return 0;
 }
 
@@ -191,32 +426,19 @@ result_t HttpCollection::parseCookie(exlib::string& str)
 
 result_t HttpCollection::has(exlib::string name, bool& retVal)
 {
-    size_t i;
-
-    retVal = false;
-    for (i = 0; i < m_count; i++)
-        if (!qstricmp(m_map[i].first.c_str(), name.c_str())) {
-            retVal = true;
-            break;
-        }
-
+    retVal = find(name.c_str(), (int32_t)name.length()) >= 0;
     return 0;
 }
 
 result_t HttpCollection::first(exlib::string name, Variant& retVal)
 {
-    size_t i;
+    exlib::string value;
+    result_t hr = first(name, value);
 
-    for (i = 0; i < m_count; i++) {
-        pair& _pair = m_map[i];
+    if (hr == 0)
+        retVal = value;
 
-        if (!qstricmp(_pair.first.c_str(), name.c_str())) {
-            retVal = _pair.second;
-            return 0;
-        }
-    }
-
-    return CALL_RETURN_NULL;
+    return hr;
 }
 
 result_t HttpCollection::get(exlib::string name, Variant& retVal)
@@ -329,6 +551,11 @@ result_t HttpCollection::remove(exlib::string name)
     size_t i;
     int32_t p = 0;
 
+    if (find(name.c_str(), (int32_t)name.length()) < 0)
+        return 0;
+
+    materialize();
+
     for (i = 0; i < m_count; i++) {
         pair& _pair = m_map[i];
 
@@ -341,6 +568,7 @@ result_t HttpCollection::remove(exlib::string name)
     }
 
     m_count = p;
+    m_dirty = true;
 
     return 0;
 }
@@ -352,10 +580,14 @@ result_t HttpCollection::_delete(exlib::string name)
 
 result_t HttpCollection::sort()
 {
-    if (m_count)
+    materialize();
+
+    if (m_count) {
         std::sort(m_map.begin(), m_map.begin() + m_count, [](pair& a, pair& b) {
             return a.first < b.first;
         });
+        m_dirty = true;
+    }
 
     return 0;
 }
@@ -365,6 +597,8 @@ result_t HttpCollection::keys(obj_ptr<NArray>& retVal)
     obj_ptr<NArray> _keys = new NArray();
     size_t i;
 
+    materialize();
+
     for (i = 0; i < m_count; i++)
         _keys->append(m_map[i].first);
 
@@ -378,6 +612,8 @@ result_t HttpCollection::values(obj_ptr<NArray>& retVal)
     obj_ptr<NArray> _keys = new NArray();
     size_t i;
 
+    materialize();
+
     for (i = 0; i < m_count; i++)
         _keys->append(m_map[i].second);
 
@@ -387,31 +623,32 @@ result_t HttpCollection::values(obj_ptr<NArray>& retVal)
 
 result_t HttpCollection::_named_getter(exlib::string property, Variant& retVal)
 {
-    size_t i;
     int32_t n = 0;
     Variant v;
     v8::Local<v8::Array> a;
     Isolate* isolate = holder();
     v8::Local<v8::Context> context = isolate->context();
-
-    for (i = 0; i < m_count; i++) {
-        pair& _pair = m_map[i];
-
-        if (!qstricmp(_pair.first.c_str(), property.c_str())) {
-            if (n == 0) {
-                v = _pair.second;
-                n = 1;
-            } else {
-                if (n == 1) {
-                    a = v8::Array::New(isolate->m_isolate);
-                    a->Set(context, 0, v).IsJust();
-                    v = a;
-                }
-
-                Variant t = _pair.second;
-                a->Set(context, n++, t).IsJust();
+    int32_t id = find(property.c_str(), (int32_t)property.length());
+
+    while (id >= 0) {
+        exlib::string s;
+
+        value(id, s);
+        if (n == 0) {
+            v = s;
+            n = 1;
+        } else {
+            if (n == 1) {
+                a = v8::Array::New(isolate->m_isolate);
+                a->Set(context, 0, v).IsJust();
+                v = a;
             }
+
+            Variant t = s;
+            a->Set(context, n++, t).IsJust();
         }
+
+        id = m_keys[id].next;
     }
 
     if (n > 0) {
@@ -430,6 +667,8 @@ result_t HttpCollection::_named_enumerator(v8::Local<v8::Array>& retVal)
     Isolate* isolate = holder();
     v8::Local<v8::Context> context = isolate->context();
 
+    materialize();
+
     retVal = v8::Array::New(isolate->m_isolate);
     for (i = 0, n = 0; i < m_count; i++) {
         exlib::string& name = m_map[i].first;
@@ -448,6 +687,8 @@ result_t HttpCollection::_named_setter(exlib::string property, Variant newVal)
 result_t HttpCollection::_named_deleter(exlib::string property,
     v8::Local<v8::Boolean>& retVal)
 {
+    materialize();
+
     size_t n = m_count;
     remove(property);
     return n > m_count;
@@ -13,6 +13,7 @@
 #include "HttpFileHandler.h"
 #include "RangeStream.h"
 #include "HttpRequest.h"
+#include "HttpHandler.h"
 #include "Url.h"
 #include "Buffer.h"
 #include "MemoryStream.h"
@@ -1178,6 +1179,145 @@ static int32_t mt_cmp(const void* p, const void* q)
     return qstricmp(*(const char**)p, *(const char**)q);
 }
 
+// precompressed files served in place of the original, in order of preference
+static const char* s_sidecarCodings[] = {
+    "br",
+    "zstd",
+    "gzip"
+};
+
+static const char* s_sidecarExts[] = {
+    ".br",
+    ".zst",
+    ".gz"
+};
+
+#define FILE_CACHE_TTL 1000
+#define FILE_CACHE_SIZE 4096
+
+obj_ptr<HttpFileHandler::file_info> HttpFileHandler::get_info(const exlib::string& path)
+{
+    obj_ptr<file_info> fi;
+    date_t now;
+
+    now.now();
+
+    m_lock.lock();
+    std::map<exlib::string, obj_ptr<file_info>>::iterator it = m_cache.find(path);
+    if (it != m_cache.end()) {
+        if (now.diff(it->second->m_checked) < FILE_CACHE_TTL)
+            fi = it->second;
+        else
+            m_cache.erase(it);
+    }
+    m_lock.unlock();
+
+    return fi;
+}
+
+void HttpFileHandler::set_info(const exlib::string& path, file_info* fi)
+{
+    m_lock.lock();
+    if (m_cache.size() >= FILE_CACHE_SIZE) {
+        std::map<exlib::string, obj_ptr<file_info>>::iterator it = m_cache.begin();
+
+        while (it != m_cache.end())
+            if (fi->m_checked.diff(it->second->m_checked) >= FILE_CACHE_TTL)
+                m_cache.erase(it++);
+            else
+                it++;
+
+        if (m_cache.size() >= FILE_CACHE_SIZE)
+            m_cache.clear();
+    }
+    m_cache[path] = fi;
+    m_lock.unlock();
+}
+
+#define HOT_FILE_SIZE 65536
+#define HOT_CACHE_SIZE (16 * 1024 * 1024)
+
+bool HttpFileHandler::get_hot(const exlib::string& path, const exlib::string& etag, exlib::string& retVal)
+{
+    bool bFound = false;
+
+    m_lock.lock();
+    std::map<exlib::string, std::list<obj_ptr<hot_file>>::iterator>::iterator it = m_hotIndex.find(path);
+    if (it != m_hotIndex.end()) {
+        hot_file* hf = *it->second;
+
+        if (hf->m_etag == etag) {
+            m_hot.splice(m_hot.begin(), m_hot, it->second);
+            retVal = hf->m_data;
+            bFound = true;
+        }
+    }
+    m_lock.unlock();
+
+    return bFound;
+}
+
+void HttpFileHandler::set_hot(const exlib::string& path, const exlib::string& etag, const exlib::string& data)
+{
+    obj_ptr<hot_file> hf = new hot_file();
+
+    hf->m_path = path;
+    hf->m_etag = etag;
+    hf->m_data = data;
+
+    m_lock.lock();
+    std::map<exlib::string, std::list<obj_ptr<hot_file>>::iterator>::iterator it = m_hotIndex.find(path);
+    if (it != m_hotIndex.end()) {
+        m_hotSize -= (*it->second)->m_data.length();
+        m_hot.erase(it->second);
+    }
+
+    m_hot.push_front(hf);
+    m_hotIndex[path] = m_hot.begin();
+    m_hotSize += data.length();
+
+    while (m_hotSize > HOT_CACHE_SIZE) {
+        hot_file* last = m_hot.back();
+
+        m_hotSize -= last->m_data.length();
+        m_hotIndex.erase(last->m_path);
+        m_hot.pop_back();
+    }
+    m_lock.unlock();
+}
+
+// If-None-Match uses the weak comparison, so a W/ prefix on either side is ignored
+static bool etag_match(const exlib::string& tags, const exlib::string& etag)
+{
+    const char* p = tags.c_str();
+    const char* tag = etag.c_str();
+    size_t len = etag.length();
+
+    if (!qstrcmp(tag, "W/", 2)) {
+        tag += 2;
+        len -= 2;
+    }
+
+    while (*p) {
+        while (*p == ',' || *p == ' ' || *p == '\t')
+            p++;
+
+        if (*p == '*')
+            return true;
+
+        if (!qstrcmp(p, "W/", 2))
+            p += 2;
+
+        if (!qstrcmp(p, tag, len) && (!p[len] || p[len] == ',' || p[len] == ' ' || p[len] == '\t'))
+            return true;
+
+        while (*p && *p != ',')
+            p++;
+    }
+
+    return false;
+}
+
 result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
     AsyncEvent* ac)
 {
@@ -1191,6 +1331,9 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             , m_autoIndex(autoIndex)
             , m_index(false)
             , m_dirPos(0)
+            , m_coding(-1)
+            , m_sidecarPos(0)
+            , m_bHot(false)
         {
             req->get_response(m_rep);
             m_req->get_value(m_value);
@@ -1226,7 +1369,55 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                 m_index = true;
             }
 
-            return fs_base::openFile(m_path, "r", m_file, next(open));
+            exlib::string accept;
+            bool bRange = false;
+
+            m_req->hasHeader("Range", bRange);
+            if (!bRange && m_req->firstHeader("Accept-Encoding", accept) != CALL_RETURN_NULL) {
+                int32_t q[ARRAYSIZE(s_sidecarCodings)];
+                int32_t i, j;
+
+                HttpHandler::accept_encoding(accept.c_str(), s_sidecarCodings,
+                    ARRAYSIZE(s_sidecarCodings), q);
+
+                for (i = 0; i < (int32_t)ARRAYSIZE(s_sidecarCodings); i++)
+                    if (q[i] > 0) {
+                        for (j = (int32_t)m_sidecars.size(); j > 0 && q[m_sidecars[j - 1]] < q[i]; j--)
+                            ;
+                        m_sidecars.insert(m_sidecars.begin() + j, i);
+                    }
+            }
+
+            return next(sidecar);
+        }
+
+        ON_STATE(asyncInvoke, sidecar)
+        {
+            m_open = m_path;
+            if (m_sidecarPos < m_sidecars.size()) {
+                m_coding = m_sidecars[m_sidecarPos++];
+                m_open.append(s_sidecarExts[m_coding]);
+            } else
+                m_coding = -1;
+
+            m_info = m_pThis->get_info(m_open);
+            if (m_info) {
+                exlib::string data;
+
+                if (!m_info->m_exists)
+                    return CALL_E_FILE_NOT_FOUND;
+
+                if (!modified())
+                    return not_modified();
+
+                if (m_pThis->get_hot(m_open, m_info->m_etag, data)) {
+                    m_file = new MemoryStream::CloneStream(data, m_info->m_mtime);
+                    m_bHot = true;
+                    return next(open);
+                }
+            }
+
+            return fs_base::openFile(m_open, "r", m_file, next(open));
         }
 
         ON_STATE(asyncInvoke, stop)
@@ -1323,8 +1514,10 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
         {
             exlib::string ext;
 
+            // the type comes from the requested url, the cached info belongs to the opened file
+            // and may be a sidecar shared with a direct request for it
             if (m_index)
-                m_rep->addHeader("Content-Type", "text/html");
+                m_type = "text/html";
             else {
                 path_base::extname(m_url, ext);
 
@@ -1334,7 +1527,7 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                     std::map<exlib::string, exlib::string>::iterator it = _mimes.find(pKey);
 
                     if (it != _mimes.end())
-                        m_rep->addHeader("Content-Type", it->second);
+                        m_type = it->second;
                     else {
                         const MimeType* pMimeType = (const MimeType*)bsearch(&pKey,
                             &s_mimeTypes, ARRAYSIZE(s_mimeTypes), sizeof(s_defType), mt_cmp);
@@ -1342,40 +1535,84 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                         if (!pMimeType)
                             pMimeType = &s_defType;
 
-                        m_rep->addHeader("Content-Type", pMimeType->type);
+                        m_type = pMimeType->type;
                     }
                 }
+            }
+
+            if (!m_type.empty())
+                m_rep->addHeader("Content-Type", m_type);
+            if (!m_index)
                 m_rep->addHeader("Accept-Ranges", "bytes");
+
+            if (m_coding >= 0) {
+                m_rep->addHeader("Content-Encoding", s_sidecarCodings[m_coding]);
+                m_rep->addHeader("Vary", "Accept-Encoding");
             }
 
+            if (m_info)
+                return next(stat);
+
             return m_file->stat(m_stat, next(stat));
         }
 
         ON_STATE(asyncInvoke, stat)
         {
-            date_t d;
-            exlib::string str;
+            if (!m_info) {
+                double sz;
+                char s[64];
 
-            m_stat->get_mtime(d);
+                m_info = new HttpFileHandler::file_info();
+                m_info->m_exists = true;
 
-            exlib::string lastModified;
-            if (m_req->firstHeader("If-Modified-Since", lastModified)
-                != CALL_RETURN_NULL) {
-                date_t d1;
-                double diff;
+                m_stat->get_mtime(m_info->m_mtime);
+                m_info->m_mtime.toGMTString(m_info->m_lastModified);
 
-                d1.parse(lastModified);
-                diff = d.diff(d1);
+                m_stat->get_size(sz);
+                m_info->m_size = (int64_t)sz;
+                snprintf(s, sizeof(s), "\"%" PRIx64 "-%" PRIx64 "\"",
+                    (int64_t)m_info->m_mtime.date(), m_info->m_size);
+                m_info->m_etag = s;
 
-                if (diff > -1000 && diff < 1000) {
-                    m_rep->set_statusCode(304);
-                    return next(CALL_RETURN_NULL);
-                }
+                m_pThis->set_info(m_open, m_info);
+
+                if (!modified())
+                    return not_modified();
             }
 
-            d.toGMTString(lastModified);
+            if (!m_bHot && m_info->m_size > 0 && m_info->m_size <= HOT_FILE_SIZE) {
+                exlib::string data;
+
+                if (!m_pThis->get_hot(m_open, m_info->m_etag, data))
+                    return m_file->readAll(m_buf, next(hot));
+
+                m_file = new MemoryStream::CloneStream(data, m_info->m_mtime);
+                m_bHot = true;
+            }
+
+            return next(send);
+        }
+
+        ON_STATE(asyncInvoke, hot)
+        {
+            exlib::string data;
+
+            if (m_buf)
+                m_buf->toString(data);
+
+            if ((int64_t)data.length() == m_info->m_size) {
+                m_pThis->set_hot(m_open, m_info->m_etag, data);
+                m_file = new MemoryStream::CloneStream(data, m_info->m_mtime);
+            } else
+                m_file->rewind();
+
+            return next(send);
+        }
 
-            m_rep->addHeader("Last-Modified", lastModified);
+        ON_STATE(asyncInvoke, send)
+        {
+            m_rep->addHeader("Last-Modified", m_info->m_lastModified);
+            m_rep->addHeader("ETag", etag());
 
             exlib::string range;
             if (m_req->firstHeader("Range", range) != CALL_RETURN_NULL) {
@@ -1416,9 +1653,61 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             return next(CALL_RETURN_NULL);
         }
 
+        // a sidecar is another representation of the url, it gets an ETag of its own
+        exlib::string etag()
+        {
+            exlib::string tag(m_info->m_etag);
+
+            if (m_coding >= 0 && tag.length() > 1) {
+                tag.resize(tag.length() - 1);
+                tag.append(1, '-');
+                tag.append(s_sidecarCodings[m_coding]);
+                tag.append(1, '\"');
+            }
+
+            return tag;
+        }
+
+        bool modified()
+        {
+            exlib::string str;
+
+            if (m_req->firstHeader("If-None-Match", str) != CALL_RETURN_NULL)
+                return !etag_match(str, etag());
+
+            if (m_req->firstHeader("If-Modified-Since", str) != CALL_RETURN_NULL) {
+                date_t d1;
+                double diff;
+
+                d1.parse(str);
+                diff = m_info->m_mtime.diff(d1);
+
+                return diff <= -1000 || diff >= 1000;
+            }
+
+            return true;
+        }
+
+        int32_t not_modified()
+        {
+            m_rep->set_statusCode(304);
+            m_rep->addHeader("ETag", etag());
+            if (m_coding >= 0)
+                m_rep->addHeader("Vary", "Accept-Encoding");
+
+            return next(CALL_RETURN_NULL);
+        }
+
         virtual int32_t error(int32_t v)
         {
-            if (at(start)) {
+            if (at(sidecar)) {
+                if (m_coding >= 0) {
+                    // remember missing sidecars, a miss on the file itself is left to the file system
+                    if (!m_info || m_info->m_exists)
+                        m_pThis->set_info(m_open, new HttpFileHandler::file_info());
+                    return next(sidecar);
+                }
+
                 if (m_index) {
                     m_index = false;
 
@@ -1444,6 +1733,14 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
         bool m_index;
         obj_ptr<NArray> m_dir;
         int32_t m_dirPos;
+        std::vector<int32_t> m_sidecars;
+        int32_t m_coding;
+        size_t m_sidecarPos;
+        exlib::string m_open;
+        exlib::string m_type;
+        obj_ptr<HttpFileHandler::file_info> m_info;
+        obj_ptr<Buffer_base> m_buf;
+        bool m_bHot;
     };
 
     if (ac->isSync())
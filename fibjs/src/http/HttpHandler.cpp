@@ -8,11 +8,14 @@
 #include "object.h"
 #include "HttpHandler.h"
 #include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "Http2Session.h"
 #include "BufferedStream.h"
 #include "JSHandler.h"
 #include "ifs/mq.h"
 #include "Buffer.h"
 #include "MemoryStream.h"
+#include "ZlibStream.h"
 #include "version.h"
 #include "ifs/zlib.h"
 #include "ifs/console.h"
@@ -586,6 +589,172 @@ static int32_t mt_cmp(const void* p, const void* q)
     return qstricmp(*(const char**)p, *(const char**)q);
 }
 
+// in order of preference when the client gives several codings the same q value
+static const char* s_codings[] = {
+    "gzip",
+    "deflate"
+};
+
+inline bool is_blank(char ch)
+{
+    return ch == ' ' || ch == '\t';
+}
+
+// q value in thousandths
+static int32_t qvalue(const char*& p)
+{
+    int32_t v = 0;
+    int32_t mul = 100;
+
+    if (*p == '1')
+        v = 1000;
+    else if (*p != '0')
+        return 0;
+    p++;
+
+    if (*p == '.') {
+        p++;
+        while (qisdigit(*p)) {
+            v += (*p - '0') * mul;
+            mul /= 10;
+            p++;
+        }
+    }
+
+    return v > 1000 ? 1000 : v;
+}
+
+void HttpHandler::accept_encoding(const char* p, const char* const* codings, int32_t count, int32_t* q)
+{
+    int32_t qAny = -1;
+    int32_t i;
+
+    for (i = 0; i < count; i++)
+        q[i] = -1;
+
+    while (*p) {
+        while (*p == ',' || is_blank(*p))
+            p++;
+
+        const char* name = p;
+        while (*p && *p != ',' && *p != ';' && !is_blank(*p))
+            p++;
+        size_t len = p - name;
+
+        int32_t v = 1000;
+        while (*p && *p != ',') {
+            if (*p++ != ';')
+                continue;
+
+            while (is_blank(*p))
+                p++;
+            if ((*p == 'q' || *p == 'Q') && p[1] == '=') {
+                p += 2;
+                v = qvalue(p);
+            }
+        }
+
+        if (len == 1 && *name == '*')
+            qAny = v;
+        else if (len > 0)
+            for (i = 0; i < count; i++)
+                if (!qstricmp(name, codings[i], len) && !codings[i][len])
+                    q[i] = v;
+    }
+
+    for (i = 0; i < count; i++)
+        if (q[i] < 0)
+            q[i] = qAny > 0 ? qAny : 0;
+}
+
+#define CHUNK_WINDOW 16384
+#define PIPELINE_WINDOW (4 * 1024 * 1024)
+
+// frames what is written to it as HTTP/1.1 chunks of up to CHUNK_WINDOW bytes, close() ends the body
+// but leaves the connection open
+class ChunkedStream : public Stream_base {
+public:
+    ChunkedStream(Stream_base* stm)
+        : m_stm(stm)
+    {
+    }
+
+public:
+    // Stream_base
+    virtual result_t get_fd(int32_t& retVal)
+    {
+        return CALL_E_INVALID_CALL;
+    }
+
+    virtual result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+    {
+        return CALL_E_INVALID_CALL;
+    }
+
+    virtual result_t write(Buffer_base* data, AsyncEvent* ac)
+    {
+        exlib::string buf;
+
+        data->toString(buf);
+        m_buf.append(buf);
+
+        if (m_buf.length() < CHUNK_WINDOW)
+            return 0;
+
+        return send(false, ac);
+    }
+
+    virtual result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac)
+    {
+        return stream_writev(this, datas, ac);
+    }
+
+    virtual result_t flush(AsyncEvent* ac)
+    {
+        if (m_buf.empty())
+            return 0;
+
+        return send(false, ac);
+    }
+
+    virtual result_t close(AsyncEvent* ac)
+    {
+        return send(true, ac);
+    }
+
+    virtual result_t copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac)
+    {
+        return CALL_E_INVALID_CALL;
+    }
+
+private:
+    result_t send(bool end, AsyncEvent* ac)
+    {
+        exlib::string buf;
+
+        if (!m_buf.empty()) {
+            char head[32];
+
+            snprintf(head, sizeof(head), "%x\r\n", (int32_t)m_buf.length());
+            buf.append(head);
+            buf.append(m_buf);
+            buf.append("\r\n", 2);
+            m_buf.clear();
+        }
+
+        if (end)
+            buf.append("0\r\n\r\n", 5);
+
+        m_out = new Buffer(buf);
+        return m_stm->write(m_out, ac);
+    }
+
+private:
+    obj_ptr<Stream_base> m_stm;
+    obj_ptr<Buffer_base> m_out;
+    exlib::string m_buf;
+};
+
 result_t HttpHandler_base::_new(Handler_base* hdlr, obj_ptr<HttpHandler_base>& retVal,
     v8::Local<v8::Object> This)
 {
@@ -603,14 +772,291 @@ HttpHandler::HttpHandler()
     , m_maxHeadersCount(128)
     , m_maxBodySize(64)
     , m_enableEncoding(false)
+    , m_encodingLevel(-1)
+    , m_encodingThreshold(128)
+    , m_enableHttp2(false)
+    , m_maxPipeline(8)
 {
     m_serverName = "fibjs/";
     m_serverName.append(fibjs_version);
 }
 
+bool HttpHandler::preflight(HttpRequest_base* req, HttpResponse_base* rep)
+{
+    if (!m_crossDomain)
+        return false;
+
+    exlib::string origin;
+
+    if (req->firstHeader("origin", origin) == CALL_RETURN_NULL)
+        return false;
+
+    rep->setHeader("Access-Control-Allow-Credentials", "true");
+    rep->setHeader("Access-Control-Allow-Origin", origin);
+
+    exlib::string str;
+
+    req->get_method(str);
+    if (qstricmp(str.c_str(), "options"))
+        return false;
+
+    rep->setHeader("Access-Control-Allow-Methods", "*");
+    rep->setHeader("Access-Control-Allow-Headers", m_allowHeaders);
+    rep->setHeader("Access-Control-Max-Age", "1728000");
+
+    return true;
+}
+
+void HttpHandler::fillHeaders(HttpRequest_base* req, HttpResponse_base* rep, bool options)
+{
+    int32_t s;
+    bool t = false;
+    exlib::string str;
+
+    if (rep->firstHeader("Server", str) == CALL_RETURN_NULL)
+        rep->addHeader("Server", m_serverName);
+
+    rep->get_statusCode(s);
+    if (s == 200 && !options) {
+        rep->hasHeader("Last-Modified", t);
+        if (!t && (rep->firstHeader("Cache-Control", str) == CALL_RETURN_NULL)) {
+            rep->addHeader("Cache-Control", "no-cache, no-store");
+            rep->addHeader("Expires", "-1");
+        }
+    }
+}
+
+int32_t HttpHandler::encoding(HttpRequest_base* req, HttpResponse_base* rep, bool bStream)
+{
+    int64_t len;
+
+    if (!m_enableEncoding)
+        return 0;
+
+    rep->get_length(len);
+    if (len <= m_encodingThreshold || (!bStream && len >= 1024 * 1024 * 64))
+        return 0;
+
+    exlib::string hdr;
+    int32_t type;
+
+    if (req->firstHeader("Accept-Encoding", hdr) == CALL_RETURN_NULL)
+        return 0;
+
+    int32_t q[ARRAYSIZE(s_codings)];
+    int32_t i, best = 0;
+
+    accept_encoding(hdr.c_str(), s_codings, ARRAYSIZE(s_codings), q);
+
+    type = 0;
+    for (i = 0; i < (int32_t)ARRAYSIZE(s_codings); i++)
+        if (q[i] > best) {
+            best = q[i];
+            type = i + 1;
+        }
+
+    if (type == 0)
+        return 0;
+
+    if (rep->firstHeader("Content-Type", hdr) == CALL_RETURN_NULL)
+        return 0;
+
+    const char* pKey = hdr.c_str();
+    if (qstricmp(hdr.c_str(), "text/", 5)
+        && !bsearch(&pKey, &s_zipTypes, ARRAYSIZE(s_zipTypes),
+            sizeof(pKey), mt_cmp))
+        return 0;
+
+    if (rep->firstHeader("Content-Encoding", hdr) != CALL_RETURN_NULL)
+        return 0;
+
+    rep->addHeader("Content-Encoding", s_codings[type - 1]);
+    return type;
+}
+
+ZlibStream* HttpHandler::encoder(int32_t type, Stream_base* stm)
+{
+    if (type == 1)
+        return new gz(stm, m_encodingLevel);
+    return new def(stm, m_encodingLevel);
+}
+
 result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
     AsyncEvent* ac)
 {
+    // requests read from the connection while an earlier one is still being handled, kept in arrival order.
+    // reading ahead stops at maxPipeline requests or once the queued bodies hold PIPELINE_WINDOW bytes
+    class HttpPipeline : public obj_base {
+    public:
+        HttpPipeline(HttpHandler* hdlr, BufferedStream_base* stm)
+            : m_hdlr(hdlr)
+            , m_stm(stm)
+            , m_waiter(NULL)
+            , m_bytes(0)
+            , m_reading(false)
+            , m_stop(false)
+        {
+        }
+
+    private:
+        class asyncRead : public AsyncEvent {
+        public:
+            asyncRead(HttpPipeline* pipe, HttpRequest_base* req)
+                : m_pipe(pipe)
+                , m_req(req)
+            {
+                setAsync();
+            }
+
+        public:
+            virtual int32_t post(int32_t v)
+            {
+                m_pipe->done(m_req, v);
+                delete this;
+                return 0;
+            }
+
+        private:
+            obj_ptr<HttpPipeline> m_pipe;
+            obj_ptr<HttpRequest_base> m_req;
+        };
+
+        struct item {
+            obj_ptr<HttpRequest_base> req;
+            result_t hr;
+            int64_t bytes;
+        };
+
+    public:
+        // the bytes behind an upgrade or a closing request do not belong to the HTTP/1.x parser
+        static bool can_follow(HttpRequest_base* req)
+        {
+            bool bKeepAlive = false;
+            bool bUpgrade = false;
+            exlib::string str;
+
+            req->get_keepAlive(bKeepAlive);
+            if (!bKeepAlive)
+                return false;
+
+            req->hasHeader("Upgrade", bUpgrade);
+            if (bUpgrade)
+                return false;
+
+            req->get_method(str);
+            return qstricmp(str.c_str(), "PRI") && qstricmp(str.c_str(), "CONNECT");
+        }
+
+        // req was read by the caller itself, so it is the last request taken from the stream
+        void follow(HttpRequest_base* req)
+        {
+            bool stop = !can_follow(req);
+
+            m_lock.lock();
+            m_stop = stop;
+            m_lock.unlock();
+        }
+
+        void read_ahead()
+        {
+            m_lock.lock();
+            if (m_reading || m_stop || !room()) {
+                m_lock.unlock();
+                return;
+            }
+            m_reading = true;
+            m_lock.unlock();
+
+            start();
+        }
+
+        // returns the result of a queued read, CALL_E_PENDDING when ac will be posted after the
+        // pending read finishes, or CALL_E_EMPTY when the caller has to read by itself
+        result_t pop(obj_ptr<HttpRequest_base>& req, AsyncEvent* ac)
+        {
+            result_t hr;
+
+            m_lock.lock();
+            if (!m_queue.empty()) {
+                req = m_queue.front().req;
+                hr = m_queue.front().hr;
+                m_bytes -= m_queue.front().bytes;
+                m_queue.pop_front();
+                m_lock.unlock();
+                return hr;
+            }
+
+            if (m_reading) {
+                m_waiter = ac;
+                m_lock.unlock();
+                return CALL_E_PENDDING;
+            }
+            m_lock.unlock();
+
+            return CALL_E_EMPTY;
+        }
+
+    private:
+        // called with m_lock held
+        bool room()
+        {
+            return (int32_t)m_queue.size() < m_hdlr->m_maxPipeline && m_bytes < PIPELINE_WINDOW;
+        }
+
+        void start()
+        {
+            obj_ptr<HttpRequest_base> req = new HttpRequest();
+
+            req->set_maxHeadersCount(m_hdlr->m_maxHeadersCount);
+            req->set_maxBodySize(m_hdlr->m_maxBodySize);
+
+            asyncRead* ev = new asyncRead(this, req);
+            result_t hr = req->readFrom(m_stm, ev);
+            if (hr != CALL_E_PENDDING)
+                ev->post(hr);
+        }
+
+        void done(HttpRequest_base* req, result_t hr)
+        {
+            AsyncEvent* ac;
+            bool more = false;
+            int64_t bytes = 0;
+
+            if (hr == 0)
+                req->get_length(bytes);
+
+            m_lock.lock();
+            m_queue.push_back({ req, hr, bytes });
+            m_bytes += bytes;
+            m_reading = false;
+
+            if (hr != 0 || !can_follow(req))
+                m_stop = true;
+            else if (room())
+                more = m_reading = true;
+
+            ac = m_waiter;
+            m_waiter = NULL;
+            m_lock.unlock();
+
+            if (more)
+                start();
+
+            if (ac)
+                ac->post(0);
+        }
+
+    private:
+        obj_ptr<HttpHandler> m_hdlr;
+        obj_ptr<BufferedStream_base> m_stm;
+        exlib::spinlock m_lock;
+        std::list<item> m_queue;
+        AsyncEvent* m_waiter;
+        int64_t m_bytes;
+        bool m_reading;
+        bool m_stop;
+    };
+
     class asyncInvoke : public AsyncState {
     public:
         asyncInvoke(HttpHandler* pThis, Stream_base* stm, AsyncEvent* ac)
@@ -618,10 +1064,13 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             , m_pThis(pThis)
             , m_stm(stm)
             , m_options(false)
+            , m_queued(false)
         {
             m_stmBuffered = new BufferedStream(stm);
             m_stmBuffered->set_EOL("\r\n");
 
+            m_pipe = new HttpPipeline(pThis, m_stmBuffered);
+
             m_req = new HttpRequest();
             m_req->get_response(m_rep);
 
@@ -645,6 +1094,26 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             m_zip.Release();
             m_body.Release();
 
+            // a read ahead still in flight posts back into this state
+            obj_ptr<HttpRequest_base> req;
+            result_t hr;
+
+            next(read);
+            hr = m_pipe->pop(req, this);
+            if (hr == CALL_E_PENDDING)
+                return hr;
+
+            if (hr != CALL_E_EMPTY) {
+                m_queued = true;
+                m_req = req;
+                m_req->get_response(m_rep);
+
+                if (hr < 0)
+                    return hr;
+                return next(invoke, hr);
+            }
+
+            m_queued = false;
             m_req->clear();
             return m_req->readFrom(m_stmBuffered, next(invoke));
         }
@@ -656,6 +1125,31 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
 
             exlib::string str;
 
+            if (m_pThis->m_enableHttp2) {
+                m_req->get_method(str);
+                if (str == "PRI") {
+                    // prior knowledge, the preface line parses as a request without headers
+                    m_req->get_protocol(str);
+                    if (str == "HTTP/2.0") {
+                        m_h2 = new Http2Session(m_pThis, m_stm, m_stmBuffered);
+                        return m_h2->run(NULL, next(h2));
+                    }
+                } else if (m_req->firstHeader("Upgrade", str) != CALL_RETURN_NULL
+                    && !qstricmp(str.c_str(), "h2c")) {
+                    bool bSettings = false;
+
+                    m_req->hasHeader("HTTP2-Settings", bSettings);
+                    if (bSettings) {
+                        m_buf = new Buffer("HTTP/1.1 101 Switching Protocols\r\nConnection: Upgrade\r\nUpgrade: h2c\r\n\r\n");
+                        return m_stm->write(m_buf, next(h2c));
+                    }
+                }
+            }
+
+            if (!m_queued)
+                m_pipe->follow(m_req);
+            m_pipe->read_ahead();
+
             m_req->get_protocol(str);
             m_rep->set_protocol(str);
 
@@ -666,28 +1160,9 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
 
             m_d.now();
 
-            if (m_pThis->m_crossDomain) {
-                m_req->get_address(str);
-
-                exlib::string origin;
-
-                if (m_req->firstHeader("origin", origin) != CALL_RETURN_NULL) {
-                    m_rep->setHeader("Access-Control-Allow-Credentials", "true");
-                    m_rep->setHeader("Access-Control-Allow-Origin", origin);
-
-                    m_req->get_method(str);
-
-                    if (!qstricmp(str.c_str(), "options")) {
-                        m_options = true;
-
-                        m_rep->setHeader("Access-Control-Allow-Methods", "*");
-                        m_rep->setHeader("Access-Control-Allow-Headers",
-                            m_pThis->m_allowHeaders);
-                        m_rep->setHeader("Access-Control-Max-Age", "1728000");
-
-                        return next(send);
-                    }
-                }
+            if (m_pThis->preflight(m_req, m_rep)) {
+                m_options = true;
+                return next(send);
             }
 
             return mq_base::invoke(m_pThis->m_hdlr, m_req, next(send));
@@ -695,24 +1170,9 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
 
         ON_STATE(asyncInvoke, send)
         {
-            int32_t s;
-            bool t = false;
-            date_t d;
             exlib::string str;
 
-            if (m_rep->firstHeader("Server", str) == CALL_RETURN_NULL)
-                m_rep->addHeader("Server", m_pThis->m_serverName);
-
-            d.now();
-
-            m_rep->get_statusCode(s);
-            if (s == 200 && !m_options) {
-                m_rep->hasHeader("Last-Modified", t);
-                if (!t && (m_rep->firstHeader("Cache-Control", str) == CALL_RETURN_NULL)) {
-                    m_rep->addHeader("Cache-Control", "no-cache, no-store");
-                    m_rep->addHeader("Expires", "-1");
-                }
-            }
+            m_pThis->fillHeaders(m_req, m_rep, m_options);
 
             m_req->get_method(str);
             bool headOnly = !qstricmp(str.c_str(), "head");
@@ -722,56 +1182,42 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                 return m_rep->sendHeader(m_stm, next(end));
             }
 
-            int64_t len;
-
-            m_rep->get_length(len);
-
-            if (m_pThis->m_enableEncoding && len > 128 && len < 1024 * 1024 * 64) {
-                exlib::string hdr;
-
-                if (m_req->firstHeader("Accept-Encoding", hdr) != CALL_RETURN_NULL) {
-                    int32_t type = 0;
-
-                    if (qstristr(hdr.c_str(), "gzip"))
-                        type = 1;
-                    else if (qstristr(hdr.c_str(), "deflate"))
-                        type = 2;
-
-                    if (type != 0) {
-                        if (m_rep->firstHeader("Content-Type", hdr) != CALL_RETURN_NULL) {
-                            const char* pKey = hdr.c_str();
-                            if (qstricmp(hdr.c_str(), "text/", 5)
-                                && !bsearch(&pKey, &s_zipTypes, ARRAYSIZE(s_zipTypes),
-                                    sizeof(pKey), mt_cmp))
-                                type = 0;
-                        } else
-                            type = 0;
-                    }
-
-                    if (type != 0) {
-                        if (m_rep->firstHeader("Content-Encoding", hdr) != CALL_RETURN_NULL)
-                            type = 0;
-                    }
+            // HTTP/1.1 responses are compressed while they are sent, HTTP/1.0 has no chunked framing
+            // so the compressed body is collected first to get its length
+            m_rep->get_protocol(str);
+            bool bChunked = (str[5] - '0') * 10 + (str[7] - '0') > 10;
 
-                    if (type != 0) {
-                        m_rep->addHeader("Content-Encoding", type == 1 ? "gzip" : "deflate");
-
-                        m_rep->get_body(m_body);
-                        m_body->rewind();
+            int32_t type = m_pThis->encoding(m_req, m_rep, bChunked);
+            if (type != 0) {
+                m_rep->get_body(m_body);
+                m_body->rewind();
 
-                        m_zip = new MemoryStream();
+                if (bChunked) {
+                    ((HttpResponse*)(HttpResponse_base*)m_rep)->m_message->m_chunked = true;
 
-                        if (type == 1)
-                            return zlib_base::gzipTo(m_body, m_zip, next(zip));
-                        else
-                            return zlib_base::deflateTo(m_body, m_zip, -1, next(zip));
-                    }
+                    m_chunk = new ChunkedStream(m_stm);
+                    m_encoder = m_pThis->encoder(type, m_chunk);
+                    return m_rep->sendHeader(m_stm, next(zip_body));
                 }
+
+                m_zip = new MemoryStream();
+                m_encoder = m_pThis->encoder(type, m_zip);
+                return m_encoder->process(m_body, next(zip));
             }
 
             return m_rep->sendTo(m_stm, next(end));
         }
 
+        ON_STATE(asyncInvoke, zip_body)
+        {
+            return m_encoder->process(m_body, next(zip_end));
+        }
+
+        ON_STATE(asyncInvoke, zip_end)
+        {
+            return m_chunk->close(next(end));
+        }
+
         ON_STATE(asyncInvoke, zip)
         {
             m_rep->set_body(m_zip);
@@ -789,6 +1235,17 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             return m_body->close(next(read));
         }
 
+        ON_STATE(asyncInvoke, h2c)
+        {
+            m_h2 = new Http2Session(m_pThis, m_stm, m_stmBuffered);
+            return m_h2->run(m_req, next(h2));
+        }
+
+        ON_STATE(asyncInvoke, h2)
+        {
+            return next(CALL_RETURN_NULL);
+        }
+
         virtual int32_t error(int32_t v)
         {
             if (at(invoke)) {
@@ -819,9 +1276,15 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
         obj_ptr<HttpRequest_base> m_req;
         obj_ptr<HttpResponse_base> m_rep;
         obj_ptr<MemoryStream> m_zip;
+        obj_ptr<ZlibStream> m_encoder;
+        obj_ptr<Stream_base> m_chunk;
         obj_ptr<SeekableStream_base> m_body;
+        obj_ptr<Buffer_base> m_buf;
+        obj_ptr<Http2Session> m_h2;
+        obj_ptr<HttpPipeline> m_pipe;
         date_t m_d;
         bool m_options;
+        bool m_queued;
     };
 
     if (ac->isSync())
@@ -886,6 +1349,63 @@ result_t HttpHandler::set_enableEncoding(bool newVal)
     return 0;
 }
 
+result_t HttpHandler::get_encodingLevel(int32_t& retVal)
+{
+    retVal = m_encodingLevel;
+    return 0;
+}
+
+result_t HttpHandler::set_encodingLevel(int32_t newVal)
+{
+    if (newVal < zlib_base::C_DEFAULT_COMPRESSION || newVal > zlib_base::C_BEST_COMPRESSION)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_encodingLevel = newVal;
+    return 0;
+}
+
+result_t HttpHandler::get_encodingThreshold(int32_t& retVal)
+{
+    retVal = m_encodingThreshold;
+    return 0;
+}
+
+result_t HttpHandler::set_encodingThreshold(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_encodingThreshold = newVal;
+    return 0;
+}
+
+result_t HttpHandler::get_enableHttp2(bool& retVal)
+{
+    retVal = m_enableHttp2;
+    return 0;
+}
+
+result_t HttpHandler::set_enableHttp2(bool newVal)
+{
+    m_enableHttp2 = newVal;
+    return 0;
+}
+
+result_t HttpHandler::get_maxPipeline(int32_t& retVal)
+{
+    retVal = m_maxPipeline;
+    return 0;
+}
+
+result_t HttpHandler::set_maxPipeline(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_maxPipeline = newVal;
+    return 0;
+}
+
 result_t HttpHandler::get_serverName(exlib::string& retVal)
 {
     retVal = m_serverName;
@@ -9,6 +9,9 @@
 #include "HttpMessage.h"
 #include "parse.h"
 #include "Buffer.h"
+#include "BufferedStream.h"
+#include "Stream.h"
+#include "File.h"
 #include <string.h>
 
 namespace fibjs {
@@ -26,6 +29,7 @@ public:
         , m_strCommand(
               strCommand)
         , m_headerOnly(headerOnly)
+        , m_bodySent(false)
     {
         m_contentLength = 0;
         m_pThis->get_length(m_contentLength);
@@ -46,37 +50,47 @@ public:
     {
         size_t sz = m_strCommand.length();
         size_t sz1;
-        exlib::string m_strBuf;
+        obj_ptr<Buffer> head;
         char* pBuf;
 
         if (m_buffer != NULL) {
-            m_buffer->toString(m_body);
-            m_buffer.Release();
+            int32_t len = 0;
 
-            if (m_contentLength != (int32_t)m_body.length())
+            m_buffer->get_length(len);
+            if (m_contentLength != len)
                 return CHECK_ERROR(Runtime::setError("HttpMessage: body is not complete."));
+
+            m_bodySent = true;
         }
 
         sz1 = m_pThis->size();
-        m_strBuf = m_strCommand;
-        m_strBuf.resize(sz + sz1 + 2 + m_body.length());
+        head = new Buffer(NULL, sz + sz1 + 2);
 
-        pBuf = m_strBuf.c_buffer() + sz;
+        pBuf = head->data();
+        memcpy(pBuf, m_strCommand.c_str(), sz);
+        pBuf += sz;
         *pBuf++ = '\r';
         *pBuf++ = '\n';
 
-        pBuf += m_pThis->getData(pBuf, sz1);
+        m_pThis->getData(pBuf, sz1);
+
+        if (m_bodySent) {
+            std::vector<obj_ptr<Buffer_base>> datas;
+
+            datas.push_back(head);
+            datas.push_back(m_buffer);
+            m_buffer.Release();
 
-        if (m_body.length() > 0)
-            memcpy(pBuf, m_body.c_str(), m_body.length());
+            return stream_writev(m_stm, datas, next(body));
+        }
 
-        m_buffer = new Buffer(m_strBuf);
+        m_buffer = head;
         return m_stm->write(m_buffer, next(body));
     }
 
     ON_STATE(asyncSendTo, body)
     {
-        if (m_headerOnly || m_contentLength == 0 || m_body.length() > 0)
+        if (m_headerOnly || m_contentLength == 0 || m_bodySent)
             return next();
 
         m_pThis->body()->rewind();
@@ -96,11 +110,11 @@ public:
     obj_ptr<Buffer_base> m_buffer;
     int64_t m_contentLength;
     int64_t m_copySize;
-    exlib::string m_body;
     exlib::string m_strCommand;
     const char* m_strStatus;
     int32_t m_nStatus;
     bool m_headerOnly;
+    bool m_bodySent;
 };
 
 result_t HttpMessage::get_data(v8::Local<v8::Value>& retVal)
@@ -183,68 +197,42 @@ result_t HttpMessage::sendHeader(Stream_base* stm, exlib::string& strCommand,
     return (new asyncSendTo(this, stm, strCommand, ac, true))->post(0);
 }
 
-result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
+result_t HttpMessage::readHead(BufferedStream_base* stm, AsyncEvent* ac)
+{
+    BufferedStream* _stm = dynamic_cast<BufferedStream*>(stm);
+    if (!_stm)
+        return CHECK_ERROR(Runtime::setError("HttpMessage: only accept BufferedStream object."));
+
+    // the start line, maxHeadersCount headers and the uncounted content-length and transfer-encoding,
+    // each up to HTTP_MAX_LINE bytes as when the head was read line by line
+    int64_t maxlen = (int64_t)HTTP_MAX_LINE * ((int64_t)m_maxHeadersCount + 3);
+    if (maxlen > INT32_MAX - 4)
+        maxlen = INT32_MAX - 4;
+
+    return _stm->readHead((int32_t)maxlen, m_headers->raw(), ac);
+}
+
+result_t HttpMessage::readFrom(Stream_base* stm, size_t pos, AsyncEvent* ac)
 {
     class asyncReadFrom : public AsyncState {
     public:
-        asyncReadFrom(HttpMessage* pThis, BufferedStream_base* stm,
+        asyncReadFrom(HttpMessage* pThis, BufferedStream_base* stm, size_t pos,
             AsyncEvent* ac)
             : AsyncState(ac)
             , m_pThis(pThis)
             , m_stm(stm)
+            , m_pos(pos)
             , m_contentLength(-1)
             , m_bChunked(false)
-            , m_headCount(0)
         {
-            next(begin);
-        }
-
-        ON_STATE(asyncReadFrom, begin)
-        {
-            return m_stm->readLine(HTTP_MAX_LINE, m_strLine, next(header));
+            next(header);
         }
 
         ON_STATE(asyncReadFrom, header)
         {
-            if (m_strLine.length() > 0) {
-                if (!qstricmp(m_strLine.c_str(), "content-length:", 15)) {
-                    m_contentLength = atoi(m_strLine.c_str() + 15);
-
-                    if ((m_contentLength < 0)
-                        || (m_pThis->m_maxBodySize >= 0
-                            && m_contentLength > (int64_t)m_pThis->m_maxBodySize * 1024 * 1024))
-                        return CHECK_ERROR(Runtime::setError("HttpMessage: body is too huge."));
-
-                    if (m_pThis->m_bNoBody) {
-                        result_t hr = m_pThis->addHeader(m_strLine);
-                        if (hr < 0)
-                            return hr;
-
-                        m_headCount++;
-                    }
-                } else if (!qstricmp(m_strLine.c_str(),
-                               "transfer-encoding:", 18)) {
-                    _parser p(m_strLine.c_str() + 18,
-                        (int32_t)m_strLine.length() - 18);
-
-                    p.skipSpace();
-                    if (qstricmp(p.now(), "chunked"))
-                        return CHECK_ERROR(Runtime::setError("HttpMessage: unknown transfer-encoding."));
-
-                    m_bChunked = true;
-                } else {
-                    result_t hr = m_pThis->addHeader(m_strLine);
-                    if (hr < 0)
-                        return hr;
-
-                    m_headCount++;
-                }
-
-                if (m_headCount > m_pThis->m_maxHeadersCount)
-                    return CHECK_ERROR(Runtime::setError("HttpMessage: too many headers."));
-
-                return m_stm->readLine(HTTP_MAX_LINE, m_strLine, this);
-            }
+            result_t hr = m_pThis->parseHeaders(m_pos, m_contentLength, m_bChunked);
+            if (hr < 0)
+                return hr;
 
             if (m_bChunked) {
                 if (m_pThis->m_maxBodySize == 0)
@@ -259,6 +247,17 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
             }
 
             if (!m_pThis->m_bNoBody && (m_contentLength > 0 || (m_pThis->m_bResponse && !m_pThis->m_keepAlive && m_contentLength == -1))) {
+                // a large request body goes to a temp file, so uploads are bounded by maxBodySize and
+                // not by memory, responses read by HttpClient stay in memory as before
+                if (!m_pThis->m_bResponse && !m_pThis->body() && m_contentLength > HTTP_MAX_MEMORY_BODY) {
+                    obj_ptr<TempFile> f = new TempFile();
+                    result_t hr = f->open("fibjs-body-");
+                    if (hr < 0)
+                        return hr;
+
+                    m_pThis->set_body(f);
+                }
+
                 m_pThis->get_body(m_body);
                 return m_stm->copyTo(m_body, m_contentLength, m_copySize, next(body));
             }
@@ -323,9 +322,9 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
         obj_ptr<BufferedStream_base> m_stm;
         obj_ptr<SeekableStream_base> m_body;
         exlib::string m_strLine;
+        size_t m_pos;
         int64_t m_contentLength;
         bool m_bChunked;
-        int32_t m_headCount;
         int64_t m_copySize;
     };
 
@@ -339,7 +338,79 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
     _stm->get_stream(m_socket);
     m_stm = _stm;
 
-    return (new asyncReadFrom(this, _stm, ac))->post(0);
+    return (new asyncReadFrom(this, _stm, pos, ac))->post(0);
+}
+
+result_t HttpMessage::parseHeaders(size_t pos, int64_t& contentLength, bool& bChunked)
+{
+    exlib::string& raw = m_headers->raw();
+    const char* base = raw.c_str();
+    const char* end = base + raw.length();
+    const char* p = base + pos;
+    int32_t headCount = 0;
+
+    while (p < end) {
+        const char* e = eol(p, end);
+        const char* colon;
+        const char* value;
+
+        if (e == p)
+            break;
+
+        if (e - p > HTTP_MAX_LINE)
+            return CHECK_ERROR(CALL_E_INVALID_DATA);
+
+        colon = (const char*)memchr(p, ':', e - p);
+        if (colon) {
+            for (value = p; value < colon && !qisspace(*value); value++)
+                ;
+            if (value < colon)
+                colon = NULL;
+        }
+
+        if (colon == NULL || colon == p)
+            return CHECK_ERROR(Runtime::setError("HttpMessage: bad header: " + exlib::string(p, e - p)));
+
+        int32_t szName = (int32_t)(colon - p);
+
+        for (value = colon + 1; value < e && qisspace(*value); value++)
+            ;
+        int32_t szValue = (int32_t)(e - value);
+
+        if (szName == 14 && !qstricmp(p, "content-length", 14)) {
+            contentLength = atoi(colon + 1);
+
+            if ((contentLength < 0)
+                || (m_maxBodySize >= 0
+                    && contentLength > (int64_t)m_maxBodySize * 1024 * 1024))
+                return CHECK_ERROR(Runtime::setError("HttpMessage: body is too huge."));
+
+            if (m_bNoBody) {
+                m_headers->add_raw((int32_t)(p - base), szName, (int32_t)(value - base), szValue);
+                headCount++;
+            }
+        } else if (szName == 17 && !qstricmp(p, "transfer-encoding", 17)) {
+            if (szValue != 7 || qstricmp(value, "chunked", 7))
+                return CHECK_ERROR(Runtime::setError("HttpMessage: unknown transfer-encoding."));
+
+            bChunked = true;
+        } else if (szName == 10 && !qstricmp(p, "connection", 10)) {
+            exlib::string v(value, szValue);
+
+            addHeader(p, szName, v.c_str(), szValue);
+            headCount++;
+        } else {
+            m_headers->add_raw((int32_t)(p - base), szName, (int32_t)(value - base), szValue);
+            headCount++;
+        }
+
+        if (headCount > m_maxHeadersCount)
+            return CHECK_ERROR(Runtime::setError("HttpMessage: too many headers."));
+
+        p = e + 2;
+    }
+
+    return 0;
 }
 
 void HttpMessage::addHeader(const char* name, int32_t szName, const char* value,
@@ -355,22 +426,6 @@ void HttpMessage::addHeader(const char* name, int32_t szName, const char* value,
         m_headers->add(name, szName, value, szValue);
 }
 
-result_t HttpMessage::addHeader(exlib::string& strLine)
-{
-    int32_t p2;
-    _parser p(strLine);
-
-    p.skipWord(':');
-    p2 = p.pos;
-    if (0 == p2 || !p.want(':'))
-        return CHECK_ERROR(Runtime::setError("HttpMessage: bad header: " + strLine));
-
-    p.skipSpace();
-    addHeader(p.string, p2, p.now(), p.left());
-
-    return 0;
-}
-
 size_t HttpMessage::size()
 {
     size_t sz = 2 + m_headers->size();
@@ -381,7 +436,9 @@ size_t HttpMessage::size()
 
     // content-length 14
     get_length(l);
-    if (l > 0) {
+    if (m_chunked)
+        sz += 28;
+    else if (l > 0) {
         sz += 14 + 4;
         while (l > 0) {
             l /= 10;
@@ -422,7 +479,9 @@ size_t HttpMessage::getData(char* buf, size_t sz)
 
     // content-length 14
     get_length(l);
-    if (l > 0) {
+    if (m_chunked)
+        cp(buf, sz, pos, "Transfer-Encoding: chunked\r\n", 28);
+    else if (l > 0) {
         char s[32];
         char* p;
         int32_t n;
@@ -601,6 +660,7 @@ result_t HttpMessage::clear()
     m_protocol.assign("HTTP/1.1", 8);
     m_keepAlive = true;
     m_upgrade = false;
+    m_chunked = false;
 
     m_origin.clear();
     m_encoding.clear();
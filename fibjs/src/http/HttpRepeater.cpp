@@ -8,9 +8,19 @@
 #include "object.h"
 #include "HttpRepeater.h"
 #include "HttpResponse.h"
+#include "HttpCollection.h"
+#include "Timer.h"
+#include "AsyncUV.h"
+#include "ifs/fs.h"
+#include <algorithm>
+#include <math.h>
 
 namespace fibjs {
 
+#define RING_POINTS 160
+#define EWMA_DECAY 10000.0
+#define RETRY_BUDGET_MAX 10.0
+
 result_t add_url(std::vector<obj_ptr<Url>>& urls, exlib::string& url)
 {
     obj_ptr<Url> u = new Url();
@@ -32,13 +42,73 @@ result_t add_url(std::vector<obj_ptr<Url>>& urls, exlib::string& url)
     return 0;
 }
 
+// header_hash with a murmur finalizer, the ring needs keys that differ in one character to land far apart
+inline uint32_t hash_key(const exlib::string& s)
+{
+    uint32_t h = header_hash(s.c_str(), (int32_t)s.length());
+
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+
+    return h;
+}
+
+// RFC 7231 4.2.2, sending one of these twice leaves the upstream as sending it once
+static bool idempotent(const exlib::string& method)
+{
+    static const char* s_methods[] = {
+        "GET",
+        "HEAD",
+        "PUT",
+        "DELETE",
+        "OPTIONS",
+        "TRACE"
+    };
+
+    for (int32_t i = 0; i < (int32_t)ARRAYSIZE(s_methods); i++)
+        if (!qstricmp(method.c_str(), s_methods[i]))
+            return true;
+
+    return false;
+}
+
+// errors raised while the connection is being set up, not a byte of the request has been written
+static bool connect_failed(result_t hr)
+{
+    switch (hr) {
+#ifdef _WIN32
+    case -WSAECONNREFUSED:
+    case -WSAEHOSTUNREACH:
+    case -WSAENETUNREACH:
+    case -WSAEADDRNOTAVAIL:
+    case -WSAHOST_NOT_FOUND:
+#else
+    case -ECONNREFUSED:
+    case -EHOSTUNREACH:
+    case -ENETUNREACH:
+    case -EADDRNOTAVAIL:
+#endif
+    case UV_EAI_NONAME:
+    case UV_EAI_AGAIN:
+        return true;
+    }
+
+    return false;
+}
+
 result_t HttpRepeater_base::_new(exlib::string url, obj_ptr<HttpRepeater_base>& retVal, v8::Local<v8::Object> This)
 {
-    obj_ptr<HttpRepeater> repeater = new HttpRepeater();
-    result_t hr = add_url(repeater->m_urls, url);
+    std::vector<obj_ptr<Url>> urls;
+    result_t hr = add_url(urls, url);
     if (hr < 0)
         return hr;
 
+    obj_ptr<HttpRepeater> repeater = new HttpRepeater();
+    repeater->reset(urls);
+
     retVal = repeater;
     return 0;
 }
@@ -63,6 +133,78 @@ HttpRepeater::HttpRepeater()
     m_client->set_userAgent("");
 
     m_idx = 0;
+
+    m_strategy = kRoundRobin;
+    m_maxFails = 5;
+    m_ejectTime = 30000;
+    m_retries = 1;
+    m_retryBudget = 0.2;
+    m_budget = RETRY_BUDGET_MAX;
+    m_retried = 0;
+    m_healthInterval = 5000;
+    m_healthGen = 0;
+}
+
+// an ejected upstream comes back on its own once ejectTime is over, a failed health check
+// keeps it out until the next check passes
+bool HttpRepeater::Upstream::available(date_t d)
+{
+    if (m_ejected && d.diff(m_ejectEnd) >= 0)
+        m_ejected = false;
+
+    return !m_ejected && m_healthy;
+}
+
+// peak-ewma: a slower sample is taken at once, faster ones only pull the average down over time
+void HttpRepeater::Upstream::observe(date_t d, double rtt)
+{
+    double dt = d.diff(m_stamp);
+
+    m_stamp = d;
+    if (rtt > m_ewma)
+        m_ewma = rtt;
+    else {
+        double w = exp(-dt / EWMA_DECAY);
+        m_ewma = m_ewma * w + rtt * (1 - w);
+    }
+}
+
+double HttpRepeater::Upstream::cost(date_t d)
+{
+    return (m_ewma + 1) * (m_outstanding + 1);
+}
+
+void HttpRepeater::reset(std::vector<obj_ptr<Url>>& urls)
+{
+    std::vector<obj_ptr<Upstream>> ups;
+    size_t i, j;
+
+    m_lock.lock();
+    for (i = 0; i < urls.size(); i++) {
+        obj_ptr<Upstream> up = new Upstream(urls[i]);
+
+        for (j = 0; j < m_urls.size(); j++)
+            if (m_urls[j]->m_base == up->m_base) {
+                up = m_urls[j];
+                break;
+            }
+
+        ups.push_back(up);
+    }
+
+    m_urls = ups;
+    m_idx = 0;
+
+    m_ring.clear();
+    for (i = 0; i < m_urls.size(); i++)
+        for (j = 0; j < RING_POINTS; j++) {
+            char buf[32];
+
+            snprintf(buf, sizeof(buf), "#%d", (int32_t)j);
+            m_ring.push_back(std::pair<uint32_t, int32_t>(hash_key(m_urls[i]->m_base + buf), (int32_t)i));
+        }
+    std::sort(m_ring.begin(), m_ring.end());
+    m_lock.unlock();
 }
 
 result_t HttpRepeater::load(v8::Local<v8::Array> urls)
@@ -88,10 +230,7 @@ result_t HttpRepeater::load(v8::Local<v8::Array> urls)
             return hr;
     }
 
-    m_lock.lock();
-    m_urls = _urls;
-    m_idx = 0;
-    m_lock.unlock();
+    reset(_urls);
 
     return 0;
 }
@@ -99,13 +238,10 @@ result_t HttpRepeater::load(v8::Local<v8::Array> urls)
 result_t HttpRepeater::get_urls(obj_ptr<NArray>& retVal)
 {
     obj_ptr<NArray> a = new NArray();
-    exlib::string s;
 
     m_lock.lock();
-    for (int32_t i = 0; i < (int32_t)m_urls.size(); i++) {
-        m_urls[i]->toString(s);
-        a->append(s);
-    }
+    for (int32_t i = 0; i < (int32_t)m_urls.size(); i++)
+        a->append(m_urls[i]->m_base);
     m_lock.unlock();
 
     retVal = a;
@@ -119,6 +255,444 @@ result_t HttpRepeater::get_client(obj_ptr<HttpClient_base>& retVal)
     return 0;
 }
 
+static const char* s_strategies[] = {
+    "round-robin",
+    "least-request",
+    "peak-ewma",
+    "hash"
+};
+
+result_t HttpRepeater::get_strategy(exlib::string& retVal)
+{
+    m_lock.lock();
+    retVal = s_strategies[m_strategy];
+    m_lock.unlock();
+
+    return 0;
+}
+
+result_t HttpRepeater::set_strategy(exlib::string newVal)
+{
+    for (int32_t i = 0; i < (int32_t)ARRAYSIZE(s_strategies); i++)
+        if (newVal == s_strategies[i]) {
+            m_lock.lock();
+            m_strategy = i;
+            m_lock.unlock();
+
+            return 0;
+        }
+
+    return CHECK_ERROR(Runtime::setError("HttpRepeater: unknown strategy."));
+}
+
+result_t HttpRepeater::get_hashHeader(exlib::string& retVal)
+{
+    m_lock.lock();
+    retVal = m_hashHeader;
+    m_lock.unlock();
+
+    return 0;
+}
+
+result_t HttpRepeater::set_hashHeader(exlib::string newVal)
+{
+    m_lock.lock();
+    m_hashHeader = newVal;
+    m_lock.unlock();
+
+    return 0;
+}
+
+result_t HttpRepeater::get_maxFails(int32_t& retVal)
+{
+    retVal = m_maxFails;
+    return 0;
+}
+
+result_t HttpRepeater::set_maxFails(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_maxFails = newVal;
+    return 0;
+}
+
+result_t HttpRepeater::get_ejectTime(int32_t& retVal)
+{
+    retVal = m_ejectTime;
+    return 0;
+}
+
+result_t HttpRepeater::set_ejectTime(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_ejectTime = newVal;
+    return 0;
+}
+
+result_t HttpRepeater::get_retries(int32_t& retVal)
+{
+    retVal = m_retries;
+    return 0;
+}
+
+result_t HttpRepeater::set_retries(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_retries = newVal;
+    return 0;
+}
+
+result_t HttpRepeater::get_retryBudget(double& retVal)
+{
+    retVal = m_retryBudget;
+    return 0;
+}
+
+result_t HttpRepeater::set_retryBudget(double newVal)
+{
+    if (newVal < 0 || newVal > 1)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_retryBudget = newVal;
+    return 0;
+}
+
+class HealthTimer : public Timer {
+public:
+    HealthTimer(HttpRepeater* r, int32_t interval, int32_t gen)
+        : Timer(interval)
+        , m_r(r)
+        , m_gen(gen)
+    {
+    }
+
+public:
+    virtual void on_timer()
+    {
+        m_r->check(m_gen);
+    }
+
+private:
+    obj_ptr<HttpRepeater> m_r;
+    int32_t m_gen;
+};
+
+result_t HttpRepeater::get_healthCheck(exlib::string& retVal)
+{
+    m_lock.lock();
+    retVal = m_healthCheck;
+    m_lock.unlock();
+
+    return 0;
+}
+
+// every change starts a new generation, the timer of the previous one stops when it sees that
+result_t HttpRepeater::set_healthCheck(exlib::string newVal)
+{
+    int32_t gen;
+
+    m_lock.lock();
+    m_healthCheck = newVal;
+    gen = ++m_healthGen;
+
+    if (newVal.empty())
+        for (size_t i = 0; i < m_urls.size(); i++)
+            m_urls[i]->m_healthy = true;
+    m_lock.unlock();
+
+    if (!newVal.empty())
+        check(gen);
+
+    return 0;
+}
+
+result_t HttpRepeater::get_healthInterval(int32_t& retVal)
+{
+    retVal = m_healthInterval;
+    return 0;
+}
+
+result_t HttpRepeater::set_healthInterval(int32_t newVal)
+{
+    if (newVal < 1)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_healthInterval = newVal;
+    return 0;
+}
+
+void HttpRepeater::check(int32_t gen)
+{
+    class asyncHealth : public AsyncState {
+    public:
+        asyncHealth(HttpRepeater* pThis, Upstream* up, exlib::string path)
+            : AsyncState(NULL)
+            , m_pThis(pThis)
+            , m_up(up)
+        {
+            obj_ptr<Url> u = new Url(*up->m_url);
+
+            if (!isUrlSlash(path[0]))
+                u->m_pathname.append(1, '/');
+            u->m_pathname.append(path);
+            u->normalize();
+            u->toString(m_url);
+
+            next(request);
+        }
+
+        ON_STATE(asyncHealth, request)
+        {
+            return m_pThis->m_client->request("GET", m_url, NULL, NULL, NULL, m_ret, next(response));
+        }
+
+        ON_STATE(asyncHealth, response)
+        {
+            int32_t code;
+
+            m_ret->get_statusCode(code);
+            m_pThis->checked(m_up, code >= 200 && code < 400);
+
+            return next();
+        }
+
+        virtual int32_t error(int32_t v)
+        {
+            m_pThis->checked(m_up, false);
+            return next();
+        }
+
+        virtual Isolate* isolate()
+        {
+            return m_pThis->holder();
+        }
+
+    private:
+        obj_ptr<HttpRepeater> m_pThis;
+        obj_ptr<Upstream> m_up;
+        exlib::string m_url;
+        obj_ptr<HttpResponse_base> m_ret;
+    };
+
+    std::vector<obj_ptr<Upstream>> ups;
+    exlib::string path;
+    int32_t interval;
+
+    m_lock.lock();
+    if (gen != m_healthGen) {
+        m_lock.unlock();
+        return;
+    }
+
+    ups = m_urls;
+    path = m_healthCheck;
+    interval = m_healthInterval;
+    m_lock.unlock();
+
+    for (size_t i = 0; i < ups.size(); i++)
+        (new asyncHealth(this, ups[i], path))->apost(0);
+
+    (new HealthTimer(this, interval, gen))->sleep();
+}
+
+void HttpRepeater::checked(Upstream* up, bool healthy)
+{
+    m_lock.lock();
+    if (!m_healthCheck.empty()) {
+        up->m_healthy = healthy;
+
+        // a passing check is better evidence than the failures that ejected it
+        if (healthy) {
+            up->m_ejected = false;
+            up->m_fails = 0;
+        }
+    }
+    m_lock.unlock();
+}
+
+HttpRepeater::Upstream* HttpRepeater::pick_hash(date_t d, exlib::string& key, Upstream* exclude)
+{
+    if (m_ring.empty())
+        return NULL;
+
+    std::pair<uint32_t, int32_t> k(hash_key(key), -1);
+    size_t pos = std::lower_bound(m_ring.begin(), m_ring.end(), k) - m_ring.begin();
+
+    for (size_t i = 0; i < m_ring.size(); i++) {
+        Upstream* up = m_urls[m_ring[(pos + i) % m_ring.size()].second];
+
+        if (up != exclude && up->available(d))
+            return up;
+    }
+
+    return NULL;
+}
+
+// pass 0 looks at available upstreams only, pass 1 falls back to ejected ones rather than
+// failing the request, pass 2 allows the one that just failed when nothing else is left
+void HttpRepeater::pick(exlib::string& key, Upstream* exclude, obj_ptr<Upstream>& retVal)
+{
+    Upstream* up = NULL;
+    date_t d;
+
+    d.now();
+
+    m_lock.lock();
+    size_t n = m_urls.size();
+
+    if (!exclude) {
+        m_budget += m_retryBudget;
+        if (m_budget > RETRY_BUDGET_MAX)
+            m_budget = RETRY_BUDGET_MAX;
+    }
+
+    if (m_strategy == kHash && !key.empty())
+        up = pick_hash(d, key, exclude);
+
+    for (int32_t pass = 0; !up && pass < 3; pass++) {
+        double best = 0;
+
+        for (size_t i = 0; i < n; i++) {
+            Upstream* u = m_urls[(m_idx + i) % n];
+
+            if (pass < 2 && u == exclude)
+                continue;
+            if (pass == 0 && !u->available(d))
+                continue;
+
+            if (m_strategy == kRoundRobin || m_strategy == kHash) {
+                up = u;
+                break;
+            }
+
+            double c = m_strategy == kLeastRequest ? (double)u->m_outstanding : u->cost(d);
+            if (!up || c < best) {
+                up = u;
+                best = c;
+            }
+        }
+    }
+
+    if (++m_idx >= (int32_t)n)
+        m_idx = 0;
+
+    up->m_outstanding++;
+    up->m_requests++;
+    retVal = up;
+    m_lock.unlock();
+}
+
+void HttpRepeater::done(Upstream* up, date_t start, bool failed)
+{
+    date_t d;
+
+    d.now();
+
+    m_lock.lock();
+    up->m_outstanding--;
+
+    if (failed) {
+        up->m_errors++;
+
+        if (m_maxFails > 0 && ++up->m_fails >= m_maxFails && !up->m_ejected) {
+            up->m_ejected = true;
+            up->m_ejectEnd = d;
+            up->m_ejectEnd.add(m_ejectTime, date_t::_MICROSECOND);
+            up->m_fails = 0;
+            up->m_ejections++;
+        }
+    } else {
+        up->m_fails = 0;
+        up->observe(d, d.diff(start));
+    }
+    m_lock.unlock();
+}
+
+bool HttpRepeater::retry()
+{
+    bool ok = false;
+
+    m_lock.lock();
+    if (m_budget >= 1) {
+        m_budget -= 1;
+        m_retried++;
+        ok = true;
+    }
+    m_lock.unlock();
+
+    return ok;
+}
+
+result_t HttpRepeater::stats(v8::Local<v8::Object>& retVal)
+{
+    class UpstreamStat {
+    public:
+        exlib::string url;
+        double requests, errors, outstanding, latency, ejections;
+        bool ejected, healthy;
+    };
+
+    Isolate* isolate = holder();
+    v8::Local<v8::Context> context = isolate->context();
+    std::vector<UpstreamStat> ups;
+    double retries, budget;
+    date_t d;
+
+    d.now();
+
+    m_lock.lock();
+    ups.resize(m_urls.size());
+    for (size_t i = 0; i < m_urls.size(); i++) {
+        Upstream* up = m_urls[i];
+        UpstreamStat& st = ups[i];
+
+        st.url = up->m_base;
+        st.requests = (double)up->m_requests;
+        st.errors = (double)up->m_errors;
+        st.outstanding = (double)up->m_outstanding;
+        st.latency = up->m_ewma;
+        st.ejections = (double)up->m_ejections;
+        up->available(d);
+        st.ejected = up->m_ejected;
+        st.healthy = up->m_healthy;
+    }
+    retries = (double)m_retried;
+    budget = m_budget;
+    m_lock.unlock();
+
+    v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+    v8::Local<v8::Array> a = v8::Array::New(isolate->m_isolate, (int32_t)ups.size());
+
+    for (size_t i = 0; i < ups.size(); i++) {
+        UpstreamStat& st = ups[i];
+        v8::Local<v8::Object> u = v8::Object::New(isolate->m_isolate);
+
+        u->Set(context, isolate->NewString("url"), isolate->NewString(st.url)).IsJust();
+        u->Set(context, isolate->NewString("requests"), v8::Number::New(isolate->m_isolate, st.requests)).IsJust();
+        u->Set(context, isolate->NewString("errors"), v8::Number::New(isolate->m_isolate, st.errors)).IsJust();
+        u->Set(context, isolate->NewString("outstanding"), v8::Number::New(isolate->m_isolate, st.outstanding)).IsJust();
+        u->Set(context, isolate->NewString("latency"), v8::Number::New(isolate->m_isolate, st.latency)).IsJust();
+        u->Set(context, isolate->NewString("ejections"), v8::Number::New(isolate->m_isolate, st.ejections)).IsJust();
+        u->Set(context, isolate->NewString("ejected"), v8::Boolean::New(isolate->m_isolate, st.ejected)).IsJust();
+        u->Set(context, isolate->NewString("healthy"), v8::Boolean::New(isolate->m_isolate, st.healthy)).IsJust();
+
+        a->Set(context, (int32_t)i, u).IsJust();
+    }
+
+    o->Set(context, isolate->NewString("retries"), v8::Number::New(isolate->m_isolate, retries)).IsJust();
+    o->Set(context, isolate->NewString("budget"), v8::Number::New(isolate->m_isolate, budget)).IsJust();
+    o->Set(context, isolate->NewString("upstreams"), a).IsJust();
+
+    retVal = o;
+    return 0;
+}
+
 result_t HttpRepeater::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
     AsyncEvent* ac)
 {
@@ -127,29 +701,27 @@ result_t HttpRepeater::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
         asyncInvoke(HttpRepeater* pThis, HttpRequest_base* req, AsyncEvent* ac)
             : AsyncState(ac)
             , m_pThis(pThis)
+            , m_body_pos(0)
+            , m_tries(0)
         {
-            exlib::string v;
-            req->get_value(v);
+            exlib::string name;
 
-            obj_ptr<Url> u;
+            req->get_value(m_value);
 
             pThis->m_lock.lock();
-            u = new Url(*pThis->m_urls[pThis->m_idx++]);
-            if (pThis->m_idx >= (int32_t)pThis->m_urls.size())
-                pThis->m_idx = 0;
+            if (pThis->m_strategy == kHash)
+                name = pThis->m_hashHeader;
             pThis->m_lock.unlock();
 
-            if (!isUrlSlash(v[0]))
-                u->m_pathname.append(1, '/');
-
-            u->m_pathname.append(v);
-            u->normalize();
+            if (!name.empty())
+                req->firstHeader(name, m_key);
 
-            req->get_queryString(u->m_query);
-            u->toString(m_url);
+            req->get_queryString(m_query);
 
             req->get_method(m_method);
             req->get_body(m_body);
+            if (m_body)
+                m_body->tell(m_body_pos);
 
             obj_ptr<HttpCollection_base> headers;
             req->get_headers(headers);
@@ -164,8 +736,30 @@ result_t HttpRepeater::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             next(request);
         }
 
+        ~asyncInvoke()
+        {
+            if (m_up)
+                m_pThis->done(m_up, m_start, true);
+        }
+
         ON_STATE(asyncInvoke, request)
         {
+            obj_ptr<Url> u;
+
+            m_pThis->pick(m_key, m_failed, m_up);
+            u = new Url(*m_up->m_url);
+
+            if (!isUrlSlash(m_value[0]))
+                u->m_pathname.append(1, '/');
+
+            u->m_pathname.append(m_value);
+            u->normalize();
+
+            u->m_query = m_query;
+            m_url.clear();
+            u->toString(m_url);
+
+            m_start.now();
             return m_pThis->m_client->request(m_method, m_url,
                 m_body, NULL, m_headers, m_ret, next(response));
         }
@@ -178,6 +772,10 @@ result_t HttpRepeater::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             obj_ptr<SeekableStream_base> body;
 
             m_ret->get_statusCode(code);
+
+            m_pThis->done(m_up, m_start, code >= 500);
+            m_up.Release();
+
             m_rep->set_statusCode(code);
 
             m_ret->get_statusMessage(msg);
@@ -192,14 +790,48 @@ result_t HttpRepeater::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             return next(CALL_RETURN_NULL);
         }
 
+        // only requests that got no response at all are sent again, and only to another upstream
+        // while the retry budget lasts, one that may have reached the upstream is sent again
+        // only when its method is idempotent
+        virtual int32_t error(int32_t v)
+        {
+            if (!at(request) || !m_up)
+                return v;
+
+            m_pThis->done(m_up, m_start, true);
+            m_failed = m_up;
+            m_up.Release();
+
+            if (!connect_failed(v) && !idempotent(m_method))
+                return v;
+
+            if (m_tries++ >= m_pThis->m_retries || !m_pThis->retry())
+                return v;
+
+            if (m_body)
+                m_body->seek(m_body_pos, fs_base::C_SEEK_SET);
+            m_ret.Release();
+
+            next(request);
+            return 0;
+        }
+
     public:
         obj_ptr<HttpRepeater> m_pThis;
+        exlib::string m_value;
+        exlib::string m_query;
+        exlib::string m_key;
         exlib::string m_method;
         exlib::string m_url;
         obj_ptr<SeekableStream_base> m_body;
+        int64_t m_body_pos;
         obj_ptr<NObject> m_headers;
         obj_ptr<HttpResponse_base> m_ret;
         obj_ptr<HttpResponse_base> m_rep;
+        obj_ptr<Upstream> m_up;
+        obj_ptr<Upstream> m_failed;
+        date_t m_start;
+        int32_t m_tries;
     };
 
     if (ac->isSync())
@@ -212,4 +844,4 @@ result_t HttpRepeater::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
 
     return (new asyncInvoke(this, req, ac))->post(0);
 }
-}
\ No newline at end of file
+}
@@ -292,7 +292,7 @@ result_t HttpRequest::readFrom(Stream_base* stm, AsyncEvent* ac)
 
         ON_STATE(asyncReadFrom, begin)
         {
-            return m_stm->readLine(HTTP_MAX_LINE, m_strLine, next(command));
+            return m_pThis->m_message->readHead(m_stm, next(command));
         }
 
         ON_STATE(asyncReadFrom, command)
@@ -300,6 +300,16 @@ result_t HttpRequest::readFrom(Stream_base* stm, AsyncEvent* ac)
             if (n == CALL_RETURN_NULL)
                 return CHECK_ERROR(Runtime::setError("HttpRequest: Connection was reset by peer."));
 
+            exlib::string& head = m_pThis->m_message->head();
+            const char* end = head.c_str() + head.length();
+            const char* e = HttpMessage::eol(head.c_str(), end);
+
+            if (e - head.c_str() > HTTP_MAX_LINE)
+                return CHECK_ERROR(CALL_E_INVALID_DATA);
+
+            m_pos = e < end ? e - head.c_str() + 2 : head.length();
+            m_strLine.assign(head.c_str(), e - head.c_str());
+
             _parser p(m_strLine);
             result_t hr;
 
@@ -332,13 +342,14 @@ result_t HttpRequest::readFrom(Stream_base* stm, AsyncEvent* ac)
             if (hr < 0)
                 return hr;
 
-            return m_pThis->m_message->readFrom(m_stm, next());
+            return m_pThis->m_message->readFrom(m_stm, m_pos, next());
         }
 
     public:
         obj_ptr<HttpRequest> m_pThis;
         obj_ptr<BufferedStream_base> m_stm;
         exlib::string m_strLine;
+        size_t m_pos;
     };
 
     if (ac->isSync())
@@ -417,6 +428,113 @@ result_t HttpRequest::get_cookies(obj_ptr<HttpCollection_base>& retVal)
     return 0;
 }
 
+class FormSink : public MultipartParser::Sink {
+public:
+    FormSink(Isolate* isolate, HttpUploadCollection* col)
+        : m_isolate(isolate)
+        , m_col(col)
+    {
+    }
+
+public:
+    virtual result_t on_field(exlib::string& name, exlib::string& value)
+    {
+        if (!m_onField.IsEmpty()) {
+            v8::Local<v8::Value> args[] = { m_isolate->NewString(name), m_isolate->NewString(value) };
+            v8::Local<v8::Value> r = m_onField->Call(m_isolate->context(), v8::Undefined(m_isolate->m_isolate), 2, args).FromMaybe(v8::Local<v8::Value>());
+            if (r.IsEmpty())
+                return CALL_E_JAVASCRIPT;
+        }
+
+        return m_col->on_field(name, value);
+    }
+
+    virtual result_t on_file(exlib::string& name, HttpUploadData* file, obj_ptr<Stream_base>& stm)
+    {
+        if (!m_onFile.IsEmpty()) {
+            v8::Local<v8::Value> args[] = { m_isolate->NewString(name), file->wrap() };
+            v8::Local<v8::Value> r = m_onFile->Call(m_isolate->context(), v8::Undefined(m_isolate->m_isolate), 2, args).FromMaybe(v8::Local<v8::Value>());
+            if (r.IsEmpty())
+                return CALL_E_JAVASCRIPT;
+
+            // the callback may hand back a stream to take the part body
+            if (!IsEmpty(r)) {
+                stm = Stream_base::getInstance(r);
+                if (!stm)
+                    return CHECK_ERROR(Runtime::setError("HttpRequest: onFile must return a Stream."));
+            }
+        }
+
+        return m_col->on_file(name, file, stm);
+    }
+
+    virtual result_t on_file_end(exlib::string& name, HttpUploadData* file)
+    {
+        return m_col->on_file_end(name, file);
+    }
+
+public:
+    Isolate* m_isolate;
+    obj_ptr<HttpUploadCollection> m_col;
+    v8::Local<v8::Function> m_onField;
+    v8::Local<v8::Function> m_onFile;
+};
+
+result_t HttpRequest::parseForm(v8::Local<v8::Object> opts, obj_ptr<HttpCollection_base>& retVal)
+{
+    Isolate* isolate = holder();
+    int64_t threshold = HTTP_UPLOAD_THRESHOLD;
+    result_t hr;
+
+    hr = GetConfigValue(isolate->m_isolate, opts, "threshold", threshold, true);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    obj_ptr<HttpUploadCollection> col = new HttpUploadCollection();
+    FormSink sink(isolate, col);
+
+    hr = GetConfigValue(isolate->m_isolate, opts, "onField", sink.m_onField, true);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    hr = GetConfigValue(isolate->m_isolate, opts, "onFile", sink.m_onFile, true);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    exlib::string strType;
+    int64_t len = 0;
+
+    get_length(len);
+    if (len == 0) {
+        m_form = new HttpCollection();
+        retVal = m_form;
+        return 0;
+    }
+
+    if (firstHeader("Content-Type", strType) == CALL_RETURN_NULL)
+        return CHECK_ERROR(Runtime::setError("HttpRequest: Content-Type is missing."));
+
+    if (qstricmp(strType.c_str(), "multipart/form-data;", 20)) {
+        m_form.Release();
+        return get_form(retVal);
+    }
+
+    obj_ptr<SeekableStream_base> _body;
+    MultipartParser parser(&sink, threshold);
+
+    get_body(_body);
+    if (parser.init(strType) != CALL_RETURN_NULL) {
+        hr = parser.parse(_body);
+        if (hr < 0)
+            return hr;
+    }
+
+    m_form = col;
+    retVal = m_form;
+
+    return 0;
+}
+
 result_t HttpRequest::get_form(obj_ptr<HttpCollection_base>& retVal)
 {
     if (m_form == NULL) {
@@ -427,38 +545,39 @@ result_t HttpRequest::get_form(obj_ptr<HttpCollection_base>& retVal)
             m_form = new HttpCollection();
         else {
             exlib::string strType;
-            bool bUpload = false;
+            obj_ptr<SeekableStream_base> _body;
+            result_t hr;
 
             if (firstHeader("Content-Type", strType) == CALL_RETURN_NULL)
                 return CHECK_ERROR(Runtime::setError("HttpRequest: Content-Type is missing."));
 
-            if (!qstricmp(strType.c_str(), "multipart/form-data;", 20))
-                bUpload = true;
-            else if (qstricmp(strType.c_str(),
-                         "application/x-www-form-urlencoded", 33))
-                return CHECK_ERROR(Runtime::setError("HttpRequest: unknown form format: " + strType));
-
-            obj_ptr<Buffer_base> buf;
-            obj_ptr<SeekableStream_base> _body;
-
             get_body(_body);
-            _body->rewind();
-            result_t hr = _body->cc_read((int32_t)len, buf);
-            if (hr < 0)
-                return hr;
 
-            exlib::string strForm;
-            buf->toString(strForm);
-
-            if (bUpload) {
+            if (!qstricmp(strType.c_str(), "multipart/form-data;", 20)) {
+                // parts are read from the body a chunk at a time, large files go to temp files
                 obj_ptr<HttpUploadCollection> col = new HttpUploadCollection();
-                col->parse(strForm, strType.c_str());
+
+                hr = col->parse(_body, strType, HTTP_UPLOAD_THRESHOLD);
+                if (hr < 0)
+                    return hr;
+
                 m_form = col;
-            } else {
+            } else if (!qstricmp(strType.c_str(), "application/x-www-form-urlencoded", 33)) {
+                obj_ptr<Buffer_base> buf;
+
+                _body->rewind();
+                hr = _body->cc_read((int32_t)len, buf);
+                if (hr < 0)
+                    return hr;
+
+                exlib::string strForm;
+                buf->toString(strForm);
+
                 obj_ptr<HttpCollection> c = new HttpCollection();
                 c->parse(strForm);
                 m_form = c;
-            }
+            } else
+                return CHECK_ERROR(Runtime::setError("HttpRequest: unknown form format: " + strType));
         }
     }
 
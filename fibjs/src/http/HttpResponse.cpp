@@ -297,11 +297,8 @@ result_t http_base::get_STATUS_CODES(v8::Local<v8::Array>& retVal)
     return 0;
 }
 
-result_t HttpResponse::sendTo(Stream_base* stm, AsyncEvent* ac)
+void HttpResponse::flushCookies()
 {
-    if (ac->isSync())
-        return CHECK_ERROR(CALL_E_NOSYNC);
-
     if (m_cookies) {
         int32_t len, i;
 
@@ -323,6 +320,14 @@ result_t HttpResponse::sendTo(Stream_base* stm, AsyncEvent* ac)
 
         m_cookies.Release();
     }
+}
+
+result_t HttpResponse::sendTo(Stream_base* stm, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    flushCookies();
 
     exlib::string strCommand;
     exlib::string statusMessage;
@@ -372,7 +377,7 @@ result_t HttpResponse::readFrom(Stream_base* stm, AsyncEvent* ac)
 
         ON_STATE(asyncReadFrom, begin)
         {
-            return m_stm->readLine(HTTP_MAX_LINE, m_strLine, next(command));
+            return m_pThis->m_message->readHead(m_stm, next(command));
         }
 
         ON_STATE(asyncReadFrom, command)
@@ -380,6 +385,16 @@ result_t HttpResponse::readFrom(Stream_base* stm, AsyncEvent* ac)
             if (n == CALL_RETURN_NULL)
                 return CHECK_ERROR(Runtime::setError("HttpResponse: Connection was reset by peer."));
 
+            exlib::string& head = m_pThis->m_message->head();
+            const char* end = head.c_str() + head.length();
+            const char* e = HttpMessage::eol(head.c_str(), end);
+
+            if (e - head.c_str() > HTTP_MAX_LINE)
+                return CHECK_ERROR(CALL_E_INVALID_DATA);
+
+            m_pos = e < end ? e - head.c_str() + 2 : head.length();
+            m_strLine.assign(head.c_str(), e - head.c_str());
+
             result_t hr;
             const char* c_str = m_strLine.c_str();
             int32_t len = (int32_t)m_strLine.length();
@@ -397,13 +412,14 @@ result_t HttpResponse::readFrom(Stream_base* stm, AsyncEvent* ac)
             if (hr < 0)
                 return hr;
 
-            return m_pThis->m_message->readFrom(m_stm, next());
+            return m_pThis->m_message->readFrom(m_stm, m_pos, next());
         }
 
     public:
         obj_ptr<HttpResponse> m_pThis;
         obj_ptr<BufferedStream_base> m_stm;
         exlib::string m_strLine;
+        size_t m_pos;
     };
 
     if (ac->isSync())
@@ -531,27 +547,7 @@ result_t HttpResponse::sendHeader(Stream_base* stm, AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    if (m_cookies) {
-        int32_t len, i;
-
-        len = m_cookies->length();
-
-        for (i = 0; i < len; i++) {
-            Variant v;
-            obj_ptr<object_base> cookie;
-            exlib::string str;
-
-            m_cookies->_indexed_getter(i, v);
-            cookie = v.object();
-
-            if (cookie) {
-                cookie->toString(str);
-                addHeader("Set-Cookie", str);
-            }
-        }
-
-        m_cookies.Release();
-    }
+    flushCookies();
 
     int32_t pos = shortcut[m_statusCode / 100 - 1] + m_statusCode % 100;
     exlib::string strCommand;
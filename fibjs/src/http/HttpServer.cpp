@@ -120,6 +120,46 @@ result_t HttpServer::set_enableEncoding(bool newVal)
     return m_hdlr->set_enableEncoding(newVal);
 }
 
+result_t HttpServer::get_encodingLevel(int32_t& retVal)
+{
+    return m_hdlr->get_encodingLevel(retVal);
+}
+
+result_t HttpServer::set_encodingLevel(int32_t newVal)
+{
+    return m_hdlr->set_encodingLevel(newVal);
+}
+
+result_t HttpServer::get_encodingThreshold(int32_t& retVal)
+{
+    return m_hdlr->get_encodingThreshold(retVal);
+}
+
+result_t HttpServer::set_encodingThreshold(int32_t newVal)
+{
+    return m_hdlr->set_encodingThreshold(newVal);
+}
+
+result_t HttpServer::get_enableHttp2(bool& retVal)
+{
+    return m_hdlr->get_enableHttp2(retVal);
+}
+
+result_t HttpServer::set_enableHttp2(bool newVal)
+{
+    return m_hdlr->set_enableHttp2(newVal);
+}
+
+result_t HttpServer::get_maxPipeline(int32_t& retVal)
+{
+    return m_hdlr->get_maxPipeline(retVal);
+}
+
+result_t HttpServer::set_maxPipeline(int32_t newVal)
+{
+    return m_hdlr->set_maxPipeline(newVal);
+}
+
 result_t HttpServer::get_serverName(exlib::string& retVal)
 {
     return m_hdlr->get_serverName(retVal);
@@ -8,204 +8,39 @@
 #include "object.h"
 #include "HttpUploadCollection.h"
 #include "HttpUploadData.h"
-#include "MemoryStream.h"
 #include <string.h>
 
 namespace fibjs {
 
-void HttpUploadCollection::parse(exlib::string& str, const char* boundary)
+result_t HttpUploadCollection::on_field(exlib::string& name, exlib::string& value)
 {
-    const char* pstr = str.c_str();
-    size_t nSize = str.length();
-    exlib::string strName;
-    exlib::string strFileName;
-    exlib::string strContentType;
-    exlib::string strContentTransferEncoding;
-    const char *p, *p1, *p2, *szQueryString;
-    const char* pstrSplit;
-    size_t uiSplitSize;
-    char ch;
-
-    boundary += 20;
-    while (*boundary && *boundary == ' ')
-        boundary++;
-
-    if (qstricmp(boundary, "boundary=", 9))
-        return;
-
-    boundary += 9;
-    uiSplitSize = qstrlen(boundary);
-
-    pstrSplit = szQueryString = pstr;
-
-    if (nSize < uiSplitSize + 2 || szQueryString[0] != '-'
-        || szQueryString[1] != '-'
-        || qstrcmp(szQueryString + 2, boundary, uiSplitSize))
-        return;
-
-    uiSplitSize += 2;
-    szQueryString += uiSplitSize;
-    nSize -= uiSplitSize;
-
-    while (nSize) {
-        strFileName.clear();
-        strContentType.clear();
-        strContentTransferEncoding.clear();
-
-        while (nSize > 0) {
-            ch = *szQueryString++;
-            nSize--;
-            if (ch != '\r')
-                return;
-            if (nSize > 0 && *szQueryString == '\n') {
-                nSize--;
-                szQueryString++;
-            }
-
-            p = szQueryString;
-            while (nSize > 0 && *p != '\r') {
-                nSize--;
-                p++;
-            }
-
-            if (nSize == 0)
-                break;
-
-            p1 = szQueryString;
-            szQueryString = p;
-
-            if (p != p1) {
-                if (p1 + 20 < p && !qstricmp(p1, "Content-Disposition:", 20)) {
-                    p1 += 20;
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-                    if (p1 + 10 >= p || qstricmp(p1, "form-data;", 10))
-                        return;
-
-                    p1 += 10;
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-                    if (p1 + 5 >= p || qstricmp(p1, "name=", 5))
-                        return;
-
-                    p1 += 5;
-
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-
-                    ch = ';';
-                    if (*p1 == '\"') {
-                        p1++;
-                        ch = '\"';
-                    }
-
-                    p2 = p1;
-                    while (p1 < p && *p1 != ch)
-                        p1++;
-
-                    strName.assign(p2, (size_t)(p1 - p2));
-
-                    if (p1 < p && *p1 == '\"')
-                        p1++;
-
-                    if (p1 < p && *p1 == ';')
-                        p1++;
-
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-
-                    if (p1 + 9 < p && !qstricmp(p1, "filename=", 9)) {
-                        p1 += 9;
-
-                        while (p1 < p && *p1 == ' ')
-                            p1++;
-
-                        ch = ';';
-                        if (*p1 == '\"') {
-                            p1++;
-                            ch = '\"';
-                        }
-
-                        p2 = p1;
-                        while (p1 < p && *p1 != ch) {
-                            if (*p1 == '/' || *p1 == '\\')
-                                p2 = p1 + 1;
-                            p1++;
-                        }
-
-                        strFileName.assign(p2, (size_t)(p1 - p2));
-                    }
-                } else if (p1 + 13 < p && !qstricmp(p1, "Content-Type:", 13)) {
-                    p1 += 13;
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-                    strContentType.assign(p1, (size_t)(p - p1));
-                } else if (p1 + 26 < p && !qstricmp(p1, "Content-Transfer-Encoding:", 26)) {
-                    p1 += 26;
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-                    strContentTransferEncoding.assign(p1, (size_t)(p - p1));
-                }
-            } else {
-                ch = *szQueryString++;
-                nSize--;
-                if (ch != '\r')
-                    return;
-                if (nSize > 0 && *szQueryString == '\n') {
-                    nSize--;
-                    szQueryString++;
-                }
-                break;
-            }
-        }
-
-        p = szQueryString;
-        p1 = p + nSize;
-        while (p1 > p && (p = (char*)memchr(p, '-', p1 - p))
-            && p1 > p + uiSplitSize && memcmp(p, pstrSplit, uiSplitSize))
-            p++;
-
-        if (!p || p1 <= p + uiSplitSize)
-            break;
+    Variant v;
 
-        nSize = (size_t)(p1 - p - uiSplitSize);
-        p1 = szQueryString;
-        szQueryString = p + uiSplitSize;
-
-        if (p > p1) {
-            p--;
-            ch = *p;
-            if (ch != '\n')
-                return;
-
-            if (p > p1 && *(p - 1) == '\r')
-                p--;
-        }
+    v = value;
+    return add(name, v);
+}
 
-        if (!strName.empty()) {
-            size_t uiSize = (size_t)(p - p1);
-            exlib::string strTemp;
-            Variant varTemp;
+result_t HttpUploadCollection::on_file(exlib::string& name, HttpUploadData* file, obj_ptr<Stream_base>& stm)
+{
+    return 0;
+}
 
-            strTemp.assign(p1, uiSize);
+result_t HttpUploadCollection::on_file_end(exlib::string& name, HttpUploadData* file)
+{
+    Variant v;
 
-            if (strFileName.empty())
-                varTemp = strTemp;
-            else {
-                obj_ptr<HttpUploadData> objTemp = new HttpUploadData();
-                date_t tm;
+    v = file;
+    return add(name, v);
+}
 
-                objTemp->m_name = strFileName;
-                objTemp->m_type = strContentType;
-                objTemp->m_encoding = strContentTransferEncoding;
-                objTemp->m_body = new MemoryStream::CloneStream(strTemp, tm);
+result_t HttpUploadCollection::parse(SeekableStream_base* body, exlib::string contentType, int64_t threshold)
+{
+    MultipartParser parser(this, threshold);
 
-                varTemp = objTemp;
-            }
+    if (parser.init(contentType) == CALL_RETURN_NULL)
+        return 0;
 
-            add(strName, varTemp);
-        }
-    }
+    return parser.parse(body);
 }
 
 result_t HttpUploadCollection::clear()
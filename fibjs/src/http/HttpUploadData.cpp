@@ -30,6 +30,9 @@ result_t HttpUploadData::get_contentTransferEncoding(exlib::string& retVal)
 
 result_t HttpUploadData::get_body(obj_ptr<SeekableStream_base>& retVal)
 {
+    if (!m_body)
+        return CALL_RETURN_NULL;
+
     retVal = m_body;
     return 0;
 }
@@ -165,6 +165,51 @@ result_t HttpsServer::set_enableEncoding(bool newVal)
     return m_hdlr->set_enableEncoding(newVal);
 }
 
+result_t HttpsServer::get_encodingLevel(int32_t& retVal)
+{
+    return m_hdlr->get_encodingLevel(retVal);
+}
+
+result_t HttpsServer::set_encodingLevel(int32_t newVal)
+{
+    return m_hdlr->set_encodingLevel(newVal);
+}
+
+result_t HttpsServer::get_encodingThreshold(int32_t& retVal)
+{
+    return m_hdlr->get_encodingThreshold(retVal);
+}
+
+result_t HttpsServer::set_encodingThreshold(int32_t newVal)
+{
+    return m_hdlr->set_encodingThreshold(newVal);
+}
+
+result_t HttpsServer::get_enableHttp2(bool& retVal)
+{
+    return m_hdlr->get_enableHttp2(retVal);
+}
+
+result_t HttpsServer::set_enableHttp2(bool newVal)
+{
+    result_t hr = m_hdlr->set_enableHttp2(newVal);
+    if (hr < 0)
+        return hr;
+
+    ((SslServer*)(SslServer_base*)m_server)->update_alpn();
+    return 0;
+}
+
+result_t HttpsServer::get_maxPipeline(int32_t& retVal)
+{
+    return m_hdlr->get_maxPipeline(retVal);
+}
+
+result_t HttpsServer::set_maxPipeline(int32_t newVal)
+{
+    return m_hdlr->set_maxPipeline(newVal);
+}
+
 result_t HttpsServer::get_serverName(exlib::string& retVal)
 {
     return m_hdlr->get_serverName(retVal);
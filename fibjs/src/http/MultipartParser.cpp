@@ -0,0 +1,497 @@
+/*
+ * MultipartParser.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "MultipartParser.h"
+#include "HttpMessage.h"
+#include "MemoryStream.h"
+#include "Buffer.h"
+#include "File.h"
+#include <string.h>
+
+namespace fibjs {
+
+MultipartParser::MultipartParser(Sink* sink, int64_t threshold)
+    : m_sink(sink)
+    , m_threshold(threshold)
+    , m_state(S_DONE)
+    , m_pos(0)
+    , m_scan(0)
+    , m_head(0)
+{
+}
+
+result_t MultipartParser::init(exlib::string contentType)
+{
+    const char* p = contentType.c_str();
+    const char* p1;
+    size_t i, n;
+
+    if (qstricmp(p, "multipart/form-data;", 20))
+        return CALL_RETURN_NULL;
+
+    p += 20;
+    while (*p == ' ')
+        p++;
+
+    if (qstricmp(p, "boundary=", 9))
+        return CALL_RETURN_NULL;
+
+    p += 9;
+    if (*p == '\"') {
+        p++;
+        p1 = p;
+        while (*p1 && *p1 != '\"')
+            p1++;
+    } else {
+        p1 = p;
+        while (*p1 && *p1 != ';')
+            p1++;
+        while (p1 > p && p1[-1] == ' ')
+            p1--;
+    }
+
+    if (p1 == p)
+        return CALL_RETURN_NULL;
+
+    m_delim.assign("\n--", 3);
+    m_delim.append(p, (size_t)(p1 - p));
+
+    // Boyer-Moore-Horspool shift table, keyed by the byte under the last delimiter position
+    n = m_delim.length();
+    for (i = 0; i < 256; i++)
+        m_skip[i] = n;
+    for (i = 0; i < n - 1; i++)
+        m_skip[(uint8_t)m_delim[i]] = n - 1 - i;
+
+    // a leading line break lets the first boundary match at the very start of the body
+    m_buf.assign(1, '\n');
+    m_pos = 0;
+    m_scan = 0;
+    m_state = S_PREAMBLE;
+
+    return 0;
+}
+
+size_t MultipartParser::find()
+{
+    const char* s = m_buf.c_str();
+    const char* d = m_delim.c_str();
+    size_t n = m_delim.length();
+    size_t len = m_buf.length();
+    uint8_t last = (uint8_t)d[n - 1];
+    size_t p = m_scan;
+
+    while (p + n <= len) {
+        uint8_t ch = (uint8_t)s[p + n - 1];
+
+        if (ch == last && !memcmp(s + p, d, n - 1))
+            return p;
+        p += m_skip[ch];
+    }
+
+    m_scan = p;
+    return (size_t)-1;
+}
+
+bool MultipartParser::header(const char* p, const char* end)
+{
+    const char *p1, *p2;
+    char ch;
+
+    p1 = p;
+    if (p1 + 20 < end && !qstricmp(p1, "Content-Disposition:", 20)) {
+        p1 += 20;
+        while (p1 < end && *p1 == ' ')
+            p1++;
+        if (p1 + 10 >= end || qstricmp(p1, "form-data;", 10))
+            return false;
+
+        p1 += 10;
+        while (p1 < end && *p1 == ' ')
+            p1++;
+        if (p1 + 5 >= end || qstricmp(p1, "name=", 5))
+            return false;
+
+        p1 += 5;
+        while (p1 < end && *p1 == ' ')
+            p1++;
+
+        ch = ';';
+        if (p1 < end && *p1 == '\"') {
+            p1++;
+            ch = '\"';
+        }
+
+        p2 = p1;
+        while (p1 < end && *p1 != ch)
+            p1++;
+
+        m_name.assign(p2, (size_t)(p1 - p2));
+
+        if (p1 < end && *p1 == '\"')
+            p1++;
+
+        if (p1 < end && *p1 == ';')
+            p1++;
+
+        while (p1 < end && *p1 == ' ')
+            p1++;
+
+        if (p1 + 9 < end && !qstricmp(p1, "filename=", 9)) {
+            p1 += 9;
+
+            while (p1 < end && *p1 == ' ')
+                p1++;
+
+            ch = ';';
+            if (*p1 == '\"') {
+                p1++;
+                ch = '\"';
+            }
+
+            p2 = p1;
+            while (p1 < end && *p1 != ch) {
+                if (*p1 == '/' || *p1 == '\\')
+                    p2 = p1 + 1;
+                p1++;
+            }
+
+            m_filename.assign(p2, (size_t)(p1 - p2));
+        }
+    } else if (p1 + 13 < end && !qstricmp(p1, "Content-Type:", 13)) {
+        p1 += 13;
+        while (p1 < end && *p1 == ' ')
+            p1++;
+        m_type.assign(p1, (size_t)(end - p1));
+    } else if (p1 + 26 < end && !qstricmp(p1, "Content-Transfer-Encoding:", 26)) {
+        p1 += 26;
+        while (p1 < end && *p1 == ' ')
+            p1++;
+        m_encoding.assign(p1, (size_t)(end - p1));
+    }
+
+    return true;
+}
+
+result_t MultipartParser::boundary(bool& more)
+{
+    const char* p = m_buf.c_str() + m_pos;
+    size_t n = m_buf.length() - m_pos;
+    size_t i = 0;
+
+    if (n > 0 && p[0] == '-') {
+        if (n < 2) {
+            more = false;
+            return 0;
+        }
+
+        // the close delimiter, whatever follows is epilogue
+        m_state = S_DONE;
+        return 0;
+    }
+
+    while (i < n && (p[i] == ' ' || p[i] == '\t'))
+        i++;
+
+    if (i == n || (p[i] == '\r' && i + 1 == n)) {
+        if (i > HTTP_MAX_LINE)
+            m_state = S_DONE;
+        more = false;
+        return 0;
+    }
+
+    if (p[i] == '\r')
+        i++;
+
+    if (p[i] != '\n') {
+        m_state = S_DONE;
+        return 0;
+    }
+
+    m_pos += i + 1;
+    m_head = 0;
+    m_name.clear();
+    m_filename.clear();
+    m_type.clear();
+    m_encoding.clear();
+    m_state = S_HEADERS;
+
+    return 0;
+}
+
+result_t MultipartParser::headers(bool& more)
+{
+    while (true) {
+        const char* s = m_buf.c_str();
+        size_t len = m_buf.length();
+        const char* p = (const char*)memchr(s + m_pos, '\n', len - m_pos);
+
+        if (!p) {
+            if (m_head + len - m_pos > HTTP_MAX_HEAD)
+                m_state = S_DONE;
+            more = false;
+            return 0;
+        }
+
+        size_t sz = (size_t)(p - s) - m_pos;
+        m_head += sz + 1;
+        if (m_head > HTTP_MAX_HEAD) {
+            m_state = S_DONE;
+            return 0;
+        }
+
+        const char* end = p;
+        if (end > s + m_pos && end[-1] == '\r')
+            end--;
+
+        if (end == s + m_pos) {
+            // the line break ending the headers stays in front of the body, so an empty
+            // body is a delimiter right here
+            m_pos = (size_t)(p - s);
+            m_scan = m_pos;
+            m_state = S_BODY;
+            return begin_part();
+        }
+
+        if (!header(s + m_pos, end)) {
+            m_state = S_DONE;
+            return 0;
+        }
+
+        m_pos = (size_t)(p - s) + 1;
+    }
+}
+
+result_t MultipartParser::body(bool& more)
+{
+    const char* s = m_buf.c_str();
+    size_t n = m_delim.length();
+    size_t i = find();
+    result_t hr;
+
+    // the byte at m_pos is never part content, it is the line break before the body
+    // or a byte that has already been handed out
+    if (i != (size_t)-1) {
+        size_t end = i;
+
+        if (end > m_pos + 1 && s[end - 1] == '\r')
+            end--;
+
+        if (end > m_pos + 1) {
+            hr = put(s + m_pos + 1, end - m_pos - 1);
+            if (hr < 0)
+                return hr;
+        }
+
+        hr = end_part();
+        if (hr < 0)
+            return hr;
+
+        m_pos = i + n;
+        m_state = S_BOUNDARY;
+        return 0;
+    }
+
+    // keep the last n bytes, they may hold the start of a delimiter and the CR before it
+    size_t len = m_buf.length();
+    if (len > m_pos + 1 + n) {
+        size_t cut = len - n;
+
+        hr = put(s + m_pos + 1, cut - m_pos - 1);
+        if (hr < 0)
+            return hr;
+
+        m_pos = cut - 1;
+    }
+
+    more = false;
+    return 0;
+}
+
+result_t MultipartParser::process()
+{
+    bool more = true;
+    result_t hr = 0;
+
+    while (more && m_state != S_DONE) {
+        switch (m_state) {
+        case S_PREAMBLE: {
+            size_t i = find();
+            if (i == (size_t)-1) {
+                m_pos = m_scan;
+                more = false;
+            } else {
+                m_pos = i + m_delim.length();
+                m_state = S_BOUNDARY;
+            }
+            break;
+        }
+        case S_BOUNDARY:
+            hr = boundary(more);
+            break;
+        case S_HEADERS:
+            hr = headers(more);
+            break;
+        case S_BODY:
+            hr = body(more);
+            break;
+        }
+
+        if (hr < 0)
+            return hr;
+    }
+
+    return 0;
+}
+
+result_t MultipartParser::write(const char* data, size_t sz)
+{
+    if (m_state == S_DONE)
+        return 0;
+
+    m_buf.append(data, sz);
+    result_t hr = process();
+
+    if (m_pos) {
+        m_buf = m_buf.substr(m_pos);
+        m_scan = m_scan > m_pos ? m_scan - m_pos : 0;
+        m_pos = 0;
+    }
+
+    return hr;
+}
+
+result_t MultipartParser::end()
+{
+    // a part cut off by the end of the body is dropped
+    m_state = S_DONE;
+    m_buf.clear();
+    m_value.clear();
+    m_file.Release();
+    m_stm.Release();
+    m_spill.Release();
+
+    return 0;
+}
+
+result_t MultipartParser::parse(SeekableStream_base* body)
+{
+    result_t hr;
+
+    body->rewind();
+    while (true) {
+        obj_ptr<Buffer_base> buf;
+
+        hr = body->cc_read(STREAM_BUFF_SIZE, buf);
+        if (hr < 0)
+            return hr;
+        if (hr == CALL_RETURN_NULL)
+            break;
+
+        Buffer* _buf = (Buffer*)(Buffer_base*)buf;
+        int32_t len;
+
+        _buf->get_length(len);
+        hr = write(_buf->data(), len);
+        if (hr < 0)
+            return hr;
+
+        if (m_state == S_DONE)
+            break;
+    }
+
+    return end();
+}
+
+result_t MultipartParser::begin_part()
+{
+    // parts without a name are skipped
+    if (m_name.empty() || m_filename.empty())
+        return 0;
+
+    m_file = new HttpUploadData();
+    m_file->m_name = m_filename;
+    m_file->m_type = m_type;
+    m_file->m_encoding = m_encoding;
+
+    return m_sink->on_file(m_name, m_file, m_stm);
+}
+
+result_t MultipartParser::put(const char* data, size_t sz)
+{
+    result_t hr;
+
+    if (m_name.empty())
+        return 0;
+
+    if (m_stm || m_spill) {
+        obj_ptr<Buffer_base> buf = new Buffer(data, sz);
+
+        if (m_stm)
+            return m_stm->cc_write(buf);
+        return m_spill->cc_write(buf);
+    }
+
+    m_value.append(data, sz);
+
+    if (m_file && m_threshold >= 0 && (int64_t)m_value.length() > m_threshold) {
+        obj_ptr<TempFile> f = new TempFile();
+
+        hr = f->open("fibjs-upload-");
+        if (hr < 0)
+            return hr;
+
+        obj_ptr<Buffer_base> buf = new Buffer(m_value.c_str(), m_value.length());
+        hr = f->cc_write(buf);
+        if (hr < 0)
+            return hr;
+
+        m_value.clear();
+        m_spill = f;
+    }
+
+    return 0;
+}
+
+result_t MultipartParser::end_part()
+{
+    result_t hr;
+
+    if (m_name.empty())
+        return 0;
+
+    if (!m_file) {
+        hr = m_sink->on_field(m_name, m_value);
+        m_value.clear();
+        return hr;
+    }
+
+    if (m_spill)
+        m_file->m_body = m_spill;
+    else if (m_stm) {
+        // the part went to the stream from onFile, it can only be read back when the stream is seekable
+        m_file->m_body = dynamic_cast<SeekableStream_base*>((Stream_base*)m_stm);
+    } else {
+        date_t tm;
+        m_file->m_body = new MemoryStream::CloneStream(m_value, tm);
+    }
+
+    if (m_file->m_body)
+        m_file->m_body->rewind();
+
+    obj_ptr<HttpUploadData> file = m_file;
+
+    m_file.Release();
+    m_stm.Release();
+    m_spill.Release();
+    m_value.clear();
+
+    return m_sink->on_file_end(m_name, file);
+}
+
+} /* namespace fibjs */
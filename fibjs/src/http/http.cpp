@@ -131,6 +131,16 @@ result_t http_base::set_poolTimeout(int32_t newVal)
     return get_httpClient()->set_poolTimeout(newVal);
 }
 
+result_t http_base::get_maxConnsPerHost(int32_t& retVal)
+{
+    return get_httpClient()->get_maxConnsPerHost(retVal);
+}
+
+result_t http_base::set_maxConnsPerHost(int32_t newVal)
+{
+    return get_httpClient()->set_maxConnsPerHost(newVal);
+}
+
 result_t http_base::get_http_proxy(exlib::string& retVal)
 {
     return get_httpClient()->get_http_proxy(retVal);
@@ -156,6 +166,11 @@ result_t http_base::setClientCert(X509Cert_base* crt, PKey_base* key)
     return get_httpClient()->setClientCert(crt, key);
 }
 
+result_t http_base::poolStats(v8::Local<v8::Object>& retVal)
+{
+    return get_httpClient()->poolStats(retVal);
+}
+
 result_t http_base::request(Stream_base* conn, HttpRequest_base* req,
     obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
 {
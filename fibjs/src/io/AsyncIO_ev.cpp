@@ -14,11 +14,26 @@
 #include "ifs/net.h"
 #include "ifs/console.h"
 #include "Buffer.h"
+#include "RecvBuffer.h"
 #include <ev/ev.h>
 #include <fcntl.h>
 #include <exlib/include/thread.h>
 #include "options.h"
 #include <sys/wait.h>
+#include <sys/uio.h>
+#include <limits.h>
+
+#if defined(Linux)
+#include <sys/sendfile.h>
+#elif defined(Darwin) || defined(FreeBSD)
+#include <sys/socket.h>
+#endif
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+#define SENDFILE_CHUNK_SIZE (1024 * 1024 * 1024)
 
 namespace fibjs {
 
@@ -47,11 +62,61 @@ void setOption(intptr_t& sockfd)
     setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, (void*)&noDelay, sizeof(noDelay));
 }
 
-static struct ev_loop* s_loop;
+class evAsyncEvent;
+
+class evLoop : public exlib::OSThread {
+public:
+    evLoop(struct ev_loop* loop)
+        : m_loop(loop)
+    {
+        m_lock.lock();
+    }
+
+    virtual void Run()
+    {
+        Runtime rtForThread(NULL);
+
+        ev_async_init(&m_evAsyncWatcher, as_cb);
+        ev_async_start(m_loop, &m_evAsyncWatcher);
+
+        m_lock.unlock();
+        ev_run(m_loop, 0);
+    }
+
+    inline void post(evAsyncEvent* p);
+
+private:
+    static void as_cb(struct ev_loop* loop, struct ev_async* watcher,
+        int32_t revents);
+
+public:
+    struct ev_loop* m_loop;
+    exlib::spinlock m_lock;
+
+private:
+    ev_async m_evAsyncWatcher;
+    exlib::LockedList<evAsyncEvent> m_evWait;
+};
+
+static std::vector<evLoop*> s_loops;
+
+static evLoop* get_loop(intptr_t fd)
+{
+    if (s_loops.size() == 1 || fd == INVALID_SOCKET)
+        return s_loops[0];
+
+    return s_loops[(uint32_t)fd % s_loops.size()];
+}
 
 result_t net_base::backend(exlib::string& retVal)
 {
-    switch (ev_backend(s_loop)) {
+    // g_io_uring is only left set when the ring actually started
+    if (g_io_uring) {
+        retVal = "io_uring";
+        return 0;
+    }
+
+    switch (ev_backend(s_loops[0]->m_loop)) {
     case EVBACKEND_SELECT:
         retVal = "Select";
         break;
@@ -75,21 +140,26 @@ result_t net_base::backend(exlib::string& retVal)
     return 0;
 }
 
-class evAsyncEvent;
-
-static ev_async s_evAsyncWatcher;
-static exlib::LockedList<evAsyncEvent> s_evWait;
+result_t net_base::get_io_threads(int32_t& retVal)
+{
+    retVal = (int32_t)s_loops.size();
+    return 0;
+}
 
 class evAsyncEvent : public exlib::Task_base {
 public:
+    evAsyncEvent(intptr_t fd = INVALID_SOCKET)
+        : m_loop(get_loop(fd))
+    {
+    }
+
     virtual ~evAsyncEvent()
     {
     }
 
     void post()
     {
-        s_evWait.putTail(this);
-        ev_async_send(s_loop, &s_evAsyncWatcher);
+        m_loop->post(this);
     }
 
     virtual void start()
@@ -101,21 +171,52 @@ public:
     {
         post();
     }
+
+public:
+    evLoop* m_loop;
 };
 
+inline void evLoop::post(evAsyncEvent* p)
+{
+    m_evWait.putTail(p);
+    ev_async_send(m_loop, &m_evAsyncWatcher);
+}
+
+void evLoop::as_cb(struct ev_loop* loop, struct ev_async* watcher,
+    int32_t revents)
+{
+    evLoop* pThis = NULL;
+    pThis = (evLoop*)((intptr_t)watcher - (intptr_t)&pThis->m_evAsyncWatcher);
+
+    exlib::List<evAsyncEvent> jobs;
+    evAsyncEvent* p1;
+
+    pThis->m_evWait.getList(jobs);
+
+    while ((p1 = jobs.getHead()) != 0)
+        p1->start();
+}
+
 class AsyncSockProc : public evAsyncEvent {
 public:
     AsyncSockProc(intptr_t& sockfd, int32_t ev_op_t, AsyncEvent* ac, exlib::Locker& locker, void*& opt)
-        : m_sockfd(sockfd)
+        : evAsyncEvent(sockfd)
+        , m_sockfd(sockfd)
         , m_ev_op_t(ev_op_t)
         , m_ac(ac)
         , m_locker(locker)
         , m_opt(opt)
+        , m_stats(NULL)
+        , m_posted(0)
+        , m_ready(0)
     {
     }
 
     virtual void start()
     {
+        if (m_posted)
+            m_stats->queue(m_posted);
+
         if (m_sockfd == SOCKET_ERROR) {
             m_ac->apost(SOCKET_ERROR);
             delete this;
@@ -125,12 +226,14 @@ public:
         m_opt = this;
 
         ev_io_init(&m_io_watcher, io_cb, m_sockfd, m_ev_op_t);
-        ev_io_start(s_loop, &m_io_watcher);
+        ev_io_start(m_loop->m_loop, &m_io_watcher);
     }
 
 public:
-    result_t request()
+    result_t request(SockStats& stats)
     {
+        m_stats = &stats;
+
         if (m_locker.lock(this)) {
             result_t hr = process();
             if (hr != CALL_E_PENDDING) {
@@ -146,6 +249,14 @@ public:
         return CALL_E_PENDDING;
     }
 
+    // every post of a socket request means the last attempt hit EAGAIN and must wait for readiness
+    void post()
+    {
+        m_stats->again();
+        m_posted = SockStats::now();
+        evAsyncEvent::post();
+    }
+
     virtual result_t process()
     {
         return 0;
@@ -158,6 +269,9 @@ public:
 
     void ready(int32_t v)
     {
+        if (m_ready)
+            m_stats->resume(m_ready);
+
         m_opt = NULL;
         m_locker.unlock(this);
         m_ac->apost(v);
@@ -166,7 +280,8 @@ public:
 
     void on_watched()
     {
-        ev_io_stop(s_loop, &m_io_watcher);
+        m_ready = SockStats::now();
+        ev_io_stop(m_loop->m_loop, &m_io_watcher);
         after_unwatch();
     }
 
@@ -176,6 +291,9 @@ public:
     AsyncEvent* m_ac;
     exlib::Locker& m_locker;
     void*& m_opt;
+    SockStats* m_stats;
+    uint64_t m_posted;
+    uint64_t m_ready;
     ev_io m_io_watcher;
 
 private:
@@ -186,48 +304,24 @@ private:
     }
 };
 
-class _acIO : public exlib::OSThread {
-public:
-    _acIO()
-    {
-        m_lock.lock();
-        s_loop = EV_DEFAULT;
-    }
-
-    virtual void Run()
-    {
-        Runtime rtForThread(NULL);
-
-        ev_async_init(&s_evAsyncWatcher, as_cb);
-        ev_async_start(s_loop, &s_evAsyncWatcher);
-
-        m_lock.unlock();
-        ev_run(s_loop, 0);
-    }
+void InitializeAsyncIOThread()
+{
+    int32_t i;
 
-private:
-    static void as_cb(struct ev_loop* loop, struct ev_async* watcher,
-        int32_t revents)
-    {
-        exlib::List<evAsyncEvent> jobs;
-        evAsyncEvent* p1;
+#ifdef HAVE_IO_URING
+    if (g_io_uring)
+        g_io_uring = init_uring();
+#else
+    g_io_uring = false;
+#endif
 
-        s_evWait.getList(jobs);
+    for (i = 0; i < g_io_threads; i++) {
+        evLoop* loop = new evLoop(i ? ev_loop_new(EVFLAG_AUTO) : EV_DEFAULT);
 
-        while ((p1 = jobs.getHead()) != 0)
-            p1->start();
+        s_loops.push_back(loop);
+        loop->start();
+        loop->m_lock.lock();
     }
-
-public:
-    exlib::spinlock m_lock;
-};
-
-void InitializeAsyncIOThread()
-{
-    static _acIO s_acIO;
-
-    s_acIO.start();
-    s_acIO.m_lock.lock();
 }
 
 result_t AsyncIO::close(AsyncEvent* ac)
@@ -235,7 +329,8 @@ result_t AsyncIO::close(AsyncEvent* ac)
     class asyncClose : public evAsyncEvent {
     public:
         asyncClose(intptr_t& sockfd, void*& recvProc, void*& sendProc, AsyncEvent* ac)
-            : m_ac(ac)
+            : evAsyncEvent(sockfd)
+            , m_ac(ac)
             , m_sockfd(sockfd)
             , m_pRecvProc(recvProc)
             , m_pSendProc(sendProc)
@@ -266,6 +361,11 @@ result_t AsyncIO::close(AsyncEvent* ac)
         void*& m_pSendProc;
     };
 
+#ifdef HAVE_IO_URING
+    if (g_io_uring)
+        return uring_close(m_fd, m_RecvOpt, m_SendOpt, ac);
+#endif
+
     (new asyncClose(m_fd, m_RecvOpt, m_SendOpt, ac))->post();
     return CALL_E_PENDDING;
 }
@@ -354,7 +454,53 @@ result_t AsyncIO::connect(exlib::string host, int32_t port, AsyncEvent* ac, Time
         }
     }
 
-    return (new asyncConnect(m_fd, addr_info, ac, m_lockRecv, m_RecvOpt, timer))->request();
+#ifdef HAVE_IO_URING
+    if (g_io_uring)
+        return uring_connect(m_fd, addr_info, ac, m_lockRecv, m_RecvOpt, timer, m_stats);
+#endif
+
+    return (new asyncConnect(m_fd, addr_info, ac, m_lockRecv, m_RecvOpt, timer))->request(m_stats);
+}
+
+AcceptStats g_accept_stats;
+
+result_t accept_drain(intptr_t sockfd, std::vector<obj_ptr<Socket_base>>& socks, int32_t budget)
+{
+    while ((int32_t)socks.size() < budget) {
+        inetAddr ai;
+        socklen_t sz = sizeof(ai);
+#ifdef Linux
+        intptr_t c = ::accept4(sockfd, (sockaddr*)&ai, &sz, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+        intptr_t c = ::accept(sockfd, (sockaddr*)&ai, &sz);
+#endif
+        if (c == INVALID_SOCKET) {
+            int32_t nError = errno;
+
+            if (!socks.empty())
+                break;
+
+            return CHECK_ERROR((nError == EWOULDBLOCK) ? CALL_E_PENDDING : -nError);
+        }
+
+#ifndef Linux
+        fcntl(c, F_SETFL, fcntl(c, F_GETFL, 0) | O_NONBLOCK);
+        fcntl(c, F_SETFD, FD_CLOEXEC);
+#endif
+
+#ifdef Darwin
+        int32_t set_option = 1;
+        setsockopt(c, SOL_SOCKET, SO_NOSIGPIPE, &set_option,
+            sizeof(set_option));
+#endif
+        setOption(c);
+
+        socks.push_back(new Socket(c, ai.family()));
+    }
+
+    g_accept_stats.record(socks.size());
+
+    return 0;
 }
 
 result_t AsyncIO::accept(obj_ptr<Socket_base>& retVal, AsyncEvent* ac)
@@ -370,33 +516,55 @@ result_t AsyncIO::accept(obj_ptr<Socket_base>& retVal, AsyncEvent* ac)
 
         virtual result_t process()
         {
-            inetAddr ai;
-            socklen_t sz = sizeof(ai);
-            intptr_t c = ::accept(m_sockfd, (sockaddr*)&ai, &sz);
-            if (c == INVALID_SOCKET) {
-                int32_t nError = errno;
-                return CHECK_ERROR((nError == EWOULDBLOCK) ? CALL_E_PENDDING : -nError);
-            }
+            std::vector<obj_ptr<Socket_base>> socks;
+
+            result_t hr = accept_drain(m_sockfd, socks, 1);
+            if (hr < 0)
+                return hr;
 
-            fcntl(c, F_SETFL, fcntl(c, F_GETFL, 0) | O_NONBLOCK);
-            fcntl(c, F_SETFD, FD_CLOEXEC);
+            m_retVal = socks[0];
 
-#ifdef Darwin
-            int32_t set_option = 1;
-            setsockopt(c, SOL_SOCKET, SO_NOSIGPIPE, &set_option,
-                sizeof(set_option));
+            return 0;
+        }
+
+    public:
+        obj_ptr<Socket_base>& m_retVal;
+    };
+
+    if (m_fd == INVALID_SOCKET)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+#ifdef HAVE_IO_URING
+    if (g_io_uring)
+        return uring_accept(m_fd, retVal, ac, m_lockRecv, m_RecvOpt, m_stats);
 #endif
-            setOption(c);
 
-            obj_ptr<Socket> sock = new Socket(c, ai.family());
+    return (new asyncAccept(m_fd, retVal, ac, m_lockRecv, m_RecvOpt))->request(m_stats);
+}
 
-            m_retVal = sock;
+result_t AsyncIO::accept(std::vector<obj_ptr<Socket_base>>& retVal, int32_t budget, AsyncEvent* ac)
+{
+    class asyncAcceptBatch : public AsyncSockProc {
+    public:
+        asyncAcceptBatch(intptr_t& sockfd, std::vector<obj_ptr<Socket_base>>& retVal, int32_t budget,
+            AsyncEvent* ac, exlib::Locker& locker, void*& opt)
+            : AsyncSockProc(sockfd, EV_READ, ac, locker, opt)
+            , m_retVal(retVal)
+            , m_budget(budget)
+        {
+        }
 
-            return 0;
+        virtual result_t process()
+        {
+            return accept_drain(m_sockfd, m_retVal, m_budget);
         }
 
     public:
-        obj_ptr<Socket_base>& m_retVal;
+        std::vector<obj_ptr<Socket_base>>& m_retVal;
+        int32_t m_budget;
     };
 
     if (m_fd == INVALID_SOCKET)
@@ -405,7 +573,15 @@ result_t AsyncIO::accept(obj_ptr<Socket_base>& retVal, AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    return (new asyncAccept(m_fd, retVal, ac, m_lockRecv, m_RecvOpt))->request();
+    if (budget < 1)
+        budget = 1;
+
+#ifdef HAVE_IO_URING
+    if (g_io_uring)
+        return uring_accept(m_fd, retVal, budget, ac, m_lockRecv, m_RecvOpt, m_stats);
+#endif
+
+    return (new asyncAcceptBatch(m_fd, retVal, budget, ac, m_lockRecv, m_RecvOpt))->request(m_stats);
 }
 
 result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
@@ -414,11 +590,13 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
     class asyncRecv : public AsyncSockProc {
     public:
         asyncRecv(intptr_t& sockfd, int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac,
-            int32_t family, bool bRead, exlib::Locker& locker, void*& opt, Timer_base* timer)
+            int32_t family, bool bRead, exlib::Locker& locker, void*& opt, Timer_base* timer,
+            int32_t& recvSize)
             : AsyncSockProc(sockfd, EV_READ, ac, locker, opt)
             , m_retVal(retVal)
             , m_pos(0)
-            , m_bytes(bytes > 0 ? bytes : SOCKET_BUFF_SIZE)
+            , m_bytes(bytes)
+            , m_recvSize(recvSize)
             , m_family(family)
             , m_bRead(bRead)
             , m_timer(timer)
@@ -428,7 +606,7 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
         virtual result_t process()
         {
             if (m_buf.empty())
-                m_buf.resize(m_bytes);
+                m_buf.alloc(m_bytes, m_recvSize);
 
             char* _buf = m_buf.c_buffer();
             do {
@@ -445,7 +623,7 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
                         n = 0;
                     else {
                         if (m_pos == 0)
-                            m_buf.resize(0);
+                            m_buf.free();
 
                         if (nError == EWOULDBLOCK)
                             return CHECK_ERROR(CALL_E_PENDDING);
@@ -458,6 +636,7 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
                     }
                 }
 
+                m_stats->read(n);
                 if (n == 0)
                     m_bRead = false;
 
@@ -469,12 +648,11 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
                     }
                     return CALL_RETURN_NULL;
                 }
-            } while (m_bRead && m_pos < (int32_t)m_buf.length());
+            } while (m_bRead && m_pos < m_buf.length());
 
-            m_buf.resize(m_pos);
-            m_retVal = new Buffer(m_buf);
             if (g_tcpdump)
-                outLog(console_base::C_NOTICE, clean_string(m_buf));
+                outLog(console_base::C_NOTICE, clean_string(exlib::string(m_buf.c_buffer(), m_pos)));
+            m_retVal = m_buf.detach(m_pos);
 
             return 0;
         }
@@ -498,9 +676,10 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
         obj_ptr<Buffer_base>& m_retVal;
         int32_t m_pos;
         int32_t m_bytes;
+        int32_t& m_recvSize;
         int32_t m_family;
         bool m_bRead;
-        exlib::string m_buf;
+        RecvBuffer m_buf;
         obj_ptr<Timer_base> m_timer;
     };
 
@@ -513,7 +692,12 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    return (new asyncRecv(m_fd, bytes, retVal, ac, m_family, bRead, m_lockRecv, m_RecvOpt, timer))->request();
+#ifdef HAVE_IO_URING
+    if (g_io_uring)
+        return uring_read(m_fd, bytes, retVal, ac, m_family, bRead, m_lockRecv, m_RecvOpt, timer, m_recvSize, m_stats);
+#endif
+
+    return (new asyncRecv(m_fd, bytes, retVal, ac, m_family, bRead, m_lockRecv, m_RecvOpt, timer, m_recvSize))->request(m_stats);
 }
 
 result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
@@ -524,12 +708,15 @@ result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
             : AsyncSockProc(sockfd, EV_WRITE, ac, locker, opt)
             , m_family(family)
         {
-            data->toString(m_buf);
-            m_p = m_buf.c_str();
-            m_sz = m_buf.length();
+            int32_t len;
+
+            data->get_length(len);
+            m_buf = data;
+            m_p = ((Buffer*)data)->data();
+            m_sz = len;
 
             if (g_tcpdump)
-                outLog(console_base::C_WARN, clean_string(m_buf));
+                outLog(console_base::C_WARN, clean_string(exlib::string(m_p, m_sz)));
         }
 
         virtual result_t process()
@@ -546,6 +733,8 @@ result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
                     return CHECK_ERROR((nError == EWOULDBLOCK) ? CALL_E_PENDDING : -nError);
                 }
 
+                m_stats->write(n);
+
                 m_sz -= n;
                 m_p += n;
             }
@@ -564,7 +753,7 @@ result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
         }
 
     public:
-        exlib::string m_buf;
+        obj_ptr<Buffer_base> m_buf;
         const char* m_p;
         int32_t m_sz;
         int32_t m_family;
@@ -576,7 +765,218 @@ result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    return (new asyncSend(m_fd, data, ac, m_family, m_lockSend, m_SendOpt))->request();
+#ifdef HAVE_IO_URING
+    if (g_io_uring)
+        return uring_write(m_fd, data, ac, m_family, m_lockSend, m_SendOpt, m_stats);
+#endif
+
+    return (new asyncSend(m_fd, data, ac, m_family, m_lockSend, m_SendOpt))->request(m_stats);
+}
+
+result_t AsyncIO::writev(std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac)
+{
+    class asyncSendv : public AsyncSockProc {
+    public:
+        asyncSendv(intptr_t& sockfd, std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac, int32_t family, exlib::Locker& locker, void*& opt)
+            : AsyncSockProc(sockfd, EV_WRITE, ac, locker, opt)
+            , m_datas(datas)
+            , m_pos(0)
+            , m_family(family)
+        {
+            size_t i;
+
+            for (i = 0; i < m_datas.size(); i++) {
+                Buffer* buf = (Buffer*)(Buffer_base*)m_datas[i];
+                int32_t len;
+
+                buf->get_length(len);
+                if (len > 0) {
+                    struct iovec iov;
+
+                    iov.iov_base = buf->data();
+                    iov.iov_len = len;
+                    m_iov.push_back(iov);
+
+                    if (g_tcpdump)
+                        outLog(console_base::C_WARN, clean_string(exlib::string(buf->data(), len)));
+                }
+            }
+        }
+
+        virtual result_t process()
+        {
+            while (m_pos < m_iov.size()) {
+                int32_t cnt = (int32_t)(m_iov.size() - m_pos);
+                ssize_t n;
+
+                if (cnt > IOV_MAX)
+                    cnt = IOV_MAX;
+
+                if (m_family) {
+                    struct msghdr msg;
+
+                    memset(&msg, 0, sizeof(msg));
+                    msg.msg_iov = &m_iov[m_pos];
+                    msg.msg_iovlen = cnt;
+
+                    n = ::sendmsg(m_sockfd, &msg, MSG_NOSIGNAL);
+                } else
+                    n = ::writev(m_sockfd, &m_iov[m_pos], cnt);
+                if (n == SOCKET_ERROR) {
+                    int32_t nError = errno;
+                    return CHECK_ERROR((nError == EWOULDBLOCK) ? CALL_E_PENDDING : -nError);
+                }
+
+                m_stats->write(n);
+
+                while (n > 0) {
+                    struct iovec& iov = m_iov[m_pos];
+
+                    if ((size_t)n >= iov.iov_len) {
+                        n -= iov.iov_len;
+                        m_pos++;
+                    } else {
+                        iov.iov_base = (char*)iov.iov_base + n;
+                        iov.iov_len -= n;
+                        n = 0;
+                    }
+                }
+            }
+
+            return 0;
+        }
+
+        virtual void after_unwatch()
+        {
+            result_t hr = process();
+
+            if (hr == CALL_E_PENDDING)
+                post();
+            else
+                ready(hr);
+        }
+
+    public:
+        std::vector<obj_ptr<Buffer_base>> m_datas;
+        std::vector<struct iovec> m_iov;
+        size_t m_pos;
+        int32_t m_family;
+    };
+
+    if (m_fd == INVALID_SOCKET)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+#ifdef HAVE_IO_URING
+    if (g_io_uring)
+        return uring_writev(m_fd, datas, ac, m_family, m_lockSend, m_SendOpt, m_stats);
+#endif
+
+    return (new asyncSendv(m_fd, datas, ac, m_family, m_lockSend, m_SendOpt))->request(m_stats);
+}
+
+ssize_t sys_sendfile(intptr_t sockfd, int32_t fd, int64_t& pos, size_t sz)
+{
+#if defined(Linux)
+    off_t off = (off_t)pos;
+    ssize_t n = ::sendfile((int32_t)sockfd, fd, &off, sz);
+
+    if (n > 0)
+        pos = off;
+    return n;
+#elif defined(Darwin)
+    off_t len = (off_t)sz;
+    int32_t r = ::sendfile(fd, (int32_t)sockfd, (off_t)pos, &len, NULL, 0);
+
+    if (r < 0 && (errno != EAGAIN || len == 0))
+        return -1;
+
+    pos += len;
+    return (ssize_t)len;
+#elif defined(FreeBSD)
+    off_t len = 0;
+    int32_t r = ::sendfile(fd, (int32_t)sockfd, (off_t)pos, sz, NULL, &len, 0);
+
+    if (r < 0 && (errno != EAGAIN || len == 0))
+        return -1;
+
+    pos += len;
+    return (ssize_t)len;
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+result_t AsyncIO::sendfile(int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal, AsyncEvent* ac)
+{
+    class asyncSendFile : public AsyncSockProc {
+    public:
+        asyncSendFile(intptr_t& sockfd, int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal,
+            AsyncEvent* ac, exlib::Locker& locker, void*& opt)
+            : AsyncSockProc(sockfd, EV_WRITE, ac, locker, opt)
+            , m_fd(fd)
+            , m_pos(pos)
+            , m_bytes(bytes)
+            , m_retVal(retVal)
+        {
+        }
+
+        virtual result_t process()
+        {
+            while (m_bytes > 0) {
+                size_t sz = m_bytes > SENDFILE_CHUNK_SIZE ? SENDFILE_CHUNK_SIZE : (size_t)m_bytes;
+                ssize_t n = sys_sendfile(m_sockfd, m_fd, m_pos, sz);
+
+                if (n == SOCKET_ERROR) {
+                    int32_t nError = errno;
+                    return CHECK_ERROR((nError == EWOULDBLOCK) ? CALL_E_PENDDING : -nError);
+                }
+
+                if (n == 0)
+                    break;
+
+                m_stats->write(n);
+                m_bytes -= n;
+                m_retVal += n;
+            }
+
+            return 0;
+        }
+
+        virtual void after_unwatch()
+        {
+            result_t hr = process();
+
+            if (hr == CALL_E_PENDDING)
+                post();
+            else
+                ready(hr);
+        }
+
+    public:
+        int32_t m_fd;
+        int64_t m_pos;
+        int64_t m_bytes;
+        int64_t& m_retVal;
+    };
+
+    if (m_fd == INVALID_SOCKET)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    retVal = 0;
+
+#ifdef HAVE_IO_URING
+    if (g_io_uring)
+        return uring_sendfile(m_fd, fd, pos, bytes, retVal, ac, m_lockSend, m_SendOpt, m_stats);
+#endif
+
+    return (new asyncSendFile(m_fd, fd, pos, bytes, retVal, ac, m_lockSend, m_SendOpt))->request(m_stats);
 }
 
 void AsyncIO::run(void (*watchProc)(void*))
@@ -590,7 +990,7 @@ void AsyncIO::run(void (*watchProc)(void*))
 
         virtual void start()
         {
-            m_proc(s_loop);
+            m_proc(m_loop->m_loop);
             delete this;
         }
 
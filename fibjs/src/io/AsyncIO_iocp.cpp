@@ -153,6 +153,12 @@ result_t net_base::backend(exlib::string& retVal)
     return 0;
 }
 
+result_t net_base::get_io_threads(int32_t& retVal)
+{
+    retVal = 1;
+    return 0;
+}
+
 result_t AsyncIO::connect(exlib::string host, int32_t port, AsyncEvent* ac, Timer_base* timer)
 {
     class asyncConnect : public asyncProc {
@@ -253,6 +259,8 @@ result_t AsyncIO::connect(exlib::string host, int32_t port, AsyncEvent* ac, Time
     return CHECK_ERROR(CALL_E_PENDDING);
 }
 
+AcceptStats g_accept_stats;
+
 result_t AsyncIO::accept(obj_ptr<Socket_base>& retVal, AsyncEvent* ac)
 {
     class asyncAccept : public asyncProc {
@@ -295,6 +303,7 @@ result_t AsyncIO::accept(obj_ptr<Socket_base>& retVal, AsyncEvent* ac)
                 setsockopt(m_s, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT,
                     (char*)&m_sListen, sizeof(m_sListen));
                 setOption(m_s);
+                g_accept_stats.record(1);
             }
             asyncProc::ready(dwBytes, nError);
         }
@@ -331,14 +340,16 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
     class asyncRecv : public asyncProc {
     public:
         asyncRecv(SOCKET s, int32_t bytes, obj_ptr<Buffer_base>& retVal,
-            AsyncEvent* ac, bool bRead, exlib::Locker& locker, Timer_base* timer)
+            AsyncEvent* ac, bool bRead, exlib::Locker& locker, Timer_base* timer,
+            int32_t& recvSize, SockStats& stats)
             : asyncProc(s, ac, locker)
             , m_retVal(retVal)
             , m_pos(0)
             , m_bRead(bRead)
             , m_timer(timer)
+            , m_stats(stats)
         {
-            m_buf.resize(bytes > 0 ? bytes : SOCKET_BUFF_SIZE);
+            m_buf.alloc(bytes, recvSize);
         }
 
         virtual result_t process()
@@ -386,19 +397,19 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
                 m_bRead = false;
 
             if (!nError) {
+                m_stats.read(dwBytes);
                 m_pos += dwBytes;
 
-                if (m_bRead && m_pos < (int32_t)m_buf.length()) {
+                if (m_bRead && m_pos < m_buf.length()) {
                     proc();
                     return;
                 }
 
                 if (m_pos) {
-                    m_buf.resize(m_pos);
-                    m_retVal = new Buffer(m_buf);
-
                     if (g_tcpdump)
-                        outLog(console_base::C_NOTICE, clean_string(m_buf));
+                        outLog(console_base::C_NOTICE, clean_string(exlib::string(m_buf.c_buffer(), m_pos)));
+
+                    m_retVal = m_buf.detach(m_pos);
                 } else
                     nError = CALL_RETURN_NULL;
             }
@@ -410,8 +421,9 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
         obj_ptr<Buffer_base>& m_retVal;
         int32_t m_pos;
         bool m_bRead;
-        exlib::string m_buf;
+        RecvBuffer m_buf;
         obj_ptr<Timer_base> m_timer;
+        SockStats& m_stats;
     };
 
     if (m_fd == INVALID_SOCKET) {
@@ -423,7 +435,7 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    (new asyncRecv(m_fd, bytes, retVal, ac, bRead, m_lockRecv, timer))->post();
+    (new asyncRecv(m_fd, bytes, retVal, ac, bRead, m_lockRecv, timer, m_recvSize, m_stats))->post();
     return CHECK_ERROR(CALL_E_PENDDING);
 }
 
@@ -431,8 +443,9 @@ result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
 {
     class asyncSend : public asyncProc {
     public:
-        asyncSend(SOCKET s, Buffer_base* data, AsyncEvent* ac, exlib::Locker& locker)
+        asyncSend(SOCKET s, Buffer_base* data, AsyncEvent* ac, exlib::Locker& locker, SockStats& stats)
             : asyncProc(s, ac, locker)
+            , m_stats(stats)
         {
             data->toString(m_buf);
             m_p = m_buf.c_str();
@@ -457,6 +470,7 @@ result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
         virtual void ready(DWORD dwBytes, int32_t nError)
         {
             if (!nError) {
+                m_stats.write(dwBytes);
                 m_p += dwBytes;
                 m_sz -= dwBytes;
 
@@ -473,6 +487,7 @@ result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
         exlib::string m_buf;
         const char* m_p;
         int32_t m_sz;
+        SockStats& m_stats;
     };
 
     if (m_fd == INVALID_SOCKET)
@@ -481,9 +496,25 @@ result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    (new asyncSend(m_fd, data, ac, m_lockSend))->post();
+    (new asyncSend(m_fd, data, ac, m_lockSend, m_stats))->post();
     return CHECK_ERROR(CALL_E_PENDDING);
 }
+
+result_t AsyncIO::writev(std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac)
+{
+    exlib::string strBuf;
+    size_t i;
+
+    for (i = 0; i < datas.size(); i++) {
+        exlib::string str;
+
+        datas[i]->toString(str);
+        strBuf.append(str);
+    }
+
+    obj_ptr<Buffer_base> buf = new Buffer(strBuf);
+    return write(buf, ac);
+}
 }
 
 #endif
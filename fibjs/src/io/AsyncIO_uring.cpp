@@ -0,0 +1,1126 @@
+/*
+ * AsyncIO_uring.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "utils.h"
+#include "AsyncIO.h"
+
+#ifdef HAVE_IO_URING
+
+#include "Socket.h"
+#include "ifs/console.h"
+#include "Buffer.h"
+#include "RecvBuffer.h"
+#include <exlib/include/thread.h>
+#include "options.h"
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <sys/uio.h>
+#include <limits.h>
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+#define SENDFILE_CHUNK_SIZE (1024 * 1024 * 1024)
+
+#define URING_ENTRIES 4096
+
+namespace fibjs {
+
+void setOption(intptr_t& sockfd);
+ssize_t sys_sendfile(intptr_t sockfd, int32_t fd, int64_t& pos, size_t sz);
+
+class uringEvent;
+
+class uringLoop : public exlib::OSThread {
+public:
+    uringLoop()
+        : m_ring_fd(-1)
+        , m_to_submit(0)
+    {
+        m_lock.lock();
+    }
+
+public:
+    bool init()
+    {
+        io_uring_params p;
+
+        memset(&p, 0, sizeof(p));
+        m_ring_fd = (int32_t)syscall(__NR_io_uring_setup, URING_ENTRIES, &p);
+        if (m_ring_fd < 0)
+            return false;
+
+        if (!(p.features & IORING_FEAT_FAST_POLL) || !(p.features & IORING_FEAT_RW_CUR_POS)) {
+            ::close(m_ring_fd);
+            return false;
+        }
+
+        size_t sq_sz = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+        size_t cq_sz = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+
+        if (p.features & IORING_FEAT_SINGLE_MMAP) {
+            if (cq_sz > sq_sz)
+                sq_sz = cq_sz;
+            cq_sz = sq_sz;
+        }
+
+        char* sq_ptr = (char*)mmap(0, sq_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            m_ring_fd, IORING_OFF_SQ_RING);
+        if (sq_ptr == MAP_FAILED) {
+            ::close(m_ring_fd);
+            return false;
+        }
+
+        char* cq_ptr = sq_ptr;
+        if (!(p.features & IORING_FEAT_SINGLE_MMAP)) {
+            cq_ptr = (char*)mmap(0, cq_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                m_ring_fd, IORING_OFF_CQ_RING);
+            if (cq_ptr == MAP_FAILED) {
+                ::close(m_ring_fd);
+                return false;
+            }
+        }
+
+        m_sqes = (io_uring_sqe*)mmap(0, p.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQES);
+        if (m_sqes == MAP_FAILED) {
+            ::close(m_ring_fd);
+            return false;
+        }
+
+        m_sq_head = (uint32_t*)(sq_ptr + p.sq_off.head);
+        m_sq_tail = (uint32_t*)(sq_ptr + p.sq_off.tail);
+        m_sq_mask = *(uint32_t*)(sq_ptr + p.sq_off.ring_mask);
+        m_sq_entries = *(uint32_t*)(sq_ptr + p.sq_off.ring_entries);
+        m_sq_array = (uint32_t*)(sq_ptr + p.sq_off.array);
+
+        m_cq_head = (uint32_t*)(cq_ptr + p.cq_off.head);
+        m_cq_tail = (uint32_t*)(cq_ptr + p.cq_off.tail);
+        m_cq_mask = *(uint32_t*)(cq_ptr + p.cq_off.ring_mask);
+        m_cqes = (io_uring_cqe*)(cq_ptr + p.cq_off.cqes);
+
+        m_event_fd = eventfd(0, EFD_CLOEXEC);
+        if (m_event_fd < 0) {
+            ::close(m_ring_fd);
+            return false;
+        }
+
+        return true;
+    }
+
+    virtual void Run()
+    {
+        Runtime rtForThread(NULL);
+
+        arm_wakeup();
+        m_lock.unlock();
+
+        while (true) {
+            int32_t n = dispatch();
+
+            if (n == 0) {
+                m_idle.xchg(1);
+                n = dispatch();
+                if (n)
+                    m_idle.xchg(0);
+            }
+
+            enter(m_to_submit, n ? 0 : 1, IORING_ENTER_GETEVENTS);
+            m_to_submit = 0;
+            m_idle.xchg(0);
+
+            reap();
+        }
+    }
+
+public:
+    void post(uringEvent* p);
+
+    io_uring_sqe* get_sqe()
+    {
+        uint32_t tail = *m_sq_tail;
+
+        while (tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE) >= m_sq_entries) {
+            enter(m_to_submit, 0, 0);
+            m_to_submit = 0;
+        }
+
+        uint32_t idx = tail & m_sq_mask;
+        io_uring_sqe* sqe = &m_sqes[idx];
+
+        memset(sqe, 0, sizeof(io_uring_sqe));
+        m_sq_array[idx] = idx;
+        __atomic_store_n(m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+        m_to_submit++;
+
+        return sqe;
+    }
+
+private:
+    void enter(uint32_t to_submit, uint32_t min_complete, uint32_t flags)
+    {
+        while (syscall(__NR_io_uring_enter, m_ring_fd, to_submit, min_complete, flags, NULL, 0) < 0
+            && errno == EINTR)
+            ;
+    }
+
+    void arm_wakeup()
+    {
+        io_uring_sqe* sqe = get_sqe();
+
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = m_event_fd;
+        sqe->addr = (uintptr_t)&m_event_val;
+        sqe->len = sizeof(m_event_val);
+        sqe->user_data = (uintptr_t)this;
+    }
+
+    int32_t dispatch();
+
+    void reap();
+
+public:
+    exlib::spinlock m_lock;
+
+private:
+    int32_t m_ring_fd;
+    int32_t m_event_fd;
+    uint64_t m_event_val;
+
+    uint32_t* m_sq_head;
+    uint32_t* m_sq_tail;
+    uint32_t* m_sq_array;
+    uint32_t m_sq_mask;
+    uint32_t m_sq_entries;
+    io_uring_sqe* m_sqes;
+
+    uint32_t* m_cq_head;
+    uint32_t* m_cq_tail;
+    uint32_t m_cq_mask;
+    io_uring_cqe* m_cqes;
+
+    uint32_t m_to_submit;
+
+    exlib::atomic m_idle;
+    exlib::LockedList<uringEvent> m_evWait;
+};
+
+static uringLoop* s_ring;
+
+class uringEvent : public exlib::Task_base {
+public:
+    virtual ~uringEvent()
+    {
+    }
+
+    void post()
+    {
+        s_ring->post(this);
+    }
+
+    virtual void start()
+    {
+    }
+
+    virtual void on_complete(int32_t res)
+    {
+    }
+
+public:
+    virtual void resume()
+    {
+        post();
+    }
+};
+
+void uringLoop::post(uringEvent* p)
+{
+    m_evWait.putTail(p);
+
+    if (m_idle.CompareAndSwap(1, 0) == 1) {
+        uint64_t v = 1;
+        ::write(m_event_fd, &v, sizeof(v));
+    }
+}
+
+int32_t uringLoop::dispatch()
+{
+    exlib::List<uringEvent> jobs;
+    uringEvent* p1;
+    int32_t n = 0;
+
+    m_evWait.getList(jobs);
+
+    while ((p1 = jobs.getHead()) != 0) {
+        p1->start();
+        n++;
+    }
+
+    return n;
+}
+
+void uringLoop::reap()
+{
+    uint32_t head = *m_cq_head;
+
+    while (head != __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE)) {
+        io_uring_cqe* cqe = &m_cqes[head & m_cq_mask];
+        uintptr_t user_data = (uintptr_t)cqe->user_data;
+        int32_t res = cqe->res;
+
+        __atomic_store_n(m_cq_head, ++head, __ATOMIC_RELEASE);
+
+        if (user_data == (uintptr_t)this)
+            arm_wakeup();
+        else if (user_data)
+            ((uringEvent*)user_data)->on_complete(res);
+    }
+}
+
+class uringSockProc : public uringEvent {
+public:
+    uringSockProc(intptr_t& sockfd, int32_t poll_mask, AsyncEvent* ac, exlib::Locker& locker, void*& opt)
+        : m_sockfd(sockfd)
+        , m_poll_mask(poll_mask)
+        , m_polling(false)
+        , m_ac(ac)
+        , m_locker(locker)
+        , m_opt(opt)
+        , m_stats(NULL)
+        , m_posted(0)
+        , m_ready(0)
+    {
+    }
+
+public:
+    result_t request(SockStats& stats)
+    {
+        m_stats = &stats;
+
+        if (m_locker.lock(this)) {
+            result_t hr = process();
+            if (hr != CALL_E_PENDDING) {
+                m_locker.unlock(this);
+                delete this;
+
+                return hr;
+            }
+
+            post();
+        }
+
+        return CALL_E_PENDDING;
+    }
+
+    void post()
+    {
+        m_posted = SockStats::now();
+        uringEvent::post();
+    }
+
+    virtual result_t process()
+    {
+        return CALL_E_PENDDING;
+    }
+
+    virtual void start()
+    {
+        if (m_posted)
+            m_stats->queue(m_posted);
+
+        m_opt = this;
+        submit();
+    }
+
+    void submit()
+    {
+        if (m_sockfd == INVALID_SOCKET) {
+            ready(CALL_E_BAD_FILE);
+            return;
+        }
+
+        io_uring_sqe* sqe = s_ring->get_sqe();
+
+        if (m_polling) {
+            sqe->opcode = IORING_OP_POLL_ADD;
+            sqe->fd = (int32_t)m_sockfd;
+            sqe->poll_events = m_poll_mask;
+        } else
+            prepare(sqe);
+
+        sqe->user_data = (uintptr_t)this;
+    }
+
+    void cancel()
+    {
+        io_uring_sqe* sqe = s_ring->get_sqe();
+
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->addr = (uintptr_t)this;
+    }
+
+    virtual void prepare(io_uring_sqe* sqe) = 0;
+    virtual result_t complete(int32_t res) = 0;
+
+    virtual result_t after_poll()
+    {
+        return CALL_E_PENDDING;
+    }
+
+    virtual void on_complete(int32_t res)
+    {
+        result_t hr;
+
+        m_ready = SockStats::now();
+
+        if (res == -ECANCELED)
+            hr = CALL_E_BAD_FILE;
+        else if (m_polling) {
+            m_polling = false;
+            hr = res < 0 ? res : after_poll();
+            if (hr == CALL_E_PENDDING)
+                m_stats->again();
+        } else if (res == -EAGAIN || res == -EINPROGRESS) {
+            m_stats->again();
+            m_polling = true;
+            hr = CALL_E_PENDDING;
+        } else
+            hr = complete(res);
+
+        if (hr == CALL_E_PENDDING)
+            submit();
+        else
+            ready(hr);
+    }
+
+    void ready(int32_t v)
+    {
+        if (m_ready)
+            m_stats->resume(m_ready);
+
+        m_opt = NULL;
+        m_locker.unlock(this);
+        m_ac->apost(v);
+        delete this;
+    }
+
+public:
+    intptr_t& m_sockfd;
+    int32_t m_poll_mask;
+    bool m_polling;
+    AsyncEvent* m_ac;
+    exlib::Locker& m_locker;
+    void*& m_opt;
+    SockStats* m_stats;
+    uint64_t m_posted;
+    uint64_t m_ready;
+};
+
+bool init_uring()
+{
+    s_ring = new uringLoop();
+    if (!s_ring->init()) {
+        delete s_ring;
+        s_ring = NULL;
+        return false;
+    }
+
+    s_ring->start();
+    s_ring->m_lock.lock();
+
+    return true;
+}
+
+result_t uring_close(intptr_t& sockfd, void*& recvProc, void*& sendProc, AsyncEvent* ac)
+{
+    class asyncClose : public uringEvent {
+    public:
+        asyncClose(intptr_t& sockfd, void*& recvProc, void*& sendProc, AsyncEvent* ac)
+            : m_ac(ac)
+            , m_sockfd(sockfd)
+            , m_pRecvProc(recvProc)
+            , m_pSendProc(sendProc)
+        {
+        }
+
+        virtual void start()
+        {
+            if (m_sockfd != INVALID_SOCKET) {
+                intptr_t fd = m_sockfd;
+                m_sockfd = INVALID_SOCKET;
+
+                if (m_pRecvProc)
+                    ((uringSockProc*)m_pRecvProc)->cancel();
+
+                if (m_pSendProc)
+                    ((uringSockProc*)m_pSendProc)->cancel();
+
+                ::closesocket(fd);
+            }
+
+            m_ac->apost(0);
+            delete this;
+        }
+
+    public:
+        AsyncEvent* m_ac;
+        intptr_t& m_sockfd;
+        void*& m_pRecvProc;
+        void*& m_pSendProc;
+    };
+
+    (new asyncClose(sockfd, recvProc, sendProc, ac))->post();
+    return CALL_E_PENDDING;
+}
+
+result_t uring_connect(intptr_t& sockfd, inetAddr& ai, AsyncEvent* ac, exlib::Locker& locker,
+    void*& opt, Timer_base* timer, SockStats& stats)
+{
+    class asyncConnect : public uringSockProc {
+    public:
+        asyncConnect(intptr_t& sockfd, inetAddr& ai, AsyncEvent* ac, exlib::Locker& locker, void*& opt, Timer_base* timer)
+            : uringSockProc(sockfd, POLLOUT, ac, locker, opt)
+            , m_ai(ai)
+            , m_timer(timer)
+        {
+        }
+
+        virtual void prepare(io_uring_sqe* sqe)
+        {
+            sqe->opcode = IORING_OP_CONNECT;
+            sqe->fd = (int32_t)m_sockfd;
+            sqe->addr = (uintptr_t)&m_ai;
+            sqe->off = m_ai.size();
+        }
+
+        virtual result_t complete(int32_t res)
+        {
+            if (m_timer) {
+                m_timer->clear();
+                m_timer.Release();
+            }
+
+            if (res < 0)
+                return CHECK_ERROR(res);
+
+            setOption(m_sockfd);
+            return 0;
+        }
+
+        virtual result_t after_poll()
+        {
+            inetAddr addr_info;
+            socklen_t sz1 = sizeof(addr_info);
+
+            if (::getpeername(m_sockfd, (sockaddr*)&addr_info, &sz1) == SOCKET_ERROR)
+                return complete(-ECONNREFUSED);
+
+            return complete(0);
+        }
+
+    public:
+        inetAddr m_ai;
+        obj_ptr<Timer_base> m_timer;
+    };
+
+    return (new asyncConnect(sockfd, ai, ac, locker, opt, timer))->request(stats);
+}
+
+result_t uring_accept(intptr_t& sockfd, obj_ptr<Socket_base>& retVal, AsyncEvent* ac,
+    exlib::Locker& locker, void*& opt, SockStats& stats)
+{
+    class asyncAccept : public uringSockProc {
+    public:
+        asyncAccept(intptr_t& sockfd, obj_ptr<Socket_base>& retVal, AsyncEvent* ac, exlib::Locker& locker, void*& opt)
+            : uringSockProc(sockfd, POLLIN, ac, locker, opt)
+            , m_retVal(retVal)
+        {
+        }
+
+        virtual void prepare(io_uring_sqe* sqe)
+        {
+            m_sz = sizeof(m_ai);
+
+            sqe->opcode = IORING_OP_ACCEPT;
+            sqe->fd = (int32_t)m_sockfd;
+            sqe->addr = (uintptr_t)&m_ai;
+            sqe->addr2 = (uintptr_t)&m_sz;
+            sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+        }
+
+        virtual result_t complete(int32_t res)
+        {
+            if (res < 0)
+                return CHECK_ERROR(res);
+
+            intptr_t c = res;
+            setOption(c);
+
+            m_retVal = new Socket(c, m_ai.family());
+            g_accept_stats.record(1);
+
+            return 0;
+        }
+
+    public:
+        obj_ptr<Socket_base>& m_retVal;
+        inetAddr m_ai;
+        socklen_t m_sz;
+    };
+
+    return (new asyncAccept(sockfd, retVal, ac, locker, opt))->request(stats);
+}
+
+result_t uring_accept(intptr_t& sockfd, std::vector<obj_ptr<Socket_base>>& retVal, int32_t budget,
+    AsyncEvent* ac, exlib::Locker& locker, void*& opt, SockStats& stats)
+{
+    class asyncAcceptBatch : public uringSockProc {
+    public:
+        asyncAcceptBatch(intptr_t& sockfd, std::vector<obj_ptr<Socket_base>>& retVal, int32_t budget,
+            AsyncEvent* ac, exlib::Locker& locker, void*& opt)
+            : uringSockProc(sockfd, POLLIN, ac, locker, opt)
+            , m_retVal(retVal)
+            , m_budget(budget)
+        {
+        }
+
+        virtual result_t process()
+        {
+            return accept_drain(m_sockfd, m_retVal, m_budget);
+        }
+
+        virtual void prepare(io_uring_sqe* sqe)
+        {
+            m_sz = sizeof(m_ai);
+
+            sqe->opcode = IORING_OP_ACCEPT;
+            sqe->fd = (int32_t)m_sockfd;
+            sqe->addr = (uintptr_t)&m_ai;
+            sqe->addr2 = (uintptr_t)&m_sz;
+            sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+        }
+
+        virtual result_t complete(int32_t res)
+        {
+            if (res < 0)
+                return CHECK_ERROR(res);
+
+            intptr_t c = res;
+            setOption(c);
+
+            m_retVal.push_back(new Socket(c, m_ai.family()));
+            accept_drain(m_sockfd, m_retVal, m_budget);
+
+            return 0;
+        }
+
+    public:
+        std::vector<obj_ptr<Socket_base>>& m_retVal;
+        int32_t m_budget;
+        inetAddr m_ai;
+        socklen_t m_sz;
+    };
+
+    return (new asyncAcceptBatch(sockfd, retVal, budget, ac, locker, opt))->request(stats);
+}
+
+result_t uring_read(intptr_t& sockfd, int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac,
+    int32_t family, bool bRead, exlib::Locker& locker, void*& opt, Timer_base* timer, int32_t& recvSize, SockStats& stats)
+{
+    class asyncRecv : public uringSockProc {
+    public:
+        asyncRecv(intptr_t& sockfd, int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac,
+            int32_t family, bool bRead, exlib::Locker& locker, void*& opt, Timer_base* timer,
+            int32_t& recvSize)
+            : uringSockProc(sockfd, POLLIN, ac, locker, opt)
+            , m_retVal(retVal)
+            , m_pos(0)
+            , m_family(family)
+            , m_bRead(bRead)
+            , m_timer(timer)
+        {
+            m_buf.alloc(bytes, recvSize);
+        }
+
+        virtual void prepare(io_uring_sqe* sqe)
+        {
+            sqe->opcode = m_family ? IORING_OP_RECV : IORING_OP_READ;
+            sqe->fd = (int32_t)m_sockfd;
+            sqe->addr = (uintptr_t)(m_buf.c_buffer() + m_pos);
+            sqe->len = (uint32_t)(m_buf.length() - m_pos);
+            if (m_family)
+                sqe->msg_flags = MSG_NOSIGNAL;
+            else
+                sqe->off = (uint64_t)-1;
+        }
+
+        virtual result_t complete(int32_t res)
+        {
+            if (res == -ECONNRESET)
+                res = 0;
+
+            if (res < 0) {
+                if (m_timer) {
+                    m_timer->clear();
+                    m_timer.Release();
+                }
+                return CHECK_ERROR(res);
+            }
+
+            m_stats->read(res);
+            if (res == 0)
+                m_bRead = false;
+
+            m_pos += res;
+            if (m_bRead && m_pos < m_buf.length())
+                return CALL_E_PENDDING;
+
+            if (m_timer) {
+                m_timer->clear();
+                m_timer.Release();
+            }
+
+            if (m_pos == 0)
+                return CALL_RETURN_NULL;
+
+            if (g_tcpdump)
+                outLog(console_base::C_NOTICE, clean_string(exlib::string(m_buf.c_buffer(), m_pos)));
+            m_retVal = m_buf.detach(m_pos);
+
+            return 0;
+        }
+
+    public:
+        obj_ptr<Buffer_base>& m_retVal;
+        int32_t m_pos;
+        int32_t m_family;
+        bool m_bRead;
+        RecvBuffer m_buf;
+        obj_ptr<Timer_base> m_timer;
+    };
+
+    return (new asyncRecv(sockfd, bytes, retVal, ac, family, bRead, locker, opt, timer, recvSize))->request(stats);
+}
+
+result_t uring_write(intptr_t& sockfd, Buffer_base* data, AsyncEvent* ac, int32_t family,
+    exlib::Locker& locker, void*& opt, SockStats& stats)
+{
+    class asyncSend : public uringSockProc {
+    public:
+        asyncSend(intptr_t& sockfd, Buffer_base* data, AsyncEvent* ac, int32_t family, exlib::Locker& locker, void*& opt)
+            : uringSockProc(sockfd, POLLOUT, ac, locker, opt)
+            , m_family(family)
+        {
+            int32_t len;
+
+            data->get_length(len);
+            m_buf = data;
+            m_p = ((Buffer*)data)->data();
+            m_sz = len;
+
+            if (g_tcpdump)
+                outLog(console_base::C_WARN, clean_string(exlib::string(m_p, m_sz)));
+        }
+
+        virtual result_t process()
+        {
+            while (m_sz) {
+                int32_t n;
+
+                if (m_family)
+                    n = (int32_t)::send(m_sockfd, m_p, m_sz, MSG_NOSIGNAL);
+                else
+                    n = (int32_t)::write(m_sockfd, m_p, m_sz);
+                if (n == SOCKET_ERROR) {
+                    int32_t nError = errno;
+                    if (nError == EWOULDBLOCK) {
+                        m_stats->again();
+                        return CALL_E_PENDDING;
+                    }
+                    return CHECK_ERROR(-nError);
+                }
+
+                m_stats->write(n);
+                m_sz -= n;
+                m_p += n;
+            }
+
+            return 0;
+        }
+
+        virtual void prepare(io_uring_sqe* sqe)
+        {
+            sqe->opcode = m_family ? IORING_OP_SEND : IORING_OP_WRITE;
+            sqe->fd = (int32_t)m_sockfd;
+            sqe->addr = (uintptr_t)m_p;
+            sqe->len = (uint32_t)m_sz;
+            if (m_family)
+                sqe->msg_flags = MSG_NOSIGNAL;
+            else
+                sqe->off = (uint64_t)-1;
+        }
+
+        virtual result_t complete(int32_t res)
+        {
+            if (res < 0)
+                return CHECK_ERROR(res);
+
+            m_stats->write(res);
+            m_sz -= res;
+            m_p += res;
+
+            return m_sz ? CALL_E_PENDDING : 0;
+        }
+
+    public:
+        obj_ptr<Buffer_base> m_buf;
+        const char* m_p;
+        int32_t m_sz;
+        int32_t m_family;
+    };
+
+    return (new asyncSend(sockfd, data, ac, family, locker, opt))->request(stats);
+}
+
+result_t uring_writev(intptr_t& sockfd, std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac,
+    int32_t family, exlib::Locker& locker, void*& opt, SockStats& stats)
+{
+    class asyncSendv : public uringSockProc {
+    public:
+        asyncSendv(intptr_t& sockfd, std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac, int32_t family, exlib::Locker& locker, void*& opt)
+            : uringSockProc(sockfd, POLLOUT, ac, locker, opt)
+            , m_datas(datas)
+            , m_pos(0)
+            , m_family(family)
+        {
+            size_t i;
+
+            for (i = 0; i < m_datas.size(); i++) {
+                Buffer* buf = (Buffer*)(Buffer_base*)m_datas[i];
+                int32_t len;
+
+                buf->get_length(len);
+                if (len > 0) {
+                    struct iovec iov;
+
+                    iov.iov_base = buf->data();
+                    iov.iov_len = len;
+                    m_iov.push_back(iov);
+
+                    if (g_tcpdump)
+                        outLog(console_base::C_WARN, clean_string(exlib::string(buf->data(), len)));
+                }
+            }
+
+            memset(&m_msg, 0, sizeof(m_msg));
+        }
+
+        int32_t count()
+        {
+            int32_t cnt = (int32_t)(m_iov.size() - m_pos);
+            return cnt > IOV_MAX ? IOV_MAX : cnt;
+        }
+
+        void advance(size_t n)
+        {
+            while (n > 0) {
+                struct iovec& iov = m_iov[m_pos];
+
+                if (n >= iov.iov_len) {
+                    n -= iov.iov_len;
+                    m_pos++;
+                } else {
+                    iov.iov_base = (char*)iov.iov_base + n;
+                    iov.iov_len -= n;
+                    n = 0;
+                }
+            }
+        }
+
+        virtual result_t process()
+        {
+            while (m_pos < m_iov.size()) {
+                ssize_t n;
+
+                m_msg.msg_iov = &m_iov[m_pos];
+                m_msg.msg_iovlen = count();
+
+                if (m_family)
+                    n = ::sendmsg(m_sockfd, &m_msg, MSG_NOSIGNAL);
+                else
+                    n = ::writev(m_sockfd, m_msg.msg_iov, m_msg.msg_iovlen);
+                if (n == SOCKET_ERROR) {
+                    int32_t nError = errno;
+                    if (nError == EWOULDBLOCK) {
+                        m_stats->again();
+                        return CALL_E_PENDDING;
+                    }
+                    return CHECK_ERROR(-nError);
+                }
+
+                m_stats->write(n);
+                advance(n);
+            }
+
+            return 0;
+        }
+
+        virtual void prepare(io_uring_sqe* sqe)
+        {
+            m_msg.msg_iov = &m_iov[m_pos];
+            m_msg.msg_iovlen = count();
+
+            sqe->fd = (int32_t)m_sockfd;
+            if (m_family) {
+                sqe->opcode = IORING_OP_SENDMSG;
+                sqe->addr = (uintptr_t)&m_msg;
+                sqe->len = 1;
+                sqe->msg_flags = MSG_NOSIGNAL;
+            } else {
+                sqe->opcode = IORING_OP_WRITEV;
+                sqe->addr = (uintptr_t)m_msg.msg_iov;
+                sqe->len = (uint32_t)m_msg.msg_iovlen;
+                sqe->off = (uint64_t)-1;
+            }
+        }
+
+        virtual result_t complete(int32_t res)
+        {
+            if (res < 0)
+                return CHECK_ERROR(res);
+
+            m_stats->write(res);
+            advance(res);
+
+            return m_pos < m_iov.size() ? CALL_E_PENDDING : 0;
+        }
+
+    public:
+        std::vector<obj_ptr<Buffer_base>> m_datas;
+        std::vector<struct iovec> m_iov;
+        struct msghdr m_msg;
+        size_t m_pos;
+        int32_t m_family;
+    };
+
+    return (new asyncSendv(sockfd, datas, ac, family, locker, opt))->request(stats);
+}
+
+result_t uring_sendfile(intptr_t& sockfd, int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal,
+    AsyncEvent* ac, exlib::Locker& locker, void*& opt, SockStats& stats)
+{
+    class asyncSendFile : public uringSockProc {
+    public:
+        asyncSendFile(intptr_t& sockfd, int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal,
+            AsyncEvent* ac, exlib::Locker& locker, void*& opt)
+            : uringSockProc(sockfd, POLLOUT, ac, locker, opt)
+            , m_fd(fd)
+            , m_pos(pos)
+            , m_bytes(bytes)
+            , m_retVal(retVal)
+        {
+        }
+
+        virtual result_t process()
+        {
+            while (m_bytes > 0) {
+                size_t sz = m_bytes > SENDFILE_CHUNK_SIZE ? SENDFILE_CHUNK_SIZE : (size_t)m_bytes;
+                ssize_t n = sys_sendfile(m_sockfd, m_fd, m_pos, sz);
+
+                if (n == SOCKET_ERROR) {
+                    int32_t nError = errno;
+                    return CHECK_ERROR((nError == EWOULDBLOCK) ? CALL_E_PENDDING : -nError);
+                }
+
+                if (n == 0)
+                    break;
+
+                m_stats->write(n);
+                m_bytes -= n;
+                m_retVal += n;
+            }
+
+            return 0;
+        }
+
+        virtual void prepare(io_uring_sqe* sqe)
+        {
+            m_polling = true;
+
+            sqe->opcode = IORING_OP_POLL_ADD;
+            sqe->fd = (int32_t)m_sockfd;
+            sqe->poll_events = m_poll_mask;
+        }
+
+        virtual result_t after_poll()
+        {
+            return process();
+        }
+
+        virtual result_t complete(int32_t res)
+        {
+            return res;
+        }
+
+    public:
+        int32_t m_fd;
+        int64_t m_pos;
+        int64_t m_bytes;
+        int64_t& m_retVal;
+    };
+
+    return (new asyncSendFile(sockfd, fd, pos, bytes, retVal, ac, locker, opt))->request(stats);
+}
+
+class uringFileProc : public uringEvent {
+public:
+    uringFileProc(int32_t fd, AsyncEvent* ac)
+        : m_fd(fd)
+        , m_ac(ac)
+    {
+    }
+
+public:
+    result_t request()
+    {
+        post();
+        return CALL_E_PENDDING;
+    }
+
+    virtual void start()
+    {
+        submit();
+    }
+
+    void submit()
+    {
+        io_uring_sqe* sqe = s_ring->get_sqe();
+
+        prepare(sqe);
+        sqe->user_data = (uintptr_t)this;
+    }
+
+    virtual void prepare(io_uring_sqe* sqe) = 0;
+    virtual result_t complete(int32_t res) = 0;
+
+    virtual void on_complete(int32_t res)
+    {
+        result_t hr = complete(res);
+
+        if (hr == CALL_E_PENDDING)
+            submit();
+        else {
+            m_ac->apost(hr);
+            delete this;
+        }
+    }
+
+public:
+    int32_t m_fd;
+    AsyncEvent* m_ac;
+};
+
+result_t uring_file_read(int32_t fd, int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    class asyncRead : public uringFileProc {
+    public:
+        asyncRead(int32_t fd, int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+            : uringFileProc(fd, ac)
+            , m_retVal(retVal)
+            , m_pos(0)
+        {
+            m_buf.resize(bytes);
+        }
+
+        virtual void prepare(io_uring_sqe* sqe)
+        {
+            int32_t sz = (int32_t)m_buf.length() - m_pos;
+
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = m_fd;
+            sqe->addr = (uintptr_t)(m_buf.c_buffer() + m_pos);
+            sqe->len = sz > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : sz;
+            sqe->off = (uint64_t)-1;
+        }
+
+        virtual result_t complete(int32_t res)
+        {
+            if (res < 0)
+                return CHECK_ERROR(res);
+
+            m_pos += res;
+            if (res > 0 && m_pos < (int32_t)m_buf.length())
+                return CALL_E_PENDDING;
+
+            if (m_pos == 0)
+                return CALL_RETURN_NULL;
+
+            m_buf.resize(m_pos);
+            m_retVal = new Buffer(m_buf);
+
+            return 0;
+        }
+
+    public:
+        obj_ptr<Buffer_base>& m_retVal;
+        int32_t m_pos;
+        exlib::string m_buf;
+    };
+
+    return (new asyncRead(fd, bytes, retVal, ac))->request();
+}
+
+result_t uring_file_write(int32_t fd, Buffer_base* data, AsyncEvent* ac)
+{
+    class asyncWrite : public uringFileProc {
+    public:
+        asyncWrite(int32_t fd, Buffer_base* data, AsyncEvent* ac)
+            : uringFileProc(fd, ac)
+        {
+            m_buf = data;
+            m_p = ((Buffer*)data)->data();
+            data->get_length(m_sz);
+        }
+
+        virtual void prepare(io_uring_sqe* sqe)
+        {
+            sqe->opcode = IORING_OP_WRITE;
+            sqe->fd = m_fd;
+            sqe->addr = (uintptr_t)m_p;
+            sqe->len = m_sz > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : m_sz;
+            sqe->off = (uint64_t)-1;
+        }
+
+        virtual result_t complete(int32_t res)
+        {
+            if (res < 0)
+                return CHECK_ERROR(res);
+
+            m_sz -= res;
+            m_p += res;
+
+            return m_sz ? CALL_E_PENDDING : 0;
+        }
+
+    public:
+        obj_ptr<Buffer_base> m_buf;
+        const char* m_p;
+        int32_t m_sz;
+    };
+
+    if (data == NULL)
+        return 0;
+
+    return (new asyncWrite(fd, data, ac))->request();
+}
+}
+
+#endif
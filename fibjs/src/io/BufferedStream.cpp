@@ -8,6 +8,7 @@
 #include "object.h"
 #include "ifs/io.h"
 #include "BufferedStream.h"
+#include "Stream.h"
 #include "Buffer.h"
 
 namespace fibjs {
@@ -47,7 +48,7 @@ public:
         m_pThis->m_pos = 0;
 
         if (n != CALL_RETURN_NULL) {
-            m_buf->toString(m_pThis->m_buf);
+            m_pThis->m_buf.set(m_buf);
             m_buf.Release();
         } else
             m_streamEnd = true;
@@ -126,11 +127,9 @@ result_t BufferedStream::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
         int32_t n = (int32_t)m_buf.length() - m_pos;
         if (n > 0) {
             if (m_pos == 0)
-                retVal = new Buffer(m_buf);
-            else {
-                exlib::string s1(m_buf.substr(m_pos, n));
-                retVal = new Buffer(s1);
-            }
+                retVal = m_buf.buffer();
+            else
+                retVal = new Buffer(m_buf.c_str() + m_pos, n);
             m_pos += n;
 
             return 0;
@@ -153,6 +152,11 @@ result_t BufferedStream::write(Buffer_base* data, AsyncEvent* ac)
     return m_stm->write(data, ac);
 }
 
+result_t BufferedStream::writev(v8::Local<v8::Array> datas, AsyncEvent* ac)
+{
+    return stream_writev(this, datas, ac);
+}
+
 result_t BufferedStream::flush(AsyncEvent* ac)
 {
     return 0;
@@ -360,6 +364,87 @@ result_t BufferedStream::readUntil(exlib::string mk, int32_t maxlen,
     return (new asyncRead(this, mk, maxlen, retVal, ac))->post(0);
 }
 
+result_t BufferedStream::readHead(int32_t maxlen, exlib::string& retVal, AsyncEvent* ac)
+{
+    class asyncRead : public asyncBuffer {
+    public:
+        asyncRead(BufferedStream* pThis, int32_t maxlen, exlib::string& retVal, AsyncEvent* ac)
+            : asyncBuffer(pThis, ac)
+            , m_maxlen(maxlen)
+            , m_retVal(retVal)
+        {
+        }
+
+        static result_t process(BufferedStream* pThis, int32_t maxlen, exlib::string& retVal, bool streamEnd)
+        {
+            static const char s_mk[] = "\r\n\r\n";
+            const char* buf = pThis->m_buf.c_str();
+            int32_t len = (int32_t)pThis->m_buf.length();
+            int32_t pos = pThis->m_pos;
+
+            // m_temp counts the terminator bytes already matched, possibly in the previous chunk
+            while (pos < len && pThis->m_temp < 4) {
+                if (pThis->m_temp == 0) {
+                    const char* p = (const char*)memchr(buf + pos, '\r', len - pos);
+                    if (!p) {
+                        pos = len;
+                        break;
+                    }
+
+                    pos = (int32_t)(p - buf) + 1;
+                    pThis->m_temp = 1;
+                } else if (buf[pos] == s_mk[pThis->m_temp]) {
+                    pos++;
+                    pThis->m_temp++;
+                } else
+                    pThis->m_temp = 0;
+            }
+
+            if (maxlen > 0
+                && ((int32_t)pThis->m_strbuf.size() + (pos - pThis->m_pos) > maxlen + 4))
+                return CHECK_ERROR(CALL_E_INVALID_DATA);
+
+            if (pThis->m_temp == 4 && pThis->m_strbuf.size() == 0) {
+                retVal.assign(buf + pThis->m_pos, pos - pThis->m_pos - 4);
+                pThis->m_pos = pos;
+                pThis->m_temp = 0;
+                return 0;
+            }
+
+            pThis->append(pos - pThis->m_pos);
+
+            if (streamEnd || pThis->m_temp == 4) {
+                retVal = pThis->m_strbuf.str();
+                retVal.resize(retVal.length() - pThis->m_temp);
+
+                bool bEnd = pThis->m_temp < 4;
+                pThis->m_temp = 0;
+                return bEnd && retVal.length() == 0 ? CALL_RETURN_NULL : 0;
+            }
+
+            return CHECK_ERROR(CALL_E_PENDDING);
+        }
+
+        virtual result_t process(bool streamEnd)
+        {
+            return process(m_pThis, m_maxlen, m_retVal, streamEnd);
+        }
+
+    public:
+        int32_t m_maxlen;
+        exlib::string& m_retVal;
+    };
+
+    result_t hr = asyncRead::process(this, maxlen, retVal, false);
+    if (hr != CALL_E_PENDDING)
+        return hr;
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncRead(this, maxlen, retVal, ac))->post(0);
+}
+
 result_t BufferedStream::writeText(exlib::string txt, AsyncEvent* ac)
 {
     if (ac->isSync())
@@ -75,6 +75,12 @@ result_t MemoryStream::CloneStream::write(Buffer_base* data,
     return CHECK_ERROR(CALL_E_INVALID_CALL);
 }
 
+result_t MemoryStream::CloneStream::writev(v8::Local<v8::Array> datas,
+    AsyncEvent* ac)
+{
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
+}
+
 result_t MemoryStream::CloneStream::close(AsyncEvent* ac)
 {
     return 0;
@@ -8,6 +8,7 @@
 #include "object.h"
 #include "ifs/io.h"
 #include "MemoryStream.h"
+#include "Stream.h"
 #include "Stat.h"
 #include "Buffer.h"
 
@@ -108,6 +109,11 @@ result_t MemoryStream::write(Buffer_base* data, AsyncEvent* ac)
     return 0;
 }
 
+result_t MemoryStream::writev(v8::Local<v8::Array> datas, AsyncEvent* ac)
+{
+    return stream_writev(this, datas, ac);
+}
+
 result_t MemoryStream::close(AsyncEvent* ac)
 {
     return 0;
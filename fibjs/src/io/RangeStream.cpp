@@ -8,6 +8,7 @@
 
 #include "object.h"
 #include "RangeStream.h"
+#include "File.h"
 
 namespace fibjs {
 
@@ -185,6 +186,11 @@ result_t RangeStream::write(Buffer_base* data, AsyncEvent* ac)
     return CALL_E_INVALID_CALL;
 }
 
+result_t RangeStream::writev(v8::Local<v8::Array> datas, AsyncEvent* ac)
+{
+    return CALL_E_INVALID_CALL;
+}
+
 result_t RangeStream::flush(AsyncEvent* ac)
 {
     return 0;
@@ -202,7 +208,55 @@ result_t RangeStream::copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, A
     if (!m_stream)
         return CALL_E_CLOSED;
 
-    return io_base::copyStream(this, stm, bytes, retVal, ac);
+    class asyncCopyRange : public AsyncState {
+    public:
+        asyncCopyRange(RangeStream* pThis, File* file, Stream_base* stm, int64_t bytes,
+            int64_t& retVal, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_pThis(pThis)
+            , m_file(file)
+            , m_stm(stm)
+            , m_bytes(bytes)
+            , m_retVal(retVal)
+        {
+            next(copy);
+        }
+
+    public:
+        ON_STATE(asyncCopyRange, copy)
+        {
+            return m_file->copyRange(m_stm, m_pThis->real_pos, m_bytes, m_retVal, next(ready));
+        }
+
+        ON_STATE(asyncCopyRange, ready)
+        {
+            m_pThis->real_pos += m_retVal;
+            return next();
+        }
+
+    private:
+        obj_ptr<RangeStream> m_pThis;
+        obj_ptr<File> m_file;
+        obj_ptr<Stream_base> m_stm;
+        int64_t m_bytes;
+        int64_t& m_retVal;
+    };
+
+    if (ac->isSync())
+        return CALL_E_NOSYNC;
+
+    File* file = dynamic_cast<File*>((SeekableStream_base*)m_stream);
+    if (!file || !file->zero_copy(stm))
+        return io_base::copyStream(this, stm, bytes, retVal, ac);
+
+    int64_t rest_sz = valid_end() - real_pos;
+    if (rest_sz < 0 || real_pos < b_pos)
+        rest_sz = 0;
+
+    if (bytes < 0 || bytes > rest_sz)
+        bytes = rest_sz;
+
+    return (new asyncCopyRange(this, file, stm, bytes, retVal, ac))->post(0);
 }
 
 result_t RangeStream::seek(int64_t offset, int32_t whence)
@@ -0,0 +1,129 @@
+/*
+ * RecvBuffer.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "RecvBuffer.h"
+#include <exlib/include/thread.h>
+#include <vector>
+
+namespace fibjs {
+
+RecvBuffer::Stats RecvBuffer::s_stats;
+
+class RecvPool {
+public:
+    static int32_t size_class(int32_t sz)
+    {
+        int32_t i;
+
+        for (i = 0; i < RECV_POOL_CLASSES; i++)
+            if (sz <= (RECV_BUFF_MIN << i))
+                return i;
+
+        return RECV_POOL_CLASSES - 1;
+    }
+
+    char* get(int32_t idx)
+    {
+        char* p = NULL;
+
+        m_lock[idx].lock();
+        if (!m_free[idx].empty()) {
+            p = m_free[idx].back();
+            m_free[idx].pop_back();
+        }
+        m_lock[idx].unlock();
+
+        if (p) {
+            RecvBuffer::s_stats.recycled.fetch_add(1, std::memory_order_relaxed);
+            RecvBuffer::s_stats.pooled.fetch_sub(1, std::memory_order_relaxed);
+        } else {
+            RecvBuffer::s_stats.allocs.fetch_add(1, std::memory_order_relaxed);
+            p = (char*)::malloc(RECV_BUFF_MIN << idx);
+        }
+
+        return p;
+    }
+
+    void put(int32_t idx, char* p)
+    {
+        m_lock[idx].lock();
+        if (m_free[idx].size() < RECV_POOL_DEPTH) {
+            m_free[idx].push_back(p);
+            p = NULL;
+        }
+        m_lock[idx].unlock();
+
+        if (p)
+            ::free(p);
+        else
+            RecvBuffer::s_stats.pooled.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    exlib::spinlock m_lock[RECV_POOL_CLASSES];
+    std::vector<char*> m_free[RECV_POOL_CLASSES];
+};
+
+static RecvPool s_pool;
+
+void RecvBuffer::alloc(int32_t bytes, int32_t& recvSize)
+{
+    if (bytes > 0) {
+        m_str.resize(bytes);
+        return;
+    }
+
+    if (recvSize < RECV_BUFF_MIN)
+        recvSize = RECV_BUFF_MIN;
+    else if (recvSize > RECV_BUFF_MAX)
+        recvSize = RECV_BUFF_MAX;
+
+    int32_t idx = RecvPool::size_class(recvSize);
+
+    m_block = s_pool.get(idx);
+    m_size = RECV_BUFF_MIN << idx;
+    m_recvSize = &recvSize;
+}
+
+void RecvBuffer::free()
+{
+    if (m_block) {
+        s_pool.put(RecvPool::size_class(m_size), m_block);
+        m_block = NULL;
+        m_size = 0;
+    }
+}
+
+Buffer_base* RecvBuffer::detach(int32_t n)
+{
+    Buffer_base* buf;
+
+    s_stats.recvs.fetch_add(1, std::memory_order_relaxed);
+    s_stats.bytes.fetch_add(n, std::memory_order_relaxed);
+
+    if (m_block) {
+        int32_t& recvSize = *m_recvSize;
+
+        if (n >= m_size) {
+            if (recvSize < RECV_BUFF_MAX)
+                recvSize = m_size * 2;
+        } else if (n < m_size / 4) {
+            if (recvSize > RECV_BUFF_MIN)
+                recvSize = m_size / 2;
+        }
+
+        buf = new Buffer(m_block, n);
+        free();
+    } else {
+        m_str.resize(n);
+        buf = new Buffer(m_str);
+    }
+
+    return buf;
+}
+}
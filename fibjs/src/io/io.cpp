@@ -10,6 +10,10 @@
 #include "object.h"
 #include "ifs/io.h"
 #include "File.h"
+#include "Stream.h"
+#include "Socket.h"
+#include "UVSocket.h"
+#include "UVStream.h"
 
 namespace fibjs {
 
@@ -189,4 +193,118 @@ result_t io_base::bridge(Stream_base* stm1, Stream_base* stm2, AsyncEvent* ac)
     new AsyncData(stm1, stm2, ac);
     return CALL_E_PENDDING;
 }
+
+result_t get_writev_buffers(v8::Local<v8::Array> datas, std::vector<obj_ptr<Buffer_base>>& bufs,
+    AsyncEvent* ac)
+{
+    if (ac->isSync()) {
+        Isolate* isolate = Isolate::current();
+        v8::Local<v8::Context> context = isolate->context();
+        int32_t sz = datas->Length();
+        int32_t i;
+
+        ac->m_ctx.resize(sz);
+        for (i = 0; i < sz; i++) {
+            obj_ptr<Buffer_base> buf = Buffer_base::getInstance(JSValue(datas->Get(context, i)));
+            if (!buf)
+                return CHECK_ERROR(CALL_E_TYPEMISMATCH);
+
+            ac->m_ctx[i] = buf;
+        }
+
+        return CHECK_ERROR(CALL_E_NOSYNC);
+    }
+
+    size_t i;
+
+    bufs.resize(ac->m_ctx.size());
+    for (i = 0; i < bufs.size(); i++)
+        bufs[i] = Buffer_base::getInstance(ac->m_ctx[i].object());
+
+    return 0;
+}
+
+result_t stream_writev(Stream_base* stm, v8::Local<v8::Array> datas, AsyncEvent* ac)
+{
+    std::vector<obj_ptr<Buffer_base>> bufs;
+
+    result_t hr = get_writev_buffers(datas, bufs, ac);
+    if (hr < 0)
+        return hr;
+
+    return stream_writev(stm, bufs, ac);
+}
+
+result_t stream_writev(Stream_base* stm, std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac)
+{
+    class asyncWritev : public AsyncState {
+    public:
+        asyncWritev(Stream_base* stm, std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_stm(stm)
+        {
+            size_t i;
+            int32_t sz = 0;
+
+            for (i = 0; i < datas.size(); i++) {
+                int32_t len;
+
+                datas[i]->get_length(len);
+                sz += len;
+            }
+
+            exlib::string strBuf;
+            char* p;
+
+            strBuf.resize(sz);
+            p = strBuf.c_buffer();
+
+            for (i = 0; i < datas.size(); i++) {
+                Buffer* buf = (Buffer*)(Buffer_base*)datas[i];
+                int32_t len;
+
+                buf->get_length(len);
+                memcpy(p, buf->data(), len);
+                p += len;
+            }
+
+            m_buf = new Buffer(strBuf);
+            next(write);
+        }
+
+        ON_STATE(asyncWritev, write)
+        {
+            return m_stm->write(m_buf, next());
+        }
+
+    public:
+        obj_ptr<Stream_base> m_stm;
+        obj_ptr<Buffer_base> m_buf;
+    };
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    if (datas.size() == 0)
+        return 0;
+
+    // sockets and libuv streams gather the buffers in one system call, anything else,
+    // SslSocket included, gets them joined into a single write
+    Socket* sock = dynamic_cast<Socket*>(stm);
+    if (sock)
+        return sock->writev(datas, ac);
+
+    UVSocket* uvsock = dynamic_cast<UVSocket*>(stm);
+    if (uvsock)
+        return uvsock->writev(datas, ac);
+
+    UVStream* uvstm = dynamic_cast<UVStream*>(stm);
+    if (uvstm)
+        return uvstm->writev(datas, ac);
+
+    if (datas.size() == 1)
+        return stm->write(datas[0], ac);
+
+    return (new asyncWritev(stm, datas, ac))->post(0);
+}
 }
@@ -11,6 +11,7 @@
 #include "ifs/HttpRequest.h"
 #include "parse.h"
 #include "Url.h"
+#include <algorithm>
 
 namespace fibjs {
 
@@ -32,11 +33,168 @@ result_t Routing_base::_new(exlib::string method, v8::Local<v8::Object> map,
     return r->_append(method, map, retVal);
 }
 
+void Routing::node::insert(const char* key, size_t len, int32_t no)
+{
+    if (len == 0) {
+        m_rules.push_back(no);
+        return;
+    }
+
+    size_t i, sz = m_children.size();
+
+    for (i = 0; i < sz; i++) {
+        obj_ptr<node>& child = m_children[i];
+
+        if (child->m_key[0] == key[0]) {
+            size_t klen = child->m_key.length();
+            size_t c = 1;
+
+            while (c < klen && c < len && child->m_key[c] == key[c])
+                c++;
+
+            if (c < klen) {
+                obj_ptr<node> mid = new node();
+
+                mid->m_key = child->m_key.substr(0, c);
+                child->m_key = child->m_key.substr(c);
+                mid->m_children.push_back(child);
+                child = mid;
+            }
+
+            child->insert(key + c, len - c, no);
+            return;
+        }
+    }
+
+    obj_ptr<node> child = new node();
+
+    child->m_key.assign(key, len);
+    child->m_rules.push_back(no);
+    m_children.push_back(child);
+}
+
+void Routing::node::lookup(const char* path, size_t len, std::vector<int32_t>& retVal)
+{
+    retVal.insert(retVal.end(), m_rules.begin(), m_rules.end());
+
+    if (len == 0)
+        return;
+
+    size_t i, sz = m_children.size();
+    char ch = qtolower(path[0]);
+
+    for (i = 0; i < sz; i++) {
+        node* child = m_children[i];
+
+        if (child->m_key[0] == ch) {
+            size_t klen = child->m_key.length();
+            size_t c;
+
+            if (klen > len)
+                return;
+
+            for (c = 1; c < klen; c++)
+                if (child->m_key[c] != qtolower(path[c]))
+                    return;
+
+            child->lookup(path + klen, len - klen, retVal);
+            return;
+        }
+    }
+}
+
+inline exlib::string method_key(exlib::string& method)
+{
+    exlib::string key(method);
+    size_t i, sz = key.length();
+
+    for (i = 0; i < sz; i++)
+        key[i] = qtoupper(key[i]);
+
+    return key;
+}
+
+bool Routing::regExpPrefix(exlib::string& re, exlib::string& retVal)
+{
+    const char* p = re.c_str();
+
+    if (*p != '^' || re.find('|') != exlib::string::npos)
+        return false;
+
+    retVal.clear();
+    p++;
+
+    while (true) {
+        char ch = *p;
+        const char* next = p + 1;
+
+        if (ch == 0 || (ch & 0x80) || qstrchr("^$.[]()?*+{}|", ch))
+            break;
+
+        if (ch == '\\') {
+            ch = p[1];
+            if (ch == 0 || (ch & 0x80) || qisdigit(ch) || qisupper(ch) || qislower(ch))
+                break;
+            next = p + 2;
+        }
+
+        if (*next == '?' || *next == '*' || *next == '{')
+            break;
+
+        retVal.append(1, qtolower(ch));
+        p = next;
+    }
+
+    return true;
+}
+
+void Routing::index(rule* r, int32_t no)
+{
+    exlib::string key = method_key(r->m_method);
+
+    if (key == "HOST") {
+        m_hosts.push_back(no);
+        return;
+    }
+
+    obj_ptr<node>& tree = m_methods[key];
+    if (tree == NULL)
+        tree = new node();
+
+    if (r->m_bAnchored)
+        tree->insert(r->m_prefix.c_str(), r->m_prefix.length(), no);
+    else
+        tree->m_rules.push_back(no);
+}
+
+void Routing::candidates(exlib::string& method, bool bHttp, exlib::string& value,
+    std::vector<int32_t>& retVal)
+{
+    std::map<exlib::string, obj_ptr<node>>::iterator it;
+
+    if (bHttp) {
+        it = m_methods.find(method_key(method));
+        if (it != m_methods.end())
+            it->second->lookup(value.c_str(), value.length(), retVal);
+
+        if (it == m_methods.end() || it->first != "*") {
+            it = m_methods.find("*");
+            if (it != m_methods.end())
+                it->second->lookup(value.c_str(), value.length(), retVal);
+        }
+    } else
+        for (it = m_methods.begin(); it != m_methods.end(); it++)
+            it->second->lookup(value.c_str(), value.length(), retVal);
+
+    retVal.insert(retVal.end(), m_hosts.begin(), m_hosts.end());
+    std::sort(retVal.begin(), retVal.end());
+}
+
 #define RE_SIZE 64
 result_t Routing::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
     AsyncEvent* ac)
 {
-    int32_t i, j;
+    int32_t i, j, k;
     int32_t rc = 0;
     obj_ptr<Message_base> msg = Message_base::getInstance(v);
     int32_t ovector[RE_SIZE];
@@ -54,8 +212,13 @@ result_t Routing::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
     if (htmsg)
         htmsg->get_method(method);
 
-    for (i = (int32_t)m_array.size() - 1; i >= 0; i--) {
-        obj_ptr<rule>& r = m_array[i];
+    std::vector<int32_t> rules;
+    int32_t last = (int32_t)m_array.size() - 1;
+
+    candidates(method, htmsg != NULL, value, rules);
+
+    for (k = 0; k < (int32_t)rules.size(); k++) {
+        obj_ptr<rule>& r = m_array[last - rules[k]];
         exlib::string& test = value;
         bool isHost = false;
 
@@ -80,7 +243,7 @@ result_t Routing::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             }
         }
 
-        rc = pcre_exec(r->m_re, NULL, test.c_str(), (int32_t)test.length(),
+        rc = pcre_exec(r->m_re, r->m_extra, test.c_str(), (int32_t)test.length(),
             0, 0, ovector, RE_SIZE);
         if (rc > 0) {
             obj_ptr<NArray> list;
@@ -322,6 +485,16 @@ result_t Routing::append(exlib::string method, exlib::string pattern, Handler_ba
         return CHECK_ERROR(Runtime::setError(buf));
     }
 
+    pcre_extra* extra;
+#ifdef PCRE_STUDY_JIT_COMPILE
+    extra = pcre_study(re, PCRE_STUDY_JIT_COMPILE, &error);
+#else
+    extra = pcre_study(re, 0, &error);
+#endif
+
+    exlib::string prefix;
+    bool bAnchored = regExpPrefix(pattern, prefix);
+
     int32_t no = (int32_t)m_array.size();
 
     char strBuf[32];
@@ -329,8 +502,9 @@ result_t Routing::append(exlib::string method, exlib::string pattern, Handler_ba
 
     SetPrivate(strBuf, hdlr->wrap());
 
-    obj_ptr<rule> r = new rule(method, re, hdlr, bSub);
+    obj_ptr<rule> r = new rule(method, re, extra, hdlr, bSub, prefix, bAnchored);
     m_array.insert(m_array.begin(), r);
+    index(r, no);
 
     retVal = this;
 
@@ -352,9 +526,12 @@ result_t Routing::append(Routing_base* route, obj_ptr<Routing_base>& retVal)
 
         SetPrivate(strBuf, r->m_hdlr->wrap());
         m_array.insert(m_array.begin(), r);
+        index(r, no - 1);
     }
 
     r_obj->m_array.resize(0);
+    r_obj->m_methods.clear();
+    r_obj->m_hosts.clear();
 
     retVal = this;
 
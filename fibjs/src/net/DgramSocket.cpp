@@ -13,8 +13,29 @@
 #include "Buffer.h"
 #include "SimpleObject.h"
 #include "EventInfo.h"
+#include "Stream.h"
 #include <fcntl.h>
 
+#ifdef Linux
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#define UDP_GSO_MAX_SEGMENTS 64
+#define UDP_GSO_MAX_BYTES 65000
+#define UDP_MMSG_MAX 1024
+#endif
+
+#define DGRAM_BATCH_CHUNKS 16
+
 namespace fibjs {
 
 DECLARE_MODULE(dgram);
@@ -76,11 +97,17 @@ result_t dgram_base::createSocket(v8::Local<v8::Object> opts, obj_ptr<DgramSocke
     if (hr < 0)
         return hr;
 
+    bool batch = false;
+    hr = GetConfigValue(isolate->m_isolate, opts, "batch", batch);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
     int32_t family = get_family(type);
     if (family < 0)
         return CHECK_ERROR(CALL_E_INVALIDARG);
 
     obj_ptr<DgramSocket> s = new DgramSocket();
+    s->m_batch = batch;
     hr = s->create(family, (reuseAddr ? UV_UDP_REUSEADDR : 0) | (ipv6Only ? UV_UDP_IPV6ONLY : 0));
     if (hr < 0)
         return hr;
@@ -117,7 +144,14 @@ result_t DgramSocket::create(int32_t family, int32_t flags)
     m_family = family;
 
     return uv_call([&] {
-        return uv_udp_init_ex(s_uv_loop, &m_udp, 0);
+        uint32_t uv_flags = 0;
+
+#if UV_VERSION_HEX >= 0x012800
+        if (m_batch)
+            uv_flags |= UV_UDP_RECVMMSG;
+#endif
+
+        return uv_udp_init_ex(s_uv_loop, &m_udp, uv_flags);
     });
 }
 
@@ -125,33 +159,78 @@ void DgramSocket::on_alloc(uv_handle_t* handle, size_t suggested_size, uv_buf_t*
 {
     DgramSocket* pThis = container_of(handle, DgramSocket, m_handle);
 
+    // with recvmmsg libuv splits the buffer into datagram sized chunks and fills them in one syscall
+    if (pThis->m_batch)
+        suggested_size *= DGRAM_BATCH_CHUNKS;
+
     pThis->m_buf.resize(suggested_size);
     *buf = uv_buf_init(pThis->m_buf.c_buffer(), (int32_t)pThis->m_buf.length());
 }
 
+static obj_ptr<NObject> get_rinfo(const struct sockaddr* addr, ssize_t nread)
+{
+    inetAddr& _addr = *(inetAddr*)addr;
+    obj_ptr<NObject> msg = new NObject();
+
+    msg->add("address", _addr.str());
+    msg->add("family", _addr.family() == net_base::C_AF_INET6 ? "IPv6" : "IPv4");
+    msg->add("port", _addr.port());
+    msg->add("size", (int32_t)nread);
+
+    return msg;
+}
+
 void DgramSocket::on_recv(uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned flags)
 {
     DgramSocket* pThis = container_of(handle, DgramSocket, m_udp);
 
+    if (pThis->m_batch) {
+        pThis->on_batch(nread, buf, addr, flags);
+        return;
+    }
+
     pThis->m_buf.resize(nread);
     if (addr) {
         Variant v[2];
 
         obj_ptr<Buffer> _buf = new Buffer(pThis->m_buf);
         v[0] = _buf;
-
-        inetAddr& _addr = *(inetAddr*)addr;
-        obj_ptr<NObject> msg = new NObject();
-        msg->add("address", _addr.str());
-        msg->add("family", _addr.family() == net_base::C_AF_INET6 ? "IPv6" : "IPv4");
-        msg->add("port", _addr.port());
-        msg->add("size", (int32_t)nread);
-        v[1] = msg;
+        v[1] = get_rinfo(addr, nread);
 
         pThis->_emit("message", v, 2);
     }
 }
 
+void DgramSocket::on_batch(ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned flags)
+{
+    if (addr && nread >= 0) {
+        if (!m_msgs) {
+            m_msgs = new NArray();
+            m_rinfos = new NArray();
+        }
+
+        m_msgs->append(new Buffer(buf->base, nread));
+        m_rinfos->append(get_rinfo(addr, nread));
+
+#if UV_VERSION_HEX >= 0x012800
+        // more chunks of the same recvmmsg call follow, the last callback carries UV_UDP_MMSG_FREE
+        if (flags & UV_UDP_MMSG_CHUNK)
+            return;
+#endif
+    }
+
+    if (m_msgs) {
+        Variant v[2];
+
+        v[0] = m_msgs;
+        v[1] = m_rinfos;
+        m_msgs.Release();
+        m_rinfos.Release();
+
+        _emit("messages", v, 2);
+    }
+}
+
 void DgramSocket::stop_bind()
 {
     m_bound = false;
@@ -283,21 +362,9 @@ result_t DgramSocket::send(Buffer_base* msg, int32_t port, exlib::string address
 
     inetAddr addr_info;
 
-    addr_info.init(m_family);
-    addr_info.setPort(port);
-
-    if (address.empty())
-        address = m_family == net_base::C_AF_INET6 ? "::1" : "127.0.0.1";
-
-    if (addr_info.addr(address.c_str()) < 0) {
-        exlib::string strAddr;
-        hr = net_base::cc_resolve(address, m_family, strAddr);
-        if (hr < 0)
-            return hr;
-
-        if (addr_info.addr(strAddr.c_str()) < 0)
-            return CHECK_ERROR(CALL_E_INVALIDARG);
-    }
+    hr = resolve(port, address, addr_info);
+    if (hr < 0)
+        return hr;
 
     AsyncSend* _send = new AsyncSend(msg, port, retVal, ac);
     int32_t status = uv_udp_try_send(&m_udp, &_send->m_buf, 1, (sockaddr*)&addr_info);
@@ -335,6 +402,276 @@ result_t DgramSocket::send(Buffer_base* msg, int32_t offset, int32_t length, int
     return send(msg1, port, address, retVal, ac);
 }
 
+#ifdef Linux
+static int32_t send_gso(intptr_t fd, struct iovec* iov, size_t cnt, int32_t seg, inetAddr& addr)
+{
+    char ctrl[CMSG_SPACE(sizeof(uint16_t))];
+    struct msghdr msg;
+    struct cmsghdr* cm;
+
+    memset(&msg, 0, sizeof(msg));
+    memset(ctrl, 0, sizeof(ctrl));
+
+    msg.msg_name = &addr;
+    msg.msg_namelen = addr.size();
+    msg.msg_iov = iov;
+    msg.msg_iovlen = cnt;
+    msg.msg_control = ctrl;
+    msg.msg_controllen = sizeof(ctrl);
+
+    cm = CMSG_FIRSTHDR(&msg);
+    cm->cmsg_level = SOL_UDP;
+    cm->cmsg_type = UDP_SEGMENT;
+    cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    *(uint16_t*)CMSG_DATA(cm) = (uint16_t)seg;
+
+    if (::sendmsg(fd, &msg, 0) < 0)
+        return -errno;
+
+    return (int32_t)cnt;
+}
+
+static int32_t send_mmsg(intptr_t fd, struct iovec* iov, size_t cnt, inetAddr& addr)
+{
+    std::vector<struct mmsghdr> msgs(cnt);
+    size_t i;
+
+    for (i = 0; i < cnt; i++) {
+        struct msghdr& msg = msgs[i].msg_hdr;
+
+        memset(&msgs[i], 0, sizeof(struct mmsghdr));
+        msg.msg_name = &addr;
+        msg.msg_namelen = addr.size();
+        msg.msg_iov = &iov[i];
+        msg.msg_iovlen = 1;
+    }
+
+    int32_t n = ::sendmmsg(fd, msgs.data(), (uint32_t)cnt, 0);
+    return n < 0 ? -errno : n;
+}
+
+// number of leading datagrams that share one size and fit in a single UDP_SEGMENT send
+static size_t gso_count(struct iovec* iov, size_t cnt)
+{
+    size_t seg = iov[0].iov_len;
+    size_t i;
+
+    if (seg == 0)
+        return 0;
+
+    if (cnt > UDP_GSO_MAX_SEGMENTS)
+        cnt = UDP_GSO_MAX_SEGMENTS;
+    if (cnt > UDP_GSO_MAX_BYTES / seg)
+        cnt = UDP_GSO_MAX_BYTES / seg;
+
+    for (i = 1; i < cnt; i++)
+        if (iov[i].iov_len != seg)
+            break;
+
+    return i < 2 ? 0 : i;
+}
+
+static result_t send_batch(intptr_t fd, std::vector<obj_ptr<Buffer_base>>& bufs, inetAddr& addr, size_t& pos)
+{
+    std::vector<struct iovec> iov(bufs.size());
+    bool gso = true;
+    size_t i;
+
+    for (i = 0; i < bufs.size(); i++) {
+        Buffer* buf = (Buffer*)(Buffer_base*)bufs[i];
+        int32_t len;
+
+        buf->get_length(len);
+        iov[i].iov_base = buf->data();
+        iov[i].iov_len = len;
+    }
+
+    while (pos < bufs.size()) {
+        size_t cnt = bufs.size() - pos;
+        size_t gcnt = gso ? gso_count(&iov[pos], cnt) : 0;
+        int32_t n;
+
+        if (gcnt) {
+            n = send_gso(fd, &iov[pos], gcnt, (int32_t)iov[pos].iov_len, addr);
+            if (n == -EINVAL || n == -EIO || n == -ENOPROTOOPT) {
+                // kernel without UDP_SEGMENT, or segment larger than the route mtu
+                gso = false;
+                continue;
+            }
+        } else
+            n = send_mmsg(fd, &iov[pos], cnt > UDP_MMSG_MAX ? UDP_MMSG_MAX : cnt, addr);
+
+        if (n < 0) {
+            if (n == -EAGAIN || n == -EWOULDBLOCK || pos > 0)
+                break;
+            return CHECK_ERROR(n);
+        }
+
+        pos += n;
+    }
+
+    return 0;
+}
+#endif
+
+result_t DgramSocket::sendBatch(v8::Local<v8::Array> msgs, int32_t port, exlib::string address,
+    int32_t& retVal, AsyncEvent* ac)
+{
+    class AsyncSendBatch {
+    public:
+        AsyncSendBatch(std::vector<obj_ptr<Buffer_base>>& bufs, int32_t& retVal, AsyncEvent* ac)
+            : m_retVal(retVal)
+            , m_ac(ac)
+            , m_bufs(bufs)
+            , m_pending(0)
+            , m_sent(0)
+            , m_error(0)
+        {
+            size_t i;
+
+            m_reqs.resize(m_bufs.size());
+            m_uvbufs.resize(m_bufs.size());
+
+            for (i = 0; i < m_bufs.size(); i++) {
+                Buffer* buf = (Buffer*)(Buffer_base*)m_bufs[i];
+                int32_t len;
+
+                buf->get_length(len);
+                m_uvbufs[i] = uv_buf_init((char*)buf->data(), len);
+                m_reqs[i].data = this;
+            }
+        }
+
+    public:
+        // runs on the loop thread
+        int32_t send(uv_udp_t* udp, inetAddr& addr)
+        {
+            size_t pos = 0;
+            size_t i;
+
+#ifdef Linux
+            uv_os_fd_t fd;
+
+            // with nothing queued in uv the batched syscalls can neither race a uv send nor overtake one,
+            // whatever they leave behind goes through uv's queue
+            if (uv_udp_get_send_queue_count(udp) == 0 && uv_fileno((uv_handle_t*)udp, &fd) == 0) {
+                result_t hr = send_batch(fd, m_bufs, addr, pos);
+                if (hr < 0) {
+                    delete this;
+                    return hr;
+                }
+
+                m_sent = (int32_t)pos;
+            }
+#endif
+
+            m_pending = (int32_t)(m_reqs.size() - pos);
+            for (i = pos; i < m_reqs.size(); i++) {
+                int32_t ret = uv_udp_send(&m_reqs[i], udp, &m_uvbufs[i], 1, (sockaddr*)&addr, callback);
+                if (ret < 0) {
+                    m_error = ret;
+                    m_pending -= (int32_t)(m_reqs.size() - i);
+                    break;
+                }
+            }
+
+            if (m_pending == 0)
+                finish();
+
+            return 0;
+        }
+
+        static void callback(uv_udp_send_t* req, int status)
+        {
+            AsyncSendBatch* pThis = (AsyncSendBatch*)req->data;
+
+            if (status < 0) {
+                if (!pThis->m_error)
+                    pThis->m_error = status;
+            } else
+                pThis->m_sent++;
+
+            if (--pThis->m_pending == 0)
+                pThis->finish();
+        }
+
+        void finish()
+        {
+            if (m_sent == 0 && m_error < 0)
+                m_ac->apost(m_error);
+            else {
+                m_retVal = m_sent;
+                m_ac->apost(0);
+            }
+
+            delete this;
+        }
+
+    public:
+        int32_t& m_retVal;
+        AsyncEvent* m_ac;
+        std::vector<obj_ptr<Buffer_base>> m_bufs;
+        std::vector<uv_udp_send_t> m_reqs;
+        std::vector<uv_buf_t> m_uvbufs;
+        int32_t m_pending;
+        int32_t m_sent;
+        int32_t m_error;
+    };
+
+    std::vector<obj_ptr<Buffer_base>> bufs;
+    result_t hr;
+
+    hr = get_writev_buffers(msgs, bufs, ac);
+    if (hr < 0 && hr != CALL_E_NOSYNC)
+        return hr;
+
+    if (!m_bound) {
+        hr = bind(0, "", ac);
+        if (hr < 0)
+            return hr;
+    }
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    retVal = 0;
+    if (bufs.empty())
+        return 0;
+
+    inetAddr addr_info;
+
+    hr = resolve(port, address, addr_info);
+    if (hr < 0)
+        return hr;
+
+    AsyncSendBatch* _send = new AsyncSendBatch(bufs, retVal, ac);
+
+    return uv_async([&] {
+        return _send->send(&m_udp, addr_info);
+    });
+}
+
+result_t DgramSocket::resolve(int32_t port, exlib::string address, inetAddr& addr_info)
+{
+    addr_info.init(m_family);
+    addr_info.setPort(port);
+
+    if (address.empty())
+        address = m_family == net_base::C_AF_INET6 ? "::1" : "127.0.0.1";
+
+    if (addr_info.addr(address.c_str()) < 0) {
+        exlib::string strAddr;
+        result_t hr = net_base::cc_resolve(address, m_family, strAddr);
+        if (hr < 0)
+            return hr;
+
+        if (addr_info.addr(strAddr.c_str()) < 0)
+            return CHECK_ERROR(CALL_E_INVALIDARG);
+    }
+
+    return 0;
+}
+
 result_t DgramSocket::address(obj_ptr<NObject>& retVal)
 {
     inetAddr addr_info;
@@ -0,0 +1,967 @@
+/*
+ * Resolver.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "Resolver.h"
+#include "AsyncUV.h"
+#include "inetAddr.h"
+#include <exlib/include/thread.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <map>
+#include <memory>
+
+namespace fibjs {
+
+#define DNS_TYPE_A 1
+#define DNS_TYPE_SOA 6
+#define DNS_TYPE_AAAA 28
+#define DNS_CLASS_IN 1
+#define DNS_RCODE_NXDOMAIN 3
+
+#define DNS_PORT 53
+#define DNS_MAX_SERVERS 3
+#define DNS_MAX_TTL 3600
+#define DNS_NEG_TTL 30
+#define DNS_MAX_NEG_TTL 300
+#define DNS_CACHE_SIZE 4096
+#define DNS_CONFIG_CHECK 5000
+#define DNS_UDP_SIZE 4096
+#define DNS_TCP_SIZE (65535 + 2)
+
+Resolver::Stats Resolver::s_stats;
+
+static uint16_t get16(const uint8_t* p)
+{
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t get32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint64_t now_ms()
+{
+    return uv_hrtime() / 1000000;
+}
+
+static exlib::string lower_name(exlib::string name)
+{
+    size_t i;
+
+    if (name.length() > 1 && name[name.length() - 1] == '.')
+        name.resize(name.length() - 1);
+
+    for (i = 0; i < name.length(); i++)
+        if (name[i] >= 'A' && name[i] <= 'Z')
+            name[i] = name[i] - 'A' + 'a';
+
+    return name;
+}
+
+class DnsConfig {
+public:
+    DnsConfig()
+        : search(false)
+        , ndots(1)
+        , timeout(5000)
+        , attempts(2)
+    {
+        mtime[0] = mtime[1] = 0;
+    }
+
+public:
+    void load()
+    {
+#ifndef _WIN32
+        mtime[0] = file_mtime("/etc/resolv.conf");
+        mtime[1] = file_mtime("/etc/hosts");
+        load_resolv();
+        load_hosts();
+#endif
+    }
+
+    bool changed()
+    {
+#ifndef _WIN32
+        return mtime[0] != file_mtime("/etc/resolv.conf")
+            || mtime[1] != file_mtime("/etc/hosts");
+#else
+        return false;
+#endif
+    }
+
+private:
+#ifndef _WIN32
+    static int64_t file_mtime(const char* fname)
+    {
+        struct stat st;
+
+        if (::stat(fname, &st))
+            return -1;
+
+        return (int64_t)st.st_mtime;
+    }
+
+    void load_resolv()
+    {
+        FILE* fp = fopen("/etc/resolv.conf", "r");
+        char line[1024];
+
+        if (fp == NULL)
+            return;
+
+        while (fgets(line, sizeof(line), fp)) {
+            char* save = NULL;
+            char* tok = strtok_r(line, " \t\r\n", &save);
+
+            if (tok == NULL || *tok == '#' || *tok == ';')
+                continue;
+
+            if (!strcmp(tok, "nameserver")) {
+                tok = strtok_r(NULL, " \t\r\n", &save);
+                if (tok && servers.size() < DNS_MAX_SERVERS) {
+                    inetAddr addr;
+
+                    addr.init(net_base::C_AF_INET);
+                    addr.setPort(DNS_PORT);
+                    if (addr.addr(tok) < 0) {
+                        addr.init(net_base::C_AF_INET6);
+                        addr.setPort(DNS_PORT);
+                        if (addr.addr(tok) < 0)
+                            continue;
+                    }
+
+                    servers.push_back(addr);
+                }
+            } else if (!strcmp(tok, "search") || !strcmp(tok, "domain")) {
+                search = strtok_r(NULL, " \t\r\n", &save) != NULL;
+            } else if (!strcmp(tok, "options")) {
+                while ((tok = strtok_r(NULL, " \t\r\n", &save)) != NULL) {
+                    if (!qstrcmp(tok, "ndots:", 6))
+                        ndots = atoi(tok + 6);
+                    else if (!qstrcmp(tok, "timeout:", 8))
+                        timeout = atoi(tok + 8) * 1000;
+                    else if (!qstrcmp(tok, "attempts:", 9))
+                        attempts = atoi(tok + 9);
+                }
+            }
+        }
+
+        fclose(fp);
+
+        if (timeout < 1000)
+            timeout = 1000;
+        if (attempts < 1)
+            attempts = 1;
+    }
+
+    void load_hosts()
+    {
+        FILE* fp = fopen("/etc/hosts", "r");
+        char line[1024];
+
+        if (fp == NULL)
+            return;
+
+        while (fgets(line, sizeof(line), fp)) {
+            char* save = NULL;
+            char* tok;
+            inetAddr addr;
+            int32_t idx = 0;
+            char* p;
+
+            p = strchr(line, '#');
+            if (p)
+                *p = 0;
+
+            tok = strtok_r(line, " \t\r\n", &save);
+            if (tok == NULL)
+                continue;
+
+            addr.init(net_base::C_AF_INET);
+            if (addr.addr(tok) < 0) {
+                addr.init(net_base::C_AF_INET6);
+                if (addr.addr(tok) < 0)
+                    continue;
+                idx = 1;
+            }
+
+            exlib::string ip = addr.str();
+            while ((tok = strtok_r(NULL, " \t\r\n", &save)) != NULL)
+                hosts[idx][lower_name(tok)].push_back(ip);
+        }
+
+        fclose(fp);
+    }
+#endif
+
+public:
+    bool search;
+    int32_t ndots;
+    int32_t timeout;
+    int32_t attempts;
+    std::vector<inetAddr> servers;
+    std::map<exlib::string, std::vector<exlib::string>> hosts[2];
+
+private:
+    int64_t mtime[2];
+};
+
+struct DnsEntry {
+    std::vector<exlib::string> addrs;
+    result_t hr;
+    uint64_t expires;
+};
+
+static exlib::spinlock s_lock;
+static std::shared_ptr<DnsConfig> s_config;
+static uint64_t s_config_check;
+static std::map<exlib::string, DnsEntry> s_cache;
+
+// the files are parsed once and looked at again at most every DNS_CONFIG_CHECK ms,
+// a new mtime on either of them loads them again
+static std::shared_ptr<DnsConfig> get_config()
+{
+    std::shared_ptr<DnsConfig> cfg;
+    uint64_t now = now_ms();
+    bool check = false;
+
+    s_lock.lock();
+    cfg = s_config;
+    if (cfg && now >= s_config_check) {
+        s_config_check = now + DNS_CONFIG_CHECK;
+        check = true;
+    }
+    s_lock.unlock();
+
+    if (!cfg || (check && cfg->changed())) {
+        std::shared_ptr<DnsConfig> stale = cfg;
+
+        cfg = std::make_shared<DnsConfig>();
+        cfg->load();
+
+        s_lock.lock();
+        if (s_config && s_config != stale)
+            cfg = s_config;
+        else {
+            s_config = cfg;
+            s_config_check = now + DNS_CONFIG_CHECK;
+        }
+        s_lock.unlock();
+    }
+
+    return cfg;
+}
+
+static exlib::string cache_key(const exlib::string& host, int32_t idx)
+{
+    return exlib::string(idx ? "6:" : "4:") + host;
+}
+
+static bool cache_get(const exlib::string& key, std::vector<exlib::string>& addrs, result_t& hr)
+{
+    uint64_t now = now_ms();
+    bool found = false;
+
+    s_lock.lock();
+    std::map<exlib::string, DnsEntry>::iterator it = s_cache.find(key);
+    if (it != s_cache.end()) {
+        if (it->second.expires > now) {
+            addrs = it->second.addrs;
+            hr = it->second.hr;
+            found = true;
+        } else
+            s_cache.erase(it);
+    }
+    s_lock.unlock();
+
+    return found;
+}
+
+static void cache_put(const exlib::string& key, std::vector<exlib::string>& addrs, result_t hr, int32_t ttl)
+{
+    uint64_t now = now_ms();
+
+    if (ttl <= 0)
+        return;
+
+    s_lock.lock();
+    if (s_cache.size() >= DNS_CACHE_SIZE) {
+        std::map<exlib::string, DnsEntry>::iterator it;
+
+        for (it = s_cache.begin(); it != s_cache.end();)
+            if (it->second.expires <= now)
+                s_cache.erase(it++);
+            else
+                ++it;
+
+        if (s_cache.size() >= DNS_CACHE_SIZE)
+            s_cache.clear();
+    }
+
+    DnsEntry& e = s_cache[key];
+    e.addrs = addrs;
+    e.hr = hr;
+    e.expires = now + (uint64_t)ttl * 1000;
+    s_lock.unlock();
+}
+
+// hosts file first, then the answer cache, false means a nameserver has to be asked
+static bool lookup_local(DnsConfig* cfg, const exlib::string& host, int32_t idx,
+    std::vector<exlib::string>& addrs, result_t& hr)
+{
+    std::map<exlib::string, std::vector<exlib::string>>::iterator it = cfg->hosts[idx].find(host);
+
+    if (it != cfg->hosts[idx].end()) {
+        addrs = it->second;
+        hr = 0;
+        Resolver::s_stats.hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    if (cache_get(cache_key(host, idx), addrs, hr)) {
+        if (hr < 0)
+            Resolver::s_stats.negative.fetch_add(1, std::memory_order_relaxed);
+        else
+            Resolver::s_stats.hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    Resolver::s_stats.misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+static result_t merge(std::vector<exlib::string>* addrs, result_t* hrs, Resolver::Callback& done)
+{
+    std::vector<exlib::string> all(addrs[0]);
+
+    all.insert(all.end(), addrs[1].begin(), addrs[1].end());
+    if (all.empty())
+        return hrs[0] < 0 ? hrs[0] : (hrs[1] < 0 ? hrs[1] : UV_EAI_NONAME);
+
+    done(all);
+    return 0;
+}
+
+class DnsWaiter {
+public:
+    DnsWaiter(Resolver::Callback done, int32_t pending, AsyncEvent* ac)
+        : m_done(done)
+        , m_ac(ac)
+        , m_pending(pending)
+    {
+        m_hrs[0] = m_hrs[1] = 0;
+    }
+
+public:
+    void set(int32_t idx, std::vector<exlib::string>& addrs, result_t hr)
+    {
+        m_addrs[idx] = addrs;
+        m_hrs[idx] = hr;
+
+        if (--m_pending == 0) {
+            m_ac->apost(merge(m_addrs, m_hrs, m_done));
+            delete this;
+        }
+    }
+
+public:
+    Resolver::Callback m_done;
+    AsyncEvent* m_ac;
+    int32_t m_pending;
+    std::vector<exlib::string> m_addrs[2];
+    result_t m_hrs[2];
+};
+
+class DnsQuery;
+static std::map<exlib::string, DnsQuery*> s_inflight;
+
+class DnsQuery {
+public:
+    struct Udp {
+        uv_udp_t udp;
+        uv_udp_send_t req;
+        exlib::string buf;
+        DnsQuery* q;
+    };
+
+    struct Tcp {
+        uv_tcp_t tcp;
+        uv_connect_t conn;
+        uv_write_t wr;
+        char hdr[2];
+        exlib::string buf;
+        int32_t used;
+        DnsQuery* q;
+    };
+
+public:
+    DnsQuery(std::shared_ptr<DnsConfig>& cfg, exlib::string key, exlib::string host, int32_t idx)
+        : m_cfg(cfg)
+        , m_key(key)
+        , m_host(host)
+        , m_idx(idx)
+        , m_type(idx ? DNS_TYPE_AAAA : DNS_TYPE_A)
+        , m_id(0)
+        , m_attempt(0)
+        , m_handles(1)
+        , m_udp(NULL)
+        , m_tcp(NULL)
+    {
+        uv_timer_init(s_uv_loop, &m_timer);
+        m_timer.data = this;
+    }
+
+public:
+    void start()
+    {
+        if (!build()) {
+            std::vector<exlib::string> addrs;
+            finish(addrs, UV_EAI_NONAME, 0);
+            return;
+        }
+
+        send();
+    }
+
+private:
+    bool build()
+    {
+        static const char hdr[12] = { 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0 };
+        size_t pos = 0;
+
+        m_packet.assign(hdr, sizeof(hdr));
+
+        if (m_host.empty() || m_host.length() > 253)
+            return false;
+
+        while (pos < m_host.length()) {
+            size_t end = m_host.find('.', pos);
+            if (end == exlib::string::npos)
+                end = m_host.length();
+
+            size_t len = end - pos;
+            if (len == 0 || len > 63)
+                return false;
+
+            m_packet.append(1, (char)len);
+            m_packet.append(m_host.c_str() + pos, len);
+            pos = end + 1;
+        }
+
+        char tail[5] = { 0, 0, (char)m_type, 0, DNS_CLASS_IN };
+        m_packet.append(tail, sizeof(tail));
+
+        return true;
+    }
+
+    void send()
+    {
+        std::vector<inetAddr>& servers = m_cfg->servers;
+        int32_t ret;
+
+        close_conn();
+
+        if (m_attempt >= (int32_t)servers.size() * m_cfg->attempts) {
+            std::vector<exlib::string> addrs;
+
+            Resolver::s_stats.timeouts.fetch_add(1, std::memory_order_relaxed);
+            finish(addrs, -ETIMEDOUT, 0);
+            return;
+        }
+
+        if (m_attempt > 0)
+            Resolver::s_stats.retries.fetch_add(1, std::memory_order_relaxed);
+
+        m_server = servers[m_attempt % servers.size()];
+        m_attempt++;
+
+#if UV_VERSION_HEX >= 0x012100
+        if (uv_random(NULL, NULL, &m_id, sizeof(m_id), 0, NULL) < 0)
+#endif
+            m_id = (uint16_t)(rand() ^ uv_hrtime());
+
+        m_packet[0] = (char)(m_id >> 8);
+        m_packet[1] = (char)m_id;
+
+        m_udp = new Udp();
+        m_udp->q = this;
+        uv_udp_init(s_uv_loop, &m_udp->udp);
+        m_udp->udp.data = m_udp;
+        m_handles++;
+
+        Resolver::s_stats.queries.fetch_add(1, std::memory_order_relaxed);
+        uv_timer_start(&m_timer, on_timeout, m_cfg->timeout, 0);
+
+        uv_buf_t buf = uv_buf_init(m_packet.c_buffer(), (uint32_t)m_packet.length());
+        ret = uv_udp_send(&m_udp->req, &m_udp->udp, &buf, 1, (sockaddr*)&m_server, NULL);
+        if (ret == 0)
+            ret = uv_udp_recv_start(&m_udp->udp, on_udp_alloc, on_udp_recv);
+        if (ret < 0)
+            send();
+    }
+
+    void send_tcp()
+    {
+        close_conn();
+        Resolver::s_stats.tcp.fetch_add(1, std::memory_order_relaxed);
+
+        m_tcp = new Tcp();
+        m_tcp->q = this;
+        m_tcp->used = 0;
+        m_tcp->hdr[0] = (char)(m_packet.length() >> 8);
+        m_tcp->hdr[1] = (char)m_packet.length();
+        uv_tcp_init(s_uv_loop, &m_tcp->tcp);
+        m_tcp->tcp.data = m_tcp;
+        m_handles++;
+
+        uv_timer_start(&m_timer, on_timeout, m_cfg->timeout, 0);
+        if (uv_tcp_connect(&m_tcp->conn, &m_tcp->tcp, (sockaddr*)&m_server, on_tcp_connect) < 0)
+            send();
+    }
+
+    void close_conn()
+    {
+        if (m_udp) {
+            uv_close((uv_handle_t*)&m_udp->udp, on_udp_close);
+            m_udp = NULL;
+        }
+
+        if (m_tcp) {
+            uv_close((uv_handle_t*)&m_tcp->tcp, on_tcp_close);
+            m_tcp = NULL;
+        }
+    }
+
+    void finish(std::vector<exlib::string>& addrs, result_t hr, int32_t ttl)
+    {
+        size_t i;
+
+        close_conn();
+        uv_timer_stop(&m_timer);
+        uv_close((uv_handle_t*)&m_timer, on_timer_close);
+
+        cache_put(m_key, addrs, hr, ttl);
+        s_inflight.erase(m_key);
+
+        for (i = 0; i < m_waiters.size(); i++)
+            m_waiters[i]->set(m_idx, addrs, hr);
+        m_waiters.clear();
+    }
+
+    void release()
+    {
+        if (--m_handles == 0)
+            delete this;
+    }
+
+    void on_response(const char* data, int32_t len, bool tcp)
+    {
+        std::vector<exlib::string> addrs;
+        int32_t ttl = 0;
+        int32_t rcode = 0;
+        bool tc = false;
+
+        if (!parse((const uint8_t*)data, len, addrs, ttl, rcode, tc)) {
+            if (tcp)
+                send();
+            return;
+        }
+
+        if (tc && !tcp)
+            send_tcp();
+        else if (rcode == 0 && !addrs.empty())
+            finish(addrs, 0, ttl);
+        else if (rcode == 0 || rcode == DNS_RCODE_NXDOMAIN)
+            finish(addrs, UV_EAI_NONAME, ttl);
+        else
+            send();
+    }
+
+    static bool skip_name(const uint8_t* p, int32_t len, int32_t& pos)
+    {
+        while (pos < len) {
+            uint8_t c = p[pos];
+
+            if (c == 0) {
+                pos++;
+                return true;
+            }
+
+            if ((c & 0xc0) == 0xc0) {
+                pos += 2;
+                return pos <= len;
+            }
+
+            if (c & 0xc0)
+                return false;
+
+            pos += c + 1;
+        }
+
+        return false;
+    }
+
+    bool parse(const uint8_t* p, int32_t len, std::vector<exlib::string>& addrs,
+        int32_t& ttl, int32_t& rcode, bool& tc)
+    {
+        int32_t qlen = (int32_t)m_packet.length() - 12;
+        int32_t pos = (int32_t)m_packet.length();
+        int32_t an, ns, i;
+
+        if (len < pos || get16(p) != m_id || !(p[2] & 0x80) || get16(p + 4) != 1)
+            return false;
+
+        // the question has to be echoed back unchanged
+        if (memcmp(p + 12, m_packet.c_str() + 12, qlen))
+            return false;
+
+        tc = (p[2] & 0x02) != 0;
+        rcode = p[3] & 0x0f;
+        if (tc)
+            return true;
+
+        an = get16(p + 6);
+        ns = get16(p + 8);
+
+        ttl = DNS_MAX_TTL;
+        for (i = 0; i < an; i++) {
+            if (!skip_name(p, len, pos) || pos + 10 > len)
+                return false;
+
+            uint16_t type = get16(p + pos);
+            uint16_t cls = get16(p + pos + 2);
+            uint32_t rttl = get32(p + pos + 4);
+            int32_t rdlen = get16(p + pos + 8);
+
+            pos += 10;
+            if (pos + rdlen > len)
+                return false;
+
+            // CNAME chains are flattened by the server, only the final address records matter here
+            if (cls == DNS_CLASS_IN && type == m_type && rdlen == (m_type == DNS_TYPE_A ? 4 : 16)) {
+                inetAddr addr;
+
+                if (m_type == DNS_TYPE_A) {
+                    addr.init(net_base::C_AF_INET);
+                    memcpy(&addr.addr4.sin_addr, p + pos, 4);
+                } else {
+                    addr.init(net_base::C_AF_INET6);
+                    memcpy(&addr.addr6.sin6_addr, p + pos, 16);
+                }
+
+                addrs.push_back(addr.str());
+                if (rttl < (uint32_t)ttl)
+                    ttl = (int32_t)rttl;
+            }
+
+            pos += rdlen;
+        }
+
+        if (!addrs.empty())
+            return true;
+
+        // negative answers are cached for the SOA minimum, RFC 2308
+        ttl = DNS_NEG_TTL;
+        for (i = 0; i < ns; i++) {
+            if (!skip_name(p, len, pos) || pos + 10 > len)
+                return true;
+
+            uint16_t type = get16(p + pos);
+            uint32_t rttl = get32(p + pos + 4);
+            int32_t rdlen = get16(p + pos + 8);
+
+            pos += 10;
+            if (pos + rdlen > len)
+                return true;
+
+            if (type == DNS_TYPE_SOA) {
+                int32_t end = pos + rdlen;
+                int32_t rpos = pos;
+
+                if (skip_name(p, end, rpos) && skip_name(p, end, rpos) && rpos + 20 <= end) {
+                    uint32_t minimum = get32(p + rpos + 16);
+                    uint32_t v = rttl < minimum ? rttl : minimum;
+
+                    ttl = v > DNS_MAX_NEG_TTL ? DNS_MAX_NEG_TTL : (int32_t)v;
+                }
+                break;
+            }
+
+            pos += rdlen;
+        }
+
+        return true;
+    }
+
+    bool from_server(const struct sockaddr* addr)
+    {
+        inetAddr& a = *(inetAddr*)addr;
+
+        if (a.addr4.sin_family != m_server.addr4.sin_family || a.port() != m_server.port())
+            return false;
+
+        if (a.addr4.sin_family == AF_INET)
+            return !memcmp(&a.addr4.sin_addr, &m_server.addr4.sin_addr, sizeof(a.addr4.sin_addr));
+
+        return !memcmp(&a.addr6.sin6_addr, &m_server.addr6.sin6_addr, sizeof(a.addr6.sin6_addr));
+    }
+
+private:
+    static void on_timeout(uv_timer_t* handle)
+    {
+        DnsQuery* q = (DnsQuery*)handle->data;
+        q->send();
+    }
+
+    static void on_udp_alloc(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf)
+    {
+        Udp* c = (Udp*)handle->data;
+
+        c->buf.resize(DNS_UDP_SIZE);
+        *buf = uv_buf_init(c->buf.c_buffer(), (uint32_t)c->buf.length());
+    }
+
+    static void on_udp_recv(uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned flags)
+    {
+        Udp* c = (Udp*)handle->data;
+        DnsQuery* q = c->q;
+
+        if (nread <= 0 || addr == NULL || c != q->m_udp || !q->from_server(addr))
+            return;
+
+        q->on_response(buf->base, (int32_t)nread, false);
+    }
+
+    static void on_udp_close(uv_handle_t* handle)
+    {
+        Udp* c = (Udp*)handle->data;
+        DnsQuery* q = c->q;
+
+        delete c;
+        q->release();
+    }
+
+    static void on_tcp_connect(uv_connect_t* req, int status)
+    {
+        Tcp* c = container_of(req, Tcp, conn);
+        DnsQuery* q = c->q;
+
+        if (c != q->m_tcp)
+            return;
+
+        if (status < 0) {
+            q->send();
+            return;
+        }
+
+        uv_buf_t bufs[2] = {
+            uv_buf_init(c->hdr, 2),
+            uv_buf_init(q->m_packet.c_buffer(), (uint32_t)q->m_packet.length())
+        };
+
+        c->buf.resize(DNS_TCP_SIZE);
+        if (uv_write(&c->wr, (uv_stream_t*)&c->tcp, bufs, 2, NULL) < 0
+            || uv_read_start((uv_stream_t*)&c->tcp, on_tcp_alloc, on_tcp_read) < 0)
+            q->send();
+    }
+
+    static void on_tcp_alloc(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf)
+    {
+        Tcp* c = (Tcp*)handle->data;
+
+        *buf = uv_buf_init(c->buf.c_buffer() + c->used, (uint32_t)(c->buf.length() - c->used));
+    }
+
+    static void on_tcp_read(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf)
+    {
+        Tcp* c = (Tcp*)stream->data;
+        DnsQuery* q = c->q;
+
+        if (c != q->m_tcp)
+            return;
+
+        if (nread < 0) {
+            q->send();
+            return;
+        }
+
+        c->used += (int32_t)nread;
+        if (c->used >= 2) {
+            int32_t need = get16((const uint8_t*)c->buf.c_str());
+
+            if (c->used >= need + 2)
+                q->on_response(c->buf.c_str() + 2, need, true);
+        }
+    }
+
+    static void on_tcp_close(uv_handle_t* handle)
+    {
+        Tcp* c = (Tcp*)handle->data;
+        DnsQuery* q = c->q;
+
+        delete c;
+        q->release();
+    }
+
+    static void on_timer_close(uv_handle_t* handle)
+    {
+        DnsQuery* q = (DnsQuery*)handle->data;
+        q->release();
+    }
+
+public:
+    std::vector<DnsWaiter*> m_waiters;
+
+private:
+    std::shared_ptr<DnsConfig> m_cfg;
+    exlib::string m_key;
+    exlib::string m_host;
+    int32_t m_idx;
+    int32_t m_type;
+    uint16_t m_id;
+    int32_t m_attempt;
+    int32_t m_handles;
+    exlib::string m_packet;
+    inetAddr m_server;
+    uv_timer_t m_timer;
+    Udp* m_udp;
+    Tcp* m_tcp;
+};
+
+// runs on the uv thread, which owns s_inflight
+static void query_start(std::shared_ptr<DnsConfig>& cfg, const exlib::string& host, int32_t idx, DnsWaiter* w)
+{
+    exlib::string key = cache_key(host, idx);
+    std::vector<exlib::string> addrs;
+    result_t hr = 0;
+
+    if (cache_get(key, addrs, hr)) {
+        w->set(idx, addrs, hr);
+        return;
+    }
+
+    std::map<exlib::string, DnsQuery*>::iterator it = s_inflight.find(key);
+    if (it != s_inflight.end()) {
+        Resolver::s_stats.coalesced.fetch_add(1, std::memory_order_relaxed);
+        it->second->m_waiters.push_back(w);
+        return;
+    }
+
+    DnsQuery* q = new DnsQuery(cfg, key, host, idx);
+    q->m_waiters.push_back(w);
+    s_inflight[key] = q;
+    q->start();
+}
+
+bool Resolver::enabled(exlib::string name)
+{
+#ifdef _WIN32
+    return false;
+#else
+    std::shared_ptr<DnsConfig> cfg = get_config();
+
+    if (cfg->servers.empty())
+        return false;
+
+    // relative names go through the search list, which getaddrinfo already implements
+    if (cfg->search && name.find(':') == exlib::string::npos
+        && (name.empty() || name[name.length() - 1] != '.')) {
+        int32_t dots = 0;
+        size_t i;
+
+        for (i = 0; i < name.length(); i++)
+            if (name[i] == '.')
+                dots++;
+
+        if (dots < cfg->ndots) {
+            exlib::string host = lower_name(name);
+            return cfg->hosts[0].find(host) != cfg->hosts[0].end()
+                || cfg->hosts[1].find(host) != cfg->hosts[1].end();
+        }
+    }
+
+    return true;
+#endif
+}
+
+result_t Resolver::resolve(exlib::string name, int32_t family, Callback done, AsyncEvent* ac)
+{
+    std::shared_ptr<DnsConfig> cfg = get_config();
+    std::vector<exlib::string> addrs[2];
+    result_t hrs[2] = { 0, 0 };
+    bool need[2];
+    int32_t pending = 0;
+    int32_t i;
+    inetAddr addr_info;
+
+    addr_info.init(net_base::C_AF_INET);
+    if (addr_info.addr(name) < 0) {
+        addr_info.init(net_base::C_AF_INET6);
+        if (addr_info.addr(name) < 0)
+            addr_info.init(0);
+    }
+
+    if (addr_info.family()) {
+        if (family && family != addr_info.family())
+            return CHECK_ERROR(UV_EAI_NONAME);
+
+        addrs[0].push_back(addr_info.str());
+        done(addrs[0]);
+        return 0;
+    }
+
+    exlib::string host = lower_name(name);
+
+    need[0] = family != net_base::C_AF_INET6;
+    need[1] = family != net_base::C_AF_INET;
+
+    for (i = 0; i < 2; i++) {
+        if (need[i] && lookup_local(cfg.get(), host, i, addrs[i], hrs[i]))
+            need[i] = false;
+        if (need[i])
+            pending++;
+    }
+
+    if (pending == 0)
+        return merge(addrs, hrs, done);
+
+    DnsWaiter* w = new DnsWaiter(done, pending, ac);
+    for (i = 0; i < 2; i++) {
+        w->m_addrs[i] = addrs[i];
+        w->m_hrs[i] = hrs[i];
+    }
+
+    return uv_async([&] {
+        for (i = 0; i < 2; i++)
+            if (need[i])
+                query_start(cfg, host, i, w);
+        return 0;
+    });
+}
+
+void Resolver::clear()
+{
+    s_lock.lock();
+    s_cache.clear();
+    s_config.reset();
+    s_lock.unlock();
+}
+
+int32_t Resolver::entries()
+{
+    int32_t n;
+
+    s_lock.lock();
+    n = (int32_t)s_cache.size();
+    s_lock.unlock();
+
+    return n;
+}
+}
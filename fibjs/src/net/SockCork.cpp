@@ -0,0 +1,286 @@
+/*
+ * SockCork.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "SockCork.h"
+
+namespace fibjs {
+
+class asyncCorkFlush : public AsyncEvent {
+public:
+    asyncCorkFlush(SockCork* cork, int32_t bytes)
+        : m_cork(cork)
+        , m_owner(cork->m_owner)
+        , m_bytes(bytes)
+    {
+        setAsync();
+    }
+
+public:
+    virtual int32_t post(int32_t v)
+    {
+        std::vector<AsyncEvent*> waiters;
+        result_t hr = 0;
+        size_t i;
+
+        // the error goes to the flush calls waiting for this writev, or to the next write when there are none
+        m_cork->m_lock.lock();
+        m_cork->m_inflight -= m_bytes;
+        if (v < 0 && m_cork->m_error == 0)
+            m_cork->m_error = v;
+
+        if (m_cork->m_inflight == 0 && !m_cork->m_waiters.empty()) {
+            waiters.swap(m_cork->m_waiters);
+            hr = m_cork->m_error;
+            m_cork->m_error = 0;
+        }
+        m_cork->m_lock.unlock();
+
+        for (i = 0; i < waiters.size(); i++)
+            waiters[i]->post(hr);
+
+        delete this;
+        return 0;
+    }
+
+private:
+    SockCork* m_cork;
+    obj_ptr<object_base> m_owner;
+    int32_t m_bytes;
+};
+
+void SockCork::set_auto(bool newVal)
+{
+    m_lock.lock();
+    m_auto = newVal;
+    m_lock.unlock();
+}
+
+void SockCork::cork()
+{
+    m_lock.lock();
+    m_corked++;
+    m_lock.unlock();
+}
+
+void SockCork::uncork()
+{
+    bool sched = false;
+
+    m_lock.lock();
+    if (m_corked > 0)
+        m_corked--;
+    if (m_corked == 0 && !m_bufs.empty() && !m_scheduled)
+        sched = m_scheduled = true;
+    m_lock.unlock();
+
+    if (sched)
+        schedule();
+}
+
+result_t SockCork::write(Buffer_base* data, AsyncEvent* ac)
+{
+    std::vector<obj_ptr<Buffer_base>> datas;
+
+    datas.push_back(data);
+    return write(datas, ac);
+}
+
+result_t SockCork::write(std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac)
+{
+    std::vector<obj_ptr<Buffer_base>> bufs;
+    int32_t bytes = 0;
+    bool sched = false;
+    result_t hr;
+    size_t i;
+
+    for (i = 0; i < datas.size(); i++) {
+        int32_t len;
+
+        datas[i]->get_length(len);
+        bytes += len;
+    }
+
+    m_lock.lock();
+    if (m_error < 0) {
+        hr = m_error;
+        m_error = 0;
+        m_lock.unlock();
+        return CHECK_ERROR(hr);
+    }
+
+    // data still on its way to a slow peer counts too, so a writer that outruns the peer waits
+    if (m_bytes + m_inflight + bytes < CORK_MAX_BYTES) {
+        // the caller may reuse its buffer as soon as write returns
+        for (i = 0; i < datas.size(); i++) {
+            Buffer* buf = (Buffer*)(Buffer_base*)datas[i];
+            int32_t len;
+
+            buf->get_length(len);
+            m_bufs.push_back(new Buffer(buf->data(), len));
+        }
+
+        m_bytes += bytes;
+        if (m_corked == 0 && !m_scheduled)
+            sched = m_scheduled = true;
+        m_lock.unlock();
+
+        if (sched)
+            schedule();
+
+        return 0;
+    }
+
+    // too much pending data, send it now and let the writer wait like an uncorked write,
+    // the writev queues behind the background ones so it also waits for them
+    if (ac->isSync()) {
+        m_lock.unlock();
+        return CHECK_ERROR(CALL_E_NOSYNC);
+    }
+
+    bufs.swap(m_bufs);
+    bufs.insert(bufs.end(), datas.begin(), datas.end());
+    m_bytes = 0;
+    m_lock.unlock();
+
+    return m_writev(bufs, ac);
+}
+
+result_t SockCork::flush(AsyncEvent* ac)
+{
+    std::vector<obj_ptr<Buffer_base>> bufs;
+    result_t hr;
+
+    m_lock.lock();
+    if (m_error < 0) {
+        hr = m_error;
+        m_error = 0;
+        m_lock.unlock();
+        return CHECK_ERROR(hr);
+    }
+
+    if (m_bufs.empty() && m_inflight == 0) {
+        m_lock.unlock();
+        return 0;
+    }
+
+    if (ac->isSync()) {
+        m_lock.unlock();
+        return CHECK_ERROR(CALL_E_NOSYNC);
+    }
+
+    if (m_bufs.empty()) {
+        m_waiters.push_back(ac);
+        m_lock.unlock();
+        return CALL_E_PENDDING;
+    }
+
+    bufs.swap(m_bufs);
+    m_bytes = 0;
+    m_lock.unlock();
+
+    return m_writev(bufs, ac);
+}
+
+result_t SockCork::close(std::function<result_t(AsyncEvent*)> close, AsyncEvent* ac)
+{
+    class asyncClose : public AsyncState {
+    public:
+        asyncClose(SockCork* cork, std::function<result_t(AsyncEvent*)> close, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_cork(cork)
+            , m_close(close)
+            , m_hr(0)
+        {
+            next(flush);
+        }
+
+        ON_STATE(asyncClose, flush)
+        {
+            return m_cork->flush(next(close));
+        }
+
+        ON_STATE(asyncClose, close)
+        {
+            return m_close(next(done));
+        }
+
+        ON_STATE(asyncClose, done)
+        {
+            if (m_hr < 0)
+                return m_hr;
+            return next();
+        }
+
+        virtual int32_t error(int32_t v)
+        {
+            // the socket is closed anyway, a failed flush is reported once it is
+            if (at(flush)) {
+                m_hr = v;
+                return 0;
+            }
+            return v;
+        }
+
+    private:
+        SockCork* m_cork;
+        std::function<result_t(AsyncEvent*)> m_close;
+        result_t m_hr;
+    };
+
+    return (new asyncClose(this, close, ac))->post(0);
+}
+
+void SockCork::drain()
+{
+    std::vector<obj_ptr<Buffer_base>> bufs;
+    int32_t bytes;
+
+    m_lock.lock();
+    bufs.swap(m_bufs);
+    bytes = m_bytes;
+    m_inflight += bytes;
+    m_bytes = 0;
+    m_lock.unlock();
+
+    if (bufs.empty())
+        return;
+
+    asyncCorkFlush* ev = new asyncCorkFlush(this, bytes);
+    result_t hr = m_writev(bufs, ev);
+    if (hr != CALL_E_PENDDING)
+        ev->post(hr);
+}
+
+void SockCork::schedule()
+{
+    Isolate* isolate = m_owner->holder();
+
+    m_owner->Ref();
+    if (isolate)
+        syncCall(isolate, flush_job, this);
+    else
+        flush_job(this);
+}
+
+// runs as an isolate job, so every write the current fiber makes before it yields lands in one writev
+result_t SockCork::flush_job(SockCork* pThis)
+{
+    bool corked;
+
+    pThis->m_lock.lock();
+    pThis->m_scheduled = false;
+    corked = pThis->m_corked > 0;
+    pThis->m_lock.unlock();
+
+    if (!corked)
+        pThis->drain();
+
+    pThis->m_owner->Unref();
+    return 0;
+}
+}
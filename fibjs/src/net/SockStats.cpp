@@ -0,0 +1,52 @@
+/*
+ * SockStats.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "SockStats.h"
+
+namespace fibjs {
+
+SockStats::Counters SockStats::s_global;
+
+result_t SockStats::toJSON(Counters& c, v8::Local<v8::Object>& retVal)
+{
+    Isolate* isolate = Isolate::current();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+
+    int64_t queued = c.queued.load(std::memory_order_relaxed);
+    int64_t resumed = c.resumed.load(std::memory_order_relaxed);
+
+    o->Set(context, isolate->NewString("reads"),
+         v8::Number::New(isolate->m_isolate, (double)c.reads.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("writes"),
+         v8::Number::New(isolate->m_isolate, (double)c.writes.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("bytesIn"),
+         v8::Number::New(isolate->m_isolate, (double)c.bytesIn.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("bytesOut"),
+         v8::Number::New(isolate->m_isolate, (double)c.bytesOut.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("again"),
+         v8::Number::New(isolate->m_isolate, (double)c.again.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("queueTime"),
+         v8::Number::New(isolate->m_isolate,
+             queued ? (double)c.queueTime.load(std::memory_order_relaxed) / queued / 1000 : 0))
+        .IsJust();
+    o->Set(context, isolate->NewString("resumeTime"),
+         v8::Number::New(isolate->m_isolate,
+             resumed ? (double)c.resumeTime.load(std::memory_order_relaxed) / resumed / 1000 : 0))
+        .IsJust();
+
+    retVal = o;
+
+    return 0;
+}
+}
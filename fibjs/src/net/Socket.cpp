@@ -8,6 +8,7 @@
 #include "object.h"
 #include "ifs/io.h"
 #include "Socket.h"
+#include "Stream.h"
 #include "UVSocket.h"
 #include "Buffer.h"
 #include "Stat.h"
@@ -107,12 +108,79 @@ result_t Socket::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
 
 result_t Socket::write(Buffer_base* data, AsyncEvent* ac)
 {
+    if (m_cork.enabled())
+        return m_cork.write(data, ac);
+
     return m_aio.write(data, ac);
 }
 
+result_t Socket::writev(v8::Local<v8::Array> datas, AsyncEvent* ac)
+{
+    return stream_writev(this, datas, ac);
+}
+
+result_t Socket::writev(std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac)
+{
+    if (m_cork.enabled())
+        return m_cork.write(datas, ac);
+
+    return m_aio.writev(datas, ac);
+}
+
+#ifndef _WIN32
+result_t Socket::accept(std::vector<obj_ptr<Socket_base>>& retVal, int32_t budget, AsyncEvent* ac)
+{
+    return m_aio.accept(retVal, budget, ac);
+}
+
+result_t Socket::sendfile(int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal, AsyncEvent* ac)
+{
+    // the corked data has to be on the wire before the file, and its errors belong to this call
+    class asyncSendfile : public AsyncState {
+    public:
+        asyncSendfile(Socket* pThis, int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal,
+            AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_pThis(pThis)
+            , m_fd(fd)
+            , m_pos(pos)
+            , m_bytes(bytes)
+            , m_retVal(retVal)
+        {
+            next(flush);
+        }
+
+        ON_STATE(asyncSendfile, flush)
+        {
+            return m_pThis->m_cork.flush(next(send));
+        }
+
+        ON_STATE(asyncSendfile, send)
+        {
+            return m_pThis->m_aio.sendfile(m_fd, m_pos, m_bytes, m_retVal, next());
+        }
+
+    private:
+        obj_ptr<Socket> m_pThis;
+        int32_t m_fd;
+        int64_t m_pos;
+        int64_t m_bytes;
+        int64_t& m_retVal;
+    };
+
+    if (!m_cork.enabled())
+        return m_aio.sendfile(fd, pos, bytes, retVal, ac);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncSendfile(this, fd, pos, bytes, retVal, ac))->post(0);
+}
+#endif
+
 result_t Socket::flush(AsyncEvent* ac)
 {
-    return 0;
+    return m_cork.flush(ac);
 }
 
 result_t Socket::copyTo(Stream_base* stm, int64_t bytes,
@@ -132,6 +200,9 @@ result_t Socket::close(AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
+    if (m_cork.enabled())
+        return m_cork.close([this](AsyncEvent* ac) { return m_aio.close(ac); }, ac);
+
     return m_aio.close(ac);
 }
 
@@ -220,6 +291,18 @@ result_t Socket::set_timeout(int32_t newVal)
     return 0;
 }
 
+result_t Socket::get_autoCork(bool& retVal)
+{
+    retVal = m_cork.get_auto();
+    return 0;
+}
+
+result_t Socket::set_autoCork(bool newVal)
+{
+    m_cork.set_auto(newVal);
+    return 0;
+}
+
 result_t Socket::bind(exlib::string addr, int32_t port, bool allowIPv4)
 {
     if (m_aio.m_fd == INVALID_SOCKET)
@@ -237,6 +320,11 @@ result_t Socket::bind(exlib::string addr, int32_t port, bool allowIPv4)
     setsockopt(m_aio.m_fd, SOL_SOCKET, SO_REUSEADDR, (const char*)&on, sizeof(on));
 #endif
 
+#ifdef SO_REUSEPORT
+    if (g_reuse_port)
+        setsockopt(m_aio.m_fd, SOL_SOCKET, SO_REUSEPORT, (const char*)&on, sizeof(on));
+#endif
+
     if (m_aio.m_family == net_base::C_AF_INET6) {
         if (allowIPv4)
             on = 0;
@@ -301,7 +389,24 @@ result_t Socket::accept(obj_ptr<Socket_base>& retVal, AsyncEvent* ac)
 
 result_t Socket::send(Buffer_base* data, AsyncEvent* ac)
 {
-    return m_aio.write(data, ac);
+    return write(data, ac);
+}
+
+result_t Socket::cork()
+{
+    m_cork.cork();
+    return 0;
+}
+
+result_t Socket::uncork()
+{
+    m_cork.uncork();
+    return 0;
+}
+
+result_t Socket::stats(v8::Local<v8::Object>& retVal)
+{
+    return m_aio.m_stats.toJSON(retVal);
 }
 
 result_t Socket::recv(int32_t bytes, obj_ptr<Buffer_base>& retVal,
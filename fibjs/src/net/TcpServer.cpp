@@ -9,6 +9,7 @@
 #include "TcpServer.h"
 #include "ifs/mq.h"
 #include "ifs/console.h"
+#include "options.h"
 
 namespace fibjs {
 
@@ -132,6 +133,7 @@ result_t TcpServer::start()
         asyncAccept(TcpServer* pThis, ValueHolder* holder)
             : AsyncState(NULL)
             , m_pThis(pThis)
+            , m_native(NULL)
             , m_holder(holder)
         {
             m_pThis->isolate_ref();
@@ -141,6 +143,12 @@ result_t TcpServer::start()
     public:
         ON_STATE(asyncAccept, accept)
         {
+#ifndef _WIN32
+            m_native = dynamic_cast<Socket*>((Socket_base*)m_pThis->m_socket);
+            if (m_native)
+                return m_native->accept(m_accepts, g_accept_batch, next(invoke));
+#endif
+
             return m_pThis->m_socket->accept(m_accept, next(invoke));
         }
 
@@ -151,6 +159,16 @@ result_t TcpServer::start()
                 m_accept.Release();
             }
 
+            size_t i;
+            for (i = 0; i < m_accepts.size(); i++)
+                (new asyncInvoke(m_pThis, m_accepts[i], m_holder))->apost(0);
+            m_accepts.clear();
+
+#ifndef _WIN32
+            if (m_native)
+                return m_native->accept(m_accepts, g_accept_batch, this);
+#endif
+
             return m_pThis->m_socket->accept(m_accept, this);
         }
 
@@ -168,6 +186,8 @@ result_t TcpServer::start()
     private:
         obj_ptr<TcpServer> m_pThis;
         obj_ptr<Socket_base> m_accept;
+        std::vector<obj_ptr<Socket_base>> m_accepts;
+        Socket* m_native;
         obj_ptr<ValueHolder> m_holder;
     };
 
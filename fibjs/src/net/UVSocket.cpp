@@ -9,6 +9,7 @@
 #include "ifs/io.h"
 #include "UVSocket.h"
 #include "Buffer.h"
+#include "options.h"
 
 namespace fibjs {
 
@@ -24,6 +25,10 @@ result_t UVSocket::create(int32_t family, obj_ptr<Socket_base>& retVal)
     result_t hr = uv_call([&] {
         if (family == net_base::C_AF_UNIX)
             return uv_pipe_init(s_uv_loop, &sock->m_pipe, 0);
+#ifdef SO_REUSEPORT
+        else if (g_reuse_port)
+            return uv_tcp_init_ex(s_uv_loop, &sock->m_tcp, family == net_base::C_AF_INET6 ? AF_INET6 : AF_INET);
+#endif
         else
             return uv_tcp_init(s_uv_loop, &sock->m_tcp);
     });
@@ -35,11 +40,53 @@ result_t UVSocket::create(int32_t family, obj_ptr<Socket_base>& retVal)
     return 0;
 }
 
+result_t UVSocket::write(Buffer_base* data, AsyncEvent* ac)
+{
+    if (m_cork.enabled())
+        return m_cork.write(data, ac);
+
+    return UVStream_tmpl<Socket_base>::write(data, ac);
+}
+
+result_t UVSocket::flush(AsyncEvent* ac)
+{
+    return m_cork.flush(ac);
+}
+
+result_t UVSocket::writev(v8::Local<v8::Array> datas, AsyncEvent* ac)
+{
+    return stream_writev(this, datas, ac);
+}
+
+result_t UVSocket::writev(std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac)
+{
+    if (m_cork.enabled())
+        return m_cork.write(datas, ac);
+
+    return UVStream_tmpl<Socket_base>::writev(datas, ac);
+}
+
+result_t UVSocket::cork_write(std::vector<obj_ptr<Buffer_base>>& datas, AsyncEvent* ac)
+{
+    if (datas.size() == 1)
+        return UVStream_tmpl<Socket_base>::write(datas[0], ac);
+
+    return UVStream_tmpl<Socket_base>::writev(datas, ac);
+}
+
 result_t UVSocket::close(AsyncEvent* ac)
 {
     if (ac && ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
+    if (ac && m_cork.enabled())
+        return m_cork.close([this](AsyncEvent* ac) { return close_handle(ac); }, ac);
+
+    return close_handle(ac);
+}
+
+result_t UVSocket::close_handle(AsyncEvent* ac)
+{
     result_t hr = UVStream_tmpl<Socket_base>::close(ac);
 
     m_lock.lock();
@@ -132,6 +179,17 @@ result_t UVSocket::bind(exlib::string addr, int32_t port, bool allowIPv4)
         if (addr_info.addr(addr) < 0)
             return CHECK_ERROR(CALL_E_INVALIDARG);
 
+#ifdef SO_REUSEPORT
+        if (g_reuse_port) {
+            uv_os_fd_t fd;
+
+            if (uv_fileno(&m_handle, &fd) == 0) {
+                int32_t on = 1;
+                setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, (const char*)&on, sizeof(on));
+            }
+        }
+#endif
+
         return uv_tcp_bind(&m_tcp, (struct sockaddr*)&addr_info,
             m_family == net_base::C_AF_INET ? 0 : (allowIPv4 ? 0 : UV_TCP_IPV6ONLY));
     }
@@ -268,6 +326,30 @@ result_t UVSocket::send(Buffer_base* data, AsyncEvent* ac)
     return write(data, ac);
 }
 
+result_t UVSocket::get_autoCork(bool& retVal)
+{
+    retVal = m_cork.get_auto();
+    return 0;
+}
+
+result_t UVSocket::set_autoCork(bool newVal)
+{
+    m_cork.set_auto(newVal);
+    return 0;
+}
+
+result_t UVSocket::cork()
+{
+    m_cork.cork();
+    return 0;
+}
+
+result_t UVSocket::uncork()
+{
+    m_cork.uncork();
+    return 0;
+}
+
 result_t UVSocket::recv(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
 {
     if (ac->isSync())
@@ -276,4 +358,9 @@ result_t UVSocket::recv(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent*
     uv_post(new AsyncRead(this, false, bytes, retVal, ac));
     return CALL_E_PENDDING;
 }
+
+result_t UVSocket::stats(v8::Local<v8::Object>& retVal)
+{
+    return m_sockStats.toJSON(retVal);
+}
 }
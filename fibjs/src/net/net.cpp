@@ -11,6 +11,8 @@
 #include "ifs/os.h"
 #include "Socket.h"
 #include "inetAddr.h"
+#include "RecvBuffer.h"
+#include "Resolver.h"
 #include "Smtp.h"
 #include "Url.h"
 #include "options.h"
@@ -23,10 +25,32 @@ namespace fibjs {
 
 DECLARE_MODULE(dns);
 
+// decided once in the sync phase and kept in the call context for the async phase
+static bool use_resolver(exlib::string& name, AsyncEvent* ac)
+{
+    if (ac->m_ctx.empty()) {
+        ac->m_ctx.resize(1);
+        ac->m_ctx[0] = Resolver::enabled(name);
+    }
+
+    return ac->m_ctx[0].boolVal();
+}
+
 result_t dns_base::resolve(exlib::string name, obj_ptr<NArray>& retVal, AsyncEvent* ac)
 {
     if (ac->isSync())
-        return CHECK_ERROR(CALL_E_LONGSYNC);
+        return CHECK_ERROR(use_resolver(name, ac) ? CALL_E_NOSYNC : CALL_E_LONGSYNC);
+
+    if (use_resolver(name, ac))
+        return Resolver::resolve(name, 0, [&retVal](std::vector<exlib::string>& addrs) {
+            obj_ptr<NArray> arr = new NArray();
+            size_t i;
+
+            for (i = 0; i < addrs.size(); i++)
+                arr->append(addrs[i]);
+            retVal = arr;
+        },
+            ac);
 
     addrinfo hints = { 0, AF_UNSPEC, SOCK_STREAM, IPPROTO_TCP, 0, 0, 0, 0 };
     addrinfo* result = NULL;
@@ -53,7 +77,13 @@ result_t dns_base::resolve(exlib::string name, obj_ptr<NArray>& retVal, AsyncEve
 result_t dns_base::lookup(exlib::string name, exlib::string& retVal, AsyncEvent* ac)
 {
     if (ac->isSync())
-        return CHECK_ERROR(CALL_E_LONGSYNC);
+        return CHECK_ERROR(use_resolver(name, ac) ? CALL_E_NOSYNC : CALL_E_LONGSYNC);
+
+    if (use_resolver(name, ac))
+        return Resolver::resolve(name, 0, [&retVal](std::vector<exlib::string>& addrs) {
+            retVal = addrs[0];
+        },
+            ac);
 
     addrinfo hints = { 0, AF_UNSPEC, SOCK_STREAM, IPPROTO_TCP, 0, 0, 0, 0 };
     addrinfo* result = NULL;
@@ -75,6 +105,50 @@ result_t dns_base::lookup(exlib::string name, exlib::string& retVal, AsyncEvent*
     return 0;
 }
 
+result_t dns_base::stats(v8::Local<v8::Object>& retVal)
+{
+    Isolate* isolate = Isolate::current();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+    Resolver::Stats& stats = Resolver::s_stats;
+
+    o->Set(context, isolate->NewString("hits"),
+         v8::Number::New(isolate->m_isolate, (double)stats.hits.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("misses"),
+         v8::Number::New(isolate->m_isolate, (double)stats.misses.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("negative"),
+         v8::Number::New(isolate->m_isolate, (double)stats.negative.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("coalesced"),
+         v8::Number::New(isolate->m_isolate, (double)stats.coalesced.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("queries"),
+         v8::Number::New(isolate->m_isolate, (double)stats.queries.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("retries"),
+         v8::Number::New(isolate->m_isolate, (double)stats.retries.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("timeouts"),
+         v8::Number::New(isolate->m_isolate, (double)stats.timeouts.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("tcp"),
+         v8::Number::New(isolate->m_isolate, (double)stats.tcp.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("entries"), v8::Number::New(isolate->m_isolate, Resolver::entries())).IsJust();
+
+    retVal = o;
+
+    return 0;
+}
+
+result_t dns_base::clearCache()
+{
+    Resolver::clear();
+    return 0;
+}
+
 DECLARE_MODULE(net);
 
 result_t net_base::get_use_uv_socket(bool& retVal)
@@ -89,11 +163,96 @@ result_t net_base::set_use_uv_socket(bool newVal)
     return 0;
 }
 
+result_t net_base::get_reuse_port(bool& retVal)
+{
+    retVal = g_reuse_port;
+    return 0;
+}
+
+result_t net_base::set_reuse_port(bool newVal)
+{
+    g_reuse_port = newVal;
+    return 0;
+}
+
+result_t net_base::get_accept_batch(int32_t& retVal)
+{
+    retVal = g_accept_batch;
+    return 0;
+}
+
+result_t net_base::set_accept_batch(int32_t newVal)
+{
+    if (newVal < 1 || newVal > 1024)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    g_accept_batch = newVal;
+    return 0;
+}
+
 result_t net_base::info(v8::Local<v8::Object>& retVal)
 {
     return os_base::networkInterfaces(retVal);
 }
 
+result_t net_base::recvStats(v8::Local<v8::Object>& retVal)
+{
+    Isolate* isolate = Isolate::current();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+    RecvBuffer::Stats& stats = RecvBuffer::s_stats;
+
+    int64_t recvs = stats.recvs.load(std::memory_order_relaxed);
+    int64_t bytes = stats.bytes.load(std::memory_order_relaxed);
+
+    o->Set(context, isolate->NewString("allocs"),
+         v8::Number::New(isolate->m_isolate, (double)stats.allocs.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("recycled"),
+         v8::Number::New(isolate->m_isolate, (double)stats.recycled.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("pooled"),
+         v8::Number::New(isolate->m_isolate, (double)stats.pooled.load(std::memory_order_relaxed)))
+        .IsJust();
+    o->Set(context, isolate->NewString("recvs"), v8::Number::New(isolate->m_isolate, (double)recvs)).IsJust();
+    o->Set(context, isolate->NewString("bytes"), v8::Number::New(isolate->m_isolate, (double)bytes)).IsJust();
+    o->Set(context, isolate->NewString("avgRecvBytes"),
+         v8::Number::New(isolate->m_isolate, recvs ? (double)(bytes / recvs) : 0))
+        .IsJust();
+
+    retVal = o;
+
+    return 0;
+}
+
+result_t net_base::acceptStats(v8::Local<v8::Object>& retVal)
+{
+    Isolate* isolate = Isolate::current();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+
+    int64_t batches = g_accept_stats.batches.load(std::memory_order_relaxed);
+    int64_t accepted = g_accept_stats.accepted.load(std::memory_order_relaxed);
+
+    o->Set(context, isolate->NewString("batches"), v8::Number::New(isolate->m_isolate, (double)batches)).IsJust();
+    o->Set(context, isolate->NewString("accepted"), v8::Number::New(isolate->m_isolate, (double)accepted)).IsJust();
+    o->Set(context, isolate->NewString("avgBatch"),
+         v8::Number::New(isolate->m_isolate, batches ? (double)accepted / batches : 0))
+        .IsJust();
+    o->Set(context, isolate->NewString("maxBatch"),
+         v8::Number::New(isolate->m_isolate, (double)g_accept_stats.max.load(std::memory_order_relaxed)))
+        .IsJust();
+
+    retVal = o;
+
+    return 0;
+}
+
+result_t net_base::ioStats(v8::Local<v8::Object>& retVal)
+{
+    return SockStats::toJSON(SockStats::s_global, retVal);
+}
+
 result_t net_base::resolve(exlib::string name, int32_t family,
     exlib::string& retVal, AsyncEvent* ac)
 {
@@ -101,7 +260,13 @@ result_t net_base::resolve(exlib::string name, int32_t family,
         return CHECK_ERROR(CALL_E_INVALIDARG);
 
     if (ac->isSync())
-        return CHECK_ERROR(CALL_E_LONGSYNC);
+        return CHECK_ERROR(use_resolver(name, ac) ? CALL_E_NOSYNC : CALL_E_LONGSYNC);
+
+    if (use_resolver(name, ac))
+        return Resolver::resolve(name, family, [&retVal](std::vector<exlib::string>& addrs) {
+            retVal = addrs[0];
+        },
+            ac);
 
     inetAddr addr_info;
 
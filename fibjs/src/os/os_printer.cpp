@@ -11,6 +11,7 @@
 #ifdef _WIN32
 
 #include "BufferedStream.h"
+#include "Stream.h"
 
 namespace fibjs {
 
@@ -126,6 +127,11 @@ result_t os_base::openPrinter(exlib::string name, obj_ptr<BufferedStream_base>&
             return 0;
         }
 
+        result_t writev(v8::Local<v8::Array> datas, AsyncEvent* ac)
+        {
+            return stream_writev(this, datas, ac);
+        }
+
         result_t flush(AsyncEvent* ac)
         {
             return 0;
@@ -18,6 +18,7 @@
 #include "ChildProcess.h"
 #include <vector>
 #include "options.h"
+#include "SlabAllocator.h"
 
 #ifdef _WIN32
 #include <psapi.h>
@@ -362,6 +363,23 @@ result_t process_base::memoryUsage(v8::Local<v8::Object>& retVal)
     info->Set(context, isolate->NewString("ExtStrings"),
         v8::Number::New(isolate->m_isolate, (double)g_ExtStringCount.value())).IsJust();
 
+    v8::Local<v8::Object> slab = v8::Object::New(isolate->m_isolate);
+    SlabAllocator::Stats& stats = SlabAllocator::s_stats;
+
+    slab->Set(context, isolate->NewString("reserved"),
+        v8::Number::New(isolate->m_isolate, (double)stats.reserved.load(std::memory_order_relaxed))).IsJust();
+    slab->Set(context, isolate->NewString("used"),
+        v8::Number::New(isolate->m_isolate, (double)stats.used.load(std::memory_order_relaxed))).IsJust();
+    slab->Set(context, isolate->NewString("allocs"),
+        v8::Number::New(isolate->m_isolate, (double)stats.allocs.load(std::memory_order_relaxed))).IsJust();
+    slab->Set(context, isolate->NewString("frees"),
+        v8::Number::New(isolate->m_isolate, (double)stats.frees.load(std::memory_order_relaxed))).IsJust();
+    slab->Set(context, isolate->NewString("hits"),
+        v8::Number::New(isolate->m_isolate, (double)stats.hits.load(std::memory_order_relaxed))).IsJust();
+    slab->Set(context, isolate->NewString("released"),
+        v8::Number::New(isolate->m_isolate, (double)stats.released.load(std::memory_order_relaxed))).IsJust();
+    info->Set(context, isolate->NewString("slab"), slab).IsJust();
+
     retVal = info;
 
     return 0;
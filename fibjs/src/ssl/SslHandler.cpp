@@ -8,6 +8,7 @@
 #include "object.h"
 #include "ifs/mq.h"
 #include "SslHandler.h"
+#include "ifs/HttpHandler.h"
 
 namespace fibjs {
 
@@ -46,27 +47,23 @@ result_t SslHandler::init(v8::Local<v8::Array> certs, Handler_base* hdlr)
 {
     result_t hr;
 
-    set_handler(hdlr);
-
     hr = SslSocket_base::_new(certs, m_socket);
     if (hr < 0)
         return hr;
 
     m_socket->set_verification(ssl_base::C_VERIFY_NONE);
-    return 0;
+    return set_handler(hdlr);
 }
 result_t SslHandler::init(X509Cert_base* crt, PKey_base* key, Handler_base* hdlr)
 {
     result_t hr;
 
-    set_handler(hdlr);
-
     hr = SslSocket_base::_new(crt, key, m_socket);
     if (hr < 0)
         return hr;
 
     m_socket->set_verification(ssl_base::C_VERIFY_NONE);
-    return 0;
+    return set_handler(hdlr);
 }
 
 result_t SslHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
@@ -144,6 +141,20 @@ result_t SslHandler::set_handler(Handler_base* newVal)
     SetPrivate("handler", newVal->wrap());
     m_hdlr = newVal;
 
+    update_alpn();
     return 0;
 }
+
+void SslHandler::update_alpn()
+{
+    // offer h2 only when the connection ends up in an HttpHandler that speaks it, the list is
+    // picked here rather than per connection because accepts read it concurrently
+    static const char* s_alpn_h2[] = { "h2", "http/1.1", NULL };
+    obj_ptr<HttpHandler_base> http = HttpHandler_base::getInstance(m_hdlr);
+    bool h2 = false;
+
+    if (http)
+        http->get_enableHttp2(h2);
+    ((SslSocket*)(SslSocket_base*)m_socket)->m_alpn = h2 ? s_alpn_h2 : NULL;
+}
 }
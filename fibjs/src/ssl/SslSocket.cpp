@@ -9,6 +9,7 @@
 #include "ifs/io.h"
 #include "ifs/console.h"
 #include "SslSocket.h"
+#include "Stream.h"
 #include "PKey.h"
 #include <string.h>
 #include "options.h"
@@ -81,6 +82,7 @@ SslSocket::SslSocket()
     mbedtls_ssl_conf_rng(&m_ssl_conf, mbedtls_ctr_drbg_random, &g_ssl.ctr_drbg);
 
     m_recv_pos = 0;
+    m_alpn = NULL;
 }
 
 SslSocket::~SslSocket()
@@ -277,6 +279,11 @@ result_t SslSocket::write(Buffer_base* data, AsyncEvent* ac)
     return (new asyncWrite(this, data, ac))->post(0);
 }
 
+result_t SslSocket::writev(v8::Local<v8::Array> datas, AsyncEvent* ac)
+{
+    return stream_writev(this, datas, ac);
+}
+
 result_t SslSocket::flush(AsyncEvent* ac)
 {
     return 0;
@@ -436,6 +443,12 @@ result_t SslSocket::connect(Stream_base* s, exlib::string server_name,
 
     mbedtls_ssl_conf_ca_chain(&m_ssl_conf, &m_ca->m_crt, NULL);
 
+    if (m_alpn) {
+        ret = mbedtls_ssl_conf_alpn_protocols(&m_ssl_conf, m_alpn);
+        if (ret != 0)
+            return CHECK_ERROR(_ssl::setError(ret));
+    }
+
     ret = mbedtls_ssl_setup(&m_ssl, &m_ssl_conf);
     if (ret != 0)
         return CHECK_ERROR(_ssl::setError(ret));
@@ -519,6 +532,12 @@ result_t SslSocket::accept(Stream_base* s, obj_ptr<SslSocket_base>& retVal,
     mbedtls_ssl_conf_session_cache(&ss->m_ssl_conf, &g_ssl.m_cache,
         mbedtls_ssl_cache_get, mbedtls_ssl_cache_set);
 
+    if (m_alpn) {
+        ret = mbedtls_ssl_conf_alpn_protocols(&ss->m_ssl_conf, m_alpn);
+        if (ret != 0)
+            return CHECK_ERROR(_ssl::setError(ret));
+    }
+
     ret = mbedtls_ssl_setup(&ss->m_ssl, &ss->m_ssl_conf);
     if (ret != 0)
         return CHECK_ERROR(_ssl::setError(ret));
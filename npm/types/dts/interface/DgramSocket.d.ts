@@ -32,6 +32,11 @@
  *     - family: string，地址类型 ('IPv4' or 'IPv6')
  *     - port: number，发送者端口
  *     - size: number，消息大小
+ * 
+ *  ### messages 事件
+ *  ** 使用 `batch` 选项创建的 `socket` 不再触发 `message` 事件，而是每次唤醒时将本次收到的全部数据包通过 `messages` 事件一次交付。在支持 recvmmsg 的系统上，一次系统调用可以收取多个数据包。 **
+ *  - msgs: Buffer[]，消息数组
+ *  - rinfos: Object[]，与 msgs 一一对应的远程地址信息数组，格式与 `message` 事件的 rinfo 相同
  *  
  */
 declare class Class_DgramSocket extends Class_EventEmitter {
@@ -80,6 +85,20 @@ declare class Class_DgramSocket extends Class_EventEmitter {
 
     send(msg: Class_Buffer, offset: number, length: number, port: number, address?: string, callback?: (err: Error | undefined | null, retVal: number)=>any): void;
 
+    /**
+     * @description 在 socket 上批量发送一组数据包
+     * 
+     *      linux 下使用 sendmmsg 在一次系统调用中发送多个数据包，当所有数据包尺寸相同时使用 UDP_SEGMENT 由内核分段发送。其它系统逐个发送。
+     *      @param msgs 指定发送的数据包数组
+     *      @param port 指定发送的目的端口
+     *      @param address 指定发送的目的地址
+     *      @return 返回成功发送的数据包数量
+     *     
+     */
+    sendBatch(msgs: any[], port: number, address?: string): number;
+
+    sendBatch(msgs: any[], port: number, address?: string, callback?: (err: Error | undefined | null, retVal: number)=>any): void;
+
     /**
      * @description 返回一个包含 socket 地址信息的对象。对于 UDP socket，该对象将包含 address、family 和 port 属性。 
      *      @return 返回对象绑定地址
@@ -98,6 +98,15 @@ declare class Class_HttpClient extends Class_object {
      */
     poolTimeout: number;
 
+    /**
+     * @description 查询和设置每个目标主机允许同时使用的最大连接数，缺省为 0，表示不限制
+     * 
+     *      连接数包括正在使用和正在建立的连接，不包括 keep-alive 缓存中空闲的连接。达到上限后，新的请求将排队等待，
+     *      直到同一主机有连接归还或关闭，设置了 timeout 时等待超过 timeout 的请求将以超时失败。经 http_proxy 转发的 http 请求按目标主机计数。
+     *      
+     */
+    maxConnsPerHost: number;
+
     /**
      * @description 查询和设置 http 请求代理，支持 http/https/socks5 代理 
      */
@@ -113,6 +122,27 @@ declare class Class_HttpClient extends Class_object {
      */
     sslVerification: number;
 
+    /**
+     * @description 查询和设置 https 请求是否通过 ALPN 协商使用 HTTP/2，默认为 false
+     * 
+     *      启用后，同一个源的并发请求将作为多个流共享同一个 HTTP/2 连接，服务器不支持 HTTP/2 时自动使用 HTTP/1.1。经由代理的请求始终使用 HTTP/1.1
+     *     
+     */
+    enableHttp2: boolean;
+
+    /**
+     * @description 查询和设置 http 请求是否直接使用明文 HTTP/2(h2c)，默认为 false
+     * 
+     *      h2c 不经过协商，直接发送 HTTP/2 连接序言，仅应在确认服务器支持时启用
+     *     
+     */
+    enableH2c: boolean;
+
+    /**
+     * @description 查询和设置每个 HTTP/2 连接上同时进行的请求数上限，默认为 100，超出时将建立新的连接 
+     */
+    maxConcurrentStreams: number;
+
     /**
      * @description 设定缺省客户端证书
      *     @param crt 证书，用于发送给服务器验证客户端
@@ -121,6 +151,32 @@ declare class Class_HttpClient extends Class_object {
      */
     setClientCert(crt: Class_X509Cert, key: Class_PKey): void;
 
+    /**
+     * @description 查询 keep-alive 连接池的统计信息
+     * 
+     *      返回结果示例：
+     *      ```JavaScript
+     *      {
+     *        "hits": 120,
+     *        "misses": 8,
+     *        "waits": 2,
+     *        "evictions": 5,
+     *        "idle": 3,
+     *        "active": 1
+     *      }
+     *      ```
+     *      其中：
+     *      - hits 复用缓存连接的次数
+     *      - misses 未命中缓存而新建连接的次数
+     *      - waits 因达到 maxConnsPerHost 而排队等待的次数
+     *      - evictions 因超出 poolSize 或超过 poolTimeout 而被丢弃的空闲连接数
+     *      - idle 当前缓存的空闲连接数
+     *      - active 当前正在使用的连接数
+     *      @return 返回连接池统计信息
+     *     
+     */
+    poolStats(): FIBJS.GeneralObject;
+
     /**
      * @description 发送 http 请求到指定的流对象，并返回结果
      *      @param conn 指定处理请求的流对象
@@ -61,5 +61,92 @@ declare class Class_HttpRepeater extends Class_Handler {
      */
     readonly client: Class_HttpClient;
 
+    /**
+     * @description 查询和设置后端选择策略，默认为 "round-robin"
+     * 
+     *      可选的策略有：
+     *      - round-robin: 依次轮流选择后端
+     *      - least-request: 选择当前未完成请求最少的后端
+     *      - peak-ewma: 选择峰值指数加权平均延迟与未完成请求数乘积最小的后端，适合后端性能差异较大的场景
+     *      - hash: 按 hashHeader 指定的请求头做一致性哈希，同一个值总是转发到同一个后端，请求头不存在时按 round-robin 选择
+     *     
+     */
+    strategy: string;
+
+    /**
+     * @description 查询和设置 hash 策略使用的请求头名称 
+     */
+    hashHeader: string;
+
+    /**
+     * @description 查询和设置后端连续失败多少次后暂时移出选择范围，0 表示不移出，默认为 5
+     * 
+     *      转发出错或者后端返回 5xx 都被视为失败，所有后端都被移出时仍会从中选择
+     *     
+     */
+    maxFails: number;
+
+    /**
+     * @description 查询和设置后端被移出的时长，单位为毫秒，默认为 30000 
+     */
+    ejectTime: number;
+
+    /**
+     * @description 查询和设置转发失败后换一个后端重试的次数，默认为 1
+     * 
+     *      只有未收到任何响应的请求会被重试，POST 等非幂等请求只在连接后端失败、请求尚未发出时重试
+     *     
+     */
+    retries: number;
+
+    /**
+     * @description 查询和设置重试预算，即每个请求为重试积累的额度，默认为 0.2
+     * 
+     *      每次重试消耗 1 个额度，额度最多积累 10 个，以此限制后端故障时重试造成的额外负载
+     *     
+     */
+    retryBudget: number;
+
+    /**
+     * @description 查询和设置健康检查的路径，设置后将在后台定期请求每个后端的这个路径，空字符串表示关闭，默认为空
+     * 
+     *      响应码不是 2xx 或 3xx 的后端将被移出，直到下一次检查通过
+     *     
+     */
+    healthCheck: string;
+
+    /**
+     * @description 查询和设置健康检查的间隔，单位为毫秒，默认为 5000 
+     */
+    healthInterval: number;
+
+    /**
+     * @description 查询转发的统计信息
+     * 
+     *      返回结果示例：
+     *      ```JavaScript
+     *      {
+     *          "retries": 2,
+     *          "budget": 10,
+     *          "upstreams": [
+     *              {
+     *                  "url": "http://server1.example.com/",
+     *                  "requests": 100,
+     *                  "errors": 1,
+     *                  "outstanding": 3,
+     *                  "latency": 12.5,
+     *                  "ejections": 0,
+     *                  "ejected": false,
+     *                  "healthy": true
+     *              }
+     *          ]
+     *      }
+     *      ```
+     *      其中 latency 为峰值指数加权平均延迟，单位为毫秒
+     *      @return 返回统计信息
+     *     
+     */
+    stats(): FIBJS.GeneralObject;
+
 }
 
@@ -67,5 +67,23 @@ declare class Class_HttpRequest extends Class_HttpMessage {
      */
     readonly query: Class_HttpCollection;
 
+    /**
+     * @description 以流的方式解析消息中的 form，并替换 form 属性的内容
+     * 
+     *      multipart/form-data 消息体分块读取，不会整体读入内存，超过 threshold 的上传文件将写入临时文件。opts 支持的选项如下：
+     *      ```JavaScript
+     *      {
+     *          "threshold": 1048576, // 上传文件在内存中保留的最大字节数，超出后写入临时文件，-1 表示始终保留在内存中
+     *          "onField": (name, value) => {}, // 每解析完成一个普通字段时调用
+     *          "onFile": (name, file) => {} // 每开始一个上传文件时调用，file 为 HttpUploadData，可返回一个 Stream 用于接收文件内容
+     *      }
+     *      ```
+     *      onFile 返回 Stream 时，文件内容将写入该 Stream，若其为 SeekableStream 则同时作为 file.body，否则 file.body 为 null
+     *      @param opts 指定解析选项
+     *      @return 返回包含消息 form 的容器
+     *     
+     */
+    parseForm(opts?: FIBJS.GeneralObject): Class_HttpCollection;
+
 }
 
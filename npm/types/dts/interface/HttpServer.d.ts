@@ -69,10 +69,39 @@ declare class Class_HttpServer extends Class_TcpServer {
     maxBodySize: number;
 
     /**
-     * @description 自动解压缩功能开关，默认关闭 
+     * @description 自动解压缩功能开关，默认关闭
+     *      打开后按 Accept-Encoding 中的 q 值协商 gzip 或 deflate，HTTP/1.1 响应以 chunked 方式边压缩边发送
+     *      
      */
     enableEncoding: boolean;
 
+    /**
+     * @description 查询和设置响应压缩级别，取值范围为 -1 到 9，缺省为 -1，即 zlib 的默认级别 
+     */
+    encodingLevel: number;
+
+    /**
+     * @description 查询和设置响应压缩的 body 尺寸下限，以字节为单位，缺省为 128
+     *      body 不超过此尺寸的响应不做压缩
+     *      
+     */
+    encodingThreshold: number;
+
+    /**
+     * @description HTTP/2 支持开关，默认关闭
+     *      打开后，以 "PRI * HTTP/2.0" 开头的连接（prior knowledge）和携带 "Upgrade: h2c" 的请求将切换到 HTTP/2，
+     *      HttpsServer 还会通过 ALPN 协商 h2。每个 stream 作为独立的 HttpRequest 并发交给 handler 处理
+     *      
+     */
+    enableHttp2: boolean;
+
+    /**
+     * @description 查询和设置 HTTP/1.1 管线化深度，缺省为 8
+     *      handler 处理当前请求时，最多预先读取并解析 maxPipeline 个后续请求，预读请求的 body 累计超过 4MB 时暂停预读，响应仍按请求顺序依次发送。设置为 0 关闭预读
+     *      
+     */
+    maxPipeline: number;
+
     /**
      * @description 查询和设置服务器名称，缺省为：fibjs/0.x.0 
      */
@@ -21,7 +21,7 @@ declare class Class_HttpUploadData extends Class_object {
     readonly contentTransferEncoding: string;
 
     /**
-     * @description 包含本条目数据部分的流对象 
+     * @description 包含本条目数据部分的流对象，parseForm 的 onFile 返回的 Stream 不是 SeekableStream 时为 null 
      */
     readonly body: Class_SeekableStream;
 
@@ -48,6 +48,14 @@ declare class Class_Socket extends Class_Stream {
      */
     timeout: number;
 
+    /**
+     * @description 查询和设置是否自动合并小块写入，缺省为 false
+     * 
+     *      开启后，同一个 fiber 在让出执行权之前发出的 write 和 send 会被缓存，并在 fiber 让出时通过一次 writev 发出，减少小包和系统调用。写入的数据会被复制，调用返回后即可重用缓冲区；后台发送的错误将在下一次 write、flush 或 close 时抛出。缓存超过 64K 时立即发送，flush 和 close 会先发出缓存的数据。
+     *      
+     */
+    autoCork: boolean;
+
     /**
      * @description 建立一个 tcp 连接
      *      @param host 指定对方地址或主机名，也可以指向 unix socket 和 Windows pipe 路径
@@ -110,5 +118,48 @@ declare class Class_Socket extends Class_Stream {
 
     send(data: Class_Buffer, callback: (err: Error | undefined | null)=>any): void;
 
+    /**
+     * @description 暂停发送，之后的写入都将被缓存，直到对应的 uncork 被调用
+     * 
+     *      cork 可以嵌套调用，需要调用同样次数的 uncork 才会恢复发送。缓存超过 64K 时仍会立即发送。
+     *      
+     */
+    cork(): void;
+
+    /**
+     * @description 恢复发送，缓存的数据将在当前 fiber 让出执行权时通过一次 writev 发出，如需立即发送并等待完成，请调用 flush 
+     */
+    uncork(): void;
+
+    /**
+     * @description 查询当前 Socket 对象的 I/O 统计信息
+     * 
+     *      返回结果示例：
+     *      ```JavaScript
+     *      {
+     *        "reads": 12,
+     *        "writes": 10,
+     *        "bytesIn": 4096,
+     *        "bytesOut": 20480,
+     *        "again": 3,
+     *        "queueTime": 8.5,
+     *        "resumeTime": 21.2
+     *      }
+     *      ```
+     *      其中：
+     *      - reads 完成的读取系统调用次数
+     *      - writes 完成的写入系统调用次数
+     *      - bytesIn 累计读取的字节数
+     *      - bytesOut 累计写入的字节数
+     *      - again 因 EAGAIN 而等待 socket 就绪的次数
+     *      - queueTime 请求在事件循环队列中的平均等待时间，单位微秒
+     *      - resumeTime 从 socket 就绪到结果交还给等待的 fiber 的平均时间，单位微秒
+     * 
+     *      统计使用无锁计数器，可以在生产环境中始终开启。uv socket 不统计 again 和 resumeTime。
+     *      @return 返回 I/O 统计信息
+     *     
+     */
+    stats(): FIBJS.GeneralObject;
+
 }
 
@@ -31,6 +31,15 @@ declare class Class_Stream extends Class_object {
 
     write(data: Class_Buffer, callback: (err: Error | undefined | null)=>any): void;
 
+    /**
+     * @description 将给定的一组数据依次写入流，Socket 与 libuv 流（use_uv_socket 创建的 Socket、管道等）将使用系统的聚集写入一次完成，不再合并数据，其它流（如 SslSocket）将数据合并后一次写入
+     *      @param datas 给定要写入的数据数组，数组成员为 Buffer
+     *      
+     */
+    writev(datas: any[]): void;
+
+    writev(datas: any[], callback: (err: Error | undefined | null)=>any): void;
+
     /**
      * @description 将文件缓冲区内容写入物理设备 
      */
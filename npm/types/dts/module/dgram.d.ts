@@ -54,7 +54,8 @@ declare module 'dgram' {
      *          "reuseAddr": true | false, // reuse address, default is false
      *          "ipv6Only": true | false, // only accept IPv6 packets, default is false
      *          "recvBufferSize": 1024,     // specify the size of the receive buffer
-     *          "sendBufferSize": 1024      // specify the size of the send buffer
+     *          "sendBufferSize": 1024,     // specify the size of the send buffer
+     *          "batch": true | false       // deliver datagrams in batches with the 'messages' event, default is false
      *      }
      *      ```
      *      @param opts
@@ -73,7 +74,8 @@ declare module 'dgram' {
      *          "reuseAddr": true | false, // reuse address, default is false
      *          "ipv6Only": true | false, // only accept IPv6 packets, default is false
      *          "recvBufferSize": 1024,     // specify the size of the receive buffer
-     *          "sendBufferSize": 1024      // specify the size of the send buffer
+     *          "sendBufferSize": 1024,     // specify the size of the send buffer
+     *          "batch": true | false       // deliver datagrams in batches with the 'messages' event, default is false
      *      }
      *      ```
      *      @param opts
@@ -29,5 +29,44 @@ declare module 'dns' {
 
     function lookup(name: string, callback: (err: Error | undefined | null, retVal: string)=>any): void;
 
+    /**
+     * @description 查询内置解析器的缓存统计信息
+     * 
+     *      在配置了 /etc/resolv.conf 的系统上，dns 与 net 模块直接向名称服务器发送查询，不再占用工作线程。查询结果按照记录的 TTL 缓存，不存在的域名同样会被缓存，同一域名的并发查询只会发出一次请求。
+     * 
+     *      返回结果示例：
+     *      ```JavaScript
+     *      {
+     *        "hits": 1024,
+     *        "misses": 16,
+     *        "negative": 2,
+     *        "coalesced": 8,
+     *        "queries": 18,
+     *        "retries": 1,
+     *        "timeouts": 0,
+     *        "tcp": 0,
+     *        "entries": 12
+     *      }
+     *      ```
+     *      其中：
+     *      - hits 命中缓存的查询次数，包括 hosts 文件
+     *      - misses 需要查询名称服务器的次数
+     *      - negative 命中不存在记录缓存的次数
+     *      - coalesced 合并到进行中请求的查询次数
+     *      - queries 发送到名称服务器的请求数量
+     *      - retries 超时或服务器失败后的重试次数
+     *      - timeouts 最终超时的查询数量
+     *      - tcp 因应答被截断而改用 TCP 的查询数量
+     *      - entries 当前缓存的记录数量
+     *      @return 返回解析器统计信息
+     *      
+     */
+    function stats(): FIBJS.GeneralObject;
+
+    /**
+     * @description 清空内置解析器的缓存，并在下次查询时重新读取 /etc/resolv.conf 和 /etc/hosts 
+     */
+    function clearCache(): void;
+
 }
 
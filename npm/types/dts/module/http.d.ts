@@ -136,6 +136,15 @@ declare module 'http' {
      */
     var poolTimeout: number;
 
+    /**
+     * @description 查询和设置每个目标主机允许同时使用的最大连接数，缺省为 0，表示不限制
+     * 
+     *      连接数包括正在使用和正在建立的连接，不包括 keep-alive 缓存中空闲的连接。达到上限后，新的请求将排队等待，
+     *      直到同一主机有连接归还或关闭，设置了 timeout 时等待超过 timeout 的请求将以超时失败。经 http_proxy 转发的 http 请求按目标主机计数。
+     *      
+     */
+    var maxConnsPerHost: number;
+
     /**
      * @description 查询和设置 http 请求代理，支持 http/https/socks5 代理 
      */
@@ -167,6 +176,32 @@ declare module 'http' {
      */
     function setClientCert(crt: Class_X509Cert, key: Class_PKey): void;
 
+    /**
+     * @description 查询 keep-alive 连接池的统计信息
+     * 
+     *      返回结果示例：
+     *      ```JavaScript
+     *      {
+     *        "hits": 120,
+     *        "misses": 8,
+     *        "waits": 2,
+     *        "evictions": 5,
+     *        "idle": 3,
+     *        "active": 1
+     *      }
+     *      ```
+     *      其中：
+     *      - hits 复用缓存连接的次数
+     *      - misses 未命中缓存而新建连接的次数
+     *      - waits 因达到 maxConnsPerHost 而排队等待的次数
+     *      - evictions 因超出 poolSize 或超过 poolTimeout 而被丢弃的空闲连接数
+     *      - idle 当前缓存的空闲连接数
+     *      - active 当前正在使用的连接数
+     *      @return 返回连接池统计信息
+     *     
+     */
+    function poolStats(): FIBJS.GeneralObject;
+
     /**
      * @description 发送 http 请求到指定的流对象，并返回结果
      *      @param conn 指定处理请求的流对象
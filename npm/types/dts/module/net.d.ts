@@ -39,6 +39,35 @@ declare module 'net' {
      */
     var use_uv_socket: boolean;
 
+    /**
+     * @description 查询 socket 后端使用的事件循环线程数量，可使用命令行选项 --io-threads=n 指定，缺省为 1
+     * 
+     *      每个 socket 根据其句柄固定分配到一个事件循环，同一 socket 的所有操作都在同一个线程内完成。windows 下始终为 1。
+     *     
+     */
+    const io_threads: number;
+
+    /**
+     * @description 查询和设置侦听 socket 是否启用 SO_REUSEPORT，缺省为 false
+     * 
+     *      启用后，在多个 Worker 中使用相同地址和端口创建的 TcpServer 或 HttpServer 可以同时侦听，由系统内核在各个 Worker 之间均衡分配新连接。需要在创建服务器之前设置，windows 下不支持。
+     *      ```JavaScript
+     *      net.reuse_port = true;
+     *      var svr = new http.Server(8080, hdlr);
+     *      svr.start();
+     *      ```
+     *     
+     */
+    var reuse_port: boolean;
+
+    /**
+     * @description 查询和设置侦听 socket 每次就绪时最多连续接受的连接数量，缺省为 64，取值范围为 1 至 1024
+     * 
+     *      侦听 socket 就绪后会连续调用 accept 直到没有等待的连接或者达到此上限，以减少高并发建立连接时的事件循环唤醒次数。windows 和 uv socket 下每次只接受一个连接。
+     *     
+     */
+    var accept_batch: number;
+
     /**
      * @description 查询当前运行环境网络信息
      *      @return 返回网卡信息
@@ -121,11 +150,71 @@ declare module 'net' {
 
     /**
      * @description 查询当前系统异步网络引擎
+     * 
+     *      启用 --use-io-uring 且内核支持时返回 "io_uring"，内核不支持时回退到事件循环并返回其引擎名称
      *      @return 返回网络引擎名称
      *     
      */
     function backend(): string;
 
+    /**
+     * @description 查询 socket 接收缓存池的统计信息
+     *      返回结果示例：
+     *      ```JavaScript
+     *      {
+     *        "allocs": 12,
+     *        "recycled": 3506,
+     *        "pooled": 8,
+     *        "recvs": 3518,
+     *        "bytes": 9382110,
+     *        "avgRecvBytes": 2666
+     *      }
+     *      ```
+     *      其中：
+     *      - allocs 缓存池未命中，新分配的接收缓存数量
+     *      - recycled 从缓存池中复用的接收缓存数量
+     *      - pooled 当前缓存池中空闲的接收缓存数量
+     *      - recvs 完成的接收操作次数
+     *      - bytes 累计接收的字节数
+     *      - avgRecvBytes 平均每次接收的字节数
+     * 
+     *      每个连接的接收缓存大小会根据读取情况在 2K 至 64K 之间自动调整，读满时加倍，读取不足四分之一时减半。
+     *      @return 返回接收缓存统计信息
+     *     
+     */
+    function recvStats(): FIBJS.GeneralObject;
+
+    /**
+     * @description 查询侦听 socket 批量接受连接的统计信息
+     * 
+     *      返回结果示例：
+     *      ```JavaScript
+     *      {
+     *        "batches": 1024,
+     *        "accepted": 8192,
+     *        "avgBatch": 8,
+     *        "maxBatch": 64
+     *      }
+     *      ```
+     *      其中：
+     *      - batches 侦听 socket 就绪后完成的接受批次
+     *      - accepted 累计接受的连接数量
+     *      - avgBatch 平均每批次接受的连接数量
+     *      - maxBatch 单个批次接受的最大连接数量
+     *      @return 返回批量接受连接统计信息
+     *     
+     */
+    function acceptStats(): FIBJS.GeneralObject;
+
+    /**
+     * @description 查询进程内所有 socket 的 I/O 统计汇总
+     * 
+     *      字段含义与 Socket.stats() 相同
+     *      @return 返回 I/O 统计信息
+     *     
+     */
+    function ioStats(): FIBJS.GeneralObject;
+
     /**
      * @description 检测输入是否是 IP 地址
      *      @param ip 指定要检测的字符串
@@ -213,6 +213,7 @@ declare module 'process' {
      *      - rss 返回进程当前占用物理内存大小
      *      - heapTotal 返回 v8 引擎堆内存大小
      *      - heapUsed 返回 v8 引擎正在使用堆内存大小
+     *      - slab 返回 Buffer 与 ArrayBuffer 共用的缓存池的统计，包括 reserved(已向系统申请的内存)，used(正在使用的内存)，allocs，frees，hits(线程缓存命中次数) 以及 released(已归还系统的内存块数)
      *      @return 返回包含内存报告
      *      
      */
@@ -175,6 +175,67 @@ describe('dgram', () => {
         test_message('message', "123456", 1002);
         test_message('empty message', "", 1003);
         test_message('big message', Buffer.alloc(4000).hex(), 1004);
+
+        function test_batch(name, msgs, port) {
+            it(`sendBatch ${name}`, () => {
+                var recv = [];
+                const s = dgram.createSocket('udp4');
+                s.on('message', (msg) => {
+                    recv.push(msg.toString());
+                });
+                s.bind(base_port + port);
+
+                const c = dgram.createSocket('udp4');
+                assert.equal(c.sendBatch(msgs.map(m => Buffer.from(m)), base_port + port), msgs.length);
+
+                for (var i = 0; i < 100 && recv.length < msgs.length; i++)
+                    coroutine.sleep(10);
+
+                c.close();
+                s.close();
+
+                assert.deepEqual(recv.sort(), msgs.slice().sort());
+            });
+        }
+
+        test_batch('same size', ["aaaa", "bbbb", "cccc", "dddd"], 1005);
+        test_batch('mixed size', ["a", "bbbbbb", "", "cc"], 1006);
+
+        it("sendBatch empty", () => {
+            const c = dgram.createSocket('udp4');
+            assert.equal(c.sendBatch([], base_port + 1007), 0);
+            c.close();
+        });
+
+        it("batch receive", () => {
+            var recv = [];
+            var events = 0;
+            const s = dgram.createSocket({
+                type: 'udp4',
+                batch: true
+            });
+            s.on('messages', (msgs, rinfos) => {
+                events++;
+                assert.equal(msgs.length, rinfos.length);
+                msgs.forEach((m, i) => {
+                    assert.equal(rinfos[i].size, m.length);
+                    recv.push(m.toString());
+                });
+            });
+            s.bind(base_port + 1008);
+
+            const c = dgram.createSocket('udp4');
+            c.sendBatch([Buffer.from("1"), Buffer.from("2"), Buffer.from("3")], base_port + 1008);
+
+            for (var i = 0; i < 100 && recv.length < 3; i++)
+                coroutine.sleep(10);
+
+            c.close();
+            s.close();
+
+            assert.greaterThan(events, 0);
+            assert.deepEqual(recv.sort(), ["1", "2", "3"]);
+        });
     });
 
     it("broadcast", () => {
@@ -1,5 +1,6 @@
 const dns = require('dns');
 const net = require('net');
+const coroutine = require('coroutine');
 const test = require('test');
 test.setup();
 
@@ -33,6 +34,79 @@ describe('dns', () => {
             net.resolve('999.999.999.999');
         });
     });
+
+    it('unknown host reports not found', () => {
+        function not_found(fn) {
+            var err;
+
+            try {
+                fn();
+            } catch (e) {
+                err = e;
+            }
+
+            assert.ok(err);
+            assert.notOk(/timer expired/i.test(err.message));
+        }
+
+        not_found(() => dns.lookup('no-such-host.invalid'));
+        not_found(() => net.resolve('127.0.0.1', net.AF_INET6));
+    });
+
+    it('ip address', () => {
+        assert.deepEqual(dns.resolve('127.0.0.1'), ['127.0.0.1']);
+        assert.equal(dns.lookup('::1'), '::1');
+        assert.equal(net.resolve('127.0.0.1', net.AF_INET), '127.0.0.1');
+    });
+
+    if (process.platform != 'win32')
+        describe('cache', () => {
+            it('hit after first query', () => {
+                dns.clearCache();
+                dns.resolve('www.icann.org');
+
+                var s1 = dns.stats();
+                dns.resolve('www.icann.org');
+                var s2 = dns.stats();
+
+                assert.equal(s2.misses, s1.misses);
+                assert.greaterThan(s2.hits + s2.negative, s1.hits + s1.negative);
+                assert.greaterThan(s2.entries, 0);
+            });
+
+            it('negative result', () => {
+                dns.clearCache();
+                assert.throws(() => {
+                    dns.lookup('999.999.999.999');
+                });
+
+                var s1 = dns.stats();
+                assert.throws(() => {
+                    dns.lookup('999.999.999.999');
+                });
+                var s2 = dns.stats();
+
+                assert.equal(s2.misses, s1.misses);
+            });
+
+            it('coalesce concurrent queries', () => {
+                dns.clearCache();
+
+                var s1 = dns.stats();
+                coroutine.parallel([1, 2, 3, 4], () => {
+                    dns.resolve('www.icann.org');
+                });
+                var s2 = dns.stats();
+
+                assert.lessThan(s2.queries - s1.queries, 8);
+            });
+
+            it('clearCache', () => {
+                dns.resolve('www.icann.org');
+                dns.clearCache();
+                assert.equal(dns.stats().entries, 0);
+            });
+        });
 });
 
 require.main === module && test.run(console.DEBUG);
\ No newline at end of file
@@ -439,10 +439,14 @@ describe('fs', () => {
         assert.equal(f1.size(), 100);
         f.copyTo(f1);
         assert.equal(f1.size(), f.size());
+        assert.equal(f.tell(), f.size());
 
         f.close();
         f1.close();
 
+        assert.equal(fs.readTextFile(path.join(__dirname, 'fs_test.js.bak' + vmid)),
+            fs.readTextFile(path.join(__dirname, 'fs_test.js')));
+
         fs.unlink(path.join(__dirname, 'fs_test.js.bak' + vmid));
     });
 
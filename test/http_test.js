@@ -9,6 +9,7 @@ var fs = require('fs');
 var http = require('http');
 var net = require('net');
 var zip = require('zip');
+var zlib = require('zlib');
 var coroutine = require("coroutine");
 var path = require("path");
 
@@ -258,6 +259,33 @@ describe("http", () => {
             assert.deepEqual(d['f'], "Wed, 12 Dec 2012 12:12:12 GMT");
             assert.deepEqual(new Date(d['f']), t);
         });
+
+        it("case insensitive lookup", () => {
+            var h = new http.Request().headers;
+            var i;
+
+            h.add('Content-Type', 'text/html');
+            h.add('X-Test', '1');
+            h.add('content-type', 'text/plain');
+            h.add('CONTENT-ENCODING', 'gzip');
+
+            assert.deepEqual(h.all('CONTENT-type'), ['text/html', 'text/plain']);
+            assert.equal(h.first('Content-Encoding'), 'gzip');
+            assert.equal(h.first('x-test'), '1');
+            assert.isFalse(h.has('Content-Typ'));
+            assert.isFalse(h.has('content-length'));
+
+            for (i = 0; i < 100; i++)
+                h.add('h' + i, '' + i);
+
+            for (i = 0; i < 100; i++)
+                assert.equal(h.first('H' + i), '' + i);
+            assert.equal(h.first('content-type'), 'text/html');
+
+            h.remove('CONTENT-TYPE');
+            assert.isFalse(h.has('content-type'));
+            assert.equal(h.first('h50'), '50');
+        });
     });
 
     describe("cookie", () => {
@@ -587,6 +615,46 @@ describe("http", () => {
             assert.equal('123456', r.body.read());
         });
 
+        it("received headers", () => {
+            var req = get_request("GET / HTTP/1.1\r\nA: 1\r\nB:2\r\na:   3\r\nConnection: close\r\n\r\n");
+
+            assert.equal(req.firstHeader("a"), "1");
+            assert.isTrue(req.hasHeader("b"));
+            assert.isFalse(req.hasHeader("connection"));
+            assert.deepEqual(req.allHeader("A"), ["1", "3"]);
+
+            req.addHeader("c", "4");
+            assert.deepEqual(req.headers.keys(), ["A", "B", "a", "c"]);
+            assert.deepEqual(req.headers.values(), ["1", "2", "3", "4"]);
+
+            req.removeHeader("a");
+            assert.deepEqual(req.headers.keys(), ["B", "c"]);
+
+            assert.throws(() => {
+                get_request("GET / HTTP/1.1\r\nA : 1\r\n\r\n");
+            });
+
+            assert.throws(() => {
+                get_request("GET / HTTP/1.1\r\n: 1\r\n\r\n");
+            });
+        });
+
+        it("large head", () => {
+            var v = "x".repeat(1000);
+            var txt = "GET / HTTP/1.1\r\n";
+            for (var i = 0; i < 100; i++)
+                txt += "h" + i + ": " + v + "\r\n";
+
+            var req = get_request(txt + "\r\n");
+            assert.equal(req.firstHeader("h99"), v);
+
+            req = new http.Request();
+            req.maxHeadersCount = 10;
+            assert.throws(() => {
+                get_request(txt + "\r\n", req);
+            });
+        });
+
         it("keep-alive", () => {
             var keep_reqs = {
                 "GET / HTTP/1.0\r\n\r\n": false,
@@ -753,6 +821,63 @@ describe("http", () => {
             assert.equal(c['pid'], '');
         });
 
+        it("parseForm", () => {
+            var b = '7d33a816d302b6';
+            var big = 'x'.repeat(65400) + '\r\n--7d33a816d302b' + 'y'.repeat(100000);
+            var body = '--' + b + '\r\nContent-Disposition: form-data;name="a"\r\n\r\n100\r\n' +
+                '--' + b + '\r\nContent-Disposition: form-data;name="f";filename="big.txt"\r\nContent-Type: text/plain\r\n\r\n' + big + '\r\n' +
+                '--' + b + '\r\nContent-Disposition: form-data;name="g";filename="small.txt"\r\n\r\nsmall\r\n' +
+                '--' + b + '--\r\n';
+
+            var req = new http.Request();
+            req.setHeader('Content-Type', 'multipart/form-data; boundary=' + b);
+            req.write(body);
+
+            var fields = [];
+            var files = [];
+            var ms = new io.MemoryStream();
+            var c = req.parseForm({
+                threshold: 16,
+                onField: (name, value) => fields.push([name, value]),
+                onFile: (name, file) => {
+                    files.push([name, file.fileName]);
+                    if (name == 'g')
+                        return ms;
+                }
+            });
+
+            assert.deepEqual(fields, [
+                ['a', '100']
+            ]);
+            assert.deepEqual(files, [
+                ['f', 'big.txt'],
+                ['g', 'small.txt']
+            ]);
+
+            assert.equal(c['a'], '100');
+            assert.equal(req.form['a'], '100');
+            assert.equal(c['f'].contentType, 'text/plain');
+            assert.equal(c['f'].body.readAll().toString(), big);
+            assert.equal(c['g'].body.readAll().toString(), 'small');
+
+            var ms1 = new io.MemoryStream();
+            c = req.parseForm({
+                onFile: (name, file) => {
+                    if (name == 'g')
+                        return new io.BufferedStream(ms1);
+                }
+            });
+            assert.isNull(c['g'].body);
+            ms1.rewind();
+            assert.equal(ms1.readAll().toString(), 'small');
+
+            assert.throws(() => {
+                req.parseForm({
+                    onFile: () => 100
+                });
+            });
+        });
+
         it("chunk", () => {
             function chunk(data) {
                 return data.length.toString(16) + '\r\n' + data + '\r\n';
@@ -1149,6 +1274,13 @@ describe("http", () => {
                 } else if (r.value == '/gzip_small') {
                     r.response.addHeader("Content-Type", "text/html");
                     r.response.write("01234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567");
+                } else if (r.value == '/slow') {
+                    coroutine.sleep(100);
+                    r.response.write("slow");
+                } else if (r.value == '/fast') {
+                    r.response.write("fast");
+                } else if (r.value == '/body_size') {
+                    r.response.write(String(r.body.readAll().length));
                 } else if (r.value == '/gzip_bin') {
                     r.response.write("0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
                 }
@@ -1204,6 +1336,57 @@ describe("http", () => {
             assert.equal(req.firstHeader('Content-Encoding'), 'gzip');
         });
 
+        it("gzip chunked", () => {
+            c.write("GET /gzip_test HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n");
+            var req = get_response();
+            assert.equal(req.statusCode, 200);
+            assert.equal(req.firstHeader('Content-Encoding'), 'gzip');
+            assert.equal(zlib.gunzip(req.body.readAll()).toString(),
+                "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
+
+            c.write("GET /gzip_test HTTP/1.1\r\nAccept-Encoding: deflate\r\n\r\n");
+            req = get_response();
+            assert.equal(req.firstHeader('Content-Encoding'), 'deflate');
+            assert.equal(zlib.inflate(req.body.readAll()).toString(),
+                "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
+        });
+
+        it("accept-encoding q value", () => {
+            function test(accept) {
+                c.write("GET /gzip_test HTTP/1.1\r\nAccept-Encoding: " + accept + "\r\n\r\n");
+                var req = get_response();
+                assert.equal(req.statusCode, 200);
+                return req.firstHeader('Content-Encoding');
+            }
+
+            assert.equal(test("deflate, gzip"), 'gzip');
+            assert.equal(test("gzip;q=0.5, deflate"), 'deflate');
+            assert.equal(test("gzip; q=0, *"), 'deflate');
+            assert.equal(test("GZIP;Q=0.8, deflate;q=0.6"), 'gzip');
+            assert.equal(test("*"), 'gzip');
+            assert.equal(test("*;q=0"), null);
+            assert.equal(test("identity"), null);
+            assert.equal(test("br, zstd"), null);
+        });
+
+        it("encodingThreshold", () => {
+            assert.equal(hdr.encodingThreshold, 128);
+            assert.equal(hdr.encodingLevel, -1);
+
+            assert.throws(() => {
+                hdr.encodingLevel = 10;
+            });
+
+            hdr.encodingThreshold = 1024;
+            try {
+                c.write("GET /gzip_test HTTP/1.0\r\nAccept-Encoding: gzip\r\n\r\n");
+                var req = get_response();
+                assert.equal(req.firstHeader('Content-Encoding'), null);
+            } finally {
+                hdr.encodingThreshold = 128;
+            }
+        });
+
         it("not zip small file", () => {
             c.write("GET /gzip_small HTTP/1.0\r\nAccept-Encoding: gzip,deflate\r\n\r\n");
             var req = get_response();
@@ -1292,6 +1475,282 @@ describe("http", () => {
             assert.equal(req.statusCode, 200);
             assert.equal(req.firstHeader('Cache-Control'), 'no-cache, no-store');
         });
+
+        it("head split across reads", () => {
+            c.write("GET /not_found HTTP/1.1\r\nHost: a\r");
+            coroutine.sleep(10);
+            c.write("\n\r");
+            coroutine.sleep(10);
+            c.write("\nGET / HTTP/1.1\r\nConnection: close\r\n\r\n");
+
+            var req = get_response();
+            assert.equal(req.statusCode, 404);
+
+            req = get_response();
+            assert.equal(req.statusCode, 200);
+        });
+
+        it("pipelining", () => {
+            assert.equal(hdr.maxPipeline, 8);
+
+            c.write("GET /not_found HTTP/1.1\r\n\r\nGET /gzip_small HTTP/1.1\r\n\r\nGET / HTTP/1.1\r\nConnection: close\r\n\r\n");
+
+            var req = get_response();
+            assert.equal(req.statusCode, 404);
+
+            req = get_response();
+            assert.equal(req.statusCode, 200);
+            assert.equal(req.readAll().toString(), "01234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567");
+
+            req = get_response();
+            assert.equal(req.statusCode, 200);
+            assert.isFalse(req.keepAlive);
+
+            assert.throws(() => {
+                hdr.maxPipeline = -1;
+            });
+        });
+
+        it("pipelining behind a slow handler", () => {
+            c.write("GET /slow HTTP/1.1\r\n\r\n");
+            coroutine.sleep(10);
+            c.write("POST /fast HTTP/1.1\r\nContent-Length: 4\r\n\r\nbody");
+            c.write("GET /fast HTTP/1.1\r\nConnection: close\r\n\r\n");
+
+            var req = get_response();
+            assert.equal(req.statusCode, 200);
+            assert.equal(req.readAll().toString(), "slow");
+
+            req = get_response();
+            assert.equal(req.statusCode, 200);
+            assert.equal(req.readAll().toString(), "fast");
+
+            req = get_response();
+            assert.equal(req.statusCode, 200);
+            assert.equal(req.readAll().toString(), "fast");
+            assert.isFalse(req.keepAlive);
+        });
+
+        function h2_frame(type, flags, id, payload) {
+            var buf = Buffer.alloc(9);
+            buf.writeUInt16BE(payload.length >> 8, 0);
+            buf.writeUInt8(payload.length & 0xff, 2);
+            buf.writeUInt8(type, 3);
+            buf.writeUInt8(flags, 4);
+            buf.writeUInt32BE(id, 5);
+            return Buffer.concat([buf, payload]);
+        }
+
+        function h2_read() {
+            var head = bs.read(9);
+            var sz = (head.readUInt16BE(0) << 8) | head.readUInt8(2);
+            return {
+                type: head.readUInt8(3),
+                flags: head.readUInt8(4),
+                id: head.readUInt32BE(5) & 0x7fffffff,
+                payload: sz ? bs.read(sz) : Buffer.alloc(0)
+            };
+        }
+
+        // reads frames until each of ids has ended, returns the DATA of every stream in the order they ended
+        function h2_streams(ids) {
+            var bodies = {};
+            var order = [];
+
+            ids.forEach(id => bodies[id] = []);
+            while (order.length < ids.length) {
+                var f = h2_read();
+                if (!bodies[f.id])
+                    continue;
+
+                if (f.type == 0)
+                    bodies[f.id].push(f.payload);
+
+                if ((f.type == 0 || f.type == 1) && (f.flags & 0x1))
+                    order.push(f.id);
+            }
+
+            ids.forEach(id => bodies[id] = Buffer.concat(bodies[id]).toString());
+            bodies.order = order;
+            return bodies;
+        }
+
+        function h2_get(id, path) {
+            // :method GET, :scheme http, :path
+            return h2_frame(1, 0x5, id, Buffer.concat([
+                Buffer.from([0x82, 0x86, 0x04, path.length]),
+                Buffer.from(path)
+            ]));
+        }
+
+        var h2_preface = Buffer.concat([
+            Buffer.from("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"),
+            h2_frame(4, 0, 0, Buffer.alloc(0))
+        ]);
+
+        it("http2 prior knowledge", () => {
+            assert.isFalse(hdr.enableHttp2);
+            hdr.enableHttp2 = true;
+
+            try {
+                c.write(Buffer.concat([
+                    Buffer.from("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"),
+                    h2_frame(4, 0, 0, Buffer.alloc(0)),
+                    // :method GET, :scheme http, :path /gzip_small
+                    h2_frame(1, 0x5, 1, Buffer.concat([
+                        Buffer.from([0x82, 0x86, 0x04, 11]),
+                        Buffer.from("/gzip_small")
+                    ]))
+                ]));
+
+                var status, body = [];
+                while (true) {
+                    var f = h2_read();
+                    if (f.id != 1)
+                        continue;
+
+                    if (f.type == 1)
+                        status = f.payload.readUInt8(0);
+                    else if (f.type == 0)
+                        body.push(f.payload);
+
+                    if (f.flags & 0x1)
+                        break;
+                }
+
+                // :status 200 is static table entry 8
+                assert.equal(status, 0x88);
+                assert.equal(Buffer.concat(body).toString(), "01234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567");
+            } finally {
+                hdr.enableHttp2 = false;
+            }
+        });
+
+        it("http2 upgrade", () => {
+            hdr.enableHttp2 = true;
+
+            try {
+                c.write("GET /gzip_small HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: Upgrade, HTTP2-Settings\r\nUpgrade: h2c\r\nHTTP2-Settings: \r\n\r\n");
+
+                assert.equal(bs.readLine(), "HTTP/1.1 101 Switching Protocols");
+                while (bs.readLine() !== "");
+
+                c.write(h2_preface);
+
+                // the upgraded request becomes stream 1, a new one still works on the same connection
+                c.write(h2_get(3, "/fast"));
+                var r = h2_streams([1, 3]);
+                assert.equal(r[1], "01234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567");
+                assert.equal(r[3], "fast");
+            } finally {
+                hdr.enableHttp2 = false;
+            }
+        });
+
+        it("http2 concurrent streams", () => {
+            hdr.enableHttp2 = true;
+
+            try {
+                c.write(Buffer.concat([
+                    h2_preface,
+                    h2_get(1, "/slow"),
+                    h2_get(3, "/fast"),
+                    h2_get(5, "/fast")
+                ]));
+
+                var r = h2_streams([1, 3, 5]);
+                assert.equal(r[1], "slow");
+                assert.equal(r[3], "fast");
+                assert.equal(r[5], "fast");
+
+                // a slow handler does not hold up the streams behind it
+                assert.equal(r.order[2], 1);
+            } finally {
+                hdr.enableHttp2 = false;
+            }
+        });
+
+        it("http2 large request body", () => {
+            hdr.enableHttp2 = true;
+
+            try {
+                var sz = 5 * 1024 * 1024;
+                var chunk = Buffer.alloc(16384, 'a');
+                var frames = [
+                    h2_preface,
+                    // :method POST, :scheme http, :path /body_size
+                    h2_frame(1, 0x4, 1, Buffer.concat([
+                        Buffer.from([0x83, 0x86, 0x04, 10]),
+                        Buffer.from("/body_size")
+                    ]))
+                ];
+
+                for (var n = 0; n < sz; n += chunk.length)
+                    frames.push(h2_frame(0, n + chunk.length >= sz ? 0x1 : 0, 1, chunk));
+
+                // the server hands the windows back while it reads, so the upload is not held up
+                coroutine.start(() => {
+                    c.write(Buffer.concat(frames));
+                });
+
+                var r = h2_streams([1]);
+                assert.equal(r[1], String(sz));
+            } finally {
+                hdr.enableHttp2 = false;
+            }
+        });
+
+        it("http2 encoding", () => {
+            hdr.enableHttp2 = true;
+
+            function get(id) {
+                // :method GET, :scheme http, :path /gzip_test, accept-encoding: gzip, deflate
+                c.write(h2_frame(1, 0x5, id, Buffer.concat([
+                    Buffer.from([0x82, 0x86, 0x04, 10]),
+                    Buffer.from("/gzip_test"),
+                    Buffer.from([0x90])
+                ])));
+
+                var body = [];
+                while (true) {
+                    var f = h2_read();
+                    if (f.id != id)
+                        continue;
+
+                    if (f.type == 0)
+                        body.push(f.payload);
+
+                    if (f.flags & 0x1)
+                        break;
+                }
+
+                return Buffer.concat(body);
+            }
+
+            try {
+                c.write(Buffer.concat([
+                    Buffer.from("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"),
+                    h2_frame(4, 0, 0, Buffer.alloc(0))
+                ]));
+
+                assert.equal(zlib.gunzip(get(1)).toString(),
+                    "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
+
+                hdr.encodingThreshold = 1024;
+                assert.equal(get(3).toString(),
+                    "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
+            } finally {
+                hdr.encodingThreshold = 128;
+                hdr.enableHttp2 = false;
+            }
+        });
+
+        it("enableHttp2", () => {
+            var s = new http.Server(8882 + base_port, (r) => {});
+            assert.isFalse(s.enableHttp2);
+            s.enableHttp2 = true;
+            assert.isTrue(s.enableHttp2);
+        });
     });
 
     describe("file handler", () => {
@@ -1353,6 +1812,70 @@ describe("http", () => {
             rep.clear();
         });
 
+        it("etag", () => {
+            var rep1 = hfh_test(url);
+            var etag = rep1.firstHeader('ETag');
+            var lastModified = rep1.firstHeader('Last-Modified');
+            assert.equal(200, rep1.statusCode);
+            assert.ok(etag);
+            rep1.clear();
+
+            function test(tags) {
+                var rep = hfh_test(url, {
+                    'If-None-Match': tags
+                });
+                var status = rep.statusCode;
+                if (status == 304)
+                    assert.equal(etag, rep.firstHeader('ETag'));
+                rep.clear();
+                return status;
+            }
+
+            assert.equal(test(etag), 304);
+            assert.equal(test('W/' + etag), 304);
+            assert.equal(test('"other", ' + etag), 304);
+            assert.equal(test('*'), 304);
+            assert.equal(test('"other"'), 200);
+
+            rep1 = hfh_test(url, {
+                'If-None-Match': '"other"',
+                'If-Modified-Since': lastModified
+            });
+            assert.equal(200, rep1.statusCode);
+            rep1.clear();
+        });
+
+        it("hot file", () => {
+            var url1 = base_port + 'hot.html';
+            var filePath1 = path.join(baseFolder, url1);
+
+            fs.writeFile(filePath1, 'hot file');
+            try {
+                for (var i = 0; i < 3; i++) {
+                    var rep1 = hfh_test(url1);
+                    assert.equal(200, rep1.statusCode);
+                    assert.equal('hot file', rep1.readAll().toString());
+                    rep1.clear();
+                }
+
+                rep1 = hfh_test(url1, {
+                    'Range': 'bytes=4-'
+                });
+                assert.equal(206, rep1.statusCode);
+                assert.equal(' file', rep1.readAll().toString());
+                rep1.clear();
+
+                fs.writeFile(filePath1, 'changed hot file');
+                coroutine.sleep(1100);
+
+                rep1 = hfh_test(url1);
+                assert.equal('changed hot file', rep1.readAll().toString());
+                rep1.clear();
+            } finally {
+                fs.unlink(filePath1);
+            }
+        });
+
         it("changed", () => {
             var rep = hfh_test(url, {
                 'If-Modified-Since': new Date('1998-04-14 12:12:12')
@@ -1363,6 +1886,73 @@ describe("http", () => {
             rep.clear();
         });
 
+        it("precompressed sidecar", () => {
+            fs.writeFile(filePath + '.gz', zlib.gzip(Buffer.from('test html file')));
+
+            try {
+                var rep = hfh_test(url, {
+                    'Accept-Encoding': 'br, gzip'
+                });
+                assert.equal(200, rep.statusCode);
+                assert.equal('gzip', rep.firstHeader('Content-Encoding'));
+                assert.equal('Accept-Encoding', rep.firstHeader('Vary'));
+                assert.equal('text/html', rep.firstHeader('Content-Type'));
+                assert.equal(zlib.gunzip(rep.readAll()).toString(), 'test html file');
+                rep.clear();
+
+                rep = hfh_test(url, {
+                    'Accept-Encoding': 'gzip;q=0, deflate'
+                });
+                assert.equal(null, rep.firstHeader('Content-Encoding'));
+                assert.equal(14, rep.length);
+                rep.clear();
+
+                rep = hfh_test(url, {
+                    'Accept-Encoding': 'gzip',
+                    'Range': 'bytes=0-3'
+                });
+                assert.equal(206, rep.statusCode);
+                assert.equal(null, rep.firstHeader('Content-Encoding'));
+                rep.clear();
+            } finally {
+                fs.unlink(filePath + '.gz');
+            }
+        });
+
+        it("sidecar and direct request keep their own type", () => {
+            var js = base_port + 'test.js';
+            var jsPath = path.join(baseFolder, js);
+
+            fs.writeFile(jsPath, 'var a = 100;');
+            fs.writeFile(jsPath + '.gz', zlib.gzip(Buffer.from('var a = 100;')));
+
+            try {
+                var rep = hfh_test(js, {
+                    'Accept-Encoding': 'gzip'
+                });
+                assert.equal('gzip', rep.firstHeader('Content-Encoding'));
+                assert.equal('application/javascript', rep.firstHeader('Content-Type'));
+                var etag = rep.firstHeader('ETag');
+                rep.clear();
+
+                rep = hfh_test(js + '.gz');
+                assert.equal(null, rep.firstHeader('Content-Encoding'));
+                assert.equal('application/gzip', rep.firstHeader('Content-Type'));
+                assert.notEqual(etag, rep.firstHeader('ETag'));
+                rep.clear();
+
+                rep = hfh_test(js, {
+                    'Accept-Encoding': 'gzip'
+                });
+                assert.equal('application/javascript', rep.firstHeader('Content-Type'));
+                assert.equal(etag, rep.firstHeader('ETag'));
+                rep.clear();
+            } finally {
+                fs.unlink(jsPath);
+                fs.unlink(jsPath + '.gz');
+            }
+        });
+
         it("index.html", () => {
             var rep = hfh_test("/");
             assert.equal(200, rep.statusCode);
@@ -1911,6 +2501,101 @@ describe("http", () => {
                 var r2 = http.get("http://127.0.0.1:" + (8882 + base_port) + "/request");
                 assert.equal(r1.stream.stream, r2.stream.stream);
             });
+
+            it("maxConnsPerHost of keep-alive", () => {
+                var client = new http.Client();
+                assert.equal(client.maxConnsPerHost, 0);
+
+                client.maxConnsPerHost = 1;
+                assert.equal(client.maxConnsPerHost, 1);
+
+                assert.throws(() => {
+                    client.maxConnsPerHost = -1;
+                });
+
+                var rs = [];
+                coroutine.parallel([1, 2, 3, 4], () => {
+                    rs.push(client.get("http://127.0.0.1:" + (8882 + base_port) + "/request"));
+                });
+
+                rs.forEach(r => assert.equal(r.stream.stream, rs[0].stream.stream));
+
+                var stats = client.poolStats();
+                assert.equal(stats.misses, 1);
+                assert.equal(stats.hits, 3);
+                assert.equal(stats.waits, 3);
+                assert.equal(stats.active, 0);
+                assert.equal(stats.idle, 1);
+            });
+
+            it("queued request times out with client.timeout", () => {
+                var slow = new net.TcpServer(8889 + base_port, (c) => {
+                    var bs = new io.BufferedStream(c);
+                    bs.EOL = "\r\n";
+
+                    var l;
+                    while ((l = bs.readLine()) !== null && l !== "");
+
+                    // every gap stays under the timeout, the whole response does not
+                    c.write("HTTP/1.1 200 OK\r\nContent-Length: 3\r\n\r\n");
+                    for (var i = 0; i < 3; i++) {
+                        coroutine.sleep(100);
+                        c.write("a");
+                    }
+                });
+                slow.start();
+                test_util.push(slow.socket);
+
+                var client = new http.Client();
+                client.maxConnsPerHost = 1;
+                client.timeout = 200;
+
+                var ok = 0;
+                var errs = 0;
+                coroutine.parallel([1, 2], () => {
+                    try {
+                        client.get("http://127.0.0.1:" + (8889 + base_port) + "/slow");
+                        ok++;
+                    } catch (e) {
+                        errs++;
+                    }
+                });
+
+                assert.equal(ok, 1);
+                assert.equal(errs, 1);
+
+                var stats = client.poolStats();
+                assert.equal(stats.waits, 1);
+                assert.equal(stats.active, 0);
+            });
+
+            it("http2", () => {
+                var client = new http.Client();
+                assert.isFalse(client.enableHttp2);
+                assert.isFalse(client.enableH2c);
+                assert.equal(client.maxConcurrentStreams, 100);
+
+                assert.throws(() => {
+                    client.maxConcurrentStreams = 0;
+                });
+
+                client.enableH2c = true;
+                svr.enableHttp2 = true;
+
+                var rs = [];
+                coroutine.parallel([1, 2, 3, 4], () => {
+                    rs.push(client.get("http://127.0.0.1:" + (8882 + base_port) + "/request"));
+                });
+
+                rs.forEach(r => {
+                    assert.equal(r.protocol, "HTTP/2.0");
+                    assert.equal(r.statusCode, 200);
+                    assert.equal(r.data.toString(), "/request");
+                    assert.equal(r.stream, rs[0].stream);
+                });
+
+                svr.enableHttp2 = false;
+            });
         });
 
         describe("head", () => {
@@ -2716,6 +3401,93 @@ describe("http", () => {
                     req_path(hr, 'path');
                 });
             });
+
+            it("retry and eject bad upstream", () => {
+                var hr = new http.Repeater([
+                    'http://127.0.0.1:' + (10000 + base_port) + '/path',
+                    'http://127.0.0.1:' + (8885 + base_port) + '/path1'
+                ]);
+                assert.equal(hr.retries, 1);
+                hr.maxFails = 1;
+
+                assert.equal(req_path(hr, 'path'), '/path1/path');
+                assert.equal(req_path(hr, 'path'), '/path1/path');
+                assert.equal(req_path(hr, 'path'), '/path1/path');
+
+                var stats = hr.stats();
+                assert.equal(stats.retries, 1);
+                assert.equal(stats.upstreams[0].errors, 1);
+                assert.equal(stats.upstreams[0].ejections, 1);
+                assert.isTrue(stats.upstreams[0].ejected);
+                assert.equal(stats.upstreams[1].requests, 3);
+                assert.equal(stats.upstreams[1].outstanding, 0);
+            });
+
+            it("retry sent requests only when idempotent", () => {
+                var drop = new net.TcpServer(8888 + base_port, (c) => {
+                    c.read();
+                    c.close();
+                });
+                drop.start();
+                test_util.push(drop.socket);
+
+                function repeater(port) {
+                    return new http.Repeater([
+                        'http://127.0.0.1:' + (port + base_port) + '/method',
+                        'http://127.0.0.1:' + (8885 + base_port) + '/method'
+                    ]);
+                }
+
+                var hr = repeater(8888);
+                assert.throws(() => {
+                    req_method(hr, 'POST');
+                });
+                assert.equal(hr.stats().retries, 0);
+
+                hr = repeater(8888);
+                assert.equal(req_method(hr, 'GET'), "method: GET");
+                assert.equal(hr.stats().retries, 1);
+
+                hr = repeater(10000);
+                assert.equal(req_method(hr, 'POST'), "method: POST");
+                assert.equal(hr.stats().retries, 1);
+            });
+
+            it("strategy", () => {
+                var hr = new http.Repeater([
+                    'http://127.0.0.1:' + (8885 + base_port) + '/path',
+                    'http://127.0.0.1:' + (8885 + base_port) + '/path1',
+                    'http://127.0.0.1:' + (8885 + base_port) + '/path2'
+                ]);
+                assert.equal(hr.strategy, "round-robin");
+
+                assert.throws(() => {
+                    hr.strategy = "random";
+                });
+
+                hr.strategy = "least-request";
+                assert.equal(req_path(hr, 'test'), '/path/test');
+
+                hr.strategy = "peak-ewma";
+                req_path(hr, 'test');
+
+                hr.strategy = "hash";
+                hr.hashHeader = "x-user";
+
+                function req_user(user) {
+                    var r = new http.Request();
+                    r.address = r.value = 'test';
+                    r.setHeader("x-user", user);
+                    hr.invoke(r);
+                    return r.response.read().toString();
+                }
+
+                for (var i = 0; i < 20; i++) {
+                    var first = req_user("user" + i);
+                    assert.equal(req_user("user" + i), first);
+                    assert.equal(req_user("user" + i), first);
+                }
+            });
         });
     });
 
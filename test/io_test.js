@@ -327,6 +327,24 @@ describe('io', () => {
                 })
             });
 
+            it("copyTo", () => {
+                var file = fs.openFile(filePath);
+                var tmp = path.join(__dirname, 'range_copy_temp' + coroutine.vmid);
+                var stm = new io.RangeStream(file, 10, 100);
+
+                var f1 = fs.openFile(tmp, 'w');
+                assert.equal(stm.copyTo(f1, 50), 50);
+                assert.equal(stm.copyTo(f1), 40);
+                assert.equal(stm.copyTo(f1), 0);
+                f1.close();
+
+                assert.equal(file.tell(), 0);
+                file.seek(10, fs.SEEK_SET);
+                assert.deepEqual(fs.readFile(tmp), file.read(90));
+
+                fs.unlink(tmp);
+            });
+
             it("::stat", () => {
                 var file = fs.openFile(filePath);
                 var sz = Number(file.size());
@@ -1048,6 +1048,44 @@ describe("mq", () => {
                 mq.invoke(r, m);
                 assert.equal('/', m.value);
             });
+
+            it("large table", () => {
+                var r = new mq.Routing();
+                var hit;
+
+                r.get("/users/:id", (v) => { hit = "user"; });
+                r.append("^/(us[a-z]+)/(\\d+)$", (v) => { hit = "regex"; });
+                for (var i = 0; i < 200; i++)
+                    r.append("/static" + i + "/:file", ((n) => (v) => { hit = n; })("static" + i));
+                r.post("/users/:id", (v) => { hit = "post"; });
+                r.append("/Items/*", (v) => { hit = "items"; });
+                r.append("*", (v) => { hit = "any"; });
+
+                function test(method, url) {
+                    var req = new http.Request();
+                    req.method = method;
+                    req.value = url;
+                    hit = undefined;
+                    mq.invoke(r, req);
+                    return hit;
+                }
+
+                assert.equal(test("GET", "/users/100"), "user");
+                assert.equal(test("POST", "/users/100"), "regex");
+                assert.equal(test("POST", "/users/abc"), "post");
+                assert.equal(test("GET", "/USERS/abc"), "user");
+                assert.equal(test("GET", "/static0/a.js"), "static0");
+                assert.equal(test("GET", "/STATIC123/a.js"), "static123");
+                assert.equal(test("GET", "/static199/a.js"), "static199");
+                assert.equal(test("GET", "/static200/a.js"), "any");
+                assert.equal(test("PUT", "/items/a/b"), "items");
+                assert.equal(test("GET", "/"), "any");
+
+                var m = new mq.Message();
+                m.value = "/users/100";
+                mq.invoke(r, m);
+                assert.equal(hit, "user");
+            });
         });
 
         it("memory leak", () => {
@@ -71,6 +71,297 @@ function test_net(eng, use_uv) {
             assert.equal(net.backend(), backend);
         });
 
+        it("io_threads", () => {
+            assert.isNumber(net.io_threads);
+            assert.greaterThan(net.io_threads, 0);
+        });
+
+        it("recvStats", () => {
+            var s1 = new net.Socket(net_config.family);
+            test_util.push(s1);
+
+            var _port = getPort();
+
+            s1.bind(_port);
+            s1.listen();
+            coroutine.start(() => {
+                var c = s1.accept();
+                c.write(Buffer.alloc(100000));
+                c.close();
+            });
+
+            var st1 = net.recvStats();
+
+            var c1 = new net.Socket();
+            c1.connect('127.0.0.1', _port);
+
+            var n = 0;
+            var b;
+            while (b = c1.read())
+                n += b.length;
+            c1.close();
+            assert.equal(n, 100000);
+
+            var st2 = net.recvStats();
+            if (!use_uv) {
+                assert.greaterThan(st2.recvs, st1.recvs);
+                assert.ok(st2.bytes - st1.bytes >= 100000);
+                assert.greaterThan(st2.allocs + st2.recycled, st1.allocs + st1.recycled);
+                assert.isNumber(st2.avgRecvBytes);
+            }
+        });
+
+        it("stats", () => {
+            var s1 = new net.Socket(net_config.family);
+            test_util.push(s1);
+
+            var _port = getPort();
+
+            s1.bind(_port);
+            s1.listen();
+            coroutine.start(() => {
+                var c = s1.accept();
+                var b;
+                while (b = c.read())
+                    c.write(b);
+                c.close();
+            });
+
+            assert.deepEqual(Object.keys(net.info()), Object.keys(os.networkInterfaces()));
+
+            var info1 = net.ioStats();
+
+            var c1 = new net.Socket();
+            c1.connect('127.0.0.1', _port);
+            c1.write(Buffer.alloc(10000));
+            var n = 0;
+            while (n < 10000)
+                n += c1.recv().length;
+
+            var st = c1.stats();
+            assert.equal(st.bytesOut, 10000);
+            assert.equal(st.bytesIn, 10000);
+            assert.ok(st.writes >= 1);
+            assert.ok(st.reads >= 1);
+            assert.isNumber(st.again);
+            assert.isNumber(st.queueTime);
+            assert.isNumber(st.resumeTime);
+            c1.close();
+
+            var info2 = net.ioStats();
+            assert.ok(info2.bytesIn - info1.bytesIn >= 20000);
+            assert.ok(info2.bytesOut - info1.bytesOut >= 20000);
+        });
+
+        describe("cork", () => {
+            function echo_server() {
+                var s1 = new net.Socket(net_config.family);
+                test_util.push(s1);
+
+                var _port = getPort();
+
+                s1.bind(_port);
+                s1.listen();
+                coroutine.start(() => {
+                    var c = s1.accept();
+                    var b;
+                    while (b = c.read())
+                        c.write(b);
+                    c.close();
+                });
+
+                var c1 = new net.Socket();
+                c1.connect('127.0.0.1', _port);
+
+                return c1;
+            }
+
+            function recv_all(c, sz) {
+                var bufs = [];
+                var n = 0;
+                while (n < sz) {
+                    var b = c.recv();
+                    bufs.push(b);
+                    n += b.length;
+                }
+                return Buffer.concat(bufs).toString();
+            }
+
+            it("autoCork", () => {
+                var c1 = echo_server();
+                assert.isFalse(c1.autoCork);
+                c1.autoCork = true;
+                assert.isTrue(c1.autoCork);
+
+                for (var i = 0; i < 10; i++)
+                    c1.write(Buffer.from(`${i}`));
+
+                assert.equal(recv_all(c1, 10), "0123456789");
+                assert.equal(c1.stats().writes, 1);
+                c1.close();
+            });
+
+            it("reuse buffer after write", () => {
+                var c1 = echo_server();
+                c1.autoCork = true;
+
+                var b = Buffer.from("a");
+                c1.write(b);
+                b[0] = 0x62;
+                c1.write(b);
+
+                assert.equal(recv_all(c1, 2), "ab");
+                c1.close();
+            });
+
+            it("cork/uncork", () => {
+                var c1 = echo_server();
+
+                c1.cork();
+                c1.write(Buffer.from("abc"));
+                c1.cork();
+                c1.write(Buffer.from("def"));
+                c1.uncork();
+                coroutine.sleep(10);
+                assert.equal(c1.stats().writes, 0);
+
+                c1.uncork();
+                assert.equal(recv_all(c1, 6), "abcdef");
+                assert.equal(c1.stats().writes, 1);
+                c1.close();
+            });
+
+            it("flush", () => {
+                var c1 = echo_server();
+
+                c1.cork();
+                c1.write(Buffer.from("abc"));
+                c1.flush();
+                assert.equal(c1.stats().bytesOut, 3);
+                c1.close();
+            });
+
+            it("writer waits for a peer that does not read", () => {
+                var s1 = new net.Socket(net_config.family);
+                test_util.push(s1);
+
+                var _port = getPort();
+                var c;
+
+                s1.bind(_port);
+                s1.listen();
+                coroutine.start(() => {
+                    c = s1.accept();
+                });
+
+                var c1 = new net.Socket();
+                c1.connect('127.0.0.1', _port);
+                c1.autoCork = true;
+
+                var total = 0;
+                var done = false;
+                var buf = Buffer.alloc(1024);
+                coroutine.start(() => {
+                    try {
+                        while (true) {
+                            c1.write(buf);
+                            total += buf.length;
+                        }
+                    } catch (e) { }
+                    done = true;
+                });
+
+                coroutine.sleep(500);
+                var n = total;
+                coroutine.sleep(200);
+                assert.equal(total, n);
+                assert.isFalse(done);
+                assert.ok(total < 64 * 1024 * 1024);
+
+                // the peer goes away with data unread, so the blocked write fails
+                c.close();
+                for (var i = 0; i < 100 && !done; i++)
+                    coroutine.sleep(10);
+                assert.isTrue(done);
+
+                try {
+                    c1.close();
+                } catch (e) { }
+            });
+
+            it("sendfile after corked writes", () => {
+                var fname = path.join(__dirname, 'cork_sendfile' + base_port + '.txt');
+                fs.writeFile(fname, "file body");
+
+                try {
+                    var c1 = echo_server();
+                    c1.autoCork = true;
+
+                    c1.write(Buffer.from("head,"));
+                    var f = fs.openFile(fname);
+                    f.copyTo(c1);
+                    f.close();
+
+                    assert.equal(recv_all(c1, 14), "head,file body");
+                    c1.close();
+                } finally {
+                    del(fname);
+                }
+            });
+
+            it("large write bypass", () => {
+                var c1 = echo_server();
+
+                c1.autoCork = true;
+                c1.write(Buffer.alloc(100000));
+                assert.equal(c1.stats().bytesOut, 100000);
+                c1.close();
+            });
+        });
+
+        it("acceptStats", () => {
+            assert.equal(net.accept_batch, 64);
+            assert.throws(() => {
+                net.accept_batch = 0;
+            });
+            assert.throws(() => {
+                net.accept_batch = 2000;
+            });
+
+            var _port = getPort();
+            var cnt = 0;
+            var svr = new net.TcpServer(_port, (c) => {
+                cnt++;
+                c.close();
+            });
+            test_util.push(svr.socket);
+            svr.start();
+
+            var st1 = net.acceptStats();
+
+            var cs = [];
+            for (var i = 0; i < 10; i++) {
+                var c = new net.Socket();
+                c.connect('127.0.0.1', _port);
+                cs.push(c);
+            }
+
+            for (var i = 0; i < 100 && cnt < 10; i++)
+                coroutine.sleep(10);
+            cs.forEach(c => c.close());
+            svr.stop();
+
+            assert.equal(cnt, 10);
+
+            var st2 = net.acceptStats();
+            if (!use_uv) {
+                assert.greaterThan(st2.batches, st1.batches);
+                assert.equal(st2.accepted - st1.accepted, 10);
+                assert.ok(st2.maxBatch >= 1);
+                assert.isNumber(st2.avgBatch);
+            }
+        });
+
         it("echo", () => {
             function connect(c) {
                 console.log(c.remoteAddress, c.remotePort, "->",
@@ -302,6 +593,41 @@ function test_net(eng, use_uv) {
             del(path.join(__dirname, 'net_temp_000002' + base_port));
         });
 
+        it("writev", () => {
+            function accept_v(s) {
+                try {
+                    while (true) {
+                        var c = s.accept();
+
+                        c.writev([Buffer.from('abc'), Buffer.from(''), Buffer.from(str)]);
+                        c.close();
+                    }
+                } catch (e) { }
+            }
+
+            var s1 = new net.Socket(net_config.family);
+            test_util.push(s1);
+
+            var _port = getPort();
+
+            s1.bind(_port);
+            s1.listen();
+            coroutine.start(accept_v, s1);
+
+            var c1 = new net.Socket();
+            c1.connect('127.0.0.1', _port);
+            var bufs = [];
+            var b;
+            while (b = c1.read())
+                bufs.push(b);
+            assert.equal(Buffer.concat(bufs).toString(), 'abc' + str);
+            c1.close();
+
+            assert.throws(() => {
+                c1.writev(['abc']);
+            });
+        });
+
         it("read & recv", () => {
             function accept2(s) {
                 try {
@@ -481,6 +807,22 @@ function test_net(eng, use_uv) {
             test_util.push(svr.socket);
         });
 
+        if (process.platform != "win32")
+            it("bind same port with reuse_port", () => {
+                var _port = getPort();
+
+                net.reuse_port = true;
+                try {
+                    var svr1 = new net.TcpServer(_port, (c) => { });
+                    var svr2 = new net.TcpServer(_port, (c) => { });
+                } finally {
+                    net.reuse_port = false;
+                }
+
+                test_util.push(svr1.socket);
+                test_util.push(svr2.socket);
+            });
+
         describe("abort Pending I/O", () => {
             function close_it(s) {
                 coroutine.sleep(50);
@@ -762,4 +1104,45 @@ function test_net(eng, use_uv) {
 test_net("ev", false);
 test_net("uv", true);
 
+describe("net options", () => {
+    var child_process = require('child_process');
+    var script = path.join(__dirname, 'process', 'exec.net_traffic.js');
+
+    // io_uring needs linux 5.6 or later and can be switched off with kernel.io_uring_disabled
+    function uring_supported() {
+        var v = os.release().split('.');
+        if (Number(v[0]) < 5 || (Number(v[0]) == 5 && Number(v[1]) < 6))
+            return false;
+
+        try {
+            return fs.readTextFile('/proc/sys/kernel/io_uring_disabled').trim() == '0';
+        } catch (e) {
+            return true;
+        }
+    }
+
+    function run_traffic(opt, port) {
+        var r = child_process.execFile(process.execPath, [opt, script, port]);
+        return JSON.parse(r.stdout);
+    }
+
+    if (process.platform != "win32")
+        it("--io-threads=4", () => {
+            var r = run_traffic("--io-threads=4", base_port + 9002);
+
+            assert.equal(r.io_threads, 4);
+            assert.equal(r.echoed, 16 * 20);
+            assert.isTrue(r.file);
+        });
+
+    if (process.platform == "linux")
+        it("--use-io-uring", () => {
+            var r = run_traffic("--use-io-uring", base_port + 9001);
+
+            assert.equal(r.backend, uring_supported() ? "io_uring" : backend);
+            assert.equal(r.echoed, 16 * 20);
+            assert.isTrue(r.file);
+        });
+});
+
 require.main === module && test.run(console.DEBUG);
\ No newline at end of file
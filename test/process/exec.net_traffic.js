@@ -0,0 +1,55 @@
+var net = require('net');
+var fs = require('fs');
+var path = require('path');
+var os = require('os');
+var coroutine = require('coroutine');
+
+var port = parseInt(process.argv[2]);
+var conns = 16;
+var rounds = 20;
+
+var svr = new net.TcpServer(port, (c) => {
+    var b;
+    while (b = c.read())
+        c.write(b);
+});
+svr.start();
+
+var echoed = 0;
+var ids = [];
+for (var i = 0; i < conns; i++)
+    ids.push(i);
+
+coroutine.parallel(ids, (i) => {
+    var c = new net.Socket();
+    c.connect('127.0.0.1', port);
+
+    for (var j = 0; j < rounds; j++) {
+        var s = 'conn ' + i + ' round ' + j + ' ' + 'x'.repeat(i * 100 + j);
+        c.write(s);
+        if (c.read(s.length).toString() == s)
+            echoed++;
+    }
+
+    c.close();
+}, conns);
+
+svr.stop();
+
+var fname = path.join(os.tmpdir(), 'fibjs_net_traffic_' + process.pid);
+var data = Buffer.alloc(300000, 'abcdefg');
+
+var f = fs.openFile(fname, 'w+');
+f.write(data);
+f.rewind();
+var d1 = f.read(1000);
+var d2 = f.readAll();
+f.close();
+fs.unlink(fname);
+
+console.log(JSON.stringify({
+    backend: net.backend(),
+    io_threads: net.io_threads,
+    echoed: echoed,
+    file: d1.length + d2.length == data.length && data.compare(Buffer.concat([d1, d2])) == 0
+}));
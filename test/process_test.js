@@ -133,6 +133,34 @@ describe('process', () => {
         console.dir(process.memoryUsage());
     });
 
+    it("memoryUsage slab", () => {
+        var s1 = process.memoryUsage().slab;
+        var bufs = [];
+
+        for (var i = 0; i < 100; i++)
+            bufs.push(new ArrayBuffer(1000));
+
+        var s2 = process.memoryUsage().slab;
+        assert.ok(s2.allocs - s1.allocs >= 100);
+        assert.ok(s2.reserved >= s2.used);
+        assert.equal(new Buffer("abc").buffer.byteLength, 3);
+        assert.equal(typeof s2.released, "number");
+    });
+
+    it("memoryUsage slab buffer", () => {
+        var s1 = process.memoryUsage().slab;
+        var buf = new Buffer("abcdef").slice(1, 4);
+        var s2 = process.memoryUsage().slab;
+        assert.ok(s2.allocs > s1.allocs);
+
+        var arr = new Uint8Array(buf.buffer);
+        assert.equal(arr.length, 3);
+
+        buf[0] = 0x41;
+        assert.equal(arr[0], 0x41);
+        assert.equal(buf.buffer.byteLength, 3);
+    });
+
     it("version", () => {
         assert.ok(process.version);
     });